@@ -0,0 +1,126 @@
+//
+//  FHSBackfill.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+/**
+ Completion block, called on the main queue.
+ @param error Error, nil on success.
+ @param tweets Tweets fetched, newest first. On failure, the tweets fetched before the error.
+ */
+typedef void(^FHSBackfillCompletionBlock)(NSError *error, NSArray *tweets);
+
+/**
+ Fetches every tweet of a timeline within an ID range.
+ The range is split into windows by tweet ID time, which are fetched
+ concurrently instead of walking max_id down one request at a time. When a
+ window comes back with fewer tweets than it holds, the rest of it is
+ requested again, so a window is only done once it comes back empty.
+ Windows are fetched newest first and fetching stops at the endpoint's depth
+ limit, past which the API returns nothing.
+ */
+@interface FHSBackfill : NSObject
+
+/**
+ Tweets of a user. Depth limit 3200.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillForUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Mentions of the authenticated user. Depth limit 800.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillForMentions;
+
+/**
+ Tweets of the authenticated user that have been retweeted.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillForRetweetsOfMe;
+
+/**
+ Tweets a user has favorited.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillForFavoritesOfUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Tweets of a list, including retweets and replies.
+ @param listID List id.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillForListWithID:(NSString *)listID;
+
+/**
+ Backfill for any timeline endpoint that takes since_id, max_id and count and returns an array of tweets.
+ @param url Endpoint URL.
+ @param params Parameters, without since_id, max_id and count.
+ @param depthLimit Most tweets the endpoint will return, or 0 for none.
+ @return A backfill instance.
+ */
++ (FHSBackfill *)backfillWithURL:(NSURL *)url parameters:(NSDictionary *)params depthLimit:(NSUInteger)depthLimit;
+
+/**
+ Engine used to send requests. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Only fetch tweets newer than this id. Defaults to 0, the start of the timeline.
+ */
+@property (nonatomic, assign) uint64_t sinceID;
+
+/**
+ Only fetch tweets up to and including this id. Defaults to 0, now.
+ */
+@property (nonatomic, assign) uint64_t maxID;
+
+/**
+ Most requests in flight. Defaults to 4.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
+/**
+ Number of windows the range is first split into. Defaults to 8.
+ */
+@property (nonatomic, assign) NSUInteger windowCount;
+
+/**
+ Most tweets the endpoint will return, or 0 for none.
+ */
+@property (nonatomic, assign) NSUInteger depthLimit;
+
+/**
+ Whether to wait for the rate limit to reset and retry, rather than fail. Defaults to YES.
+ */
+@property (nonatomic, assign) BOOL waitsForRateLimit;
+
+/**
+ Set sinceID and maxID from a time window.
+ @param fromDate Start of the window, or nil.
+ @param toDate End of the window, or nil.
+ */
+- (void)setFromDate:(NSDate *)fromDate toDate:(NSDate *)toDate;
+
+/**
+ Start fetching.
+ @param block Block to be called on completion.
+ */
+- (void)startWithCompletionBlock:(FHSBackfillCompletionBlock)block;
+
+/**
+ Stop fetching. The completion block is called with a cancellation error and the tweets fetched so far.
+ */
+- (void)cancel;
+
+@end
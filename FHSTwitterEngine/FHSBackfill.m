@@ -0,0 +1,281 @@
+//
+//  FHSBackfill.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSBackfill.h"
+
+#include "FHSSnowflake.h"
+
+static NSString * const pageSize = @"200";
+
+// Used when a 429 comes without a reset time
+static NSTimeInterval const defaultRateLimitWait = 60.0;
+
+// Inclusive range of tweet ids still to fetch
+@interface FHSBackfillWindow : NSObject
+
+@property (nonatomic, assign) uint64_t low;
+@property (nonatomic, assign) uint64_t high;
+
+@end
+
+@implementation FHSBackfillWindow
+
++ (FHSBackfillWindow *)windowWithLow:(uint64_t)low high:(uint64_t)high {
+    FHSBackfillWindow *window = [[[self class]alloc]init];
+    window.low = low;
+    window.high = high;
+    return window;
+}
+
+@end
+
+// All state below is only touched on the backfill's serial queue.
+
+@interface FHSBackfill ()
+
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic, strong) NSDictionary *params;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray *pendingWindows; // newest last
+@property (nonatomic, strong) NSMutableDictionary *tweets; // by id
+@property (nonatomic, copy) FHSBackfillCompletionBlock completionBlock;
+@property (nonatomic, assign) NSUInteger requestsInFlight;
+@property (nonatomic, assign) BOOL running;
+@property (nonatomic, assign) NSUInteger generation; // ignores late responses from a cancelled run
+
+@end
+
+@implementation FHSBackfill
+
++ (FHSBackfill *)backfillForUser:(NSString *)user isID:(BOOL)isID {
+    return [self backfillWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointStatusesUserTimeline)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"", @"exclude_replies":@"false", @"include_rts":@"true" } depthLimit:3200];
+}
+
++ (FHSBackfill *)backfillForMentions {
+    return [self backfillWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointStatusesMentionsTimeline)->url)] parameters:nil depthLimit:800];
+}
+
++ (FHSBackfill *)backfillForRetweetsOfMe {
+    return [self backfillWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointStatusesRetweetsOfMe)->url)] parameters:nil depthLimit:0];
+}
+
++ (FHSBackfill *)backfillForFavoritesOfUser:(NSString *)user isID:(BOOL)isID {
+    return [self backfillWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointFavoritesList)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"" } depthLimit:0];
+}
+
++ (FHSBackfill *)backfillForListWithID:(NSString *)listID {
+    return [self backfillWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointListsStatuses)->url)] parameters:@{ @"list_id":listID?:@"", @"include_rts":@"true" } depthLimit:0];
+}
+
++ (FHSBackfill *)backfillWithURL:(NSURL *)url parameters:(NSDictionary *)params depthLimit:(NSUInteger)depthLimit {
+    return [[[self class]alloc]initWithURL:url parameters:params depthLimit:depthLimit];
+}
+
+- (instancetype)initWithURL:(NSURL *)url parameters:(NSDictionary *)params depthLimit:(NSUInteger)depthLimit {
+    self = [super init];
+    if (self) {
+        self.url = url;
+        self.params = params?:@{};
+        self.depthLimit = depthLimit;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.maxConcurrentRequests = 4;
+        self.windowCount = 8;
+        self.waitsForRateLimit = YES;
+        self.queue = dispatch_queue_create("FHSBackfill", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)setFromDate:(NSDate *)fromDate toDate:(NSDate *)toDate {
+    uint64_t first = fromDate.fhs_firstTweetID;
+    self.sinceID = (first > 0)?first-1:0;
+    self.maxID = toDate?MAX(toDate.fhs_lastTweetID, 1):0;
+}
+
+- (NSError *)cancelledError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:@{NSLocalizedDescriptionKey: @"The backfill was cancelled."}];
+}
+
+- (BOOL)reachedDepthLimit {
+    return _depthLimit > 0 && _tweets.count >= _depthLimit;
+}
+
+- (void)finishWithError:(NSError *)error {
+    FHSBackfillCompletionBlock block = _completionBlock;
+    NSArray *tweetIDs = [_tweets.allKeys sortedArrayUsingSelector:@selector(compare:)].reverseObjectEnumerator.allObjects;
+    NSArray *tweets = [_tweets objectsForKeys:tweetIDs notFoundMarker:[NSNull null]];
+
+    self.completionBlock = nil;
+    self.pendingWindows = nil;
+    self.tweets = nil;
+    self.running = NO;
+    self.generation++;
+
+    if (block) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            block(error, tweets);
+        });
+    }
+}
+
+- (void)scheduleRequests {
+    while (_running && _requestsInFlight < MAX(_maxConcurrentRequests, 1) && _pendingWindows.count > 0 && !self.reachedDepthLimit) {
+        FHSBackfillWindow *window = _pendingWindows.lastObject;
+        [_pendingWindows removeLastObject];
+        [self fetchWindow:window];
+    }
+
+    if (_running && _requestsInFlight == 0 && (_pendingWindows.count == 0 || self.reachedDepthLimit)) {
+        [self finishWithError:nil];
+    }
+}
+
+- (void)fetchWindow:(FHSBackfillWindow *)window {
+    NSMutableDictionary *params = [_params mutableCopy];
+    params[@"count"] = pageSize;
+    params[@"max_id"] = [NSString fhs_stringWithTweetID:window.high];
+
+    if (window.low > 1) {
+        params[@"since_id"] = [NSString fhs_stringWithTweetID:window.low-1];
+    }
+
+    NSUInteger generation = _generation;
+    FHSTwitterEngine *engine = _engine;
+    NSURL *url = _url;
+    self.requestsInFlight++;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = [engine sendRequestForURL:url HTTPMethod:@"GET" parameters:params];
+
+            dispatch_async(self.queue, ^{
+                if (!self.running || self.generation != generation) {
+                    return;
+                }
+
+                [self handleResponse:response forWindow:window];
+            });
+        }
+    });
+}
+
+- (void)handleResponse:(id)response forWindow:(FHSBackfillWindow *)window {
+    if ([response isKindOfClass:[NSError class]] && [[response domain]isEqualToString:FHSErrorDomain] && [response code] == 429 && _waitsForRateLimit) {
+        // Keep the slot while waiting, nothing else would get through either
+        NSDate *reset = [response userInfo][FHSRateLimitResetDateKey]?:[NSDate dateWithTimeIntervalSinceNow:defaultRateLimitWait];
+        NSTimeInterval delay = MAX(reset.timeIntervalSinceNow, 0)+1.0;
+        NSUInteger generation = _generation;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay*NSEC_PER_SEC)), _queue, ^{
+            if (!self.running || self.generation != generation) {
+                return;
+            }
+
+            self.requestsInFlight--;
+            [self.pendingWindows addObject:window];
+            [self scheduleRequests];
+        });
+        return;
+    }
+
+    self.requestsInFlight--;
+
+    if ([response isKindOfClass:[NSError class]]) {
+        [self finishWithError:response];
+        return;
+    }
+
+    if (![response isKindOfClass:[NSArray class]]) {
+        [self finishWithError:[NSError noDataError]];
+        return;
+    }
+
+    uint64_t oldest = UINT64_MAX;
+
+    for (id tweet in response) {
+        uint64_t tweetID = [tweet isKindOfClass:[NSDictionary class]]?[tweet[@"id_str"] fhs_tweetID]:0;
+
+        if (tweetID >= window.low && tweetID <= window.high) {
+            _tweets[@(tweetID)] = tweet;
+            oldest = MIN(oldest, tweetID);
+        }
+    }
+
+    // An empty page means the window is done. Otherwise refill whatever is older than the page.
+    if (oldest != UINT64_MAX && oldest > window.low) {
+        uint64_t high = oldest-1;
+        uint64_t span = high-window.low;
+        NSUInteger slots = MAX(_maxConcurrentRequests, 1);
+
+        // Split the gap when there is nothing else to keep the other slots busy
+        if (_pendingWindows.count == 0 && _requestsInFlight+1 < slots && span > (1ULL << 22)) {
+            uint64_t middle = window.low+span/2;
+            [_pendingWindows addObject:[FHSBackfillWindow windowWithLow:window.low high:middle]];
+            [_pendingWindows addObject:[FHSBackfillWindow windowWithLow:middle+1 high:high]];
+        } else {
+            [_pendingWindows addObject:[FHSBackfillWindow windowWithLow:window.low high:high]];
+        }
+    }
+
+    [self scheduleRequests];
+}
+
+- (void)startWithCompletionBlock:(FHSBackfillCompletionBlock)block {
+    uint64_t low = _sinceID+1;
+    uint64_t high = (_maxID > 0)?_maxID:fhs_snowflake_last_id((uint64_t)(NSDate.date.timeIntervalSince1970*1000.0));
+    NSUInteger windowCount = MAX(_windowCount, 1);
+
+    dispatch_async(_queue, ^{
+        if (self.running) {
+            return;
+        }
+
+        if (self.url == nil || high < low) {
+            if (block) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    block([NSError badRequestError], nil);
+                });
+            }
+            return;
+        }
+
+        self.running = YES;
+        self.completionBlock = block;
+        self.tweets = [NSMutableDictionary dictionary];
+        self.pendingWindows = [NSMutableArray arrayWithCapacity:windowCount];
+        self.requestsInFlight = 0;
+
+        // Equal id spans are equal time spans. Oldest first, so the newest is fetched first.
+        uint64_t step = MAX((high-low)/windowCount, 1);
+        uint64_t start = low;
+
+        while (start <= high) {
+            uint64_t end = (high-start <= step || self.pendingWindows.count == windowCount-1)?high:start+step-1;
+            [self.pendingWindows addObject:[FHSBackfillWindow windowWithLow:start high:end]];
+
+            if (end == high) {
+                break;
+            }
+
+            start = end+1;
+        }
+
+        [self scheduleRequests];
+    });
+}
+
+- (void)cancel {
+    dispatch_async(_queue, ^{
+        if (!self.running) {
+            return;
+        }
+
+        [self finishWithError:[self cancelledError]];
+    });
+}
+
+@end
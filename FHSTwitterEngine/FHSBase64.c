@@ -0,0 +1,507 @@
+//
+//  FHSBase64.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSBase64.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define FHS_BASE64_X86 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FHS_BASE64_NEON 1
+#endif
+
+static char const alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 0xFF marks characters outside the alphabet
+static const uint8_t decodeTable[256] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+};
+
+//
+// Vector kernels. Each one handles as many whole blocks as it can without
+// reading or writing out of bounds and returns the number of input bytes
+// consumed, always a multiple of 3 (encode) or 4 (decode). Decoders stop
+// at the first block holding a character outside the alphabet and leave it
+// to the scalar loop, which also deals with padding.
+//
+
+typedef size_t (*fhs_base64_encode_fn)(const uint8_t *src, size_t length, char *dst);
+typedef size_t (*fhs_base64_decode_fn)(const char *src, size_t length, uint8_t *dst);
+
+static size_t fhs_base64_encode_none(const uint8_t *src, size_t length, char *dst) {
+    (void)src; (void)length; (void)dst;
+    return 0;
+}
+
+static size_t fhs_base64_decode_none(const char *src, size_t length, uint8_t *dst) {
+    (void)src; (void)length; (void)dst;
+    return 0;
+}
+
+#if FHS_BASE64_X86
+
+#define FHS_BASE64_OFFSETS 'a'-26, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, '0'-52, \
+                           '0'-52, '0'-52, '0'-52, '+'-62, '/'-63, 'A', 0, 0
+
+// 12 input bytes in the low lanes of a 128-bit vector become 16 six-bit indices,
+// which are mapped to ASCII by adding an offset picked by the range they fall in.
+// The AVX2 versions do the same to each 128-bit half.
+
+__attribute__((target("ssse3")))
+static inline __m128i fhs_base64_encode_block_ssse3(__m128i in) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i hi = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+    __m128i lo = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(hi, lo);
+
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(_mm_setr_epi8(FHS_BASE64_OFFSETS), range), indices);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i fhs_base64_encode_block_avx2(__m256i in) {
+    in = _mm256_shuffle_epi8(in, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                                 10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m256i hi = _mm256_mulhi_epu16(_mm256_and_si256(in, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+    __m256i lo = _mm256_mullo_epi16(_mm256_and_si256(in, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+    __m256i indices = _mm256_or_si256(hi, lo);
+
+    __m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+    __m256i less = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+    range = _mm256_or_si256(range, _mm256_and_si256(less, _mm256_set1_epi8(13)));
+    return _mm256_add_epi8(_mm256_shuffle_epi8(_mm256_setr_epi8(FHS_BASE64_OFFSETS, FHS_BASE64_OFFSETS), range), indices);
+}
+
+__attribute__((target("ssse3")))
+static size_t fhs_base64_encode_ssse3(const uint8_t *src, size_t length, char *dst) {
+    size_t consumed = 0;
+
+    // Loads 16 bytes, uses 12
+    while (length-consumed >= 16) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(src+consumed));
+        _mm_storeu_si128((__m128i *)dst, fhs_base64_encode_block_ssse3(in));
+        consumed += 12;
+        dst += 16;
+    }
+
+    return consumed;
+}
+
+__attribute__((target("avx2")))
+static size_t fhs_base64_encode_avx2(const uint8_t *src, size_t length, char *dst) {
+    size_t consumed = 0;
+
+    // Each half loads 16 bytes and uses 12
+    while (length-consumed >= 28) {
+        __m128i lo = _mm_loadu_si128((const __m128i *)(src+consumed));
+        __m128i hi = _mm_loadu_si128((const __m128i *)(src+consumed+12));
+        __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+        _mm256_storeu_si256((__m256i *)dst, fhs_base64_encode_block_avx2(in));
+        consumed += 24;
+        dst += 32;
+    }
+
+    return consumed+fhs_base64_encode_ssse3(src+consumed, length-consumed, dst);
+}
+
+// Decoding tables, indexed by the low and high nibble of each character.
+// A character is valid when its two lookups share no bit.
+#define FHS_BASE64_LUT_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define FHS_BASE64_LUT_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define FHS_BASE64_LUT_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define FHS_BASE64_PACK 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+__attribute__((target("ssse3")))
+static size_t fhs_base64_decode_ssse3(const char *src, size_t length, uint8_t *dst) {
+    const __m128i lutLo = _mm_setr_epi8(FHS_BASE64_LUT_LO);
+    const __m128i lutHi = _mm_setr_epi8(FHS_BASE64_LUT_HI);
+    const __m128i lutRoll = _mm_setr_epi8(FHS_BASE64_LUT_ROLL);
+    const __m128i pack = _mm_setr_epi8(FHS_BASE64_PACK);
+    const __m128i nibble = _mm_set1_epi8(0x0F);
+    size_t consumed = 0;
+
+    // Writes 16 bytes, uses 12. Leaving 8 characters behind keeps the
+    // store inside the output and the final, maybe padded, block for the scalar loop.
+    while (length-consumed >= 24) {
+        __m128i in = _mm_loadu_si128((const __m128i *)(src+consumed));
+        __m128i hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+        __m128i lo = _mm_shuffle_epi8(lutLo, _mm_and_si128(in, nibble));
+        __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+
+        __m128i slash = _mm_cmpeq_epi8(in, _mm_set1_epi8('/'));
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(slash, hiNibbles));
+        __m128i values = _mm_add_epi8(in, roll);
+
+        values = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        values = _mm_madd_epi16(values, _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i *)dst, _mm_shuffle_epi8(values, pack));
+
+        consumed += 16;
+        dst += 12;
+    }
+
+    return consumed;
+}
+
+__attribute__((target("avx2")))
+static size_t fhs_base64_decode_avx2(const char *src, size_t length, uint8_t *dst) {
+    const __m256i lutLo = _mm256_setr_epi8(FHS_BASE64_LUT_LO, FHS_BASE64_LUT_LO);
+    const __m256i lutHi = _mm256_setr_epi8(FHS_BASE64_LUT_HI, FHS_BASE64_LUT_HI);
+    const __m256i lutRoll = _mm256_setr_epi8(FHS_BASE64_LUT_ROLL, FHS_BASE64_LUT_ROLL);
+    const __m256i pack = _mm256_setr_epi8(FHS_BASE64_PACK, FHS_BASE64_PACK);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    size_t consumed = 0;
+
+    // Writes 32 bytes, uses 24
+    while (length-consumed >= 48) {
+        __m256i in = _mm256_loadu_si256((const __m256i *)(src+consumed));
+        __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+        __m256i lo = _mm256_shuffle_epi8(lutLo, _mm256_and_si256(in, nibble));
+        __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+
+        if (!_mm256_testz_si256(lo, hi)) {
+            break;
+        }
+
+        __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+        __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(slash, hiNibbles));
+        __m256i values = _mm256_add_epi8(in, roll);
+
+        values = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        values = _mm256_madd_epi16(values, _mm256_set1_epi32(0x00011000));
+        values = _mm256_shuffle_epi8(values, pack);
+        values = _mm256_permutevar8x32_epi32(values, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7));
+        _mm256_storeu_si256((__m256i *)dst, values);
+
+        consumed += 32;
+        dst += 24;
+    }
+
+    return consumed+fhs_base64_decode_ssse3(src+consumed, length-consumed, dst);
+}
+
+#endif
+
+#if FHS_BASE64_NEON
+
+static size_t fhs_base64_encode_neon(const uint8_t *src, size_t length, char *dst) {
+    const uint8x16x4_t table = {{vld1q_u8((const uint8_t *)alphabet), vld1q_u8((const uint8_t *)alphabet+16),
+                                 vld1q_u8((const uint8_t *)alphabet+32), vld1q_u8((const uint8_t *)alphabet+48)}};
+    const uint8x16_t mask = vdupq_n_u8(0x3F);
+    size_t consumed = 0;
+
+    while (length-consumed >= 48) {
+        uint8x16x3_t in = vld3q_u8(src+consumed);
+        uint8x16x4_t out;
+
+        out.val[0] = vshrq_n_u8(in.val[0], 2);
+        out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask);
+        out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask);
+        out.val[3] = vandq_u8(in.val[2], mask);
+
+        for (int i = 0; i < 4; i++) {
+            out.val[i] = vqtbl4q_u8(table, out.val[i]);
+        }
+
+        vst4q_u8((uint8_t *)dst, out);
+        consumed += 48;
+        dst += 64;
+    }
+
+    return consumed;
+}
+
+static size_t fhs_base64_decode_neon(const char *src, size_t length, uint8_t *dst) {
+    const uint8x16x4_t tableLo = {{vld1q_u8(decodeTable), vld1q_u8(decodeTable+16), vld1q_u8(decodeTable+32), vld1q_u8(decodeTable+48)}};
+    const uint8x16x4_t tableHi = {{vld1q_u8(decodeTable+64), vld1q_u8(decodeTable+80), vld1q_u8(decodeTable+96), vld1q_u8(decodeTable+112)}};
+    const uint8x16_t offset = vdupq_n_u8(64);
+    const uint8x16_t ascii = vdupq_n_u8(0x80);
+    size_t consumed = 0;
+
+    // Leave the final, maybe padded, block for the scalar loop
+    while (length-consumed >= 68) {
+        uint8x16x4_t in = vld4q_u8((const uint8_t *)src+consumed);
+        uint8x16_t invalid = vdupq_n_u8(0);
+
+        for (int i = 0; i < 4; i++) {
+            uint8x16_t v = in.val[i];
+            uint8x16_t d = vqtbx4q_u8(vqtbl4q_u8(tableLo, v), tableHi, vsubq_u8(v, offset));
+            d = vorrq_u8(d, vcgeq_u8(v, ascii));
+            invalid = vorrq_u8(invalid, d);
+            in.val[i] = d;
+        }
+
+        if (vmaxvq_u8(invalid) > 0x3F) {
+            break;
+        }
+
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(in.val[0], 2), vshrq_n_u8(in.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(in.val[1], 4), vshrq_n_u8(in.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(in.val[2], 6), in.val[3]);
+        vst3q_u8(dst, out);
+
+        consumed += 64;
+        dst += 48;
+    }
+
+    return consumed;
+}
+
+#endif
+
+//
+// Kernel selection
+//
+
+static fhs_base64_encode_fn encodeKernel = fhs_base64_encode_none;
+static fhs_base64_decode_fn decodeKernel = fhs_base64_decode_none;
+static const char *kernelName = "scalar";
+static FHSBase64Backend detectedBackend = FHSBase64BackendScalar;
+static pthread_once_t detectOnce = PTHREAD_ONCE_INIT;
+
+static int fhs_base64_set_kernels(FHSBase64Backend backend) {
+    switch (backend) {
+        case FHSBase64BackendScalar:
+            encodeKernel = fhs_base64_encode_none;
+            decodeKernel = fhs_base64_decode_none;
+            kernelName = "scalar";
+            return 0;
+#if FHS_BASE64_X86
+        case FHSBase64BackendSSSE3:
+            encodeKernel = fhs_base64_encode_ssse3;
+            decodeKernel = fhs_base64_decode_ssse3;
+            kernelName = "ssse3";
+            return 0;
+        case FHSBase64BackendAVX2:
+            encodeKernel = fhs_base64_encode_avx2;
+            decodeKernel = fhs_base64_decode_avx2;
+            kernelName = "avx2";
+            return 0;
+#elif FHS_BASE64_NEON
+        case FHSBase64BackendNEON:
+            encodeKernel = fhs_base64_encode_neon;
+            decodeKernel = fhs_base64_decode_neon;
+            kernelName = "neon";
+            return 0;
+#endif
+        default:
+            return -1;
+    }
+}
+
+static int fhs_base64_supports(FHSBase64Backend backend) {
+    switch (backend) {
+        case FHSBase64BackendScalar:
+            return 1;
+#if FHS_BASE64_X86
+        case FHSBase64BackendSSSE3:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("ssse3");
+        case FHSBase64BackendAVX2:
+            // The AVX2 decoder finishes with the SSSE3 one
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("ssse3");
+#elif FHS_BASE64_NEON
+        case FHSBase64BackendNEON:
+            return 1;
+#endif
+        default:
+            return 0;
+    }
+}
+
+static void fhs_base64_detect(void) {
+    static const FHSBase64Backend preferred[] = { FHSBase64BackendAVX2, FHSBase64BackendSSSE3, FHSBase64BackendNEON };
+
+    for (size_t i = 0; i < sizeof(preferred)/sizeof(preferred[0]); i++) {
+        if (fhs_base64_supports(preferred[i])) {
+            detectedBackend = preferred[i];
+            break;
+        }
+    }
+
+    fhs_base64_set_kernels(detectedBackend);
+}
+
+int fhs_base64_use_backend(FHSBase64Backend backend) {
+    pthread_once(&detectOnce, fhs_base64_detect);
+
+    if (backend == FHSBase64BackendDetected) {
+        backend = detectedBackend;
+    }
+
+    if (!fhs_base64_supports(backend)) {
+        return -1;
+    }
+
+    return fhs_base64_set_kernels(backend);
+}
+
+const char *fhs_base64_backend_name(void) {
+    pthread_once(&detectOnce, fhs_base64_detect);
+    return kernelName;
+}
+
+//
+// Scalar
+//
+
+static size_t fhs_base64_encode_scalar(const uint8_t *src, size_t length, char *dst) {
+    char *out = dst;
+    size_t i = 0;
+
+    for (; i+3 <= length; i += 3) {
+        uint32_t v = ((uint32_t)src[i] << 16) | ((uint32_t)src[i+1] << 8) | src[i+2];
+        out[0] = alphabet[v >> 18];
+        out[1] = alphabet[(v >> 12) & 0x3F];
+        out[2] = alphabet[(v >> 6) & 0x3F];
+        out[3] = alphabet[v & 0x3F];
+        out += 4;
+    }
+
+    if (i < length) {
+        uint32_t v = (uint32_t)src[i] << 16;
+        if (i+1 < length) {
+            v |= (uint32_t)src[i+1] << 8;
+        }
+        out[0] = alphabet[v >> 18];
+        out[1] = alphabet[(v >> 12) & 0x3F];
+        out[2] = (i+1 < length)?alphabet[(v >> 6) & 0x3F]:'=';
+        out[3] = '=';
+        out += 4;
+    }
+
+    return out-dst;
+}
+
+size_t fhs_base64_encode(const void *src, size_t length, char *dst) {
+    pthread_once(&detectOnce, fhs_base64_detect);
+
+    const uint8_t *in = src;
+    size_t consumed = encodeKernel(in, length, dst);
+    size_t written = (consumed/3)*4;
+    return written+fhs_base64_encode_scalar(in+consumed, length-consumed, dst+written);
+}
+
+int fhs_base64_decode(const char *src, size_t length, uint8_t *dst, size_t *decodedLength) {
+    pthread_once(&detectOnce, fhs_base64_detect);
+
+    const uint8_t *in = (const uint8_t *)src;
+    uint8_t *out = dst;
+
+    // Strip padding, at most two characters
+    if (length % 4 == 0 && length > 0 && in[length-1] == '=') {
+        length -= (in[length-2] == '=')?2:1;
+    }
+
+    if (length % 4 == 1) {
+        return -1;
+    }
+
+    size_t consumed = decodeKernel(src, length, out);
+    out += (consumed/4)*3;
+    in += consumed;
+    length -= consumed;
+
+    for (; length >= 4; length -= 4, in += 4, out += 3) {
+        uint32_t a = decodeTable[in[0]], b = decodeTable[in[1]], c = decodeTable[in[2]], d = decodeTable[in[3]];
+        if ((a | b | c | d) & 0xC0) {
+            return -1;
+        }
+        uint32_t v = (a << 18) | (b << 12) | (c << 6) | d;
+        out[0] = (uint8_t)(v >> 16);
+        out[1] = (uint8_t)(v >> 8);
+        out[2] = (uint8_t)v;
+    }
+
+    if (length > 0) {
+        uint32_t a = decodeTable[in[0]], b = decodeTable[in[1]], c = (length == 3)?decodeTable[in[2]]:0;
+        if ((a | b | c) & 0xC0) {
+            return -1;
+        }
+        uint32_t v = (a << 18) | (b << 12) | (c << 6);
+        *out++ = (uint8_t)(v >> 16);
+        if (length == 3) {
+            *out++ = (uint8_t)(v >> 8);
+        }
+    }
+
+    *decodedLength = out-dst;
+    return 0;
+}
+
+//
+// Streaming
+//
+
+void fhs_base64_stream_init(fhs_base64_stream *stream) {
+    stream->carryLength = 0;
+}
+
+size_t fhs_base64_stream_update(fhs_base64_stream *stream, const void *src, size_t length, char *dst) {
+    const uint8_t *in = src;
+    size_t written = 0;
+
+    // Complete the group left over from the last call
+    if (stream->carryLength > 0) {
+        uint8_t group[3] = {stream->carry[0], stream->carry[1], 0};
+        size_t n = stream->carryLength;
+
+        while (n < 3 && length > 0) {
+            group[n++] = *in++;
+            length--;
+        }
+
+        if (n < 3) {
+            memcpy(stream->carry, group, n);
+            stream->carryLength = n;
+            return 0;
+        }
+
+        written = fhs_base64_encode_scalar(group, 3, dst);
+    }
+
+    size_t whole = (length/3)*3;
+    written += fhs_base64_encode(in, whole, dst+written);
+
+    stream->carryLength = length-whole;
+    memcpy(stream->carry, in+whole, stream->carryLength);
+
+    return written;
+}
+
+size_t fhs_base64_stream_final(fhs_base64_stream *stream, char *dst) {
+    size_t written = fhs_base64_encode_scalar(stream->carry, stream->carryLength, dst);
+    stream->carryLength = 0;
+    return written;
+}
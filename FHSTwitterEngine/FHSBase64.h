@@ -0,0 +1,102 @@
+//
+//  FHSBase64.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Base64 (RFC 4648) encoding and decoding with SSSE3/AVX2/NEON kernels.
+//
+
+#ifndef FHSBASE64_H
+#define FHSBASE64_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Streaming encoder state, holds up to two bytes between calls.
+ */
+typedef struct {
+    uint8_t carry[2];
+    size_t carryLength;
+} fhs_base64_stream;
+
+/**
+ Name of the kernels in use: "scalar", "ssse3", "avx2" or "neon".
+ */
+const char *fhs_base64_backend_name(void);
+
+typedef enum {
+    FHSBase64BackendDetected = 0, // picked at startup for this CPU
+    FHSBase64BackendScalar,
+    FHSBase64BackendSSSE3,
+    FHSBase64BackendAVX2,
+    FHSBase64BackendNEON
+} FHSBase64Backend;
+
+/**
+ Switch to a built-in set of kernels, e.g. to test the scalar loop on a CPU with vector units.
+ @param backend Backend.
+ @return 0, or -1 if this build or CPU doesn't have it.
+ */
+int fhs_base64_use_backend(FHSBase64Backend backend);
+
+/**
+ Encoded length, including padding.
+ */
+static inline size_t fhs_base64_encoded_length(size_t length) {
+    return ((length+2)/3)*4;
+}
+
+/**
+ Upper bound on the decoded length of a base64 string.
+ */
+static inline size_t fhs_base64_decoded_length(size_t length) {
+    return ((length+3)/4)*3;
+}
+
+/**
+ Base64 encode.
+ @param src Input bytes.
+ @param length Input length.
+ @param dst Output, at least fhs_base64_encoded_length(length) bytes. Not NUL-terminated.
+ @return Number of characters written.
+ */
+size_t fhs_base64_encode(const void *src, size_t length, char *dst);
+
+/**
+ Base64 decode. Padding is optional, whitespace is not allowed.
+ @param src Input characters.
+ @param length Input length.
+ @param dst Output, at least fhs_base64_decoded_length(length) bytes.
+ @param decodedLength Number of bytes written.
+ @return 0 on success, -1 if the input is not valid base64.
+ */
+int fhs_base64_decode(const char *src, size_t length, uint8_t *dst, size_t *decodedLength);
+
+void fhs_base64_stream_init(fhs_base64_stream *stream);
+
+/**
+ Encode the next chunk of a stream.
+ Only whole three-byte groups are written, the rest is carried into the next call.
+ @param dst Output, at least fhs_base64_encoded_length(length+2) bytes.
+ @return Number of characters written.
+ */
+size_t fhs_base64_stream_update(fhs_base64_stream *stream, const void *src, size_t length, char *dst);
+
+/**
+ Flush the carried bytes with padding.
+ @param dst Output, at least 4 bytes.
+ @return Number of characters written.
+ */
+size_t fhs_base64_stream_final(fhs_base64_stream *stream, char *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
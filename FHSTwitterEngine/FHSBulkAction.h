@@ -0,0 +1,151 @@
+//
+//  FHSBulkAction.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+@class FHSBulkAction;
+
+/**
+ Progress block, called on the main queue after each request.
+ @param action The action, for its counts, throughput and estimate.
+ */
+typedef void(^FHSBulkActionProgressBlock)(FHSBulkAction *action);
+
+/**
+ Completion block, called on the main queue.
+ @param error Error that stopped the job, nil if every target was tried.
+ @param failures Errors of the targets that failed, by target.
+ */
+typedef void(^FHSBulkActionCompletionBlock)(NSError *error, NSDictionary *failures);
+
+/**
+ Follows, unfollows, blocks, unblocks, or adds or removes list members, for
+ many users. Requests run with bounded concurrency, wait out rate limits, and
+ list changes go 100 users per request.
+ Targets that succeed are appended to a journal file. A job started again
+ with the same journal skips them, so a crashed job picks up where it left
+ off. A request that succeeds but is cut off before its journal entry is
+ written is sent again, which these endpoints treat as a no-op.
+ Failed targets are not journaled and are tried again when the job is resumed.
+ */
+@interface FHSBulkAction : NSObject
+
+/**
+ Follow users.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @return An action instance.
+ */
++ (FHSBulkAction *)followUsers:(NSArray *)users isID:(BOOL)isID;
+
+/**
+ Unfollow users.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @return An action instance.
+ */
++ (FHSBulkAction *)unfollowUsers:(NSArray *)users isID:(BOOL)isID;
+
+/**
+ Block users.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @return An action instance.
+ */
++ (FHSBulkAction *)blockUsers:(NSArray *)users isID:(BOOL)isID;
+
+/**
+ Unblock users.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @return An action instance.
+ */
++ (FHSBulkAction *)unblockUsers:(NSArray *)users isID:(BOOL)isID;
+
+/**
+ Add users to a list.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @param listID List id.
+ @return An action instance.
+ */
++ (FHSBulkAction *)addUsers:(NSArray *)users isID:(BOOL)isID toListWithID:(NSString *)listID;
+
+/**
+ Remove users from a list.
+ @param users Users.
+ @param isID Boolean whether the users are user ids.
+ @param listID List id.
+ @return An action instance.
+ */
++ (FHSBulkAction *)removeUsers:(NSArray *)users isID:(BOOL)isID fromListWithID:(NSString *)listID;
+
+/**
+ Engine used to send requests. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Journal file, or nil for none. Use one file per job.
+ */
+@property (nonatomic, copy) NSString *journalPath;
+
+/**
+ Most requests in flight. Defaults to 2.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentRequests;
+
+/**
+ Least time between the starts of two requests, for limits the API doesn't report in headers. Defaults to 0.
+ */
+@property (nonatomic, assign) NSTimeInterval minimumInterval;
+
+/**
+ Whether to wait for the rate limit to reset and retry, rather than fail the targets. Defaults to YES.
+ */
+@property (nonatomic, assign) BOOL waitsForRateLimit;
+
+/**
+ Number of targets.
+ */
+@property (readonly) NSUInteger totalCount;
+
+/**
+ Number of targets done, including those skipped from the journal.
+ */
+@property (readonly) NSUInteger completedCount;
+
+/**
+ Number of targets that failed.
+ */
+@property (readonly) NSUInteger failedCount;
+
+/**
+ Targets done per second in this run.
+ */
+@property (readonly) double throughput;
+
+/**
+ Seconds until the remaining targets are done at the current throughput, or -1 before there is one.
+ */
+@property (readonly) NSTimeInterval estimatedTimeRemaining;
+
+/**
+ Start the job.
+ @param progressBlock Block to be called after each request, may be nil.
+ @param completionBlock Block to be called on completion.
+ */
+- (void)startWithProgressBlock:(FHSBulkActionProgressBlock)progressBlock completionBlock:(FHSBulkActionCompletionBlock)completionBlock;
+
+/**
+ Stop the job once the requests in flight return. Requests waiting out a rate limit are dropped right away.
+ The completion block is called with a cancellation error.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,407 @@
+//
+//  FHSBulkAction.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSBulkAction.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+// Used when a 429 comes without a reset time
+static NSTimeInterval const defaultRateLimitWait = 60.0;
+
+// All state below is only touched on the action's serial queue, except the
+// counters, which are atomic so they can be read from anywhere.
+
+@interface FHSBulkAction () {
+    FILE *_journal;
+}
+
+@property (nonatomic, assign) FHSEndpoint endpoint;
+@property (nonatomic, strong) NSDictionary *params;
+@property (nonatomic, strong) NSString *usersKey;
+@property (nonatomic, strong) NSArray *targets;
+@property (nonatomic, assign) NSUInteger chunkSize;
+
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray *pendingChunks;
+@property (nonatomic, strong) NSMutableDictionary *failures;
+@property (nonatomic, copy) FHSBulkActionProgressBlock progressBlock;
+@property (nonatomic, copy) FHSBulkActionCompletionBlock completionBlock;
+@property (nonatomic, assign) NSUInteger requestsInFlight;
+@property (nonatomic, assign) NSUInteger rateLimitedChunks; // waiting out a 429, holding a slot but nothing to wait for on cancel
+@property (nonatomic, assign) BOOL running;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, strong) NSError *stopError;
+@property (nonatomic, assign) BOOL waitingForInterval;
+@property (nonatomic, assign) NSTimeInterval nextRequestTime;
+@property (nonatomic, assign) NSTimeInterval startTime;
+@property (nonatomic, assign) NSUInteger skippedCount; // done in an earlier run
+@property (nonatomic, assign) NSUInteger generation; // ignores late responses from a cancelled run
+
+@property (readwrite) NSUInteger totalCount;
+@property (readwrite) NSUInteger completedCount;
+@property (readwrite) NSUInteger failedCount;
+@property (readwrite) double throughput;
+@property (readwrite) NSTimeInterval estimatedTimeRemaining;
+
+@end
+
+@implementation FHSBulkAction
+
++ (FHSBulkAction *)followUsers:(NSArray *)users isID:(BOOL)isID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointFriendshipsCreate parameters:nil users:users isID:isID];
+}
+
++ (FHSBulkAction *)unfollowUsers:(NSArray *)users isID:(BOOL)isID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointFriendshipsDestroy parameters:nil users:users isID:isID];
+}
+
++ (FHSBulkAction *)blockUsers:(NSArray *)users isID:(BOOL)isID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointBlocksCreate parameters:@{ @"skip_status":@"true" } users:users isID:isID];
+}
+
++ (FHSBulkAction *)unblockUsers:(NSArray *)users isID:(BOOL)isID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointBlocksDestroy parameters:@{ @"skip_status":@"true" } users:users isID:isID];
+}
+
++ (FHSBulkAction *)addUsers:(NSArray *)users isID:(BOOL)isID toListWithID:(NSString *)listID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointListsMembersCreateAll parameters:@{ @"list_id":listID?:@"" } users:users isID:isID];
+}
+
++ (FHSBulkAction *)removeUsers:(NSArray *)users isID:(BOOL)isID fromListWithID:(NSString *)listID {
+    return [[[self class]alloc]initWithEndpoint:FHSEndpointListsMembersDestroyAll parameters:@{ @"list_id":listID?:@"" } users:users isID:isID];
+}
+
+- (instancetype)initWithEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params users:(NSArray *)users isID:(BOOL)isID {
+    self = [super init];
+    if (self) {
+        self.endpoint = endpoint;
+        self.params = params?:@{};
+        self.usersKey = isID?@"user_id":@"screen_name";
+        self.targets = [NSOrderedSet orderedSetWithArray:users?:@[]].array;
+
+        // As many users per request as the endpoint's schema takes
+        const char *usersKey = _usersKey.UTF8String;
+        const fhs_endpoint_param *schema = fhs_endpoint_param_named(fhs_endpoint_get(endpoint), usersKey, strlen(usersKey));
+        self.chunkSize = (schema && schema->type == FHSParameterList && schema->limit > 0)?schema->limit:1;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.maxConcurrentRequests = 2;
+        self.waitsForRateLimit = YES;
+        self.totalCount = _targets.count;
+        self.estimatedTimeRemaining = -1;
+        self.queue = dispatch_queue_create("FHSBulkAction", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_journal) {
+        fclose(_journal);
+    }
+}
+
+- (NSError *)cancelledError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:@{NSLocalizedDescriptionKey: @"The bulk action was cancelled."}];
+}
+
+//
+// Journal: one completed target per line
+//
+
+- (NSSet *)journaledTargets {
+    NSString *contents = _journalPath?[NSString stringWithContentsOfFile:_journalPath encoding:NSUTF8StringEncoding error:nil]:nil;
+    NSMutableArray *lines = [[contents componentsSeparatedByString:@"\n"]mutableCopy];
+
+    // The last line is only complete if it ends in a newline
+    [lines removeLastObject];
+    return [NSSet setWithArray:lines?:@[]];
+}
+
+// Opens the journal for appending, after cutting off a torn last line so it can't run into the next entry
+- (NSError *)openJournal {
+    const char *path = _journalPath.fileSystemRepresentation;
+    NSData *data = [NSData dataWithContentsOfFile:_journalPath];
+    const char *bytes = data.bytes;
+    size_t length = data.length;
+
+    while (length > 0 && bytes[length-1] != '\n') {
+        length--;
+    }
+
+    if (length < data.length && truncate(path, (off_t)length) != 0) {
+        return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+    }
+
+    _journal = fopen(path, "ab");
+    return _journal?nil:[NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+}
+
+- (NSError *)journalTargets:(NSArray *)targets {
+    if (!_journal) {
+        return nil;
+    }
+
+    NSData *data = [[[targets componentsJoinedByString:@"\n"]stringByAppendingString:@"\n"]dataUsingEncoding:NSUTF8StringEncoding];
+
+    if (fwrite(data.bytes, 1, data.length, _journal) != data.length || fflush(_journal) != 0 || fsync(fileno(_journal)) != 0) {
+        return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+    }
+
+    return nil;
+}
+
+//
+// Scheduling
+//
+
+- (void)updateEstimates {
+    NSTimeInterval elapsed = [NSDate timeIntervalSinceReferenceDate]-_startTime;
+    NSUInteger done = self.completedCount+self.failedCount-_skippedCount;
+    double throughput = (elapsed > 0)?done/elapsed:0;
+
+    self.throughput = throughput;
+    self.estimatedTimeRemaining = (throughput > 0)?(self.totalCount-self.completedCount-self.failedCount)/throughput:-1;
+}
+
+- (void)reportProgress {
+    FHSBulkActionProgressBlock block = _progressBlock;
+
+    if (block) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            block(self);
+        });
+    }
+}
+
+- (void)finishWithError:(NSError *)error {
+    FHSBulkActionCompletionBlock block = _completionBlock;
+    NSDictionary *failures = [_failures copy];
+
+    if (_journal) {
+        fclose(_journal);
+        _journal = NULL;
+    }
+
+    self.completionBlock = nil;
+    self.progressBlock = nil;
+    self.pendingChunks = nil;
+    self.failures = nil;
+    self.running = NO;
+    self.generation++;
+
+    if (block) {
+        dispatch_async(dispatch_get_main_queue(), ^{
+            block(error, failures);
+        });
+    }
+}
+
+// Finish once the requests in flight are back, so their results still get journaled
+- (void)stopWithError:(NSError *)error {
+    if (!_cancelled) {
+        self.cancelled = YES;
+        self.stopError = error;
+        self.pendingChunks = nil;
+    }
+    [self scheduleRequests];
+}
+
+- (void)scheduleRequests {
+    if (_cancelled) {
+        if (_running && _requestsInFlight == 0) {
+            [self finishWithError:_stopError];
+        }
+        return;
+    }
+
+    while (_running && !_waitingForInterval && _requestsInFlight+_rateLimitedChunks < MAX(_maxConcurrentRequests, 1) && _pendingChunks.count > 0) {
+        NSTimeInterval now = [NSDate timeIntervalSinceReferenceDate];
+
+        if (now < _nextRequestTime) {
+            NSUInteger generation = _generation;
+            self.waitingForInterval = YES;
+
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)((_nextRequestTime-now)*NSEC_PER_SEC)), _queue, ^{
+                if (!self.running || self.generation != generation) {
+                    return;
+                }
+
+                self.waitingForInterval = NO;
+                [self scheduleRequests];
+            });
+            return;
+        }
+
+        self.nextRequestTime = now+_minimumInterval;
+
+        NSArray *chunk = _pendingChunks.firstObject;
+        [_pendingChunks removeObjectAtIndex:0];
+        [self sendChunk:chunk];
+    }
+
+    if (_running && _requestsInFlight == 0 && _rateLimitedChunks == 0 && _pendingChunks.count == 0) {
+        [self finishWithError:nil];
+    }
+}
+
+- (void)sendChunk:(NSArray *)chunk {
+    NSMutableDictionary *params = [_params mutableCopy];
+    params[_usersKey] = [chunk componentsJoinedByString:@","];
+
+    NSUInteger generation = _generation;
+    FHSTwitterEngine *engine = _engine;
+    FHSEndpoint endpoint = _endpoint;
+    self.requestsInFlight++;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = [engine sendRequestForEndpoint:endpoint parameters:params];
+
+            dispatch_async(self.queue, ^{
+                if (!self.running || self.generation != generation) {
+                    return;
+                }
+
+                [self handleResponse:response forChunk:chunk];
+            });
+        }
+    });
+}
+
+- (void)handleResponse:(id)response forChunk:(NSArray *)chunk {
+    NSError *error = [response isKindOfClass:[NSError class]]?response:nil;
+
+    if (error.code == 429 && [error.domain isEqualToString:FHSErrorDomain] && _waitsForRateLimit && !_cancelled) {
+        // Keep the slot while waiting, nothing else would get through either. A cancel doesn't wait
+        // for it though: the chunk was never done, so it is simply left out of the journal.
+        NSDate *reset = error.userInfo[FHSRateLimitResetDateKey]?:[NSDate dateWithTimeIntervalSinceNow:defaultRateLimitWait];
+        NSTimeInterval delay = MAX(reset.timeIntervalSinceNow, 0)+1.0;
+        NSUInteger generation = _generation;
+        self.requestsInFlight--;
+        self.rateLimitedChunks++;
+
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay*NSEC_PER_SEC)), _queue, ^{
+            if (!self.running || self.generation != generation || self.cancelled) {
+                return;
+            }
+
+            self.rateLimitedChunks--;
+            [self.pendingChunks insertObject:chunk atIndex:0];
+            [self scheduleRequests];
+        });
+        return;
+    }
+
+    self.requestsInFlight--;
+
+    if (!error) {
+        NSError *journalError = [self journalTargets:chunk];
+
+        if (journalError) {
+            [self stopWithError:journalError];
+            return;
+        }
+
+        self.completedCount += chunk.count;
+    } else if (![error.domain isEqualToString:FHSErrorDomain] || error.code == 401) {
+        // Without a connection or credentials every other target would fail the same way
+        [self stopWithError:error];
+        return;
+    } else {
+        for (NSString *target in chunk) {
+            _failures[target] = error;
+        }
+        self.failedCount += chunk.count;
+    }
+
+    [self updateEstimates];
+    [self reportProgress];
+    [self scheduleRequests];
+}
+
+- (void)startWithProgressBlock:(FHSBulkActionProgressBlock)progressBlock completionBlock:(FHSBulkActionCompletionBlock)completionBlock {
+    dispatch_async(_queue, ^{
+        if (self.running) {
+            return;
+        }
+
+        if (self.chunkSize > 1 && [self.params[@"list_id"] length] == 0) {
+            if (completionBlock) {
+                dispatch_async(dispatch_get_main_queue(), ^{
+                    completionBlock([NSError badRequestError], nil);
+                });
+            }
+            return;
+        }
+
+        if (self.journalPath) {
+            NSError *error = [self openJournal];
+
+            if (error) {
+                if (completionBlock) {
+                    dispatch_async(dispatch_get_main_queue(), ^{
+                        completionBlock(error, nil);
+                    });
+                }
+                return;
+            }
+        }
+
+        NSSet *journaled = [self journaledTargets];
+        NSMutableArray *chunks = [NSMutableArray array];
+        NSMutableArray *chunk = nil;
+        NSUInteger remaining = 0;
+
+        for (NSString *target in self.targets) {
+            if ([journaled containsObject:target]) {
+                continue;
+            }
+
+            remaining++;
+
+            if (chunk.count == 0 || chunk.count == self.chunkSize) {
+                chunk = [NSMutableArray arrayWithCapacity:self.chunkSize];
+                [chunks addObject:chunk];
+            }
+
+            [chunk addObject:target];
+        }
+
+        self.running = YES;
+        self.cancelled = NO;
+        self.stopError = nil;
+        self.waitingForInterval = NO;
+        self.progressBlock = progressBlock;
+        self.completionBlock = completionBlock;
+        self.pendingChunks = chunks;
+        self.failures = [NSMutableDictionary dictionary];
+        self.requestsInFlight = 0;
+        self.rateLimitedChunks = 0;
+        self.nextRequestTime = 0;
+        self.startTime = [NSDate timeIntervalSinceReferenceDate];
+        self.skippedCount = self.totalCount-remaining;
+        self.completedCount = self.skippedCount;
+        self.failedCount = 0;
+        self.throughput = 0;
+        self.estimatedTimeRemaining = -1;
+
+        [self scheduleRequests];
+    });
+}
+
+- (void)cancel {
+    dispatch_async(_queue, ^{
+        if (!self.running) {
+            return;
+        }
+
+        [self stopWithError:[self cancelledError]];
+    });
+}
+
+@end
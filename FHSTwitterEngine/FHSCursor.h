@@ -0,0 +1,113 @@
+//
+//  FHSCursor.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+#import "FHSIDList.h"
+
+/**
+ Iterator over a cursored listing, such as followers or friends.
+ The next page is requested as soon as a page is handed out, so it downloads
+ while the caller works through the current one. Rate limited requests are
+ retried once the limit resets.
+ Enumerating with for...in walks every item of every page; check error afterwards.
+ A cursor must only be used from one thread at a time.
+ */
+@interface FHSCursor : NSObject <NSFastEnumeration>
+
+/**
+ Followers of a user, as user objects, 200 per page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A cursor instance.
+ */
++ (FHSCursor *)followersForUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Users a user is following, as user objects, 200 per page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A cursor instance.
+ */
++ (FHSCursor *)friendsForUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Follower ids of a user, as strings, 5000 per page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A cursor instance.
+ */
++ (FHSCursor *)followerIDsForUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Ids of the users a user is following, as strings, 5000 per page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @return A cursor instance.
+ */
++ (FHSCursor *)friendIDsForUser:(NSString *)user isID:(BOOL)isID;
+
+/**
+ Ids of the users the authenticated user has blocked, as strings, 5000 per page.
+ @return A cursor instance.
+ */
++ (FHSCursor *)blockedIDs;
+
+/**
+ Cursor over any endpoint that pages with cursor and next_cursor_str.
+ @param url Endpoint URL.
+ @param params Parameters, without cursor.
+ @param itemsKey Key of the items in each page, e.g. "users" or "ids". Pages of "ids" are decoded straight into packed integers.
+ @return A cursor instance.
+ */
++ (FHSCursor *)cursorWithURL:(NSURL *)url parameters:(NSDictionary *)params itemsKey:(NSString *)itemsKey;
+
+/**
+ Engine used to send requests. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Cursor of the next page nextPage will return: "-1" for the first page, "0" once finished.
+ Save it after processing a page to checkpoint a crawl, and set it on a new cursor to resume.
+ Setting it discards any prefetched page.
+ */
+@property (copy) NSString *cursor;
+
+/**
+ Whether to wait for the rate limit to reset and retry, rather than fail. Defaults to YES.
+ */
+@property (assign) BOOL waitsForRateLimit;
+
+/**
+ Error that stopped the iteration, or nil.
+ */
+@property (strong, readonly) NSError *error;
+
+/**
+ Whether the last page has been returned.
+ */
+@property (readonly, getter=isFinished) BOOL finished;
+
+/**
+ Next page, waiting for it if it hasn't been prefetched yet.
+ @return Items of the page, or nil once finished, cancelled or on error.
+ */
+- (NSArray *)nextPage;
+
+/**
+ Next page of an id cursor as packed integers, skipping the strings nextPage makes.
+ @return Ids of the page, or nil once finished, cancelled, on error, or if the cursor isn't over "ids".
+ */
+- (FHSIDList *)nextIDList;
+
+/**
+ Stop prefetching and stop waiting for a rate limit. nextPage returns nil afterwards.
+ */
+- (void)cancel;
+
+@end
@@ -0,0 +1,265 @@
+//
+//  FHSCursor.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSCursor.h"
+#import "FHSIDList.h"
+
+// Used when a 429 comes without a reset time
+static NSTimeInterval const defaultRateLimitWait = 60.0;
+
+@interface FHSCursor () {
+    NSString *_cursor;
+    NSError *_error;
+    BOOL _finished;
+}
+
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic, strong) NSDictionary *params;
+@property (nonatomic, strong) NSString *itemsKey;
+@property (nonatomic, assign) BOOL decodesIDs; // pages come back as FHSIDList
+
+// Everything below is guarded by the condition
+@property (nonatomic, strong) NSCondition *condition;
+@property (nonatomic, strong) id result; // prefetched page or error
+@property (nonatomic, assign) BOOL fetching;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, assign) NSUInteger generation; // ignores pages fetched for a replaced cursor
+
+// Only touched by the enumerating thread
+@property (nonatomic, strong) NSArray *enumeratedPage;
+
+@end
+
+@implementation FHSCursor
+
++ (FHSCursor *)followersForUser:(NSString *)user isID:(BOOL)isID {
+    return [self cursorWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointFollowersList)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"", @"count":@"200", @"skip_status":@"true" } itemsKey:@"users"];
+}
+
++ (FHSCursor *)friendsForUser:(NSString *)user isID:(BOOL)isID {
+    return [self cursorWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointFriendsList)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"", @"count":@"200", @"skip_status":@"true" } itemsKey:@"users"];
+}
+
++ (FHSCursor *)followerIDsForUser:(NSString *)user isID:(BOOL)isID {
+    return [self cursorWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointFollowersIDs)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"", @"count":@"5000", @"stringify_ids":@"true" } itemsKey:@"ids"];
+}
+
++ (FHSCursor *)friendIDsForUser:(NSString *)user isID:(BOOL)isID {
+    return [self cursorWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointFriendsIDs)->url)] parameters:@{ (isID?@"user_id":@"screen_name"):user?:@"", @"count":@"5000", @"stringify_ids":@"true" } itemsKey:@"ids"];
+}
+
++ (FHSCursor *)blockedIDs {
+    return [self cursorWithURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointBlocksIDs)->url)] parameters:@{ @"stringify_ids":@"true" } itemsKey:@"ids"];
+}
+
++ (FHSCursor *)cursorWithURL:(NSURL *)url parameters:(NSDictionary *)params itemsKey:(NSString *)itemsKey {
+    return [[[self class]alloc]initWithURL:url parameters:params itemsKey:itemsKey];
+}
+
+- (instancetype)initWithURL:(NSURL *)url parameters:(NSDictionary *)params itemsKey:(NSString *)itemsKey {
+    self = [super init];
+    if (self) {
+        self.url = url;
+        self.params = params?:@{};
+        self.itemsKey = itemsKey;
+        self.decodesIDs = [itemsKey isEqualToString:@"ids"];
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.waitsForRateLimit = YES;
+        self.condition = [[NSCondition alloc]init];
+        _cursor = @"-1";
+    }
+    return self;
+}
+
+- (NSString *)cursor {
+    [_condition lock];
+    NSString *cursor = _cursor;
+    [_condition unlock];
+    return cursor;
+}
+
+- (void)setCursor:(NSString *)cursor {
+    [_condition lock];
+    _cursor = cursor.length > 0?[cursor copy]:@"-1";
+    _finished = [_cursor isEqualToString:@"0"];
+    _error = nil;
+    _result = nil;
+    _fetching = NO;
+    _generation++;
+    [_condition unlock];
+}
+
+- (NSError *)error {
+    [_condition lock];
+    NSError *error = _error;
+    [_condition unlock];
+    return error;
+}
+
+- (BOOL)isFinished {
+    [_condition lock];
+    BOOL finished = _finished;
+    [_condition unlock];
+    return finished;
+}
+
+- (BOOL)isRateLimitError:(id)response {
+    return [response isKindOfClass:[NSError class]] && [[response domain]isEqualToString:FHSErrorDomain] && [response code] == 429;
+}
+
+// Call with the condition locked
+- (void)fetchNextPage {
+    NSMutableDictionary *params = [_params mutableCopy];
+    params[@"cursor"] = _cursor;
+
+    NSUInteger generation = _generation;
+    FHSTwitterEngine *engine = _engine;
+    self.fetching = YES;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = nil;
+
+            while (YES) {
+                response = _decodesIDs?[engine getIDListForURL:_url parameters:params]:[engine sendRequestForURL:_url HTTPMethod:@"GET" parameters:params];
+
+                if (![self isRateLimitError:response] || !self.waitsForRateLimit) {
+                    break;
+                }
+
+                // A second of slack for clock skew with the API servers
+                NSDate *reset = [response userInfo][FHSRateLimitResetDateKey]?:[NSDate dateWithTimeIntervalSinceNow:defaultRateLimitWait];
+                reset = [reset dateByAddingTimeInterval:1.0];
+
+                [_condition lock];
+
+                while (!_cancelled && _generation == generation && reset.timeIntervalSinceNow > 0) {
+                    [_condition waitUntilDate:reset];
+                }
+
+                BOOL stale = (_cancelled || _generation != generation);
+                [_condition unlock];
+
+                if (stale) {
+                    return;
+                }
+            }
+
+            [_condition lock];
+
+            if (!_cancelled && _generation == generation) {
+                self.result = response?:[NSError noDataError];
+                self.fetching = NO;
+                [_condition broadcast];
+            }
+
+            [_condition unlock];
+        }
+    });
+}
+
+// Next page as the response holds it, an FHSIDList or an array
+- (id)nextResult {
+    [_condition lock];
+
+    if (_cancelled || _error || _finished) {
+        [_condition unlock];
+        return nil;
+    }
+
+    if (!_result && !_fetching) {
+        [self fetchNextPage];
+    }
+
+    while (!_result && !_cancelled) {
+        [_condition wait];
+    }
+
+    id result = _result;
+    id items = nil;
+    NSString *next = nil;
+    self.result = nil;
+
+    if (_cancelled) {
+        // Nothing to hand out
+    } else if ([result isKindOfClass:[NSError class]]) {
+        _error = result;
+    } else {
+        if ([result isKindOfClass:[FHSIDList class]]) {
+            next = @([result nextCursor]).stringValue;
+            items = result;
+        } else if ([result isKindOfClass:[NSDictionary class]]) {
+            next = result[@"next_cursor_str"];
+            items = result[_itemsKey];
+        }
+
+        if (![next isKindOfClass:[NSString class]] || !([items isKindOfClass:[NSArray class]] || [items isKindOfClass:[FHSIDList class]])) {
+            _error = [NSError noDataError];
+            items = nil;
+        } else {
+            _cursor = next;
+            _finished = (next.length == 0 || [next isEqualToString:@"0"]);
+
+            // Prefetch while the caller works through this page
+            if (!_finished) {
+                [self fetchNextPage];
+            }
+        }
+    }
+
+    [_condition unlock];
+    return items;
+}
+
+- (NSArray *)nextPage {
+    id items = [self nextResult];
+    return [items isKindOfClass:[FHSIDList class]]?[items strings]:items;
+}
+
+- (FHSIDList *)nextIDList {
+    if (!_decodesIDs) {
+        return nil;
+    }
+    return [self nextResult];
+}
+
+- (void)cancel {
+    [_condition lock];
+    self.cancelled = YES;
+    self.result = nil;
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+- (NSUInteger)countByEnumeratingWithState:(NSFastEnumerationState *)state objects:(id __unsafe_unretained [])buffer count:(NSUInteger)len {
+    if (state->state == 0) {
+        state->state = 1;
+        state->mutationsPtr = &state->extra[0];
+        state->extra[1] = 0;
+        self.enumeratedPage = nil;
+    }
+
+    NSUInteger index = state->extra[1];
+
+    while (!_enumeratedPage || index >= _enumeratedPage.count) {
+        self.enumeratedPage = [self nextPage];
+        index = 0;
+
+        if (!_enumeratedPage) {
+            return 0;
+        }
+    }
+
+    NSUInteger count = MIN(len, _enumeratedPage.count-index);
+    [_enumeratedPage getObjects:buffer range:NSMakeRange(index, count)];
+
+    state->itemsPtr = buffer;
+    state->extra[1] = index+count;
+    return count;
+}
+
+@end
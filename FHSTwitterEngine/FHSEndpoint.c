@@ -0,0 +1,419 @@
+//
+//  FHSEndpoint.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSEndpoint.h"
+#include "FHSNonce.h"
+
+#include <string.h>
+#include <time.h>
+
+#define FHS_API "https://api.twitter.com/1.1/"
+#define FHS_API_ENCODED "https%3A%2F%2Fapi.twitter.com%2F1.1%2F"
+#define FHS_UPLOAD "https://upload.twitter.com/1.1/"
+#define FHS_UPLOAD_ENCODED "https%3A%2F%2Fupload.twitter.com%2F1.1%2F"
+
+// Paths are given twice, as is and with '/' encoded, so both strings are literals
+#define FHS_ENDPOINT(method, host, path, encodedPath, family, params) \
+    { path, family, #method, host path ".json", #method "&" host##_ENCODED encodedPath ".json&", \
+      sizeof(host path ".json")-1, sizeof(#method "&" host##_ENCODED encodedPath ".json&")-1, -1, params }
+
+// The id goes after the path, then ".json". Its parameter comes first in the schema.
+#define FHS_PATH_ENDPOINT(method, host, path, encodedPath, family, params) \
+    { path "/:id", family, #method, host path "/", #method "&" host##_ENCODED encodedPath "%2F", \
+      sizeof(host path "/")-1, sizeof(#method "&" host##_ENCODED encodedPath "%2F")-1, 0, params }
+
+#define FHS_PARAMS(params) sizeof(params)/sizeof(params[0]), params
+#define FHS_NO_PARAMS 0, NULL
+
+#define FHS_STRING(key, flags, limit) { key, FHSParameterString, flags, limit, NULL }
+#define FHS_ID(key, flags) { key, FHSParameterID, flags, 0, NULL }
+#define FHS_INTEGER(key, flags, limit) { key, FHSParameterInteger, flags, limit, #limit }
+#define FHS_BOOL(key) { key, FHSParameterBool, 0, 0, NULL }
+#define FHS_LIST(key, flags, limit) { key, FHSParameterList, flags, limit, NULL }
+#define FHS_DATA(key, flags) { key, FHSParameterData, flags, 0, NULL }
+#define FHS_BASE64(key, flags) { key, FHSParameterBase64, flags, 0, NULL }
+
+#define FHS_COUNT(max) FHS_INTEGER("count", FHSParameterTruncate, max)
+#define FHS_CURSOR FHS_INTEGER("cursor", 0, 0)
+#define FHS_WINDOW FHS_ID("since_id", 0), FHS_ID("max_id", 0)
+#define FHS_USER FHS_ID("user_id", FHSParameterOneOf), FHS_STRING("screen_name", FHSParameterOneOf, 0)
+#define FHS_OPTIONAL_USER FHS_ID("user_id", 0), FHS_STRING("screen_name", 0, 0)
+#define FHS_USERS(max) FHS_LIST("user_id", FHSParameterOneOf, max), FHS_LIST("screen_name", FHSParameterOneOf, max)
+#define FHS_ENTITIES FHS_BOOL("include_entities")
+#define FHS_SKIP_STATUS FHS_BOOL("skip_status")
+
+//
+// Parameter schemas
+//
+
+static const fhs_endpoint_param fhs_home_timeline_params[] = { FHS_COUNT(200), FHS_WINDOW, FHS_BOOL("trim_user"), FHS_BOOL("exclude_replies"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_user_timeline_params[] = { FHS_USER, FHS_COUNT(200), FHS_WINDOW, FHS_BOOL("trim_user"), FHS_BOOL("exclude_replies"), FHS_BOOL("include_rts") };
+static const fhs_endpoint_param fhs_mentions_timeline_params[] = { FHS_COUNT(200), FHS_WINDOW, FHS_BOOL("trim_user"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_retweets_of_me_params[] = { FHS_COUNT(100), FHS_WINDOW, FHS_BOOL("trim_user"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_retweets_params[] = { FHS_ID("id", FHSParameterRequired | FHSParameterInPath), FHS_COUNT(100), FHS_BOOL("trim_user") };
+static const fhs_endpoint_param fhs_show_params[] = { FHS_ID("id", FHSParameterRequired), FHS_BOOL("include_my_retweet"), FHS_BOOL("trim_user"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_update_params[] = { FHS_STRING("status", FHSParameterRequired, 0), FHS_ID("in_reply_to_status_id", 0), FHS_LIST("media_ids", 0, 4), FHS_BOOL("possibly_sensitive") };
+static const fhs_endpoint_param fhs_update_with_media_params[] = { FHS_STRING("status", FHSParameterRequired, 0), FHS_DATA("media[]", FHSParameterRequired), FHS_ID("in_reply_to_status_id", 0), FHS_BOOL("possibly_sensitive") };
+static const fhs_endpoint_param fhs_tweet_id_params[] = { FHS_ID("id", FHSParameterRequired), FHS_BOOL("trim_user"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_retweet_params[] = { FHS_ID("id", FHSParameterRequired | FHSParameterInPath), FHS_BOOL("trim_user") };
+static const fhs_endpoint_param fhs_media_upload_params[] = { FHS_STRING("command", 0, 0), FHS_ID("media_id", 0), FHS_DATA("media", 0), FHS_STRING("media_data", 0, 0), FHS_STRING("media_type", 0, 0), FHS_STRING("media_category", 0, 0), FHS_INTEGER("total_bytes", 0, 0), FHS_INTEGER("segment_index", 0, 999) };
+static const fhs_endpoint_param fhs_media_upload_status_params[] = { FHS_STRING("command", FHSParameterRequired, 0), FHS_ID("media_id", FHSParameterRequired) };
+static const fhs_endpoint_param fhs_search_tweets_params[] = { FHS_STRING("q", FHSParameterRequired | FHSParameterTruncate, 1000), FHS_COUNT(100), FHS_WINDOW, FHS_STRING("result_type", 0, 0), FHS_STRING("until", 0, 0), FHS_STRING("geocode", 0, 0), FHS_STRING("lang", 0, 0), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_users_show_params[] = { FHS_USER, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_users_lookup_params[] = { FHS_USERS(100), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_users_search_params[] = { FHS_STRING("q", FHSParameterRequired | FHSParameterTruncate, 1000), FHS_COUNT(20), FHS_INTEGER("page", 0, 0), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_user_params[] = { FHS_USER };
+static const fhs_endpoint_param fhs_id_list_params[] = { FHS_OPTIONAL_USER, FHS_CURSOR, FHS_COUNT(5000), FHS_BOOL("stringify_ids") };
+static const fhs_endpoint_param fhs_user_list_params[] = { FHS_USER, FHS_CURSOR, FHS_COUNT(200), FHS_SKIP_STATUS, FHS_BOOL("include_user_entities"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_follow_params[] = { FHS_USER, FHS_BOOL("follow") };
+static const fhs_endpoint_param fhs_friendships_update_params[] = { FHS_USER, FHS_BOOL("retweets"), FHS_BOOL("device") };
+static const fhs_endpoint_param fhs_friendships_lookup_params[] = { FHS_USERS(100) };
+static const fhs_endpoint_param fhs_pending_params[] = { FHS_CURSOR, FHS_BOOL("stringify_ids") };
+static const fhs_endpoint_param fhs_stringify_params[] = { FHS_BOOL("stringify_ids") };
+static const fhs_endpoint_param fhs_block_params[] = { FHS_USER, FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_blocks_list_params[] = { FHS_CURSOR, FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_blocks_ids_params[] = { FHS_CURSOR, FHS_BOOL("stringify_ids") };
+static const fhs_endpoint_param fhs_lists_list_params[] = { FHS_USER, FHS_BOOL("reverse") };
+static const fhs_endpoint_param fhs_list_id_params[] = { FHS_ID("list_id", FHSParameterRequired) };
+static const fhs_endpoint_param fhs_lists_create_params[] = { FHS_STRING("name", FHSParameterRequired, 25), FHS_STRING("mode", 0, 0), FHS_STRING("description", 0, 100) };
+static const fhs_endpoint_param fhs_lists_update_params[] = { FHS_ID("list_id", FHSParameterRequired), FHS_STRING("name", 0, 25), FHS_STRING("mode", 0, 0), FHS_STRING("description", 0, 100) };
+static const fhs_endpoint_param fhs_lists_statuses_params[] = { FHS_ID("list_id", FHSParameterRequired), FHS_COUNT(200), FHS_WINDOW, FHS_BOOL("include_rts"), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_lists_members_params[] = { FHS_ID("list_id", FHSParameterRequired), FHS_CURSOR, FHS_COUNT(5000), FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_lists_members_all_params[] = { FHS_ID("list_id", FHSParameterRequired), FHS_USERS(100) };
+static const fhs_endpoint_param fhs_direct_messages_params[] = { FHS_COUNT(200), FHS_WINDOW, FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_direct_messages_sent_params[] = { FHS_COUNT(200), FHS_WINDOW, FHS_INTEGER("page", 0, 0), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_direct_messages_new_params[] = { FHS_USER, FHS_STRING("text", FHSParameterRequired | FHSParameterTruncate, 140) };
+static const fhs_endpoint_param fhs_id_params[] = { FHS_ID("id", FHSParameterRequired), FHS_ENTITIES };
+static const fhs_endpoint_param fhs_favorites_list_params[] = { FHS_USER, FHS_COUNT(200), FHS_WINDOW, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_verify_credentials_params[] = { FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_account_settings_params[] = { FHS_BOOL("sleep_time_enabled"), FHS_INTEGER("start_sleep_time", 0, 23), FHS_INTEGER("end_sleep_time", 0, 23), FHS_STRING("time_zone", 0, 0), FHS_STRING("lang", 0, 0) };
+static const fhs_endpoint_param fhs_update_profile_params[] = { FHS_STRING("name", 0, 20), FHS_STRING("url", 0, 100), FHS_STRING("location", 0, 30), FHS_STRING("description", 0, 160), FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_update_profile_colors_params[] = { FHS_STRING("profile_background_color", 0, 7), FHS_STRING("profile_link_color", 0, 7), FHS_STRING("profile_sidebar_border_color", 0, 7), FHS_STRING("profile_sidebar_fill_color", 0, 7), FHS_STRING("profile_text_color", 0, 7), FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_update_profile_image_params[] = { FHS_BASE64("image", FHSParameterRequired), FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_update_profile_background_image_params[] = { FHS_BASE64("image", 0), FHS_BOOL("tile"), FHS_BOOL("tiled"), FHS_BOOL("use"), FHS_SKIP_STATUS, FHS_ENTITIES };
+static const fhs_endpoint_param fhs_rate_limit_status_params[] = { FHS_LIST("resources", 0, 0) };
+
+//
+// Endpoints
+//
+
+static const fhs_endpoint fhs_endpoints[FHSEndpointCount] = {
+    [FHSEndpointStatusesHomeTimeline] = FHS_ENDPOINT(GET, FHS_API, "statuses/home_timeline", "statuses%2Fhome_timeline", "statuses", FHS_PARAMS(fhs_home_timeline_params)),
+    [FHSEndpointStatusesUserTimeline] = FHS_ENDPOINT(GET, FHS_API, "statuses/user_timeline", "statuses%2Fuser_timeline", "statuses", FHS_PARAMS(fhs_user_timeline_params)),
+    [FHSEndpointStatusesMentionsTimeline] = FHS_ENDPOINT(GET, FHS_API, "statuses/mentions_timeline", "statuses%2Fmentions_timeline", "statuses", FHS_PARAMS(fhs_mentions_timeline_params)),
+    [FHSEndpointStatusesRetweetsOfMe] = FHS_ENDPOINT(GET, FHS_API, "statuses/retweets_of_me", "statuses%2Fretweets_of_me", "statuses", FHS_PARAMS(fhs_retweets_of_me_params)),
+    [FHSEndpointStatusesRetweets] = FHS_PATH_ENDPOINT(GET, FHS_API, "statuses/retweets", "statuses%2Fretweets", "statuses", FHS_PARAMS(fhs_retweets_params)),
+    [FHSEndpointStatusesShow] = FHS_ENDPOINT(GET, FHS_API, "statuses/show", "statuses%2Fshow", "statuses", FHS_PARAMS(fhs_show_params)),
+    [FHSEndpointStatusesUpdate] = FHS_ENDPOINT(POST, FHS_API, "statuses/update", "statuses%2Fupdate", "statuses", FHS_PARAMS(fhs_update_params)),
+    [FHSEndpointStatusesUpdateWithMedia] = FHS_ENDPOINT(POST, FHS_API, "statuses/update_with_media", "statuses%2Fupdate_with_media", "statuses", FHS_PARAMS(fhs_update_with_media_params)),
+    [FHSEndpointStatusesDestroy] = FHS_ENDPOINT(POST, FHS_API, "statuses/destroy", "statuses%2Fdestroy", "statuses", FHS_PARAMS(fhs_tweet_id_params)),
+    [FHSEndpointStatusesRetweet] = FHS_PATH_ENDPOINT(POST, FHS_API, "statuses/retweet", "statuses%2Fretweet", "statuses", FHS_PARAMS(fhs_retweet_params)),
+    [FHSEndpointMediaUpload] = FHS_ENDPOINT(POST, FHS_UPLOAD, "media/upload", "media%2Fupload", "media", FHS_PARAMS(fhs_media_upload_params)),
+    [FHSEndpointMediaUploadStatus] = FHS_ENDPOINT(GET, FHS_UPLOAD, "media/upload", "media%2Fupload", "media", FHS_PARAMS(fhs_media_upload_status_params)),
+    [FHSEndpointSearchTweets] = FHS_ENDPOINT(GET, FHS_API, "search/tweets", "search%2Ftweets", "search", FHS_PARAMS(fhs_search_tweets_params)),
+    [FHSEndpointUsersShow] = FHS_ENDPOINT(GET, FHS_API, "users/show", "users%2Fshow", "users", FHS_PARAMS(fhs_users_show_params)),
+    [FHSEndpointUsersLookup] = FHS_ENDPOINT(GET, FHS_API, "users/lookup", "users%2Flookup", "users", FHS_PARAMS(fhs_users_lookup_params)),
+    [FHSEndpointUsersSearch] = FHS_ENDPOINT(GET, FHS_API, "users/search", "users%2Fsearch", "users", FHS_PARAMS(fhs_users_search_params)),
+    [FHSEndpointUsersReportSpam] = FHS_ENDPOINT(POST, FHS_API, "users/report_spam", "users%2Freport_spam", "users", FHS_PARAMS(fhs_user_params)),
+    [FHSEndpointFollowersIDs] = FHS_ENDPOINT(GET, FHS_API, "followers/ids", "followers%2Fids", "followers", FHS_PARAMS(fhs_id_list_params)),
+    [FHSEndpointFollowersList] = FHS_ENDPOINT(GET, FHS_API, "followers/list", "followers%2Flist", "followers", FHS_PARAMS(fhs_user_list_params)),
+    [FHSEndpointFriendsIDs] = FHS_ENDPOINT(GET, FHS_API, "friends/ids", "friends%2Fids", "friends", FHS_PARAMS(fhs_id_list_params)),
+    [FHSEndpointFriendsList] = FHS_ENDPOINT(GET, FHS_API, "friends/list", "friends%2Flist", "friends", FHS_PARAMS(fhs_user_list_params)),
+    [FHSEndpointFriendshipsCreate] = FHS_ENDPOINT(POST, FHS_API, "friendships/create", "friendships%2Fcreate", "friendships", FHS_PARAMS(fhs_follow_params)),
+    [FHSEndpointFriendshipsDestroy] = FHS_ENDPOINT(POST, FHS_API, "friendships/destroy", "friendships%2Fdestroy", "friendships", FHS_PARAMS(fhs_user_params)),
+    [FHSEndpointFriendshipsUpdate] = FHS_ENDPOINT(POST, FHS_API, "friendships/update", "friendships%2Fupdate", "friendships", FHS_PARAMS(fhs_friendships_update_params)),
+    [FHSEndpointFriendshipsLookup] = FHS_ENDPOINT(GET, FHS_API, "friendships/lookup", "friendships%2Flookup", "friendships", FHS_PARAMS(fhs_friendships_lookup_params)),
+    [FHSEndpointFriendshipsIncoming] = FHS_ENDPOINT(GET, FHS_API, "friendships/incoming", "friendships%2Fincoming", "friendships", FHS_PARAMS(fhs_pending_params)),
+    [FHSEndpointFriendshipsOutgoing] = FHS_ENDPOINT(GET, FHS_API, "friendships/outgoing", "friendships%2Foutgoing", "friendships", FHS_PARAMS(fhs_pending_params)),
+    [FHSEndpointFriendshipsNoRetweetsIDs] = FHS_ENDPOINT(GET, FHS_API, "friendships/no_retweets/ids", "friendships%2Fno_retweets%2Fids", "friendships", FHS_PARAMS(fhs_stringify_params)),
+    [FHSEndpointBlocksExists] = FHS_ENDPOINT(GET, FHS_API, "blocks/exists", "blocks%2Fexists", "blocks", FHS_PARAMS(fhs_block_params)),
+    [FHSEndpointBlocksList] = FHS_ENDPOINT(GET, FHS_API, "blocks/list", "blocks%2Flist", "blocks", FHS_PARAMS(fhs_blocks_list_params)),
+    [FHSEndpointBlocksIDs] = FHS_ENDPOINT(GET, FHS_API, "blocks/ids", "blocks%2Fids", "blocks", FHS_PARAMS(fhs_blocks_ids_params)),
+    [FHSEndpointBlocksCreate] = FHS_ENDPOINT(POST, FHS_API, "blocks/create", "blocks%2Fcreate", "blocks", FHS_PARAMS(fhs_block_params)),
+    [FHSEndpointBlocksDestroy] = FHS_ENDPOINT(POST, FHS_API, "blocks/destroy", "blocks%2Fdestroy", "blocks", FHS_PARAMS(fhs_block_params)),
+    [FHSEndpointListsList] = FHS_ENDPOINT(GET, FHS_API, "lists/list", "lists%2Flist", "lists", FHS_PARAMS(fhs_lists_list_params)),
+    [FHSEndpointListsShow] = FHS_ENDPOINT(GET, FHS_API, "lists/show", "lists%2Fshow", "lists", FHS_PARAMS(fhs_list_id_params)),
+    [FHSEndpointListsCreate] = FHS_ENDPOINT(POST, FHS_API, "lists/create", "lists%2Fcreate", "lists", FHS_PARAMS(fhs_lists_create_params)),
+    [FHSEndpointListsUpdate] = FHS_ENDPOINT(POST, FHS_API, "lists/update", "lists%2Fupdate", "lists", FHS_PARAMS(fhs_lists_update_params)),
+    [FHSEndpointListsStatuses] = FHS_ENDPOINT(GET, FHS_API, "lists/statuses", "lists%2Fstatuses", "lists", FHS_PARAMS(fhs_lists_statuses_params)),
+    [FHSEndpointListsMembers] = FHS_ENDPOINT(GET, FHS_API, "lists/members", "lists%2Fmembers", "lists", FHS_PARAMS(fhs_lists_members_params)),
+    [FHSEndpointListsMembersCreateAll] = FHS_ENDPOINT(POST, FHS_API, "lists/members/create_all", "lists%2Fmembers%2Fcreate_all", "lists", FHS_PARAMS(fhs_lists_members_all_params)),
+    [FHSEndpointListsMembersDestroyAll] = FHS_ENDPOINT(POST, FHS_API, "lists/members/destroy_all", "lists%2Fmembers%2Fdestroy_all", "lists", FHS_PARAMS(fhs_lists_members_all_params)),
+    [FHSEndpointDirectMessages] = FHS_ENDPOINT(GET, FHS_API, "direct_messages", "direct_messages", "direct_messages", FHS_PARAMS(fhs_direct_messages_params)),
+    [FHSEndpointDirectMessagesSent] = FHS_ENDPOINT(GET, FHS_API, "direct_messages/sent", "direct_messages%2Fsent", "direct_messages", FHS_PARAMS(fhs_direct_messages_sent_params)),
+    [FHSEndpointDirectMessagesShow] = FHS_ENDPOINT(GET, FHS_API, "direct_messages/show", "direct_messages%2Fshow", "direct_messages", FHS_PARAMS(fhs_id_params)),
+    [FHSEndpointDirectMessagesNew] = FHS_ENDPOINT(POST, FHS_API, "direct_messages/new", "direct_messages%2Fnew", "direct_messages", FHS_PARAMS(fhs_direct_messages_new_params)),
+    [FHSEndpointDirectMessagesDestroy] = FHS_ENDPOINT(POST, FHS_API, "direct_messages/destroy", "direct_messages%2Fdestroy", "direct_messages", FHS_PARAMS(fhs_id_params)),
+    [FHSEndpointFavoritesList] = FHS_ENDPOINT(GET, FHS_API, "favorites/list", "favorites%2Flist", "favorites", FHS_PARAMS(fhs_favorites_list_params)),
+    [FHSEndpointFavoritesCreate] = FHS_ENDPOINT(POST, FHS_API, "favorites/create", "favorites%2Fcreate", "favorites", FHS_PARAMS(fhs_id_params)),
+    [FHSEndpointFavoritesDestroy] = FHS_ENDPOINT(POST, FHS_API, "favorites/destroy", "favorites%2Fdestroy", "favorites", FHS_PARAMS(fhs_id_params)),
+    [FHSEndpointAccountVerifyCredentials] = FHS_ENDPOINT(GET, FHS_API, "account/verify_credentials", "account%2Fverify_credentials", "account", FHS_PARAMS(fhs_verify_credentials_params)),
+    [FHSEndpointAccountSettings] = FHS_ENDPOINT(GET, FHS_API, "account/settings", "account%2Fsettings", "account", FHS_NO_PARAMS),
+    [FHSEndpointAccountUpdateSettings] = FHS_ENDPOINT(POST, FHS_API, "account/settings", "account%2Fsettings", "account", FHS_PARAMS(fhs_account_settings_params)),
+    [FHSEndpointAccountUpdateProfile] = FHS_ENDPOINT(POST, FHS_API, "account/update_profile", "account%2Fupdate_profile", "account", FHS_PARAMS(fhs_update_profile_params)),
+    [FHSEndpointAccountUpdateProfileColors] = FHS_ENDPOINT(POST, FHS_API, "account/update_profile_colors", "account%2Fupdate_profile_colors", "account", FHS_PARAMS(fhs_update_profile_colors_params)),
+    [FHSEndpointAccountUpdateProfileImage] = FHS_ENDPOINT(POST, FHS_API, "account/update_profile_image", "account%2Fupdate_profile_image", "account", FHS_PARAMS(fhs_update_profile_image_params)),
+    [FHSEndpointAccountUpdateProfileBackgroundImage] = FHS_ENDPOINT(POST, FHS_API, "account/update_profile_background_image", "account%2Fupdate_profile_background_image", "account", FHS_PARAMS(fhs_update_profile_background_image_params)),
+    [FHSEndpointHelpConfiguration] = FHS_ENDPOINT(GET, FHS_API, "help/configuration", "help%2Fconfiguration", "help", FHS_NO_PARAMS),
+    [FHSEndpointHelpLanguages] = FHS_ENDPOINT(GET, FHS_API, "help/languages", "help%2Flanguages", "help", FHS_NO_PARAMS),
+    [FHSEndpointHelpPrivacy] = FHS_ENDPOINT(GET, FHS_API, "help/privacy", "help%2Fprivacy", "help", FHS_NO_PARAMS),
+    [FHSEndpointHelpTOS] = FHS_ENDPOINT(GET, FHS_API, "help/tos", "help%2Ftos", "help", FHS_NO_PARAMS),
+    [FHSEndpointHelpTest] = FHS_ENDPOINT(GET, FHS_API, "help/test", "help%2Ftest", "help", FHS_NO_PARAMS),
+    [FHSEndpointApplicationRateLimitStatus] = FHS_ENDPOINT(GET, FHS_API, "application/rate_limit_status", "application%2Frate_limit_status", "application", FHS_PARAMS(fhs_rate_limit_status_params))
+};
+
+const fhs_endpoint *fhs_endpoint_get(FHSEndpoint endpoint) {
+    return ((unsigned)endpoint < FHSEndpointCount)?&fhs_endpoints[endpoint]:NULL;
+}
+
+const fhs_endpoint_param *fhs_endpoint_param_named(const fhs_endpoint *endpoint, const char *key, size_t length) {
+    for (size_t i = 0; i < endpoint->paramCount; i++) {
+        const char *name = endpoint->params[i].key;
+
+        if (strncmp(name, key, length) == 0 && name[length] == '\0') {
+            return &endpoint->params[i];
+        }
+    }
+    return NULL;
+}
+
+//
+// Checking
+//
+
+static int fhs_all_digits(const char *value, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (value[i] < '0' || value[i] > '9') {
+            return 0;
+        }
+    }
+    return length > 0;
+}
+
+// Byte length of the first limit characters
+static size_t fhs_utf8_prefix_length(const char *value, size_t length, size_t limit) {
+    size_t characters = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        if (((uint8_t)value[i] & 0xC0) != 0x80 && characters++ == limit) {
+            return i;
+        }
+    }
+    return length;
+}
+
+static int fhs_check_value(const fhs_endpoint_param *schema, fhs_request_param *param) {
+    const char *value = param->value;
+    size_t length = param->valueLength;
+
+    if (schema->type == FHSParameterData || schema->type == FHSParameterBase64) {
+        return 0;
+    }
+
+    if (!value) {
+        return -1;
+    }
+
+    // Empty values are sent as they are, e.g. to clear a list description
+    if (length == 0) {
+        return 0;
+    }
+
+    switch (schema->type) {
+        case FHSParameterString: {
+            size_t prefix = schema->limit?fhs_utf8_prefix_length(value, length, schema->limit):length;
+
+            if (prefix < length) {
+                if (!(schema->flags & FHSParameterTruncate)) {
+                    return -1;
+                }
+                param->valueLength = prefix;
+            }
+            return 0;
+        }
+        case FHSParameterID:
+            return (length <= 20 && fhs_all_digits(value, length))?0:-1;
+        case FHSParameterInteger: {
+            int negative = (value[0] == '-');
+
+            if (length-negative > 19 || !fhs_all_digits(value+negative, length-negative)) {
+                return -1;
+            }
+
+            uint64_t number = 0;
+
+            for (size_t i = negative; i < length; i++) {
+                number = number*10+(value[i]-'0');
+            }
+
+            if (schema->limit && !negative && number > schema->limit) {
+                if (!(schema->flags & FHSParameterTruncate)) {
+                    return -1;
+                }
+                param->value = schema->limitText;
+                param->valueLength = strlen(schema->limitText);
+            }
+            return 0;
+        }
+        case FHSParameterBool:
+            return ((length == 4 && memcmp(value, "true", 4) == 0) || (length == 5 && memcmp(value, "false", 5) == 0) || (length == 1 && (value[0] == '1' || value[0] == '0')))?0:-1;
+        case FHSParameterList: {
+            size_t items = 1;
+
+            for (size_t i = 0; i < length; i++) {
+                items += (value[i] == ',');
+            }
+            return (schema->limit && items > schema->limit)?-1:0;
+        }
+        default:
+            return -1;
+    }
+}
+
+int fhs_endpoint_check(const fhs_endpoint *endpoint, fhs_request_param *params, size_t count) {
+    uint32_t present = 0; // schema entries with a non-empty value
+    uint32_t oneOf = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        const fhs_endpoint_param *schema = fhs_endpoint_param_named(endpoint, params[i].key, params[i].keyLength);
+
+        if (!schema) {
+            continue;
+        }
+
+        if (fhs_check_value(schema, &params[i]) != 0) {
+            return -1;
+        }
+
+        if (params[i].valueLength > 0) {
+            present |= 1u << (schema-endpoint->params);
+        }
+    }
+
+    for (size_t i = 0; i < endpoint->paramCount; i++) {
+        uint8_t flags = endpoint->params[i].flags;
+
+        if ((flags & FHSParameterRequired) && !(present & (1u << i))) {
+            return -1;
+        }
+
+        if (flags & FHSParameterOneOf) {
+            oneOf |= 1u << i;
+        }
+    }
+
+    return (oneOf && !(present & oneOf))?-1:0;
+}
+
+//
+// Building
+//
+
+int fhs_endpoint_request_build(fhs_endpoint_request *request, const fhs_endpoint *endpoint, fhs_request_param *params, size_t count, int multipart) {
+    if (fhs_endpoint_check(endpoint, params, count) != 0) {
+        return -1;
+    }
+
+    request->url.length = 0;
+    request->body.length = 0;
+    request->method = endpoint->method;
+    request->multipart = multipart;
+    request->signingPrefix = endpoint->signingPrefix;
+    request->signingPrefixLength = endpoint->signingPrefixLength;
+
+    if (fhs_request_buffer_append(&request->url, endpoint->url, endpoint->urlLength) != 0
+        || fhs_request_buffer_append(&request->body, NULL, 0) != 0) {
+        return -1;
+    }
+
+    const fhs_request_param *pathValue = NULL;
+
+    if (endpoint->pathParam >= 0) {
+        const char *key = endpoint->params[endpoint->pathParam].key;
+        size_t keyLength = strlen(key);
+
+        for (size_t i = 0; i < count && !pathValue; i++) {
+            if (params[i].keyLength == keyLength && memcmp(params[i].key, key, keyLength) == 0) {
+                pathValue = &params[i];
+            }
+        }
+
+        if (!pathValue) {
+            return -1;
+        }
+
+        // Path parameters are ids, which never need encoding
+        size_t prefixLength = endpoint->signingPrefixLength+pathValue->valueLength+6;
+
+        if (prefixLength > sizeof(request->pathPrefix)) {
+            return -1;
+        }
+
+        memcpy(request->pathPrefix, endpoint->signingPrefix, endpoint->signingPrefixLength);
+        memcpy(request->pathPrefix+endpoint->signingPrefixLength, pathValue->value, pathValue->valueLength);
+        memcpy(request->pathPrefix+prefixLength-6, ".json&", 6);
+        request->signingPrefix = request->pathPrefix;
+        request->signingPrefixLength = prefixLength;
+
+        if (fhs_request_buffer_append(&request->url, pathValue->value, pathValue->valueLength) != 0
+            || fhs_request_buffer_append(&request->url, ".json", 5) != 0) {
+            return -1;
+        }
+    }
+
+    int get = (strcmp(endpoint->method, "GET") == 0);
+
+    if (!get && multipart) {
+        return 0;
+    }
+
+    fhs_request_buffer *form = get?&request->url:&request->body;
+    size_t written = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (&params[i] == pathValue || !params[i].value) {
+            continue;
+        }
+
+        const char *separator = (written > 0)?"&":(get?"?":NULL);
+        const fhs_endpoint_param *schema = fhs_endpoint_param_named(endpoint, params[i].key, params[i].keyLength);
+        int base64 = (schema && schema->type == FHSParameterBase64);
+
+        if ((separator && fhs_request_buffer_append(form, separator, 1) != 0)
+            || (base64?fhs_request_append_base64_form(form, &params[i]):fhs_request_append_form(form, &params[i], 1)) != 0) {
+            return -1;
+        }
+
+        written++;
+    }
+
+    return 0;
+}
+
+const char *fhs_endpoint_request_sign(const fhs_endpoint_request *request, const fhs_oauth_key *key, size_t *headerLength) {
+    char nonce[FHS_NONCE_LENGTH+1];
+    fhs_nonce(nonce);
+
+    fhs_oauth_request oauth;
+    memset(&oauth, 0, sizeof(oauth));
+    oauth.method = request->method;
+    oauth.url = request->url.data;
+    oauth.urlLength = request->url.length;
+    oauth.body = (request->multipart || request->body.length == 0)?NULL:request->body.data;
+    oauth.bodyLength = oauth.body?request->body.length:0;
+    oauth.nonce = nonce;
+    oauth.timestamp = (long)time(NULL);
+    oauth.signingPrefix = request->signingPrefix;
+    oauth.signingPrefixLength = request->signingPrefixLength;
+
+    return fhs_oauth_sign(key, &oauth, headerLength);
+}
+
+void fhs_endpoint_request_free(fhs_endpoint_request *request) {
+    fhs_request_buffer_free(&request->url);
+    fhs_request_buffer_free(&request->body);
+}
@@ -0,0 +1,210 @@
+//
+//  FHSEndpoint.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Static table of the REST endpoints: method, URL, the signature base
+//  string prefix already percent-encoded, the parameter schema with its
+//  limits and the rate limit family. Building a request from it is a table
+//  lookup, a check of the parameters against the schema, and encoding only
+//  the parameters themselves.
+//
+
+#ifndef FHSENDPOINT_H
+#define FHSENDPOINT_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FHSRequest.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FHSEndpointStatusesHomeTimeline = 0,
+    FHSEndpointStatusesUserTimeline,
+    FHSEndpointStatusesMentionsTimeline,
+    FHSEndpointStatusesRetweetsOfMe,
+    FHSEndpointStatusesRetweets,
+    FHSEndpointStatusesShow,
+    FHSEndpointStatusesUpdate,
+    FHSEndpointStatusesUpdateWithMedia,
+    FHSEndpointStatusesDestroy,
+    FHSEndpointStatusesRetweet,
+    FHSEndpointMediaUpload,
+    FHSEndpointMediaUploadStatus,
+    FHSEndpointSearchTweets,
+    FHSEndpointUsersShow,
+    FHSEndpointUsersLookup,
+    FHSEndpointUsersSearch,
+    FHSEndpointUsersReportSpam,
+    FHSEndpointFollowersIDs,
+    FHSEndpointFollowersList,
+    FHSEndpointFriendsIDs,
+    FHSEndpointFriendsList,
+    FHSEndpointFriendshipsCreate,
+    FHSEndpointFriendshipsDestroy,
+    FHSEndpointFriendshipsUpdate,
+    FHSEndpointFriendshipsLookup,
+    FHSEndpointFriendshipsIncoming,
+    FHSEndpointFriendshipsOutgoing,
+    FHSEndpointFriendshipsNoRetweetsIDs,
+    FHSEndpointBlocksExists,
+    FHSEndpointBlocksList,
+    FHSEndpointBlocksIDs,
+    FHSEndpointBlocksCreate,
+    FHSEndpointBlocksDestroy,
+    FHSEndpointListsList,
+    FHSEndpointListsShow,
+    FHSEndpointListsCreate,
+    FHSEndpointListsUpdate,
+    FHSEndpointListsStatuses,
+    FHSEndpointListsMembers,
+    FHSEndpointListsMembersCreateAll,
+    FHSEndpointListsMembersDestroyAll,
+    FHSEndpointDirectMessages,
+    FHSEndpointDirectMessagesSent,
+    FHSEndpointDirectMessagesShow,
+    FHSEndpointDirectMessagesNew,
+    FHSEndpointDirectMessagesDestroy,
+    FHSEndpointFavoritesList,
+    FHSEndpointFavoritesCreate,
+    FHSEndpointFavoritesDestroy,
+    FHSEndpointAccountVerifyCredentials,
+    FHSEndpointAccountSettings,
+    FHSEndpointAccountUpdateSettings,
+    FHSEndpointAccountUpdateProfile,
+    FHSEndpointAccountUpdateProfileColors,
+    FHSEndpointAccountUpdateProfileImage,
+    FHSEndpointAccountUpdateProfileBackgroundImage,
+    FHSEndpointHelpConfiguration,
+    FHSEndpointHelpLanguages,
+    FHSEndpointHelpPrivacy,
+    FHSEndpointHelpTOS,
+    FHSEndpointHelpTest,
+    FHSEndpointApplicationRateLimitStatus,
+    FHSEndpointCount
+} FHSEndpoint;
+
+typedef enum {
+    FHSParameterString = 0, // limit is in characters
+    FHSParameterID,         // decimal id
+    FHSParameterInteger,    // limit is the largest value
+    FHSParameterBool,       // true, false, 1 or 0
+    FHSParameterList,       // comma separated, limit is the number of items
+    FHSParameterData,       // binary, sent in a multipart body
+    FHSParameterBase64      // binary, base 64 encoded into the form body
+} FHSParameterType;
+
+enum {
+    FHSParameterRequired = 1 << 0,
+    FHSParameterOneOf = 1 << 1,     // at least one of the endpoint's FHSParameterOneOf parameters is required
+    FHSParameterTruncate = 1 << 2,  // strings over the limit are truncated and integers clamped instead of rejected
+    FHSParameterInPath = 1 << 3     // goes in the URL path instead of the query or body
+};
+
+/**
+ Parameter schema entry. Parameters that aren't in an endpoint's schema are sent unchecked.
+ */
+typedef struct {
+    const char *key;
+    uint8_t type;
+    uint8_t flags;
+    uint32_t limit;         // 0 for none
+    const char *limitText;  // limit of integers as text, what a clamped value becomes
+} fhs_endpoint_param;
+
+/**
+ Endpoint descriptor.
+ */
+typedef struct {
+    const char *path;           // e.g. "statuses/user_timeline", with ":id" for a path parameter
+    const char *family;         // rate limit resource family, e.g. "statuses"
+    const char *method;         // "GET" or "POST"
+    const char *url;            // URL, up to the path parameter if there is one
+    const char *signingPrefix;  // method, '&' and the percent-encoded URL, then '&' unless there's a path parameter
+    uint16_t urlLength;
+    uint16_t signingPrefixLength;
+    int16_t pathParam;          // index of the path parameter in params, or -1
+    uint16_t paramCount;
+    const fhs_endpoint_param *params;
+} fhs_endpoint;
+
+/**
+ Request built from an endpoint. Zero it before the first use, it can be
+ reused for several requests. Free it with fhs_endpoint_request_free().
+ */
+typedef struct {
+    fhs_request_buffer url;         // URL, with the query string of GET requests
+    fhs_request_buffer body;        // form body of POST requests, empty for multipart ones
+    const char *signingPrefix;
+    size_t signingPrefixLength;
+    const char *method;
+    int multipart;
+    char pathPrefix[192];           // backs signingPrefix for endpoints with a path parameter
+} fhs_endpoint_request;
+
+/**
+ Look up an endpoint.
+ @param endpoint Endpoint.
+ @return Descriptor, or NULL if out of range.
+ */
+const fhs_endpoint *fhs_endpoint_get(FHSEndpoint endpoint);
+
+/**
+ Look up a parameter in an endpoint's schema.
+ @param endpoint Descriptor.
+ @param key Parameter name.
+ @param length Length of the name.
+ @return Schema entry, or NULL if the endpoint doesn't list it.
+ */
+const fhs_endpoint_param *fhs_endpoint_param_named(const fhs_endpoint *endpoint, const char *key, size_t length);
+
+/**
+ Check parameters against an endpoint's schema. Strings over their limit are
+ shortened and integers clamped in place where the schema allows it.
+ Data parameters have a NULL value and the length of the data, base 64 ones the binary value.
+ @param endpoint Descriptor.
+ @param params Parameters.
+ @param count Number of parameters.
+ @return 0 if they're valid, -1 if a required parameter is missing or empty, or one is malformed or over its limit.
+ */
+int fhs_endpoint_check(const fhs_endpoint *endpoint, fhs_request_param *params, size_t count);
+
+/**
+ Check parameters and build a request: the URL with the path parameter and,
+ for GET, the query; the form body for POST; and the signing prefix.
+ Parameters with a NULL value are left to the caller's multipart body, base 64
+ ones are encoded into the form body.
+ @param request Request, its previous contents are replaced.
+ @param endpoint Descriptor.
+ @param params Parameters, checked as with fhs_endpoint_check().
+ @param count Number of parameters.
+ @param multipart Non-zero if the caller sends the parameters of a POST as a multipart body.
+ @return 0 on success, -1 on invalid parameters or if out of memory.
+ */
+int fhs_endpoint_request_build(fhs_endpoint_request *request, const fhs_endpoint *endpoint, fhs_request_param *params, size_t count, int multipart);
+
+/**
+ Sign a built request with a fresh nonce and the current time.
+ @param request Request.
+ @param key Signing key.
+ @param headerLength Set to the length of the returned header.
+ @return Authorization header value, valid until the next signing on the same thread. NULL if out of memory.
+ */
+const char *fhs_endpoint_request_sign(const fhs_endpoint_request *request, const fhs_oauth_key *key, size_t *headerLength);
+
+/**
+ Free a request's buffers.
+ @param request Request.
+ */
+void fhs_endpoint_request_free(fhs_endpoint_request *request);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,118 @@
+//
+//  FHSGraphSnapshot.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+/**
+ Set of user ids, such as a user's followers at one point in time.
+ Ids are kept as one sorted array of 64-bit integers, 8 bytes each, rather
+ than an array of strings. Snapshots saved to a file are memory mapped when
+ read back, so loading one costs no parsing or copying. Snapshots are
+ immutable and safe to share between threads.
+ */
+@interface FHSGraphSnapshot : NSObject
+
+/**
+ Followers of a user, fetched page by page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @param engine Engine used to send the requests, or nil for the shared engine.
+ @param error Set on failure, may be NULL.
+ @return A snapshot, or nil on failure.
+ */
++ (FHSGraphSnapshot *)followersOfUser:(NSString *)user isID:(BOOL)isID engine:(FHSTwitterEngine *)engine error:(NSError **)error;
+
+/**
+ Users a user is following, fetched page by page.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @param engine Engine used to send the requests, or nil for the shared engine.
+ @param error Set on failure, may be NULL.
+ @return A snapshot, or nil on failure.
+ */
++ (FHSGraphSnapshot *)friendsOfUser:(NSString *)user isID:(BOOL)isID engine:(FHSTwitterEngine *)engine error:(NSError **)error;
+
+/**
+ Snapshot saved with writeToFile:error:, memory mapped.
+ @param path File path.
+ @param error Set on failure, may be NULL.
+ @return A snapshot, or nil on failure.
+ */
++ (FHSGraphSnapshot *)snapshotWithContentsOfFile:(NSString *)path error:(NSError **)error;
+
+/**
+ Snapshot of ids in any order, with duplicates.
+ @param ids Ids.
+ @param count Number of ids.
+ @return A snapshot.
+ */
++ (FHSGraphSnapshot *)snapshotWithIDs:(const uint64_t *)ids count:(NSUInteger)count;
+
+/**
+ Snapshot of id strings in any order, with duplicates. Strings that aren't ids are skipped.
+ @param ids NSString or NSNumber ids.
+ @return A snapshot.
+ */
++ (FHSGraphSnapshot *)snapshotWithArray:(NSArray *)ids;
+
+/**
+ Number of ids.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ Sorted ids, valid as long as the snapshot is.
+ */
+@property (nonatomic, readonly) const uint64_t *IDs;
+
+/**
+ Whether the snapshot holds an id.
+ @param identifier User id.
+ @return Whether the id is in the snapshot.
+ */
+- (BOOL)containsID:(uint64_t)identifier;
+
+/**
+ Ids not in another snapshot, e.g. new followers when called on the newer snapshot.
+ @param snapshot Other snapshot.
+ @return A snapshot.
+ */
+- (FHSGraphSnapshot *)snapshotBySubtracting:(FHSGraphSnapshot *)snapshot;
+
+/**
+ Ids also in another snapshot, e.g. mutual follows when called on followers with friends.
+ @param snapshot Other snapshot.
+ @return A snapshot.
+ */
+- (FHSGraphSnapshot *)snapshotByIntersecting:(FHSGraphSnapshot *)snapshot;
+
+/**
+ Compare with an older snapshot in one pass.
+ @param snapshot Older snapshot.
+ @param added Set to the ids only in this snapshot, may be NULL.
+ @param removed Set to the ids only in the older snapshot, may be NULL.
+ @param unchanged Set to the ids in both, may be NULL.
+ */
+- (void)compareWithSnapshot:(FHSGraphSnapshot *)snapshot added:(FHSGraphSnapshot **)added removed:(FHSGraphSnapshot **)removed unchanged:(FHSGraphSnapshot **)unchanged;
+
+/**
+ Ids as decimal strings, for the engine's lookup methods.
+ @param range Range of ids.
+ @return Array of NSString.
+ */
+- (NSArray *)stringsInRange:(NSRange)range;
+
+/**
+ Save the snapshot. The file can be memory mapped as is.
+ @param path File path.
+ @param error Set on failure, may be NULL.
+ @return Whether the file was written.
+ */
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error;
+
+@end
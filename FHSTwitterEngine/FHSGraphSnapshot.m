@@ -0,0 +1,208 @@
+//
+//  FHSGraphSnapshot.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSGraphSnapshot.h"
+#import "FHSCursor.h"
+
+#include <string.h>
+
+#include "FHSIDSet.h"
+
+@interface FHSGraphSnapshot () {
+    NSData *_data;
+    const uint64_t *_ids;
+    NSUInteger _count;
+}
+
+@end
+
+@implementation FHSGraphSnapshot
+
+// Takes ownership of a buffer of ids and normalizes it
++ (FHSGraphSnapshot *)snapshotWithBuffer:(NSMutableData *)buffer count:(NSUInteger)count {
+    NSMutableData *scratch = (count >= 64)?[NSMutableData dataWithLength:count*sizeof(uint64_t)]:nil;
+    size_t unique = fhs_idset_normalize(buffer.mutableBytes, count, scratch.mutableBytes);
+    buffer.length = unique*sizeof(uint64_t);
+    return [[[self class]alloc]initWithData:buffer offset:0 count:unique];
+}
+
++ (FHSGraphSnapshot *)snapshotWithCursor:(FHSCursor *)cursor engine:(FHSTwitterEngine *)engine error:(NSError **)error {
+    if (engine) {
+        cursor.engine = engine;
+    }
+
+    NSMutableData *buffer = [NSMutableData data];
+    NSUInteger count = 0;
+    FHSIDList *page;
+
+    // Pages are decoded to packed ids, so each one is a single copy into the buffer
+    while ((page = [cursor nextIDList])) {
+        if (page.count > 0) {
+            buffer.length = (count+page.count)*sizeof(uint64_t);
+            memcpy((uint64_t *)buffer.mutableBytes+count, page.IDs, page.count*sizeof(uint64_t));
+            count += page.count;
+        }
+    }
+
+    if (cursor.error) {
+        if (error) {
+            *error = cursor.error;
+        }
+        return nil;
+    }
+
+    return [self snapshotWithBuffer:buffer count:count];
+}
+
++ (FHSGraphSnapshot *)followersOfUser:(NSString *)user isID:(BOOL)isID engine:(FHSTwitterEngine *)engine error:(NSError **)error {
+    return [self snapshotWithCursor:[FHSCursor followerIDsForUser:user isID:isID] engine:engine error:error];
+}
+
++ (FHSGraphSnapshot *)friendsOfUser:(NSString *)user isID:(BOOL)isID engine:(FHSTwitterEngine *)engine error:(NSError **)error {
+    return [self snapshotWithCursor:[FHSCursor friendIDsForUser:user isID:isID] engine:engine error:error];
+}
+
++ (FHSGraphSnapshot *)snapshotWithContentsOfFile:(NSString *)path error:(NSError **)error {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:error];
+    uint64_t count;
+
+    if (!data) {
+        return nil;
+    }
+
+    if (fhs_idset_read_header(data.bytes, data.length, &count) != 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError userInfo:@{NSFilePathErrorKey: path}];
+        }
+        return nil;
+    }
+
+    // The file is little endian, like every device this runs on
+    if (NSHostByteOrder() != NS_LittleEndian) {
+        NSMutableData *swapped = [NSMutableData dataWithLength:(NSUInteger)count*sizeof(uint64_t)];
+        const uint64_t *source = (const uint64_t *)((const uint8_t *)data.bytes+FHS_IDSET_HEADER_LENGTH);
+        uint64_t *destination = swapped.mutableBytes;
+
+        for (uint64_t i = 0; i < count; i++) {
+            destination[i] = NSSwapLittleLongLongToHost(source[i]);
+        }
+
+        return [[[self class]alloc]initWithData:swapped offset:0 count:(NSUInteger)count];
+    }
+
+    return [[[self class]alloc]initWithData:data offset:FHS_IDSET_HEADER_LENGTH count:(NSUInteger)count];
+}
+
++ (FHSGraphSnapshot *)snapshotWithIDs:(const uint64_t *)ids count:(NSUInteger)count {
+    return [self snapshotWithBuffer:[NSMutableData dataWithBytes:ids length:count*sizeof(uint64_t)] count:count];
+}
+
++ (FHSGraphSnapshot *)snapshotWithArray:(NSArray *)ids {
+    NSMutableData *buffer = [NSMutableData dataWithLength:ids.count*sizeof(uint64_t)];
+    uint64_t *values = buffer.mutableBytes;
+    NSUInteger count = 0;
+
+    for (id identifier in ids) {
+        uint64_t value = [identifier isKindOfClass:[NSString class]]?[identifier fhs_tweetID]:[identifier unsignedLongLongValue];
+
+        if (value > 0) {
+            values[count++] = value;
+        }
+    }
+
+    return [self snapshotWithBuffer:buffer count:count];
+}
+
+- (instancetype)initWithData:(NSData *)data offset:(NSUInteger)offset count:(NSUInteger)count {
+    self = [super init];
+    if (self) {
+        _data = data;
+        _ids = (const uint64_t *)((const uint8_t *)data.bytes+offset);
+        _count = count;
+    }
+    return self;
+}
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (const uint64_t *)IDs {
+    return _ids;
+}
+
+- (BOOL)containsID:(uint64_t)identifier {
+    return fhs_idset_contains(_ids, _count, identifier) != 0;
+}
+
+- (FHSGraphSnapshot *)snapshotWithSortedBuffer:(NSMutableData *)buffer count:(size_t)count {
+    buffer.length = count*sizeof(uint64_t);
+    return [[[self class]alloc]initWithData:buffer offset:0 count:count];
+}
+
+- (FHSGraphSnapshot *)snapshotBySubtracting:(FHSGraphSnapshot *)snapshot {
+    NSMutableData *buffer = [NSMutableData dataWithLength:_count*sizeof(uint64_t)];
+    size_t count;
+    fhs_idset_compare(_ids, _count, snapshot.IDs, snapshot.count, buffer.mutableBytes, &count, NULL, NULL, NULL, NULL);
+    return [self snapshotWithSortedBuffer:buffer count:count];
+}
+
+- (FHSGraphSnapshot *)snapshotByIntersecting:(FHSGraphSnapshot *)snapshot {
+    NSMutableData *buffer = [NSMutableData dataWithLength:MIN(_count, snapshot.count)*sizeof(uint64_t)];
+    size_t count;
+    fhs_idset_compare(_ids, _count, snapshot.IDs, snapshot.count, NULL, NULL, NULL, NULL, buffer.mutableBytes, &count);
+    return [self snapshotWithSortedBuffer:buffer count:count];
+}
+
+- (void)compareWithSnapshot:(FHSGraphSnapshot *)snapshot added:(FHSGraphSnapshot **)added removed:(FHSGraphSnapshot **)removed unchanged:(FHSGraphSnapshot **)unchanged {
+    NSMutableData *addedBuffer = added?[NSMutableData dataWithLength:_count*sizeof(uint64_t)]:nil;
+    NSMutableData *removedBuffer = removed?[NSMutableData dataWithLength:snapshot.count*sizeof(uint64_t)]:nil;
+    NSMutableData *unchangedBuffer = unchanged?[NSMutableData dataWithLength:MIN(_count, snapshot.count)*sizeof(uint64_t)]:nil;
+    size_t addedCount, removedCount, unchangedCount;
+
+    fhs_idset_compare(_ids, _count, snapshot.IDs, snapshot.count, addedBuffer.mutableBytes, &addedCount, removedBuffer.mutableBytes, &removedCount, unchangedBuffer.mutableBytes, &unchangedCount);
+
+    if (added) {
+        *added = [self snapshotWithSortedBuffer:addedBuffer count:addedCount];
+    }
+
+    if (removed) {
+        *removed = [self snapshotWithSortedBuffer:removedBuffer count:removedCount];
+    }
+
+    if (unchanged) {
+        *unchanged = [self snapshotWithSortedBuffer:unchangedBuffer count:unchangedCount];
+    }
+}
+
+- (NSArray *)stringsInRange:(NSRange)range {
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:range.length];
+
+    for (NSUInteger i = range.location; i < NSMaxRange(range) && i < _count; i++) {
+        [strings addObject:[NSString fhs_stringWithTweetID:_ids[i]]];
+    }
+
+    return strings;
+}
+
+- (BOOL)writeToFile:(NSString *)path error:(NSError **)error {
+    NSMutableData *data = [NSMutableData dataWithLength:FHS_IDSET_HEADER_LENGTH];
+    fhs_idset_write_header(_count, data.mutableBytes);
+
+    if (NSHostByteOrder() == NS_LittleEndian) {
+        [data appendBytes:_ids length:_count*sizeof(uint64_t)];
+    } else {
+        for (NSUInteger i = 0; i < _count; i++) {
+            uint64_t value = NSSwapHostLongLongToLittle(_ids[i]);
+            [data appendBytes:&value length:sizeof(value)];
+        }
+    }
+
+    return [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+@end
@@ -0,0 +1,210 @@
+//
+//  FHSIDDecoder.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSIDDecoder.h"
+#include "FHSSnowflake.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+typedef enum {
+    FHS_ID_KEY_OTHER,
+    FHS_ID_KEY_IDS,
+    FHS_ID_KEY_NEXT_CURSOR,
+    FHS_ID_KEY_PREVIOUS_CURSOR,
+    FHS_ID_KEY_ERRORS
+} fhs_id_key;
+
+typedef struct {
+    fhs_id_list *list;
+    size_t depth;
+    fhs_id_key key; // last key at depth 1
+    int inIDs;
+    int foundIDs;
+    const char *message;
+} fhs_id_decoder;
+
+#define FHS_ID_KEY_IS(bytes, length, literal) ((length) == sizeof(literal)-1 && memcmp((bytes), (literal), sizeof(literal)-1) == 0)
+
+static int fhs_id_fail(fhs_id_decoder *decoder, const char *message) {
+    decoder->message = message;
+    return -1;
+}
+
+static int fhs_id_append(fhs_id_decoder *decoder, uint64_t value) {
+    fhs_id_list *list = decoder->list;
+
+    if (list->count == list->capacity) {
+        size_t capacity = (list->capacity > 0)?list->capacity*2:256;
+        uint64_t *ids = realloc(list->ids, capacity*sizeof(uint64_t));
+
+        if (!ids) {
+            return fhs_id_fail(decoder, "Out of memory");
+        }
+
+        list->ids = ids;
+        list->capacity = capacity;
+    }
+
+    list->ids[list->count++] = value;
+    return 0;
+}
+
+static int fhs_id_begin_object(void *context) {
+    fhs_id_decoder *decoder = context;
+
+    if (decoder->inIDs) {
+        return fhs_id_fail(decoder, "Expected an id");
+    }
+
+    decoder->depth++;
+    return 0;
+}
+
+static int fhs_id_begin_array(void *context) {
+    fhs_id_decoder *decoder = context;
+
+    if (decoder->inIDs) {
+        return fhs_id_fail(decoder, "Expected an id");
+    }
+
+    decoder->depth++;
+
+    if (decoder->depth == 1 || (decoder->depth == 2 && decoder->key == FHS_ID_KEY_IDS)) {
+        decoder->inIDs = 1;
+        decoder->foundIDs = 1;
+    }
+    return 0;
+}
+
+static int fhs_id_end(void *context) {
+    fhs_id_decoder *decoder = context;
+    decoder->inIDs = 0;
+    decoder->depth--;
+    return 0;
+}
+
+static int fhs_id_key_callback(void *context, const char *bytes, size_t length) {
+    fhs_id_decoder *decoder = context;
+
+    if (decoder->depth != 1) {
+        return 0;
+    }
+
+    if (FHS_ID_KEY_IS(bytes, length, "ids") || FHS_ID_KEY_IS(bytes, length, "friends") || FHS_ID_KEY_IS(bytes, length, "friends_str")) {
+        decoder->key = FHS_ID_KEY_IDS;
+    } else if (FHS_ID_KEY_IS(bytes, length, "next_cursor")) {
+        decoder->key = FHS_ID_KEY_NEXT_CURSOR;
+    } else if (FHS_ID_KEY_IS(bytes, length, "previous_cursor")) {
+        decoder->key = FHS_ID_KEY_PREVIOUS_CURSOR;
+    } else if (FHS_ID_KEY_IS(bytes, length, "errors")) {
+        return fhs_id_fail(decoder, "Response is an error");
+    } else {
+        decoder->key = FHS_ID_KEY_OTHER;
+    }
+    return 0;
+}
+
+static int fhs_id_integer(void *context, int64_t value) {
+    fhs_id_decoder *decoder = context;
+
+    if (decoder->inIDs) {
+        return (value > 0)?fhs_id_append(decoder, (uint64_t)value):fhs_id_fail(decoder, "Invalid id");
+    }
+
+    if (decoder->depth == 1 && decoder->key == FHS_ID_KEY_NEXT_CURSOR) {
+        decoder->list->nextCursor = value;
+    } else if (decoder->depth == 1 && decoder->key == FHS_ID_KEY_PREVIOUS_CURSOR) {
+        decoder->list->previousCursor = value;
+    }
+    return 0;
+}
+
+static int fhs_id_unsigned_integer(void *context, uint64_t value) {
+    fhs_id_decoder *decoder = context;
+    return decoder->inIDs?fhs_id_append(decoder, value):0;
+}
+
+static int fhs_id_string(void *context, const char *bytes, size_t length) {
+    fhs_id_decoder *decoder = context;
+    uint64_t value;
+
+    if (!decoder->inIDs) {
+        return 0;
+    }
+
+    if (fhs_snowflake_parse(bytes, length, &value) != 0 || value == 0) {
+        return fhs_id_fail(decoder, "Invalid id");
+    }
+
+    return fhs_id_append(decoder, value);
+}
+
+static int fhs_id_other(void *context) {
+    fhs_id_decoder *decoder = context;
+    return decoder->inIDs?fhs_id_fail(decoder, "Expected an id"):0;
+}
+
+static int fhs_id_real(void *context, double value) {
+    (void)value;
+    return fhs_id_other(context);
+}
+
+static int fhs_id_boolean(void *context, int value) {
+    (void)value;
+    return fhs_id_other(context);
+}
+
+static const fhs_json_callbacks fhs_id_callbacks = {
+    .begin_object = fhs_id_begin_object,
+    .end_object = fhs_id_end,
+    .begin_array = fhs_id_begin_array,
+    .end_array = fhs_id_end,
+    .key = fhs_id_key_callback,
+    .string = fhs_id_string,
+    .integer = fhs_id_integer,
+    .unsigned_integer = fhs_id_unsigned_integer,
+    .real = fhs_id_real,
+    .boolean = fhs_id_boolean,
+    .null = fhs_id_other
+};
+
+int fhs_id_list_decode(const uint8_t *data, size_t length, fhs_id_list *list, fhs_json_error *error) {
+    fhs_id_decoder decoder = {.list = list, .key = FHS_ID_KEY_OTHER};
+    size_t count = list->count;
+    int64_t nextCursor = list->nextCursor;
+    int64_t previousCursor = list->previousCursor;
+    fhs_json_error parseError = {0, NULL};
+
+    list->nextCursor = 0;
+    list->previousCursor = 0;
+
+    // Ids take 8 bytes here and at least 2 in the text, usually 10 to 20
+    if (list->capacity-list->count < length/12) {
+        size_t capacity = list->count+length/12+16;
+        uint64_t *ids = realloc(list->ids, capacity*sizeof(uint64_t));
+
+        if (ids) {
+            list->ids = ids;
+            list->capacity = capacity;
+        }
+    }
+
+    if (fhs_json_parse(data, length, &fhs_id_callbacks, &decoder, &parseError) == 0 && decoder.foundIDs) {
+        return 0;
+    }
+
+    list->count = count;
+    list->nextCursor = nextCursor;
+    list->previousCursor = previousCursor;
+
+    if (error) {
+        error->offset = parseError.offset;
+        error->message = decoder.message?decoder.message:(parseError.message?parseError.message:"No ids");
+    }
+    return -1;
+}
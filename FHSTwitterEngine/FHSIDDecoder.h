@@ -0,0 +1,51 @@
+//
+//  FHSIDDecoder.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Decodes id list responses (followers/ids, friends/ids, blocks/ids,
+//  friendships/no_retweets/ids and the user stream friends message) straight
+//  into an array of 64-bit integers, with no object per id.
+//
+
+#ifndef FHSIDDECODER_H
+#define FHSIDDECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "FHSJSON.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Decoded ids. Zero it before the first use and free ids when done.
+ */
+typedef struct {
+    uint64_t *ids;
+    size_t count;
+    size_t capacity;
+    int64_t nextCursor; // 0 when absent, or on the last page
+    int64_t previousCursor;
+} fhs_id_list;
+
+/**
+ Decode an id list and append its ids. Accepts a bare array of ids, or an
+ object holding an "ids", "friends" or "friends_str" array and optionally
+ cursors. Ids may be numbers or digit strings.
+ @param data JSON text.
+ @param length Length of the text.
+ @param list List to append to. Its cursors are replaced.
+ @param error Set on failure, may be NULL.
+ @return 0 on success, -1 if the text isn't an id list. The list is left as it was on failure, apart from its capacity.
+ */
+int fhs_id_list_decode(const uint8_t *data, size_t length, fhs_id_list *list, fhs_json_error *error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,59 @@
+//
+//  FHSIDList.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Page of user ids from an id list endpoint, such as followers/ids or
+ blocks/ids, or the friends message of a user stream.
+ Ids are decoded straight from the response into one array of 64-bit
+ integers, 8 bytes each, with no object per id. Lists are immutable and safe
+ to share between threads.
+ */
+@interface FHSIDList : NSObject
+
+/**
+ Decode an id list response.
+ @param data Response data.
+ @return A list, or nil if the data isn't an id list, e.g. an error response.
+ */
++ (FHSIDList *)listWithData:(NSData *)data;
+
+/**
+ Number of ids.
+ */
+@property (nonatomic, readonly) NSUInteger count;
+
+/**
+ Ids in the order of the response, valid as long as the list is.
+ */
+@property (nonatomic, readonly) const uint64_t *IDs;
+
+/**
+ Cursor of the next page, 0 on the last page or if the response isn't paged.
+ */
+@property (nonatomic, readonly) int64_t nextCursor;
+
+/**
+ Cursor of the previous page, 0 on the first page or if the response isn't paged.
+ */
+@property (nonatomic, readonly) int64_t previousCursor;
+
+/**
+ Id at an index.
+ @param index Index, less than count.
+ @return User id.
+ */
+- (uint64_t)IDAtIndex:(NSUInteger)index;
+
+/**
+ Ids as decimal strings, like the stringify_ids responses of the engine's other methods.
+ @return Array of NSString.
+ */
+- (NSArray *)strings;
+
+@end
@@ -0,0 +1,79 @@
+//
+//  FHSIDList.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSIDList.h"
+#import "FHSTwitterEngine.h"
+
+#include <stdlib.h>
+
+#include "FHSIDDecoder.h"
+
+@interface FHSIDList () {
+    NSData *_data;
+}
+
+@end
+
+@implementation FHSIDList
+
++ (FHSIDList *)listWithData:(NSData *)data {
+    fhs_id_list list = {0};
+
+    if (data.length == 0 || fhs_id_list_decode(data.bytes, data.length, &list, NULL) != 0) {
+        free(list.ids);
+        return nil;
+    }
+
+    return [[[self class]alloc]initWithList:&list];
+}
+
+// Takes ownership of the list's buffer
+- (instancetype)initWithList:(fhs_id_list *)list {
+    self = [super init];
+    if (self) {
+        uint64_t *ids = list->ids;
+
+        if (list->count == 0) {
+            free(ids);
+            _data = [NSData data];
+        } else {
+            // The decoder reserves room by response size, so give back the slack
+            if (list->count < list->capacity) {
+                uint64_t *shrunk = realloc(ids, list->count*sizeof(uint64_t));
+                ids = shrunk?shrunk:ids;
+            }
+
+            _data = [NSData dataWithBytesNoCopy:ids length:list->count*sizeof(uint64_t) freeWhenDone:YES];
+        }
+
+        _count = list->count;
+        _nextCursor = list->nextCursor;
+        _previousCursor = list->previousCursor;
+    }
+    return self;
+}
+
+- (const uint64_t *)IDs {
+    return _data.bytes;
+}
+
+- (uint64_t)IDAtIndex:(NSUInteger)index {
+    return ((const uint64_t *)_data.bytes)[index];
+}
+
+- (NSArray *)strings {
+    const uint64_t *ids = _data.bytes;
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:_count];
+
+    for (NSUInteger i = 0; i < _count; i++) {
+        [strings addObject:[NSString fhs_stringWithTweetID:ids[i]]];
+    }
+
+    return strings;
+}
+
+@end
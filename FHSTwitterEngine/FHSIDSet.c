@@ -0,0 +1,167 @@
+//
+//  FHSIDSet.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSIDSet.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+static const uint8_t fhs_idset_magic[8] = {'F','H','S','I','D','S','E','T'};
+
+static int fhs_idset_compare_values(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y)-(x < y);
+}
+
+// Least significant digit first, one byte per pass. Ids share their high
+// bytes, so the passes where every id has the same digit are skipped.
+static void fhs_idset_radix_sort(uint64_t *ids, size_t count, uint64_t *scratch) {
+    size_t histograms[8][256];
+    memset(histograms, 0, sizeof(histograms));
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = ids[i];
+        for (int pass = 0; pass < 8; pass++) {
+            histograms[pass][(value >> (pass*8)) & 0xFF]++;
+        }
+    }
+
+    uint64_t *source = ids;
+    uint64_t *destination = scratch;
+
+    for (int pass = 0; pass < 8; pass++) {
+        size_t *histogram = histograms[pass];
+
+        if (histogram[(ids[0] >> (pass*8)) & 0xFF] == count) {
+            continue;
+        }
+
+        size_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            size_t bucket = histogram[digit];
+            histogram[digit] = offset;
+            offset += bucket;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            uint64_t value = source[i];
+            destination[histogram[(value >> (pass*8)) & 0xFF]++] = value;
+        }
+
+        uint64_t *swap = source;
+        source = destination;
+        destination = swap;
+    }
+
+    if (source != ids) {
+        memcpy(ids, source, count*sizeof(uint64_t));
+    }
+}
+
+size_t fhs_idset_normalize(uint64_t *ids, size_t count, uint64_t *scratch) {
+    if (count < 2) {
+        return count;
+    }
+
+    if (scratch && count >= 64) {
+        fhs_idset_radix_sort(ids, count, scratch);
+    } else {
+        qsort(ids, count, sizeof(uint64_t), fhs_idset_compare_values);
+    }
+
+    size_t unique = 1;
+    for (size_t i = 1; i < count; i++) {
+        if (ids[i] != ids[unique-1]) {
+            ids[unique++] = ids[i];
+        }
+    }
+
+    return unique;
+}
+
+int fhs_idset_contains(const uint64_t *ids, size_t count, uint64_t value) {
+    size_t low = 0;
+    size_t high = count;
+
+    while (low < high) {
+        size_t middle = low+(high-low)/2;
+
+        if (ids[middle] < value) {
+            low = middle+1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return low < count && ids[low] == value;
+}
+
+void fhs_idset_compare(const uint64_t *a, size_t aCount, const uint64_t *b, size_t bCount, uint64_t *onlyA, size_t *onlyACount, uint64_t *onlyB, size_t *onlyBCount, uint64_t *both, size_t *bothCount) {
+    size_t i = 0, j = 0;
+    size_t nA = 0, nB = 0, nBoth = 0;
+
+    while (i < aCount && j < bCount) {
+        uint64_t x = a[i];
+        uint64_t y = b[j];
+
+        if (x < y) {
+            if (onlyA) onlyA[nA] = x;
+            nA++;
+            i++;
+        } else if (y < x) {
+            if (onlyB) onlyB[nB] = y;
+            nB++;
+            j++;
+        } else {
+            if (both) both[nBoth] = x;
+            nBoth++;
+            i++;
+            j++;
+        }
+    }
+
+    if (onlyA && i < aCount) {
+        memcpy(onlyA+nA, a+i, (aCount-i)*sizeof(uint64_t));
+    }
+    nA += aCount-i;
+
+    if (onlyB && j < bCount) {
+        memcpy(onlyB+nB, b+j, (bCount-j)*sizeof(uint64_t));
+    }
+    nB += bCount-j;
+
+    if (onlyACount) *onlyACount = nA;
+    if (onlyBCount) *onlyBCount = nB;
+    if (bothCount) *bothCount = nBoth;
+}
+
+void fhs_idset_write_header(uint64_t count, uint8_t *header) {
+    memcpy(header, fhs_idset_magic, sizeof(fhs_idset_magic));
+
+    for (int i = 0; i < 8; i++) {
+        header[8+i] = (uint8_t)(count >> (i*8));
+    }
+}
+
+int fhs_idset_read_header(const uint8_t *data, size_t length, uint64_t *count) {
+    if (length < FHS_IDSET_HEADER_LENGTH || memcmp(data, fhs_idset_magic, sizeof(fhs_idset_magic)) != 0) {
+        return -1;
+    }
+
+    uint64_t value = 0;
+    for (int i = 0; i < 8; i++) {
+        value |= (uint64_t)data[8+i] << (i*8);
+    }
+
+    if (value > (length-FHS_IDSET_HEADER_LENGTH)/sizeof(uint64_t)) {
+        return -1;
+    }
+
+    *count = value;
+    return 0;
+}
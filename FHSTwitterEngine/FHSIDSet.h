@@ -0,0 +1,81 @@
+//
+//  FHSIDSet.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Sets of 64-bit user or tweet ids, stored as sorted arrays without
+//  duplicates. Set operations are single merges over both arrays. The file
+//  layout is a 16 byte header followed by the ids in little endian, so a
+//  mapped file can be used in place.
+//
+
+#ifndef FHSIDSET_H
+#define FHSIDSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Length of the file header. The ids that follow stay 8 byte aligned.
+ */
+#define FHS_IDSET_HEADER_LENGTH 16
+
+/**
+ Sort ids and remove duplicates.
+ @param ids Ids, sorted in place.
+ @param count Number of ids.
+ @param scratch Buffer of count ids for the radix sort, or NULL to sort in place more slowly.
+ @return Number of distinct ids, now at the start of the array.
+ */
+size_t fhs_idset_normalize(uint64_t *ids, size_t count, uint64_t *scratch);
+
+/**
+ Whether a set holds an id.
+ @param ids Sorted ids.
+ @param count Number of ids.
+ @param value Id to look for.
+ @return 1 if found, 0 if not.
+ */
+int fhs_idset_contains(const uint64_t *ids, size_t count, uint64_t value);
+
+/**
+ Compare two sets in one merge. Any output may be NULL to only count it.
+ @param a First set, sorted.
+ @param aCount Size of the first set.
+ @param b Second set, sorted.
+ @param bCount Size of the second set.
+ @param onlyA Ids only in a, room for aCount.
+ @param onlyACount Set to the number of ids only in a, may be NULL.
+ @param onlyB Ids only in b, room for bCount.
+ @param onlyBCount Set to the number of ids only in b, may be NULL.
+ @param both Ids in both, room for the smaller count.
+ @param bothCount Set to the number of ids in both, may be NULL.
+ */
+void fhs_idset_compare(const uint64_t *a, size_t aCount, const uint64_t *b, size_t bCount, uint64_t *onlyA, size_t *onlyACount, uint64_t *onlyB, size_t *onlyBCount, uint64_t *both, size_t *bothCount);
+
+/**
+ Write a file header.
+ @param count Number of ids that follow.
+ @param header Output, FHS_IDSET_HEADER_LENGTH bytes.
+ */
+void fhs_idset_write_header(uint64_t count, uint8_t *header);
+
+/**
+ Check a file's header and length.
+ @param data File contents.
+ @param length Length of the file.
+ @param count Set to the number of ids.
+ @return 0 on success, -1 if the file isn't an id set or is truncated.
+ */
+int fhs_idset_read_header(const uint8_t *data, size_t length, uint64_t *count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
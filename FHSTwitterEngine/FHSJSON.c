@@ -0,0 +1,799 @@
+//
+//  FHSJSON.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSJSON.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FHS_JSON_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FHS_JSON_NEON 1
+#endif
+
+typedef struct {
+    const uint8_t *start;
+    const uint8_t *p;
+    const uint8_t *end;
+    const fhs_json_callbacks *callbacks;
+    void *context;
+    char *scratch;
+    size_t scratchCapacity;
+    size_t scratchLength;
+    const char *message;
+} fhs_json_parser;
+
+#define FHS_JSON_FAIL(parser, text) do { (parser)->message = (text); return -1; } while (0)
+#define FHS_JSON_EMIT(parser, callback, ...) do { \
+    if ((parser)->callbacks->callback && (parser)->callbacks->callback((parser)->context, ##__VA_ARGS__) != 0) { \
+        FHS_JSON_FAIL(parser, "Parse stopped by callback"); \
+    } \
+} while (0)
+
+static inline void fhs_json_skip_whitespace(fhs_json_parser *parser) {
+    const uint8_t *p = parser->p;
+    while (p < parser->end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) {
+        p++;
+    }
+    parser->p = p;
+}
+
+// First quote, backslash or control character, 16 bytes at a time where possible
+static inline const uint8_t *fhs_json_scan_string(const uint8_t *p, const uint8_t *end) {
+#if FHS_JSON_SSE2
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+
+    while (end-p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash));
+        special = _mm_or_si128(special, _mm_cmpeq_epi8(_mm_max_epu8(v, control), control));
+        int mask = _mm_movemask_epi8(special);
+
+        if (mask) {
+            return p+__builtin_ctz(mask);
+        }
+
+        p += 16;
+    }
+#elif FHS_JSON_NEON
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control = vdupq_n_u8(0x20);
+
+    while (end-p >= 16) {
+        uint8x16_t v = vld1q_u8(p);
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcltq_u8(v, control));
+
+        if (vmaxvq_u8(special)) {
+            break;
+        }
+
+        p += 16;
+    }
+#endif
+
+    while (p < end && *p != '"' && *p != '\\' && *p >= 0x20) {
+        p++;
+    }
+
+    return p;
+}
+
+static int fhs_json_scratch_append(fhs_json_parser *parser, const void *bytes, size_t length) {
+    if (length == 0) {
+        return 0;
+    }
+
+    if (parser->scratchLength+length > parser->scratchCapacity) {
+        size_t capacity = parser->scratchCapacity ? parser->scratchCapacity : 256;
+
+        while (capacity < parser->scratchLength+length) {
+            capacity *= 2;
+        }
+
+        char *scratch = realloc(parser->scratch, capacity);
+
+        if (!scratch) {
+            FHS_JSON_FAIL(parser, "Out of memory");
+        }
+
+        parser->scratch = scratch;
+        parser->scratchCapacity = capacity;
+    }
+
+    memcpy(parser->scratch+parser->scratchLength, bytes, length);
+    parser->scratchLength += length;
+    return 0;
+}
+
+static int fhs_json_hex4(const uint8_t *p, uint32_t *value) {
+    uint32_t v = 0;
+
+    for (int i = 0; i < 4; i++) {
+        uint8_t c = p[i];
+        v <<= 4;
+
+        if (c >= '0' && c <= '9') {
+            v |= c-'0';
+        } else if ((c|0x20) >= 'a' && (c|0x20) <= 'f') {
+            v |= (c|0x20)-'a'+10;
+        } else {
+            return -1;
+        }
+    }
+
+    *value = v;
+    return 0;
+}
+
+static size_t fhs_json_utf8(uint32_t codepoint, uint8_t *out) {
+    if (codepoint < 0x80) {
+        out[0] = (uint8_t)codepoint;
+        return 1;
+    } else if (codepoint < 0x800) {
+        out[0] = (uint8_t)(0xC0 | (codepoint >> 6));
+        out[1] = (uint8_t)(0x80 | (codepoint & 0x3F));
+        return 2;
+    } else if (codepoint < 0x10000) {
+        out[0] = (uint8_t)(0xE0 | (codepoint >> 12));
+        out[1] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+        out[2] = (uint8_t)(0x80 | (codepoint & 0x3F));
+        return 3;
+    }
+
+    out[0] = (uint8_t)(0xF0 | (codepoint >> 18));
+    out[1] = (uint8_t)(0x80 | ((codepoint >> 12) & 0x3F));
+    out[2] = (uint8_t)(0x80 | ((codepoint >> 6) & 0x3F));
+    out[3] = (uint8_t)(0x80 | (codepoint & 0x3F));
+    return 4;
+}
+
+// Parses the string at p (just past the opening quote). Strings without
+// escapes are handed out straight from the input; the rest go through scratch.
+static int fhs_json_parse_string(fhs_json_parser *parser, const char **bytes, size_t *length) {
+    const uint8_t *p = parser->p;
+    const uint8_t *end = parser->end;
+    const uint8_t *q = fhs_json_scan_string(p, end);
+
+    if (q < end && *q == '"') {
+        *bytes = (const char *)p;
+        *length = (size_t)(q-p);
+        parser->p = q+1;
+        return 0;
+    }
+
+    parser->scratchLength = 0;
+
+    while (1) {
+        if (fhs_json_scratch_append(parser, p, (size_t)(q-p)) != 0) {
+            return -1;
+        }
+
+        if (q == end) {
+            FHS_JSON_FAIL(parser, "Unterminated string");
+        } else if (*q == '"') {
+            break;
+        } else if (*q < 0x20) {
+            parser->p = q;
+            FHS_JSON_FAIL(parser, "Control character in string");
+        }
+
+        if (++q == end) {
+            FHS_JSON_FAIL(parser, "Unterminated string");
+        }
+
+        uint8_t utf8[4];
+        size_t utf8Length = 1;
+
+        switch (*q++) {
+            case '"': utf8[0] = '"'; break;
+            case '\\': utf8[0] = '\\'; break;
+            case '/': utf8[0] = '/'; break;
+            case 'b': utf8[0] = '\b'; break;
+            case 'f': utf8[0] = '\f'; break;
+            case 'n': utf8[0] = '\n'; break;
+            case 'r': utf8[0] = '\r'; break;
+            case 't': utf8[0] = '\t'; break;
+            case 'u': {
+                uint32_t codepoint;
+
+                if (end-q < 4 || fhs_json_hex4(q, &codepoint) != 0) {
+                    parser->p = q;
+                    FHS_JSON_FAIL(parser, "Invalid \\u escape");
+                }
+
+                q += 4;
+
+                if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+                    uint32_t low;
+
+                    if (end-q >= 6 && q[0] == '\\' && q[1] == 'u' && fhs_json_hex4(q+2, &low) == 0 && low >= 0xDC00 && low <= 0xDFFF) {
+                        codepoint = 0x10000+((codepoint-0xD800) << 10)+(low-0xDC00);
+                        q += 6;
+                    } else {
+                        codepoint = 0xFFFD;
+                    }
+                } else if (codepoint >= 0xDC00 && codepoint <= 0xDFFF) {
+                    codepoint = 0xFFFD;
+                }
+
+                utf8Length = fhs_json_utf8(codepoint, utf8);
+                break;
+            }
+            default:
+                parser->p = q-1;
+                FHS_JSON_FAIL(parser, "Invalid escape");
+        }
+
+        if (fhs_json_scratch_append(parser, utf8, utf8Length) != 0) {
+            return -1;
+        }
+
+        p = q;
+        q = fhs_json_scan_string(p, end);
+    }
+
+    *bytes = parser->scratch;
+    *length = parser->scratchLength;
+    parser->p = q+1;
+    return 0;
+}
+
+static int fhs_json_parse_number(fhs_json_parser *parser) {
+    const uint8_t *start = parser->p;
+    const uint8_t *p = start;
+    const uint8_t *end = parser->end;
+    int negative = 0;
+    int overflow = 0;
+    int real = 0;
+    uint64_t mantissa = 0;
+
+    if (*p == '-') {
+        negative = 1;
+        p++;
+    }
+
+    if (p == end || *p < '0' || *p > '9') {
+        FHS_JSON_FAIL(parser, "Invalid number");
+    }
+
+    if (*p == '0') {
+        p++;
+    } else {
+        while (p < end && *p >= '0' && *p <= '9') {
+            uint64_t digit = *p-'0';
+
+            if (mantissa > (UINT64_MAX-digit)/10) {
+                overflow = 1;
+            } else {
+                mantissa = mantissa*10+digit;
+            }
+
+            p++;
+        }
+    }
+
+    if (p < end && *p == '.') {
+        real = 1;
+
+        if (++p == end || *p < '0' || *p > '9') {
+            parser->p = p;
+            FHS_JSON_FAIL(parser, "Invalid number");
+        }
+
+        while (p < end && *p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        real = 1;
+
+        if (++p < end && (*p == '+' || *p == '-')) {
+            p++;
+        }
+
+        if (p == end || *p < '0' || *p > '9') {
+            parser->p = p;
+            FHS_JSON_FAIL(parser, "Invalid number");
+        }
+
+        while (p < end && *p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+
+    parser->p = p;
+
+    if (!real && !overflow) {
+        if (!negative && mantissa > (uint64_t)INT64_MAX) {
+            FHS_JSON_EMIT(parser, unsigned_integer, mantissa);
+            return 0;
+        } else if (!negative) {
+            FHS_JSON_EMIT(parser, integer, (int64_t)mantissa);
+            return 0;
+        } else if (mantissa <= (uint64_t)INT64_MAX+1) {
+            FHS_JSON_EMIT(parser, integer, (int64_t)(0-mantissa));
+            return 0;
+        }
+    }
+
+    // strtod needs a terminated copy; numbers this long are rare
+    char buffer[64];
+    size_t length = (size_t)(p-start);
+    char *text = buffer;
+
+    if (length >= sizeof(buffer)) {
+        text = malloc(length+1);
+
+        if (!text) {
+            FHS_JSON_FAIL(parser, "Out of memory");
+        }
+    }
+
+    memcpy(text, start, length);
+    text[length] = '\0';
+    double value = strtod(text, NULL);
+
+    if (text != buffer) {
+        free(text);
+    }
+
+    FHS_JSON_EMIT(parser, real, value);
+    return 0;
+}
+
+static int fhs_json_parse_literal(fhs_json_parser *parser, const char *literal, size_t length) {
+    if ((size_t)(parser->end-parser->p) < length || memcmp(parser->p, literal, length) != 0) {
+        FHS_JSON_FAIL(parser, "Invalid literal");
+    }
+
+    parser->p += length;
+    return 0;
+}
+
+// Iterative, so deep input can't overflow the call stack
+static int fhs_json_parse_document(fhs_json_parser *parser) {
+    char stack[FHS_JSON_MAX_DEPTH];
+    size_t depth = 0;
+    const char *bytes;
+    size_t length;
+
+value:
+    fhs_json_skip_whitespace(parser);
+
+    if (parser->p == parser->end) {
+        FHS_JSON_FAIL(parser, "Expected a value");
+    }
+
+    switch (*parser->p) {
+        case '{':
+            // Before the callback, empty containers included, so handlers never see more than FHS_JSON_MAX_DEPTH open
+            if (depth == FHS_JSON_MAX_DEPTH) {
+                FHS_JSON_FAIL(parser, "Too deeply nested");
+            }
+
+            parser->p++;
+            FHS_JSON_EMIT(parser, begin_object);
+            fhs_json_skip_whitespace(parser);
+
+            if (parser->p < parser->end && *parser->p == '}') {
+                parser->p++;
+                FHS_JSON_EMIT(parser, end_object);
+                goto next;
+            }
+
+            stack[depth++] = '{';
+            goto key;
+        case '[':
+            // Before the callback, empty containers included, so handlers never see more than FHS_JSON_MAX_DEPTH open
+            if (depth == FHS_JSON_MAX_DEPTH) {
+                FHS_JSON_FAIL(parser, "Too deeply nested");
+            }
+
+            parser->p++;
+            FHS_JSON_EMIT(parser, begin_array);
+            fhs_json_skip_whitespace(parser);
+
+            if (parser->p < parser->end && *parser->p == ']') {
+                parser->p++;
+                FHS_JSON_EMIT(parser, end_array);
+                goto next;
+            }
+
+            stack[depth++] = '[';
+            goto value;
+        case '"':
+            parser->p++;
+
+            if (fhs_json_parse_string(parser, &bytes, &length) != 0) {
+                return -1;
+            }
+
+            FHS_JSON_EMIT(parser, string, bytes, length);
+            goto next;
+        case 't':
+            if (fhs_json_parse_literal(parser, "true", 4) != 0) {
+                return -1;
+            }
+            FHS_JSON_EMIT(parser, boolean, 1);
+            goto next;
+        case 'f':
+            if (fhs_json_parse_literal(parser, "false", 5) != 0) {
+                return -1;
+            }
+            FHS_JSON_EMIT(parser, boolean, 0);
+            goto next;
+        case 'n':
+            if (fhs_json_parse_literal(parser, "null", 4) != 0) {
+                return -1;
+            }
+            FHS_JSON_EMIT(parser, null);
+            goto next;
+        default:
+            if (fhs_json_parse_number(parser) != 0) {
+                return -1;
+            }
+            goto next;
+    }
+
+key:
+    fhs_json_skip_whitespace(parser);
+
+    if (parser->p == parser->end || *parser->p != '"') {
+        FHS_JSON_FAIL(parser, "Expected a key");
+    }
+
+    parser->p++;
+
+    if (fhs_json_parse_string(parser, &bytes, &length) != 0) {
+        return -1;
+    }
+
+    FHS_JSON_EMIT(parser, key, bytes, length);
+    fhs_json_skip_whitespace(parser);
+
+    if (parser->p == parser->end || *parser->p != ':') {
+        FHS_JSON_FAIL(parser, "Expected ':'");
+    }
+
+    parser->p++;
+    goto value;
+
+next:
+    fhs_json_skip_whitespace(parser);
+
+    if (depth == 0) {
+        if (parser->p != parser->end) {
+            FHS_JSON_FAIL(parser, "Unexpected data after the document");
+        }
+        return 0;
+    }
+
+    if (parser->p == parser->end) {
+        FHS_JSON_FAIL(parser, "Unexpected end of input");
+    }
+
+    if (*parser->p == ',') {
+        parser->p++;
+
+        if (stack[depth-1] == '{') {
+            goto key;
+        }
+
+        goto value;
+    }
+
+    if (stack[depth-1] == '{' && *parser->p == '}') {
+        parser->p++;
+        depth--;
+        FHS_JSON_EMIT(parser, end_object);
+        goto next;
+    }
+
+    if (stack[depth-1] == '[' && *parser->p == ']') {
+        parser->p++;
+        depth--;
+        FHS_JSON_EMIT(parser, end_array);
+        goto next;
+    }
+
+    FHS_JSON_FAIL(parser, "Expected ',' or a closing bracket");
+}
+
+int fhs_json_parse(const uint8_t *data, size_t length, const fhs_json_callbacks *callbacks, void *context, fhs_json_error *error) {
+    fhs_json_parser parser = {
+        .start = data,
+        .p = data,
+        .end = data+length,
+        .callbacks = callbacks,
+        .context = context
+    };
+
+    // Skip a UTF-8 byte order mark
+    if (length >= 3 && data[0] == 0xEF && data[1] == 0xBB && data[2] == 0xBF) {
+        parser.p += 3;
+    }
+
+    int result = fhs_json_parse_document(&parser);
+    free(parser.scratch);
+
+    if (result != 0 && error) {
+        error->offset = (size_t)(parser.p-parser.start);
+        error->message = parser.message;
+    }
+
+    return result;
+}
+
+//
+// Index: one scan over a container, skipping nested values by bracket matching
+//
+
+// Past the closing quote of the string starting after p, or NULL
+static const uint8_t *fhs_json_skip_string(const uint8_t *p, const uint8_t *end, int *escaped) {
+    while (1) {
+        p = fhs_json_scan_string(p, end);
+
+        if (p == end || *p < 0x20) {
+            return NULL;
+        } else if (*p == '"') {
+            return p+1;
+        }
+
+        *escaped = 1;
+
+        if (end-p < 2) {
+            return NULL;
+        }
+
+        p += 2;
+    }
+}
+
+static const uint8_t *fhs_json_skip_value(const uint8_t *p, const uint8_t *end, uint8_t *type, int *escaped) {
+    switch (*p) {
+        case '"':
+            *type = FHS_JSON_STRING;
+            return fhs_json_skip_string(p+1, end, escaped);
+        case '{':
+        case '[': {
+            char stack[FHS_JSON_MAX_DEPTH];
+            size_t depth = 0;
+            int nestedEscape = 0;
+            *type = (*p == '{')?FHS_JSON_OBJECT:FHS_JSON_ARRAY;
+
+            while (p < end) {
+                uint8_t c = *p;
+
+                if (c == '"') {
+                    p = fhs_json_skip_string(p+1, end, &nestedEscape);
+
+                    if (!p) {
+                        return NULL;
+                    }
+                    continue;
+                } else if (c == '{' || c == '[') {
+                    if (depth == FHS_JSON_MAX_DEPTH) {
+                        return NULL;
+                    }
+                    stack[depth++] = (char)(c+2); // '{'+2 == '}', '['+2 == ']'
+                } else if (c == '}' || c == ']') {
+                    if (depth == 0 || stack[--depth] != (char)c) {
+                        return NULL;
+                    }
+
+                    if (depth == 0) {
+                        return p+1;
+                    }
+                }
+
+                p++;
+            }
+            return NULL;
+        }
+        case 't':
+            *type = FHS_JSON_TRUE;
+            return (end-p >= 4 && memcmp(p, "true", 4) == 0)?p+4:NULL;
+        case 'f':
+            *type = FHS_JSON_FALSE;
+            return (end-p >= 5 && memcmp(p, "false", 5) == 0)?p+5:NULL;
+        case 'n':
+            *type = FHS_JSON_NULL;
+            return (end-p >= 4 && memcmp(p, "null", 4) == 0)?p+4:NULL;
+        default: {
+            const uint8_t *start = p;
+            *type = FHS_JSON_NUMBER;
+
+            while (p < end && ((*p >= '0' && *p <= '9') || *p == '-' || *p == '+' || *p == '.' || *p == 'e' || *p == 'E')) {
+                p++;
+            }
+            return (p > start)?p:NULL;
+        }
+    }
+}
+
+int fhs_json_index(const uint8_t *data, size_t length, fhs_json_member *members, size_t capacity, size_t *count, fhs_json_type *type) {
+    fhs_json_parser parser = {.start = data, .p = data, .end = data+length};
+    size_t n = 0;
+
+    if (length > UINT32_MAX) {
+        return -1;
+    }
+
+    fhs_json_skip_whitespace(&parser);
+
+    if (parser.p == parser.end || (*parser.p != '{' && *parser.p != '[')) {
+        return -1;
+    }
+
+    int isObject = (*parser.p == '{');
+    uint8_t close = isObject?'}':']';
+    parser.p++;
+    fhs_json_skip_whitespace(&parser);
+
+    if (parser.p < parser.end && *parser.p == close) {
+        parser.p++;
+    } else {
+        while (1) {
+            fhs_json_member member = {0};
+            int escaped = 0;
+
+            if (isObject) {
+                if (parser.p == parser.end || *parser.p != '"') {
+                    return -1;
+                }
+
+                const uint8_t *keyEnd = fhs_json_skip_string(parser.p+1, parser.end, &escaped);
+
+                if (!keyEnd || keyEnd-parser.p-2 > UINT16_MAX) {
+                    return -1;
+                }
+
+                member.keyOffset = (uint32_t)(parser.p+1-data);
+                member.keyLength = (uint16_t)(keyEnd-parser.p-2);
+                member.flags = escaped?FHS_JSON_KEY_ESCAPED:0;
+                parser.p = keyEnd;
+                fhs_json_skip_whitespace(&parser);
+
+                if (parser.p == parser.end || *parser.p != ':') {
+                    return -1;
+                }
+
+                parser.p++;
+                fhs_json_skip_whitespace(&parser);
+            }
+
+            if (parser.p == parser.end) {
+                return -1;
+            }
+
+            escaped = 0;
+            const uint8_t *valueEnd = fhs_json_skip_value(parser.p, parser.end, &member.type, &escaped);
+
+            if (!valueEnd) {
+                return -1;
+            }
+
+            member.valueOffset = (uint32_t)(parser.p-data);
+            member.valueLength = (uint32_t)(valueEnd-parser.p);
+            member.flags |= escaped?FHS_JSON_VALUE_ESCAPED:0;
+
+            if (n < capacity) {
+                members[n] = member;
+            }
+
+            n++;
+            parser.p = valueEnd;
+            fhs_json_skip_whitespace(&parser);
+
+            if (parser.p == parser.end) {
+                return -1;
+            } else if (*parser.p == ',') {
+                parser.p++;
+                fhs_json_skip_whitespace(&parser);
+            } else if (*parser.p == close) {
+                parser.p++;
+                break;
+            } else {
+                return -1;
+            }
+        }
+    }
+
+    fhs_json_skip_whitespace(&parser);
+
+    if (parser.p != parser.end) {
+        return -1;
+    }
+
+    *count = n;
+
+    if (type) {
+        *type = isObject?FHS_JSON_OBJECT:FHS_JSON_ARRAY;
+    }
+
+    return 0;
+}
+
+const fhs_json_member *fhs_json_find(const uint8_t *data, const fhs_json_member *members, size_t count, const char *key, size_t keyLength) {
+    for (size_t i = 0; i < count; i++) {
+        if (members[i].keyLength == keyLength && memcmp(data+members[i].keyOffset, key, keyLength) == 0) {
+            return &members[i];
+        }
+    }
+    return NULL;
+}
+
+int fhs_json_read_uint64(const uint8_t *value, size_t length, uint64_t *result) {
+    if (length >= 2 && value[0] == '"' && value[length-1] == '"') {
+        value++;
+        length -= 2;
+    }
+
+    if (length == 0 || length > 20) {
+        return -1;
+    }
+
+    uint64_t v = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint64_t digit = value[i]-'0';
+
+        if (digit > 9 || v > (UINT64_MAX-digit)/10) {
+            return -1;
+        }
+
+        v = v*10+digit;
+    }
+
+    *result = v;
+    return 0;
+}
+
+int fhs_json_read_int64(const uint8_t *value, size_t length, int64_t *result) {
+    uint64_t magnitude;
+
+    if (length > 0 && value[0] == '-') {
+        if (fhs_json_read_uint64(value+1, length-1, &magnitude) != 0 || magnitude > (uint64_t)INT64_MAX+1) {
+            return -1;
+        }
+        *result = (int64_t)(0-magnitude);
+        return 0;
+    }
+
+    if (length > 0 && value[0] == '"') {
+        return -1;
+    }
+
+    if (fhs_json_read_uint64(value, length, &magnitude) != 0 || magnitude > (uint64_t)INT64_MAX) {
+        return -1;
+    }
+
+    *result = (int64_t)magnitude;
+    return 0;
+}
+
+int fhs_json_read_double(const uint8_t *value, size_t length, double *result) {
+    char buffer[64];
+
+    if (length == 0 || length >= sizeof(buffer) || !((value[0] >= '0' && value[0] <= '9') || value[0] == '-')) {
+        return -1;
+    }
+
+    memcpy(buffer, value, length);
+    buffer[length] = '\0';
+
+    char *end;
+    *result = strtod(buffer, &end);
+    return (end == buffer+length)?0:-1;
+}
@@ -0,0 +1,139 @@
+//
+//  FHSJSON.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Single-pass, event-based JSON (RFC 8259) parser. Strings come back
+//  unescaped as UTF-8 and numbers already converted, so callers can build
+//  their own values directly without an intermediate tree. Objects and arrays
+//  can also be indexed in one scan and read lazily.
+//
+
+#ifndef FHSJSON_H
+#define FHSJSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Maximum nesting depth. A container past it fails the parse before its begin callback, so handlers can keep a frame per open container in a fixed array.
+ */
+#define FHS_JSON_MAX_DEPTH 512
+
+/**
+ Parse events. Each callback returns 0 to continue or nonzero to stop the parse.
+ String and key bytes are only valid for the duration of the call. Any callback may be NULL.
+ */
+typedef struct {
+    int (*begin_object)(void *context);
+    int (*end_object)(void *context);
+    int (*begin_array)(void *context);
+    int (*end_array)(void *context);
+    int (*key)(void *context, const char *bytes, size_t length);
+    int (*string)(void *context, const char *bytes, size_t length);
+    int (*integer)(void *context, int64_t value);
+    int (*unsigned_integer)(void *context, uint64_t value); // only for values over INT64_MAX
+    int (*real)(void *context, double value);
+    int (*boolean)(void *context, int value);
+    int (*null)(void *context);
+} fhs_json_callbacks;
+
+/**
+ Parse error.
+ */
+typedef struct {
+    size_t offset;
+    const char *message;
+} fhs_json_error;
+
+/**
+ Parse a JSON text.
+ @param data JSON text, UTF-8.
+ @param length Length of the text.
+ @param callbacks Event callbacks.
+ @param context Passed to the callbacks.
+ @param error Set on failure, may be NULL.
+ @return 0 on success, -1 on a syntax error or if a callback stopped the parse.
+ */
+int fhs_json_parse(const uint8_t *data, size_t length, const fhs_json_callbacks *callbacks, void *context, fhs_json_error *error);
+
+/**
+ Value types in an index.
+ */
+typedef enum {
+    FHS_JSON_STRING = 1,
+    FHS_JSON_NUMBER,
+    FHS_JSON_OBJECT,
+    FHS_JSON_ARRAY,
+    FHS_JSON_TRUE,
+    FHS_JSON_FALSE,
+    FHS_JSON_NULL
+} fhs_json_type;
+
+/**
+ Index flags.
+ */
+#define FHS_JSON_KEY_ESCAPED 0x1
+#define FHS_JSON_VALUE_ESCAPED 0x2
+
+/**
+ One member of an object or element of an array. Offsets are relative to the
+ indexed buffer; the key excludes its quotes, the value span includes them.
+ Array elements have no key.
+ */
+typedef struct {
+    uint32_t keyOffset;
+    uint32_t valueOffset;
+    uint32_t valueLength;
+    uint16_t keyLength;
+    uint8_t type;
+    uint8_t flags;
+} fhs_json_member;
+
+/**
+ Index the top-level members of an object, or the elements of an array, in one scan.
+ Nested containers are skipped by matching brackets and are not validated until they are indexed themselves.
+ @param data JSON text holding exactly one object or array, at most 4 GB.
+ @param length Length of the text.
+ @param members Output, may be NULL if capacity is 0.
+ @param capacity Number of members that fit in the output.
+ @param count Set to the total number of members, which may exceed capacity. Call again with a larger buffer in that case.
+ @param type Set to FHS_JSON_OBJECT or FHS_JSON_ARRAY, may be NULL.
+ @return 0 on success, -1 if the text is not a well-formed object or array.
+ */
+int fhs_json_index(const uint8_t *data, size_t length, fhs_json_member *members, size_t capacity, size_t *count, fhs_json_type *type);
+
+/**
+ Find an object member by key. Keys are compared as raw bytes, so escaped keys only match their escaped form.
+ @return The member, or NULL.
+ */
+const fhs_json_member *fhs_json_find(const uint8_t *data, const fhs_json_member *members, size_t count, const char *key, size_t keyLength);
+
+/**
+ Read an unsigned integer from a number, or from a string holding only digits (as Twitter's id_str fields do).
+ @return 0 on success, -1 if the value isn't an unsigned integer or overflows.
+ */
+int fhs_json_read_uint64(const uint8_t *value, size_t length, uint64_t *result);
+
+/**
+ Read a signed integer from a number.
+ @return 0 on success, -1 if the value isn't an integer or overflows.
+ */
+int fhs_json_read_int64(const uint8_t *value, size_t length, int64_t *result);
+
+/**
+ Read a number as a double.
+ @return 0 on success, -1 if the value isn't a number.
+ */
+int fhs_json_read_double(const uint8_t *value, size_t length, double *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
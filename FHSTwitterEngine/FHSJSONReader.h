@@ -0,0 +1,41 @@
+//
+//  FHSJSONReader.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ JSON reader that replaces nulls while parsing.
+ Each container is built once, directly from the parsed values, so there is
+ no second pass over the result as with removeNull.
+ */
+@interface FHSJSONReader : NSObject
+
+/**
+ Reader with the defaults: mutable containers, nulls replaced by an empty string.
+ @return A reader instance.
+ */
++ (FHSJSONReader *)reader;
+
+/**
+ Object used in place of null, including a null document. Defaults to @"". Set to nil to keep NSNull.
+ */
+@property (nonatomic, strong) id nullPlaceholder;
+
+/**
+ Whether arrays and dictionaries are mutable. Defaults to YES.
+ */
+@property (nonatomic, assign) BOOL mutableContainers;
+
+/**
+ Parse JSON data. Safe to call from several threads at once.
+ @param data UTF-8 JSON data.
+ @param error Set on failure, may be NULL. Uses the NSJSONSerialization error domain and code.
+ @return Parsed object, or nil on failure.
+ */
+- (id)objectWithData:(NSData *)data error:(NSError **)error;
+
+@end
@@ -0,0 +1,259 @@
+//
+//  FHSJSONReader.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSJSONReader.h"
+
+#include "FHSJSON.h"
+
+// Twitter repeats the same few dozen keys in every object, so short keys
+// are interned per parse instead of allocating a new string each time.
+#define FHS_JSON_KEY_CACHE_SIZE 256
+#define FHS_JSON_KEY_CACHE_LENGTH 32
+
+typedef struct {
+    uint32_t hash;
+    uint32_t length;
+    char bytes[FHS_JSON_KEY_CACHE_LENGTH];
+    __unsafe_unretained NSString *string; // retained by the key pool
+} fhs_json_cached_key;
+
+//
+// Builder: parsed values are pushed on a stack, and a closing bracket turns
+// the values since the matching opening bracket into one container.
+//
+
+@interface FHSJSONBuilder : NSObject {
+    @package
+    NSMutableArray *_values;
+    NSUInteger _frames[FHS_JSON_MAX_DEPTH];
+    NSUInteger _depth;
+    id _nullPlaceholder;
+    BOOL _mutable;
+    __unsafe_unretained id *_buffer;
+    NSUInteger _bufferCapacity;
+    fhs_json_cached_key _keyCache[FHS_JSON_KEY_CACHE_SIZE];
+    NSMutableArray *_keyPool;
+    BOOL _invalidString;
+}
+
+@end
+
+@implementation FHSJSONBuilder
+
+- (instancetype)initWithNullPlaceholder:(id)nullPlaceholder mutable:(BOOL)mutable {
+    self = [super init];
+    if (self) {
+        _values = [[NSMutableArray alloc]init];
+        _keyPool = [[NSMutableArray alloc]init];
+        _nullPlaceholder = nullPlaceholder?:[NSNull null];
+        _mutable = mutable;
+    }
+    return self;
+}
+
+- (void)dealloc {
+    free(_buffer);
+}
+
+- (BOOL)reserveBuffer:(NSUInteger)count {
+    if (count > _bufferCapacity) {
+        NSUInteger capacity = MAX(count, _bufferCapacity*2);
+        __unsafe_unretained id *buffer = (__unsafe_unretained id *)realloc(_buffer, capacity*sizeof(id));
+
+        if (!buffer) {
+            return NO;
+        }
+
+        _buffer = buffer;
+        _bufferCapacity = capacity;
+    }
+    return YES;
+}
+
+- (NSString *)keyWithBytes:(const char *)bytes length:(size_t)length {
+    if (length > FHS_JSON_KEY_CACHE_LENGTH) {
+        return [[NSString alloc]initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+    }
+
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)bytes[i])*16777619u;
+    }
+
+    fhs_json_cached_key *entry = &_keyCache[hash % FHS_JSON_KEY_CACHE_SIZE];
+
+    if (entry->string && entry->hash == hash && entry->length == length && memcmp(entry->bytes, bytes, length) == 0) {
+        return entry->string;
+    }
+
+    NSString *key = [[NSString alloc]initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+
+    if (key) {
+        [_keyPool addObject:key];
+        entry->hash = hash;
+        entry->length = (uint32_t)length;
+        memcpy(entry->bytes, bytes, length);
+        entry->string = key;
+    }
+
+    return key;
+}
+
+static int fhs_json_begin(void *context) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    builder->_frames[builder->_depth++] = builder->_values.count;
+    return 0;
+}
+
+static int fhs_json_end_object(void *context) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    NSUInteger start = builder->_frames[--builder->_depth];
+    NSRange range = NSMakeRange(start, builder->_values.count-start);
+    NSUInteger count = range.length/2;
+
+    if (![builder reserveBuffer:range.length*2]) {
+        return -1;
+    }
+
+    // Keys and values are interleaved on the stack
+    __unsafe_unretained id *pairs = builder->_buffer;
+    __unsafe_unretained id *keys = pairs+range.length;
+    __unsafe_unretained id *objects = keys+count;
+    [builder->_values getObjects:pairs range:range];
+
+    for (NSUInteger i = 0; i < count; i++) {
+        keys[i] = pairs[2*i];
+        objects[i] = pairs[2*i+1];
+    }
+
+    NSDictionary *dictionary = builder->_mutable?[[NSMutableDictionary alloc]initWithObjects:objects forKeys:keys count:count]:[[NSDictionary alloc]initWithObjects:objects forKeys:keys count:count];
+    [builder->_values removeObjectsInRange:range];
+    [builder->_values addObject:dictionary];
+    return 0;
+}
+
+static int fhs_json_end_array(void *context) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    NSUInteger start = builder->_frames[--builder->_depth];
+    NSRange range = NSMakeRange(start, builder->_values.count-start);
+
+    if (![builder reserveBuffer:range.length]) {
+        return -1;
+    }
+
+    [builder->_values getObjects:builder->_buffer range:range];
+    NSArray *array = builder->_mutable?[[NSMutableArray alloc]initWithObjects:builder->_buffer count:range.length]:[[NSArray alloc]initWithObjects:builder->_buffer count:range.length];
+    [builder->_values removeObjectsInRange:range];
+    [builder->_values addObject:array];
+    return 0;
+}
+
+static int fhs_json_key(void *context, const char *bytes, size_t length) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    NSString *key = [builder keyWithBytes:bytes length:length];
+
+    if (!key) {
+        builder->_invalidString = YES;
+        return -1;
+    }
+
+    [builder->_values addObject:key];
+    return 0;
+}
+
+static int fhs_json_string(void *context, const char *bytes, size_t length) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    NSString *string = [[NSString alloc]initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+
+    if (!string) {
+        builder->_invalidString = YES;
+        return -1;
+    }
+
+    [builder->_values addObject:string];
+    return 0;
+}
+
+static int fhs_json_integer(void *context, int64_t value) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    [builder->_values addObject:[[NSNumber alloc]initWithLongLong:value]];
+    return 0;
+}
+
+static int fhs_json_unsigned_integer(void *context, uint64_t value) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    [builder->_values addObject:[[NSNumber alloc]initWithUnsignedLongLong:value]];
+    return 0;
+}
+
+static int fhs_json_real(void *context, double value) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    [builder->_values addObject:[[NSNumber alloc]initWithDouble:value]];
+    return 0;
+}
+
+static int fhs_json_boolean(void *context, int value) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    [builder->_values addObject:value?@YES:@NO];
+    return 0;
+}
+
+static int fhs_json_null(void *context) {
+    FHSJSONBuilder *builder = (__bridge FHSJSONBuilder *)context;
+    [builder->_values addObject:builder->_nullPlaceholder];
+    return 0;
+}
+
+static const fhs_json_callbacks fhs_json_builder_callbacks = {
+    .begin_object = fhs_json_begin,
+    .end_object = fhs_json_end_object,
+    .begin_array = fhs_json_begin,
+    .end_array = fhs_json_end_array,
+    .key = fhs_json_key,
+    .string = fhs_json_string,
+    .integer = fhs_json_integer,
+    .unsigned_integer = fhs_json_unsigned_integer,
+    .real = fhs_json_real,
+    .boolean = fhs_json_boolean,
+    .null = fhs_json_null
+};
+
+@end
+
+@implementation FHSJSONReader
+
++ (FHSJSONReader *)reader {
+    return [[[self class]alloc]init];
+}
+
+- (instancetype)init {
+    self = [super init];
+    if (self) {
+        self.nullPlaceholder = @"";
+        self.mutableContainers = YES;
+    }
+    return self;
+}
+
+- (id)objectWithData:(NSData *)data error:(NSError **)error {
+    FHSJSONBuilder *builder = [[FHSJSONBuilder alloc]initWithNullPlaceholder:_nullPlaceholder mutable:_mutableContainers];
+    fhs_json_error parseError = {0, "No data"};
+
+    if (data.length > 0 && fhs_json_parse(data.bytes, data.length, &fhs_json_builder_callbacks, (__bridge void *)builder, &parseError) == 0) {
+        return builder->_values.lastObject;
+    }
+
+    if (error) {
+        NSString *message = builder->_invalidString?@"Invalid UTF-8 in string":@(parseError.message);
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSPropertyListReadCorruptError userInfo:@{NSLocalizedDescriptionKey: [NSString stringWithFormat:@"%@ at offset %lu.", message, (unsigned long)parseError.offset], @"NSJSONSerializationErrorIndex": @(parseError.offset)}];
+    }
+
+    return nil;
+}
+
+@end
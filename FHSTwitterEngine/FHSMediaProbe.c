@@ -0,0 +1,493 @@
+//
+//  FHSMediaProbe.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSMediaProbe.h"
+
+#include <string.h>
+
+const fhs_media_limits fhs_media_default_limits = {
+    .imageBytes = 5*1024*1024,
+    .gifBytes = 15*1024*1024,
+    .videoBytes = 512*1024*1024,
+    .minDimension = 4,
+    .maxImageDimension = 8192,
+    .maxGIFWidth = 1280,
+    .maxGIFHeight = 1080,
+    .maxGIFFrames = 350,
+    .maxVideoWidth = 1920,
+    .maxVideoHeight = 1200,
+    .minVideoDuration = 0.5,
+    .maxVideoDuration = 140.0
+};
+
+static inline uint16_t fhs_be16(const uint8_t *p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static inline uint32_t fhs_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+static inline uint64_t fhs_be64(const uint8_t *p) {
+    return ((uint64_t)fhs_be32(p) << 32) | fhs_be32(p+4);
+}
+
+static inline uint16_t fhs_le16(const uint8_t *p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static inline uint32_t fhs_le24(const uint8_t *p) {
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+static inline uint32_t fhs_le32(const uint8_t *p) {
+    return fhs_le24(p) | ((uint32_t)p[3] << 24);
+}
+
+//
+// JPEG: walk the markers up to the first start-of-frame
+//
+
+static int fhs_probe_jpeg(const uint8_t *p, size_t length, fhs_media_info *info) {
+    size_t i = 2;
+
+    while (i+4 <= length) {
+        if (p[i] != 0xFF) {
+            return -1;
+        }
+
+        uint8_t marker = p[i+1];
+
+        if (marker == 0xFF) { // fill byte
+            i++;
+            continue;
+        }
+
+        if (marker == 0xD8 || marker == 0x01 || (marker >= 0xD0 && marker <= 0xD7)) { // no length
+            i += 2;
+            continue;
+        }
+
+        uint16_t segmentLength = fhs_be16(p+i+2);
+
+        if (segmentLength < 2) {
+            return -1;
+        }
+
+        // SOF0..SOF15, except DHT (C4), JPG (C8) and DAC (CC)
+        if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) {
+            if (i+9 > length) {
+                return -1;
+            }
+            info->height = fhs_be16(p+i+5);
+            info->width = fhs_be16(p+i+7);
+            info->frames = 1;
+            return 0;
+        }
+
+        if (marker == 0xDA || marker == 0xD9) { // scan data or end before a frame header
+            return -1;
+        }
+
+        i += 2+segmentLength;
+    }
+
+    return -1;
+}
+
+//
+// PNG: IHDR, plus acTL for animated PNG
+//
+
+static int fhs_probe_png(const uint8_t *p, size_t length, fhs_media_info *info) {
+    if (length < 33 || memcmp(p+12, "IHDR", 4) != 0) {
+        return -1;
+    }
+
+    info->width = fhs_be32(p+16);
+    info->height = fhs_be32(p+20);
+    info->frames = 1;
+
+    // acTL has to come before the first IDAT
+    size_t i = 33;
+    while (i+12 <= length) {
+        uint32_t chunkLength = fhs_be32(p+i);
+        const uint8_t *type = p+i+4;
+
+        if (memcmp(type, "acTL", 4) == 0 && chunkLength >= 8 && i+16 <= length) {
+            info->frames = fhs_be32(p+i+8);
+            break;
+        }
+
+        if (memcmp(type, "IDAT", 4) == 0 || memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+
+        if (chunkLength > length-i-12) {
+            break;
+        }
+
+        i += 12+(size_t)chunkLength;
+    }
+
+    return 0;
+}
+
+//
+// GIF: count image descriptors, skipping extensions and image data sub-blocks
+//
+
+static size_t fhs_gif_skip_sub_blocks(const uint8_t *p, size_t length, size_t i) {
+    while (i < length) {
+        uint8_t size = p[i];
+        if (size == 0) {
+            return i+1;
+        }
+        i += 1+(size_t)size;
+    }
+    return 0; // truncated
+}
+
+static int fhs_probe_gif(const uint8_t *p, size_t length, fhs_media_info *info) {
+    if (length < 13) {
+        return -1;
+    }
+
+    info->width = fhs_le16(p+6);
+    info->height = fhs_le16(p+8);
+    info->frames = 0;
+
+    size_t i = 13;
+
+    if (p[10] & 0x80) { // global color table
+        i += 3*((size_t)1 << ((p[10] & 0x07)+1));
+    }
+
+    while (i < length) {
+        uint8_t block = p[i];
+
+        if (block == 0x3B) { // trailer
+            return 0;
+        } else if (block == 0x21) { // extension
+            if (i+2 > length) {
+                break;
+            }
+            i = fhs_gif_skip_sub_blocks(p, length, i+2);
+        } else if (block == 0x2C) { // image descriptor
+            if (i+10 > length) {
+                break;
+            }
+            uint8_t flags = p[i+9];
+            i += 10;
+            if (flags & 0x80) { // local color table
+                i += 3*((size_t)1 << ((flags & 0x07)+1));
+            }
+            i = fhs_gif_skip_sub_blocks(p, length, i+1); // after the LZW minimum code size
+            info->frames++;
+        } else {
+            return -1;
+        }
+
+        if (i == 0) {
+            break;
+        }
+    }
+
+    // Missing trailer, count what was there
+    return (info->frames > 0)?0:-1;
+}
+
+//
+// WebP: VP8, VP8L or VP8X, counting ANMF chunks when animated
+//
+
+static int fhs_probe_webp(const uint8_t *p, size_t length, fhs_media_info *info) {
+    size_t end = 8+(size_t)fhs_le32(p+4);
+    if (end > length) {
+        end = length;
+    }
+
+    size_t i = 12;
+    int extended = 0;
+    info->frames = 0;
+
+    while (i+8 <= end) {
+        const uint8_t *type = p+i;
+        uint32_t chunkLength = fhs_le32(p+i+4);
+        const uint8_t *chunk = p+i+8;
+        size_t available = end-i-8;
+
+        if (memcmp(type, "VP8X", 4) == 0) {
+            if (available < 10) {
+                return -1;
+            }
+            info->width = fhs_le24(chunk+4)+1;
+            info->height = fhs_le24(chunk+7)+1;
+            extended = 1;
+        } else if (memcmp(type, "ANMF", 4) == 0) {
+            info->frames++;
+        } else if (memcmp(type, "VP8 ", 4) == 0) {
+            if (available < 10 || chunk[3] != 0x9D || chunk[4] != 0x01 || chunk[5] != 0x2A) {
+                return -1;
+            }
+            if (!extended) {
+                info->width = fhs_le16(chunk+6) & 0x3FFF;
+                info->height = fhs_le16(chunk+8) & 0x3FFF;
+                info->frames = 1;
+                return 0;
+            }
+        } else if (memcmp(type, "VP8L", 4) == 0) {
+            if (available < 5 || chunk[0] != 0x2F) {
+                return -1;
+            }
+            if (!extended) {
+                uint32_t bits = fhs_le32(chunk+1);
+                info->width = (bits & 0x3FFF)+1;
+                info->height = ((bits >> 14) & 0x3FFF)+1;
+                info->frames = 1;
+                return 0;
+            }
+        }
+
+        // Chunks are padded to an even length
+        size_t step = 8+(size_t)chunkLength+(chunkLength & 1);
+        if (step > end-i) {
+            break;
+        }
+        i += step;
+    }
+
+    if (!extended) {
+        return -1;
+    }
+
+    if (info->frames == 0) {
+        info->frames = 1;
+    }
+    return 0;
+}
+
+//
+// MP4: moov/mvhd for the duration, then the first track with a picture size
+// for dimensions (tkhd) and frame count (stsz)
+//
+
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    const uint8_t *type;
+} fhs_mp4_box;
+
+// Next box in [p, end), 0 when there is none
+static int fhs_mp4_next_box(const uint8_t **p, const uint8_t *end, fhs_mp4_box *box) {
+    if (end-*p < 8) {
+        return 0;
+    }
+
+    uint64_t size = fhs_be32(*p);
+    size_t header = 8;
+
+    if (size == 1) {
+        if (end-*p < 16) {
+            return 0;
+        }
+        size = fhs_be64(*p+8);
+        header = 16;
+    } else if (size == 0) {
+        size = (uint64_t)(end-*p);
+    }
+
+    if (size < header) {
+        return 0;
+    }
+
+    box->type = *p+4;
+    box->data = *p+header;
+    box->length = (size > (uint64_t)(end-*p))?(size_t)(end-*p)-header:(size_t)size-header; // box may run past a truncated buffer
+
+    *p = box->data+box->length;
+    return 1;
+}
+
+static int fhs_mp4_find_box(const uint8_t *p, size_t length, const char *type, fhs_mp4_box *box) {
+    const uint8_t *end = p+length;
+    while (fhs_mp4_next_box(&p, end, box)) {
+        if (memcmp(box->type, type, 4) == 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static int fhs_mp4_find_path(const uint8_t *p, size_t length, const char *const *path, fhs_mp4_box *box) {
+    for (; *path; path++) {
+        if (!fhs_mp4_find_box(p, length, *path, box)) {
+            return 0;
+        }
+        p = box->data;
+        length = box->length;
+    }
+    return 1;
+}
+
+static int fhs_probe_mp4(const uint8_t *p, size_t length, fhs_media_info *info) {
+    fhs_mp4_box moov, box;
+
+    if (!fhs_mp4_find_box(p, length, "moov", &moov)) {
+        return -1;
+    }
+
+    if (fhs_mp4_find_box(moov.data, moov.length, "mvhd", &box) && box.length >= 20) {
+        if (box.data[0] == 1 && box.length >= 32) {
+            uint32_t timescale = fhs_be32(box.data+20);
+            info->duration = timescale?(double)fhs_be64(box.data+24)/timescale:0;
+        } else {
+            uint32_t timescale = fhs_be32(box.data+12);
+            info->duration = timescale?(double)fhs_be32(box.data+16)/timescale:0;
+        }
+    }
+
+    const uint8_t *cursor = moov.data;
+    const uint8_t *end = moov.data+moov.length;
+    fhs_mp4_box trak;
+
+    while (fhs_mp4_next_box(&cursor, end, &trak)) {
+        if (memcmp(trak.type, "trak", 4) != 0 || !fhs_mp4_find_box(trak.data, trak.length, "tkhd", &box) || box.length == 0) {
+            continue;
+        }
+
+        // Width and height are 16.16 fixed point, the last two fields of tkhd
+        size_t sizeOffset = (box.data[0] == 1)?88:76;
+        if (box.length < sizeOffset+8) {
+            continue;
+        }
+
+        uint32_t width = fhs_be32(box.data+sizeOffset) >> 16;
+        uint32_t height = fhs_be32(box.data+sizeOffset+4) >> 16;
+
+        if (width == 0 || height == 0) {
+            continue; // audio
+        }
+
+        info->width = width;
+        info->height = height;
+
+        static const char *const stsz[] = {"mdia", "minf", "stbl", "stsz", NULL};
+        if (fhs_mp4_find_path(trak.data, trak.length, stsz, &box) && box.length >= 12) {
+            info->frames = fhs_be32(box.data+8);
+        }
+        return 0;
+    }
+
+    return -1;
+}
+
+int fhs_media_probe(const uint8_t *data, size_t length, fhs_media_info *info) {
+    memset(info, 0, sizeof(fhs_media_info));
+
+    if (!data || length < 12) {
+        return -1;
+    }
+
+    int result = -1;
+
+    if (data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+        info->format = FHSMediaFormatJPEG;
+        result = fhs_probe_jpeg(data, length, info);
+    } else if (memcmp(data, "\x89PNG\r\n\x1A\n", 8) == 0) {
+        info->format = FHSMediaFormatPNG;
+        result = fhs_probe_png(data, length, info);
+    } else if (memcmp(data, "GIF87a", 6) == 0 || memcmp(data, "GIF89a", 6) == 0) {
+        info->format = FHSMediaFormatGIF;
+        result = fhs_probe_gif(data, length, info);
+    } else if (memcmp(data, "RIFF", 4) == 0 && memcmp(data+8, "WEBP", 4) == 0) {
+        info->format = FHSMediaFormatWebP;
+        result = fhs_probe_webp(data, length, info);
+    } else if (memcmp(data+4, "ftyp", 4) == 0) {
+        info->format = FHSMediaFormatMP4;
+        result = fhs_probe_mp4(data, length, info);
+    }
+
+    if (result != 0) {
+        memset(info, 0, sizeof(fhs_media_info));
+    }
+
+    return result;
+}
+
+FHSMediaValidity fhs_media_validate(const fhs_media_info *info, uint64_t byteSize, const fhs_media_limits *limits) {
+    uint64_t maxBytes = 0;
+    uint32_t maxWidth = 0, maxHeight = 0;
+
+    switch (info->format) {
+        case FHSMediaFormatJPEG:
+        case FHSMediaFormatPNG:
+        case FHSMediaFormatWebP:
+            maxBytes = limits->imageBytes;
+            maxWidth = maxHeight = limits->maxImageDimension;
+            break;
+        case FHSMediaFormatGIF:
+            maxBytes = limits->gifBytes;
+            maxWidth = limits->maxGIFWidth;
+            maxHeight = limits->maxGIFHeight;
+            break;
+        case FHSMediaFormatMP4:
+            maxBytes = limits->videoBytes;
+            maxWidth = limits->maxVideoWidth;
+            maxHeight = limits->maxVideoHeight;
+            break;
+        default:
+            return FHSMediaUnsupported;
+    }
+
+    if (maxBytes && byteSize > maxBytes) {
+        return FHSMediaTooLarge;
+    }
+
+    if (info->width < limits->minDimension || info->height < limits->minDimension) {
+        return FHSMediaBadDimensions;
+    }
+
+    if ((maxWidth && info->width > maxWidth) || (maxHeight && info->height > maxHeight)) {
+        return FHSMediaBadDimensions;
+    }
+
+    if (info->format == FHSMediaFormatGIF && limits->maxGIFFrames && info->frames > limits->maxGIFFrames) {
+        return FHSMediaTooManyFrames;
+    }
+
+    if (info->format == FHSMediaFormatMP4) {
+        if ((limits->minVideoDuration > 0 && info->duration < limits->minVideoDuration) ||
+            (limits->maxVideoDuration > 0 && info->duration > limits->maxVideoDuration)) {
+            return FHSMediaBadDuration;
+        }
+    }
+
+    return FHSMediaValid;
+}
+
+const char *fhs_media_format_extension(FHSMediaFormat format) {
+    switch (format) {
+        case FHSMediaFormatJPEG: return "jpeg";
+        case FHSMediaFormatPNG: return "png";
+        case FHSMediaFormatGIF: return "gif";
+        case FHSMediaFormatWebP: return "webp";
+        case FHSMediaFormatMP4: return "mp4";
+        default: return NULL;
+    }
+}
+
+const char *fhs_media_format_mime_type(FHSMediaFormat format) {
+    switch (format) {
+        case FHSMediaFormatJPEG: return "image/jpeg";
+        case FHSMediaFormatPNG: return "image/png";
+        case FHSMediaFormatGIF: return "image/gif";
+        case FHSMediaFormatWebP: return "image/webp";
+        case FHSMediaFormatMP4: return "video/mp4";
+        default: return NULL;
+    }
+}
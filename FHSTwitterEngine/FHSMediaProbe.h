@@ -0,0 +1,102 @@
+//
+//  FHSMediaProbe.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Reads format, dimensions and frame count from JPEG, PNG, GIF, WebP and MP4
+//  container headers without decoding any pixels.
+//
+
+#ifndef FHSMEDIAPROBE_H
+#define FHSMEDIAPROBE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    FHSMediaFormatUnknown = 0,
+    FHSMediaFormatJPEG,
+    FHSMediaFormatPNG,
+    FHSMediaFormatGIF,
+    FHSMediaFormatWebP,
+    FHSMediaFormatMP4
+} FHSMediaFormat;
+
+typedef struct {
+    FHSMediaFormat format;
+    uint32_t width;
+    uint32_t height;
+    uint32_t frames;   // 1 for still images, 0 if the container doesn't say
+    double duration;   // seconds, MP4 only
+} fhs_media_info;
+
+typedef enum {
+    FHSMediaValid = 0,
+    FHSMediaUnsupported,    // unknown or truncated container
+    FHSMediaTooLarge,       // byte size over the limit
+    FHSMediaBadDimensions,  // too small or too large
+    FHSMediaTooManyFrames,
+    FHSMediaBadDuration
+} FHSMediaValidity;
+
+/**
+ Upload limits. Zero means no limit.
+ */
+typedef struct {
+    uint64_t imageBytes;
+    uint64_t gifBytes;
+    uint64_t videoBytes;
+    uint32_t minDimension;
+    uint32_t maxImageDimension;
+    uint32_t maxGIFWidth;
+    uint32_t maxGIFHeight;
+    uint32_t maxGIFFrames;
+    uint32_t maxVideoWidth;
+    uint32_t maxVideoHeight;
+    double minVideoDuration;
+    double maxVideoDuration;
+} fhs_media_limits;
+
+/**
+ Limits documented for media/upload.
+ */
+extern const fhs_media_limits fhs_media_default_limits;
+
+/**
+ Probe a media header.
+ @param data Media bytes. Only headers are read, so a memory-mapped file stays mostly untouched.
+ @param length Length of the data.
+ @param info Output.
+ @return 0 on success, -1 if the format is unknown or the header is truncated.
+ */
+int fhs_media_probe(const uint8_t *data, size_t length, fhs_media_info *info);
+
+/**
+ Check probed media against upload limits.
+ @param info Probe result.
+ @param byteSize Media size in bytes.
+ @param limits Limits.
+ @return FHSMediaValid, or the first limit the media breaks.
+ */
+FHSMediaValidity fhs_media_validate(const fhs_media_info *info, uint64_t byteSize, const fhs_media_limits *limits);
+
+/**
+ File extension for a format, e.g. "jpeg", or NULL if unknown.
+ */
+const char *fhs_media_format_extension(FHSMediaFormat format);
+
+/**
+ MIME type for a format, e.g. "image/jpeg", or NULL if unknown.
+ */
+const char *fhs_media_format_mime_type(FHSMediaFormat format);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
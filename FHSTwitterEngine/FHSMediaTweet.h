@@ -0,0 +1,74 @@
+//
+//  FHSMediaTweet.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+#import "FHSMediaUpload.h"
+
+/**
+ Completion block, called on the main queue.
+ @param error Error, nil on success.
+ @param response Posted tweet, nil on failure.
+ */
+typedef void(^FHSMediaTweetCompletionBlock)(NSError *error, id response);
+
+/**
+ Tweet with several media attachments. The media are uploaded concurrently and
+ the status is posted as soon as the last upload finishes, with the media IDs
+ in the order the uploads were given. If one upload fails, the others are
+ cancelled and the tweet is not posted.
+ */
+@interface FHSMediaTweet : NSObject
+
+/**
+ Tweet with media uploads.
+ @param status Tweet text.
+ @param uploads FHSMediaUpload instances, in display order. Uploads that already have a media ID are resumed.
+ @return A tweet instance.
+ */
++ (FHSMediaTweet *)tweetWithStatus:(NSString *)status uploads:(NSArray *)uploads;
+
+/**
+ Tweet with in-memory media. Media types are taken from the data headers.
+ @param status Tweet text.
+ @param mediaData NSData instances, in display order.
+ @return A tweet instance.
+ */
++ (FHSMediaTweet *)tweetWithStatus:(NSString *)status mediaData:(NSArray *)mediaData;
+
+/**
+ Engine used to upload and post. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Tweet id to reply to, or nil.
+ */
+@property (nonatomic, copy) NSString *inReplyToID;
+
+/**
+ Maximum number of uploads in flight. Defaults to 4.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentUploads;
+
+/**
+ Uploads, in display order.
+ */
+@property (nonatomic, copy, readonly) NSArray *uploads;
+
+/**
+ Start the uploads and post the tweet.
+ @param block Block to be called on completion.
+ */
+- (void)startWithCompletionBlock:(FHSMediaTweetCompletionBlock)block;
+
+/**
+ Cancel the uploads. The completion block is called with a cancellation error, unless the status is already being posted.
+ */
+- (void)cancel;
+
+@end
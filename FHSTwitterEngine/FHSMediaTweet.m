@@ -0,0 +1,177 @@
+//
+//  FHSMediaTweet.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSMediaTweet.h"
+
+static NSUInteger const maxMediaPerTweet = 4;
+
+// All state below is only touched on the main queue, where the upload
+// completion blocks are called.
+
+@interface FHSMediaTweet ()
+
+@property (nonatomic, strong) NSString *status;
+@property (nonatomic, copy, readwrite) NSArray *uploads;
+@property (nonatomic, strong) NSMutableArray *mediaIDs;
+@property (nonatomic, copy) FHSMediaTweetCompletionBlock completionBlock;
+@property (nonatomic, assign) NSUInteger nextUpload;
+@property (nonatomic, assign) NSUInteger finishedUploads;
+@property (nonatomic, assign) BOOL running;
+@property (nonatomic, assign) BOOL posting;
+@property (nonatomic, assign) NSUInteger generation; // ignores late callbacks from a cancelled run
+
+@end
+
+@implementation FHSMediaTweet
+
++ (FHSMediaTweet *)tweetWithStatus:(NSString *)status uploads:(NSArray *)uploads {
+    return [[[self class]alloc]initWithStatus:status uploads:uploads];
+}
+
++ (FHSMediaTweet *)tweetWithStatus:(NSString *)status mediaData:(NSArray *)mediaData {
+    NSMutableArray *uploads = [NSMutableArray arrayWithCapacity:mediaData.count];
+
+    for (NSData *data in mediaData) {
+        [uploads addObject:[FHSMediaUpload uploadWithData:data mediaType:nil]];
+    }
+
+    return [[[self class]alloc]initWithStatus:status uploads:uploads];
+}
+
+- (instancetype)initWithStatus:(NSString *)status uploads:(NSArray *)uploads {
+    self = [super init];
+    if (self) {
+        self.status = status;
+        self.uploads = uploads;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.maxConcurrentUploads = 4;
+    }
+    return self;
+}
+
+- (NSError *)cancelledError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:@{NSLocalizedDescriptionKey: @"The tweet was cancelled."}];
+}
+
+- (void)finishWithError:(NSError *)error response:(id)response {
+    FHSMediaTweetCompletionBlock block = _completionBlock;
+    self.completionBlock = nil;
+    self.running = NO;
+    self.posting = NO;
+    self.generation++;
+
+    if (block) {
+        block(error, response);
+    }
+}
+
+- (void)startNextUpload {
+    NSUInteger index = _nextUpload++;
+    FHSMediaUpload *upload = _uploads[index];
+    NSUInteger generation = _generation;
+    upload.engine = _engine;
+
+    [upload startWithCompletionBlock:^(NSError *error, NSString *mediaID) {
+        if (!self.running || self.posting || self.generation != generation) {
+            return;
+        }
+
+        if (error) {
+            // Fail fast: nothing gets posted, so the other uploads are wasted
+            for (FHSMediaUpload *other in _uploads) {
+                [other cancel];
+            }
+
+            [self finishWithError:error response:nil];
+            return;
+        }
+
+        _mediaIDs[index] = mediaID;
+        self.finishedUploads++;
+
+        if (_finishedUploads == _uploads.count) {
+            [self post];
+        } else if (_nextUpload < _uploads.count) {
+            [self startNextUpload];
+        }
+    }];
+}
+
+- (void)post {
+    self.posting = YES;
+
+    NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:3];
+    params[@"status"] = _status;
+    params[@"media_ids"] = [_mediaIDs componentsJoinedByString:@","];
+
+    if (_inReplyToID.length > 0) {
+        params[@"in_reply_to_status_id"] = _inReplyToID;
+    }
+
+    FHSTwitterEngine *engine = _engine;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = [engine sendRequestForEndpoint:FHSEndpointStatusesUpdate parameters:params];
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if ([response isKindOfClass:[NSError class]]) {
+                    [self finishWithError:response response:nil];
+                } else {
+                    [self finishWithError:nil response:response];
+                }
+            });
+        }
+    });
+}
+
+- (void)startWithCompletionBlock:(FHSMediaTweetCompletionBlock)block {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (self.running) {
+            return;
+        }
+
+        if (_status.length == 0 || _uploads.count == 0 || _uploads.count > maxMediaPerTweet) {
+            if (block) {
+                block([NSError badRequestError], nil);
+            }
+            return;
+        }
+
+        self.running = YES;
+        self.completionBlock = block;
+        self.mediaIDs = [NSMutableArray arrayWithCapacity:_uploads.count];
+        self.nextUpload = 0;
+        self.finishedUploads = 0;
+
+        for (NSUInteger i = 0; i < _uploads.count; i++) {
+            [_mediaIDs addObject:[NSNull null]];
+        }
+
+        NSUInteger concurrent = MIN(MAX(_maxConcurrentUploads, 1), _uploads.count);
+
+        for (NSUInteger i = 0; i < concurrent; i++) {
+            [self startNextUpload];
+        }
+    });
+}
+
+- (void)cancel {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        if (!self.running || self.posting) {
+            return;
+        }
+
+        for (FHSMediaUpload *upload in _uploads) {
+            [upload cancel];
+        }
+
+        [self finishWithError:[self cancelledError] response:nil];
+    });
+}
+
+@end
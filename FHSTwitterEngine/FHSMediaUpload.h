@@ -0,0 +1,101 @@
+//
+//  FHSMediaUpload.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+/**
+ Progress block.
+ @param bytesSent Bytes in acknowledged segments.
+ @param totalBytes Media size.
+ */
+typedef void(^FHSMediaUploadProgressBlock)(int64_t bytesSent, int64_t totalBytes);
+
+/**
+ Completion block, called on the main queue.
+ @param error Error, nil on success.
+ @param mediaID Media ID to attach to a tweet, nil on failure.
+ */
+typedef void(^FHSMediaUploadCompletionBlock)(NSError *error, NSString *mediaID);
+
+/**
+ Chunked media upload (media/upload INIT, APPEND, FINALIZE and STATUS).
+ Segments are streamed from the data or a memory-mapped range of the file, so
+ the media is never copied into request bodies. The media header is checked
+ against the upload limits before INIT. After a failure, starting the
+ upload again resumes it: the media ID and acknowledged segments are kept.
+ */
+@interface FHSMediaUpload : NSObject
+
+/**
+ Upload of a file.
+ @param path File path.
+ @param mediaType MIME type, e.g. video/mp4, or nil to take it from the file header.
+ @return An upload instance.
+ */
++ (FHSMediaUpload *)uploadWithFileAtPath:(NSString *)path mediaType:(NSString *)mediaType;
+
+/**
+ Upload of in-memory data.
+ @param data Media data.
+ @param mediaType MIME type, e.g. image/gif, or nil to take it from the data header.
+ @return An upload instance.
+ */
++ (FHSMediaUpload *)uploadWithData:(NSData *)data mediaType:(NSString *)mediaType;
+
+/**
+ Engine used to sign and send requests. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Media category, e.g. tweet_video or tweet_gif. Required for videos and GIFs over 5 MB.
+ */
+@property (nonatomic, copy) NSString *mediaCategory;
+
+/**
+ Segment size in bytes, at most 5 MB. Defaults to 1 MB.
+ */
+@property (nonatomic, assign) NSUInteger segmentSize;
+
+/**
+ Maximum number of APPEND requests in flight. Defaults to 4.
+ */
+@property (nonatomic, assign) NSUInteger maxConcurrentSegments;
+
+/**
+ Attempts per request before the upload fails. Defaults to 3.
+ */
+@property (nonatomic, assign) NSUInteger maxAttempts;
+
+/**
+ Progress block, called on an arbitrary queue.
+ */
+@property (nonatomic, copy) FHSMediaUploadProgressBlock progressBlock;
+
+/**
+ Media ID, set once INIT has succeeded.
+ */
+@property (nonatomic, copy, readonly) NSString *mediaID;
+
+/**
+ Indexes of the segments Twitter has acknowledged.
+ */
+@property (nonatomic, copy, readonly) NSIndexSet *acknowledgedSegments;
+
+/**
+ Start or resume the upload.
+ @param block Block to be called on completion.
+ */
+- (void)startWithCompletionBlock:(FHSMediaUploadCompletionBlock)block;
+
+/**
+ Cancel the upload. The completion block is called with a cancellation error.
+ */
+- (void)cancel;
+
+@end
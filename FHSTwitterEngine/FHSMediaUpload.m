@@ -0,0 +1,348 @@
+//
+//  FHSMediaUpload.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSMediaUpload.h"
+#import "FHSMultipartBody.h"
+
+#include "FHSMediaProbe.h"
+
+static NSUInteger const maxSegmentSize = 5*1024*1024;
+
+@interface FHSMediaUpload ()
+
+@property (nonatomic, strong) NSString *path;
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong) NSString *mediaType;
+@property (nonatomic, assign) int64_t totalBytes;
+
+@property (nonatomic, copy, readwrite) NSString *mediaID;
+@property (nonatomic, strong) NSMutableIndexSet *acknowledged;
+@property (atomic, strong) NSOperationQueue *queue;
+@property (atomic, assign) BOOL cancelled;
+@property (atomic, assign) BOOL running;
+
+@end
+
+@implementation FHSMediaUpload
+
++ (FHSMediaUpload *)uploadWithFileAtPath:(NSString *)path mediaType:(NSString *)mediaType {
+    return [[[self class]alloc]initWithPath:path data:nil mediaType:mediaType];
+}
+
++ (FHSMediaUpload *)uploadWithData:(NSData *)data mediaType:(NSString *)mediaType {
+    return [[[self class]alloc]initWithPath:nil data:data mediaType:mediaType];
+}
+
+- (instancetype)initWithPath:(NSString *)path data:(NSData *)data mediaType:(NSString *)mediaType {
+    self = [super init];
+    if (self) {
+        self.path = path;
+        self.data = data;
+        self.mediaType = mediaType;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.segmentSize = 1024*1024;
+        self.maxConcurrentSegments = 4;
+        self.maxAttempts = 3;
+        self.acknowledged = [NSMutableIndexSet indexSet];
+    }
+    return self;
+}
+
+- (NSIndexSet *)acknowledgedSegments {
+    @synchronized(_acknowledged) {
+        return [_acknowledged copy];
+    }
+}
+
+- (NSUInteger)segmentCount {
+    return (NSUInteger)((_totalBytes+_segmentSize-1)/_segmentSize);
+}
+
+- (int64_t)acknowledgedBytes {
+    @synchronized(_acknowledged) {
+        int64_t bytes = _acknowledged.count*(int64_t)_segmentSize;
+        NSUInteger last = [self segmentCount]-1;
+        if ([_acknowledged containsIndex:last]) {
+            bytes -= (int64_t)(last+1)*_segmentSize-_totalBytes;
+        }
+        return bytes;
+    }
+}
+
+#pragma mark - Requests
+
+// Retries network failures, 5xx and 429 with exponential backoff
+- (id)sendWithRetry:(id (^)(void))send {
+    id result = nil;
+
+    for (NSUInteger attempt = 0; attempt < MAX(_maxAttempts, 1); attempt++) {
+        if (self.cancelled) {
+            return [self cancelledError];
+        }
+
+        if (attempt > 0) {
+            [NSThread sleepForTimeInterval:(1 << (attempt-1))];
+        }
+
+        result = send();
+
+        if (![result isKindOfClass:[NSError class]]) {
+            return result;
+        }
+
+        NSError *error = result;
+        BOOL transient = ![error.domain isEqualToString:FHSErrorDomain] || error.code >= 500 || error.code == 429;
+
+        if (!transient) {
+            return result;
+        }
+    }
+
+    return result;
+}
+
+- (id)sendCommand:(NSString *)command params:(NSDictionary *)params HTTPMethod:(NSString *)method {
+    NSMutableDictionary *allParams = [NSMutableDictionary dictionaryWithDictionary:params];
+    allParams[@"command"] = command;
+
+    FHSEndpoint endpoint = [method isEqualToString:@"GET"]?FHSEndpointMediaUploadStatus:FHSEndpointMediaUpload;
+
+    return [self sendWithRetry:^id{
+        return [_engine sendRequestForEndpoint:endpoint parameters:allParams];
+    }];
+}
+
+// Multipart body borrowing the segment from the data, or mapping it from the file
+- (id)appendSegment:(NSUInteger)index {
+    int64_t offset = (int64_t)index*_segmentSize;
+    NSUInteger length = (NSUInteger)MIN((int64_t)_segmentSize, _totalBytes-offset);
+
+    FHSMultipartBody *body = [FHSMultipartBody body];
+    [body addString:@"APPEND" forName:@"command"];
+    [body addString:_mediaID forName:@"media_id"];
+    [body addString:@(index).stringValue forName:@"segment_index"];
+
+    if (_data) {
+        NSData *segment = [NSData dataWithBytesNoCopy:(uint8_t *)_data.bytes+offset length:length freeWhenDone:NO];
+        [body addData:segment forName:@"media" fileName:nil contentType:nil];
+    } else {
+        NSError *error = [body addFileAtPath:_path offset:offset length:length forName:@"media" fileName:nil contentType:nil];
+        if (error) {
+            return error;
+        }
+    }
+
+    return [self sendWithRetry:^id{
+        return [_engine sendPOSTRequestForURL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointMediaUpload)->url)] multipartBody:body];
+    }];
+}
+
+#pragma mark - Upload
+
+- (NSError *)cancelledError {
+    return [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorCancelled userInfo:@{NSLocalizedDescriptionKey: @"The upload was cancelled."}];
+}
+
+- (NSError *)sendInit {
+    NSMutableDictionary *params = [NSMutableDictionary dictionary];
+    params[@"total_bytes"] = @(_totalBytes).stringValue;
+    params[@"media_type"] = _mediaType;
+
+    if (_mediaCategory.length > 0) {
+        params[@"media_category"] = _mediaCategory;
+    }
+
+    id json = [self sendCommand:@"INIT" params:params HTTPMethod:@"POST"];
+
+    if ([json isKindOfClass:[NSError class]]) {
+        return json;
+    }
+
+    NSString *mediaID = [json isKindOfClass:[NSDictionary class]]?json[@"media_id_string"]:nil;
+
+    if (mediaID.length == 0) {
+        return [NSError noDataError];
+    }
+
+    self.mediaID = mediaID;
+    return nil;
+}
+
+- (NSError *)sendAppends {
+    __block NSError *failure = nil;
+
+    NSOperationQueue *queue = [[NSOperationQueue alloc]init];
+    queue.maxConcurrentOperationCount = MAX(_maxConcurrentSegments, 1);
+    self.queue = queue;
+
+    NSIndexSet *acknowledged = self.acknowledgedSegments;
+
+    for (NSUInteger i = 0; i < [self segmentCount]; i++) {
+        if ([acknowledged containsIndex:i]) {
+            continue;
+        }
+
+        [queue addOperationWithBlock:^{
+            @synchronized(self) {
+                if (failure) {
+                    return;
+                }
+            }
+
+            id result = [self appendSegment:i];
+
+            if ([result isKindOfClass:[NSError class]]) {
+                @synchronized(self) {
+                    if (!failure) {
+                        failure = result;
+                    }
+                }
+                [queue cancelAllOperations];
+                return;
+            }
+
+            @synchronized(_acknowledged) {
+                [_acknowledged addIndex:i];
+            }
+
+            if (_progressBlock) {
+                _progressBlock([self acknowledgedBytes], _totalBytes);
+            }
+        }];
+    }
+
+    [queue waitUntilAllOperationsAreFinished];
+    self.queue = nil;
+
+    if (self.cancelled) {
+        return [self cancelledError];
+    }
+
+    return failure;
+}
+
+// FINALIZE, then STATUS until async processing (video, GIF) is done
+- (NSError *)sendFinalize {
+    id json = [self sendCommand:@"FINALIZE" params:@{@"media_id": _mediaID} HTTPMethod:@"POST"];
+
+    while (YES) {
+        if ([json isKindOfClass:[NSError class]]) {
+            return json;
+        }
+
+        NSDictionary *info = [json isKindOfClass:[NSDictionary class]]?json[@"processing_info"]:nil;
+        NSString *state = info[@"state"];
+
+        if (!info || [state isEqualToString:@"succeeded"]) {
+            return nil;
+        }
+
+        if ([state isEqualToString:@"failed"]) {
+            NSDictionary *error = info[@"error"];
+            return [NSError errorWithDomain:FHSErrorDomain code:[error[@"code"]integerValue] userInfo:@{NSLocalizedDescriptionKey: error[@"message"]?:@"Media processing failed."}];
+        }
+
+        if (self.cancelled) {
+            return [self cancelledError];
+        }
+
+        [NSThread sleepForTimeInterval:MAX([info[@"check_after_secs"]doubleValue], 1.0)];
+        json = [self sendCommand:@"STATUS" params:@{@"media_id": _mediaID} HTTPMethod:@"GET"];
+    }
+}
+
+- (NSError *)upload {
+    if (_data) {
+        self.totalBytes = _data.length;
+    } else {
+        NSDictionary *attributes = [[NSFileManager defaultManager]attributesOfItemAtPath:_path error:nil];
+
+        if (!attributes) {
+            return [NSError badRequestError];
+        }
+
+        self.totalBytes = [attributes fileSize];
+    }
+
+    if (!_mediaID) {
+        // Refuse media Twitter would reject before INIT gets a media ID for it
+        NSData *media = _data?:[NSData dataWithContentsOfFile:_path options:NSDataReadingMappedIfSafe error:nil];
+        NSError *mediaError = [_engine validateMediaData:media];
+
+        if (mediaError) {
+            return mediaError;
+        }
+
+        if (_mediaType.length == 0) {
+            fhs_media_info info;
+
+            if (fhs_media_probe(media.bytes, media.length, &info) == 0) {
+                self.mediaType = @(fhs_media_format_mime_type(info.format));
+            }
+        }
+    }
+
+    if (_totalBytes == 0 || _mediaType.length == 0) {
+        return [NSError badRequestError];
+    }
+
+    self.segmentSize = MIN(MAX(_segmentSize, 1), maxSegmentSize);
+
+    NSError *error = nil;
+
+    if (!_mediaID) {
+        // Segment indexes only hold for the media ID they were sent under
+        @synchronized(_acknowledged) {
+            [_acknowledged removeAllIndexes];
+        }
+
+        error = [self sendInit];
+
+        if (error) {
+            return error;
+        }
+    }
+
+    error = [self sendAppends];
+
+    if (error) {
+        return error;
+    }
+
+    return [self sendFinalize];
+}
+
+- (void)startWithCompletionBlock:(FHSMediaUploadCompletionBlock)block {
+    @synchronized(self) {
+        if (self.running) {
+            return;
+        }
+        self.running = YES;
+        self.cancelled = NO;
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            NSError *error = [self upload];
+            NSString *mediaID = error?nil:_mediaID;
+            self.running = NO;
+
+            dispatch_async(dispatch_get_main_queue(), ^{
+                if (block) {
+                    block(error, mediaID);
+                }
+            });
+        }
+    });
+}
+
+- (void)cancel {
+    self.cancelled = YES;
+    [self.queue cancelAllOperations];
+}
+
+@end
@@ -0,0 +1,147 @@
+//
+//  FHSModel.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+
+@class FHSUser;
+
+/**
+ Lazy model over a JSON object.
+ Keeps the response bytes plus an index of the object's members, built in one
+ scan, and only creates values when they are read. Nothing is cached, so
+ models are immutable and safe to share between threads.
+ Models are immutable NSDictionary instances, so code written against parsed
+ dictionaries keeps working. Nested objects come back as models and nested
+ arrays as immutable arrays.
+ */
+@interface FHSModel : NSDictionary
+
+/**
+ Model for a JSON object, or an array of models for a JSON array. Objects shaped like tweets, users and direct messages become FHSTweet, FHSUser and FHSDirectMessage. Nulls become NSNull.
+ @param data JSON data. It is retained, not copied.
+ @return A model, an array, or nil if the data isn't an object or array.
+ */
++ (id)modelWithData:(NSData *)data;
+
+/**
+ Model for a JSON object, or an array of models for a JSON array.
+ @param data JSON data. It is retained, not copied.
+ @param nullPlaceholder Object returned for null values, or nil for NSNull.
+ @return A model, an array, or nil if the data isn't an object or array.
+ */
++ (id)modelWithData:(NSData *)data nullPlaceholder:(id)nullPlaceholder;
+
+/**
+ JSON text of this object.
+ */
+@property (nonatomic, readonly) NSData *JSONData;
+
+/**
+ String value.
+ @param key Key.
+ @return The string, or nil if the value is missing or not a string.
+ */
+- (NSString *)stringForKey:(NSString *)key;
+
+/**
+ Unsigned integer value, read exactly from a number or a string of digits such as id_str.
+ @param key Key.
+ @return The value, or 0 if it is missing or not an unsigned integer.
+ */
+- (uint64_t)unsignedLongLongForKey:(NSString *)key;
+
+/**
+ Signed integer value.
+ @param key Key.
+ @return The value, or 0 if it is missing or not an integer.
+ */
+- (int64_t)longLongForKey:(NSString *)key;
+
+/**
+ Number value.
+ @param key Key.
+ @return The value, or 0 if it is missing or not a number.
+ */
+- (double)doubleForKey:(NSString *)key;
+
+/**
+ Boolean value.
+ @param key Key.
+ @return The value, or NO if it is missing or not a boolean.
+ */
+- (BOOL)boolForKey:(NSString *)key;
+
+/**
+ Twitter timestamp (e.g. created_at) as seconds since 1970.
+ @param key Key.
+ @return The time, or 0 if the value is missing or malformed.
+ */
+- (NSTimeInterval)timeIntervalForKey:(NSString *)key;
+
+/**
+ Fully parsed copy, with mutable containers, as returned when models are off.
+ @return Mutable dictionary.
+ */
+- (NSMutableDictionary *)dictionaryValue;
+
+@end
+
+/**
+ Tweet.
+ */
+@interface FHSTweet : FHSModel
+
+@property (nonatomic, readonly) uint64_t ID;
+@property (nonatomic, readonly) NSString *text; // full_text when present
+@property (nonatomic, readonly) NSTimeInterval createdAt;
+@property (nonatomic, readonly) FHSUser *user;
+@property (nonatomic, readonly) uint64_t inReplyToStatusID;
+@property (nonatomic, readonly) uint64_t inReplyToUserID;
+@property (nonatomic, readonly) NSString *inReplyToScreenName;
+@property (nonatomic, readonly) FHSTweet *retweetedStatus;
+@property (nonatomic, readonly) int64_t retweetCount;
+@property (nonatomic, readonly) int64_t favoriteCount;
+@property (nonatomic, readonly) BOOL favorited;
+@property (nonatomic, readonly) BOOL retweeted;
+@property (nonatomic, readonly) NSString *lang;
+
+@end
+
+/**
+ User.
+ */
+@interface FHSUser : FHSModel
+
+@property (nonatomic, readonly) uint64_t ID;
+@property (nonatomic, readonly) NSString *screenName;
+@property (nonatomic, readonly) NSString *name;
+@property (nonatomic, readonly) NSString *userDescription;
+@property (nonatomic, readonly) NSString *location;
+@property (nonatomic, readonly) NSString *profileImageURL;
+@property (nonatomic, readonly) NSTimeInterval createdAt;
+@property (nonatomic, readonly) int64_t followersCount;
+@property (nonatomic, readonly) int64_t friendsCount;
+@property (nonatomic, readonly) int64_t statusesCount;
+@property (nonatomic, readonly) BOOL isProtected;
+@property (nonatomic, readonly) BOOL verified;
+
+@end
+
+/**
+ Direct message.
+ */
+@interface FHSDirectMessage : FHSModel
+
+@property (nonatomic, readonly) uint64_t ID;
+@property (nonatomic, readonly) NSString *text;
+@property (nonatomic, readonly) NSTimeInterval createdAt;
+@property (nonatomic, readonly) uint64_t senderID;
+@property (nonatomic, readonly) uint64_t recipientID;
+@property (nonatomic, readonly) FHSUser *sender;
+@property (nonatomic, readonly) FHSUser *recipient;
+
+@end
@@ -0,0 +1,479 @@
+//
+//  FHSModel.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSModel.h"
+#import "FHSJSONReader.h"
+
+#include "FHSJSON.h"
+#include "FHSTimestamp.h"
+
+// Most objects fit, so indexing usually needs one scan and no retry
+#define FHS_MODEL_STACK_MEMBERS 64
+
+static fhs_json_member *fhs_model_index(const uint8_t *bytes, size_t length, size_t *count, fhs_json_type *type) {
+    fhs_json_member stackMembers[FHS_MODEL_STACK_MEMBERS];
+
+    if (fhs_json_index(bytes, length, stackMembers, FHS_MODEL_STACK_MEMBERS, count, type) != 0) {
+        return NULL;
+    }
+
+    fhs_json_member *members = malloc(MAX(*count, 1)*sizeof(fhs_json_member));
+
+    if (!members) {
+        return NULL;
+    }
+
+    if (*count <= FHS_MODEL_STACK_MEMBERS) {
+        memcpy(members, stackMembers, *count*sizeof(fhs_json_member));
+    } else {
+        fhs_json_index(bytes, length, members, *count, count, type);
+    }
+
+    return members;
+}
+
+static int fhs_model_string_callback(void *context, const char *bytes, size_t length) {
+    *(CFStringRef *)context = CFStringCreateWithBytes(kCFAllocatorDefault, (const UInt8 *)bytes, (CFIndex)length, kCFStringEncodingUTF8, false);
+    return 0;
+}
+
+// value spans the quotes
+static NSString *fhs_model_string(const uint8_t *value, size_t length, BOOL escaped) {
+    if (!escaped) {
+        return [[NSString alloc]initWithBytes:value+1 length:length-2 encoding:NSUTF8StringEncoding];
+    }
+
+    CFStringRef string = NULL;
+    fhs_json_callbacks callbacks = {.string = fhs_model_string_callback};
+    fhs_json_parse(value, length, &callbacks, &string, NULL);
+    return CFBridgingRelease(string);
+}
+
+static NSTimeInterval fhs_model_timestamp(const uint8_t *value, size_t length) {
+    int64_t seconds;
+    return (length >= 2 && fhs_timestamp_parse((const char *)value+1, length-2, &seconds) == 0)?(NSTimeInterval)seconds:0;
+}
+
+static Class fhs_model_class(const uint8_t *bytes, const fhs_json_member *members, size_t count) {
+    #define FHS_MODEL_HAS(key) (fhs_json_find(bytes, members, count, key, sizeof(key)-1) != NULL)
+
+    if (FHS_MODEL_HAS("sender_id") && FHS_MODEL_HAS("recipient_id")) {
+        return [FHSDirectMessage class];
+    } else if ((FHS_MODEL_HAS("text") || FHS_MODEL_HAS("full_text")) && FHS_MODEL_HAS("user")) {
+        return [FHSTweet class];
+    } else if (FHS_MODEL_HAS("screen_name") && FHS_MODEL_HAS("followers_count")) {
+        return [FHSUser class];
+    }
+
+    #undef FHS_MODEL_HAS
+    return [FHSModel class];
+}
+
+@interface FHSModel () {
+    NSData *_data;
+    NSRange _range;
+    fhs_json_member *_members;
+    size_t _count;
+    id _nullPlaceholder;
+}
+
+- (instancetype)initWithData:(NSData *)data range:(NSRange)range members:(fhs_json_member *)members count:(size_t)count nullPlaceholder:(id)nullPlaceholder;
+
+@end
+
+static id fhs_model_container(NSData *data, NSRange range, id nullPlaceholder);
+
+static id fhs_model_value(NSData *data, NSUInteger base, const fhs_json_member *member, id nullPlaceholder) {
+    const uint8_t *value = (const uint8_t *)data.bytes+base+member->valueOffset;
+
+    switch (member->type) {
+        case FHS_JSON_STRING:
+            return fhs_model_string(value, member->valueLength, (member->flags & FHS_JSON_VALUE_ESCAPED) != 0);
+        case FHS_JSON_NUMBER: {
+            int64_t integer;
+            uint64_t unsignedInteger;
+            double real;
+
+            if (fhs_json_read_int64(value, member->valueLength, &integer) == 0) {
+                return @(integer);
+            } else if (fhs_json_read_uint64(value, member->valueLength, &unsignedInteger) == 0) {
+                return @(unsignedInteger);
+            } else if (fhs_json_read_double(value, member->valueLength, &real) == 0) {
+                return @(real);
+            }
+            return nil;
+        }
+        case FHS_JSON_TRUE:
+            return @YES;
+        case FHS_JSON_FALSE:
+            return @NO;
+        case FHS_JSON_NULL:
+            return nullPlaceholder;
+        default:
+            return fhs_model_container(data, NSMakeRange(base+member->valueOffset, member->valueLength), nullPlaceholder);
+    }
+}
+
+static id fhs_model_container(NSData *data, NSRange range, id nullPlaceholder) {
+    const uint8_t *bytes = (const uint8_t *)data.bytes+range.location;
+    size_t count;
+    fhs_json_type type;
+    fhs_json_member *members = fhs_model_index(bytes, range.length, &count, &type);
+
+    if (!members) {
+        return nil;
+    }
+
+    if (type == FHS_JSON_OBJECT) {
+        Class modelClass = fhs_model_class(bytes, members, count);
+        return [[modelClass alloc]initWithData:data range:range members:members count:count nullPlaceholder:nullPlaceholder];
+    }
+
+    NSMutableArray *array = [NSMutableArray arrayWithCapacity:count];
+
+    for (size_t i = 0; i < count; i++) {
+        id element = fhs_model_value(data, range.location, &members[i], nullPlaceholder);
+
+        if (element) {
+            [array addObject:element];
+        }
+    }
+
+    free(members);
+    return [array copy];
+}
+
+@implementation FHSModel
+
++ (id)modelWithData:(NSData *)data {
+    return [[self class]modelWithData:data nullPlaceholder:nil];
+}
+
++ (id)modelWithData:(NSData *)data nullPlaceholder:(id)nullPlaceholder {
+    if (data.length == 0) {
+        return nil;
+    }
+
+    return fhs_model_container(data, NSMakeRange(0, data.length), nullPlaceholder?:[NSNull null]);
+}
+
+- (instancetype)initWithData:(NSData *)data range:(NSRange)range members:(fhs_json_member *)members count:(size_t)count nullPlaceholder:(id)nullPlaceholder {
+    self = [super init];
+    if (self) {
+        _data = data;
+        _range = range;
+        _members = members;
+        _count = count;
+        _nullPlaceholder = nullPlaceholder;
+    } else {
+        free(members);
+    }
+    return self;
+}
+
+- (instancetype)initWithObjects:(const id [])objects forKeys:(const id<NSCopying> [])keys count:(NSUInteger)count {
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjects:objects forKeys:keys count:count];
+    NSData *data = [NSJSONSerialization isValidJSONObject:dictionary]?[NSJSONSerialization dataWithJSONObject:dictionary options:0 error:nil]:nil;
+    size_t memberCount;
+    fhs_json_member *members = data?fhs_model_index(data.bytes, data.length, &memberCount, NULL):NULL;
+
+    if (!members) {
+        return nil;
+    }
+
+    return [self initWithData:data range:NSMakeRange(0, data.length) members:members count:memberCount nullPlaceholder:[NSNull null]];
+}
+
+- (instancetype)init {
+    return [self initWithObjects:NULL forKeys:NULL count:0];
+}
+
+- (void)dealloc {
+    free(_members);
+}
+
+- (const fhs_json_member *)memberForKey:(id)key {
+    if (![key isKindOfClass:[NSString class]]) {
+        return NULL;
+    }
+
+    char buffer[64];
+    NSUInteger used;
+    NSRange remaining;
+
+    if ([key getBytes:buffer maxLength:sizeof(buffer) usedLength:&used encoding:NSUTF8StringEncoding options:0 range:NSMakeRange(0, [key length]) remainingRange:&remaining] && remaining.length == 0) {
+        return fhs_json_find((const uint8_t *)_data.bytes+_range.location, _members, _count, buffer, used);
+    }
+
+    const char *utf8 = [key UTF8String];
+    return utf8?fhs_json_find((const uint8_t *)_data.bytes+_range.location, _members, _count, utf8, strlen(utf8)):NULL;
+}
+
+- (const uint8_t *)bytesForMember:(const fhs_json_member *)member {
+    return (const uint8_t *)_data.bytes+_range.location+member->valueOffset;
+}
+
+#pragma mark - NSDictionary
+
+- (NSUInteger)count {
+    return _count;
+}
+
+- (id)objectForKey:(id)key {
+    const fhs_json_member *member = [self memberForKey:key];
+    return member?fhs_model_value(_data, _range.location, member, _nullPlaceholder):nil;
+}
+
+- (NSEnumerator *)keyEnumerator {
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:_count];
+    const uint8_t *bytes = (const uint8_t *)_data.bytes+_range.location;
+
+    for (size_t i = 0; i < _count; i++) {
+        // fhs_model_string wants the quotes around the key
+        NSString *key = fhs_model_string(bytes+_members[i].keyOffset-1, _members[i].keyLength+2, (_members[i].flags & FHS_JSON_KEY_ESCAPED) != 0);
+
+        if (key) {
+            [keys addObject:key];
+        }
+    }
+
+    return [keys objectEnumerator];
+}
+
+- (id)copyWithZone:(NSZone *)zone {
+    return self;
+}
+
+- (Class)classForCoder {
+    return [NSDictionary class];
+}
+
+#pragma mark - Typed access
+
+- (NSData *)JSONData {
+    return [_data subdataWithRange:_range];
+}
+
+- (NSString *)stringForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+
+    if (!member || member->type != FHS_JSON_STRING) {
+        return nil;
+    }
+
+    return fhs_model_string([self bytesForMember:member], member->valueLength, (member->flags & FHS_JSON_VALUE_ESCAPED) != 0);
+}
+
+- (uint64_t)unsignedLongLongForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+    uint64_t value = 0;
+
+    if (member && (member->type == FHS_JSON_NUMBER || member->type == FHS_JSON_STRING) && fhs_json_read_uint64([self bytesForMember:member], member->valueLength, &value) == 0) {
+        return value;
+    }
+
+    return 0;
+}
+
+- (int64_t)longLongForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+    int64_t value = 0;
+
+    if (member && member->type == FHS_JSON_NUMBER && fhs_json_read_int64([self bytesForMember:member], member->valueLength, &value) == 0) {
+        return value;
+    }
+
+    return 0;
+}
+
+- (double)doubleForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+    double value = 0;
+
+    if (member && member->type == FHS_JSON_NUMBER && fhs_json_read_double([self bytesForMember:member], member->valueLength, &value) == 0) {
+        return value;
+    }
+
+    return 0;
+}
+
+- (BOOL)boolForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+    return member && member->type == FHS_JSON_TRUE;
+}
+
+- (NSTimeInterval)timeIntervalForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+
+    if (!member || member->type != FHS_JSON_STRING) {
+        return 0;
+    }
+
+    return fhs_model_timestamp([self bytesForMember:member], member->valueLength);
+}
+
+- (id)modelForKey:(NSString *)key {
+    const fhs_json_member *member = [self memberForKey:key];
+
+    if (!member || member->type != FHS_JSON_OBJECT) {
+        return nil;
+    }
+
+    return fhs_model_container(_data, NSMakeRange(_range.location+member->valueOffset, member->valueLength), _nullPlaceholder);
+}
+
+- (NSMutableDictionary *)dictionaryValue {
+    FHSJSONReader *reader = [FHSJSONReader reader];
+    reader.nullPlaceholder = _nullPlaceholder;
+    return [reader objectWithData:self.JSONData error:nil];
+}
+
+@end
+
+@implementation FHSTweet
+
+- (uint64_t)ID {
+    return [self unsignedLongLongForKey:@"id_str"]?:[self unsignedLongLongForKey:@"id"];
+}
+
+- (NSString *)text {
+    return [self stringForKey:@"full_text"]?:[self stringForKey:@"text"];
+}
+
+- (NSTimeInterval)createdAt {
+    return [self timeIntervalForKey:@"created_at"];
+}
+
+- (FHSUser *)user {
+    id user = [self modelForKey:@"user"];
+    return [user isKindOfClass:[FHSUser class]]?user:nil;
+}
+
+- (uint64_t)inReplyToStatusID {
+    return [self unsignedLongLongForKey:@"in_reply_to_status_id_str"]?:[self unsignedLongLongForKey:@"in_reply_to_status_id"];
+}
+
+- (uint64_t)inReplyToUserID {
+    return [self unsignedLongLongForKey:@"in_reply_to_user_id_str"]?:[self unsignedLongLongForKey:@"in_reply_to_user_id"];
+}
+
+- (NSString *)inReplyToScreenName {
+    return [self stringForKey:@"in_reply_to_screen_name"];
+}
+
+- (FHSTweet *)retweetedStatus {
+    id status = [self modelForKey:@"retweeted_status"];
+    return [status isKindOfClass:[FHSTweet class]]?status:nil;
+}
+
+- (int64_t)retweetCount {
+    return [self longLongForKey:@"retweet_count"];
+}
+
+- (int64_t)favoriteCount {
+    return [self longLongForKey:@"favorite_count"];
+}
+
+- (BOOL)favorited {
+    return [self boolForKey:@"favorited"];
+}
+
+- (BOOL)retweeted {
+    return [self boolForKey:@"retweeted"];
+}
+
+- (NSString *)lang {
+    return [self stringForKey:@"lang"];
+}
+
+@end
+
+@implementation FHSUser
+
+- (uint64_t)ID {
+    return [self unsignedLongLongForKey:@"id_str"]?:[self unsignedLongLongForKey:@"id"];
+}
+
+- (NSString *)screenName {
+    return [self stringForKey:@"screen_name"];
+}
+
+- (NSString *)name {
+    return [self stringForKey:@"name"];
+}
+
+- (NSString *)userDescription {
+    return [self stringForKey:@"description"];
+}
+
+- (NSString *)location {
+    return [self stringForKey:@"location"];
+}
+
+- (NSString *)profileImageURL {
+    return [self stringForKey:@"profile_image_url_https"]?:[self stringForKey:@"profile_image_url"];
+}
+
+- (NSTimeInterval)createdAt {
+    return [self timeIntervalForKey:@"created_at"];
+}
+
+- (int64_t)followersCount {
+    return [self longLongForKey:@"followers_count"];
+}
+
+- (int64_t)friendsCount {
+    return [self longLongForKey:@"friends_count"];
+}
+
+- (int64_t)statusesCount {
+    return [self longLongForKey:@"statuses_count"];
+}
+
+- (BOOL)isProtected {
+    return [self boolForKey:@"protected"];
+}
+
+- (BOOL)verified {
+    return [self boolForKey:@"verified"];
+}
+
+@end
+
+@implementation FHSDirectMessage
+
+- (uint64_t)ID {
+    return [self unsignedLongLongForKey:@"id_str"]?:[self unsignedLongLongForKey:@"id"];
+}
+
+- (NSString *)text {
+    return [self stringForKey:@"text"];
+}
+
+- (NSTimeInterval)createdAt {
+    return [self timeIntervalForKey:@"created_at"];
+}
+
+- (uint64_t)senderID {
+    return [self unsignedLongLongForKey:@"sender_id_str"]?:[self unsignedLongLongForKey:@"sender_id"];
+}
+
+- (uint64_t)recipientID {
+    return [self unsignedLongLongForKey:@"recipient_id_str"]?:[self unsignedLongLongForKey:@"recipient_id"];
+}
+
+- (FHSUser *)sender {
+    id user = [self modelForKey:@"sender"];
+    return [user isKindOfClass:[FHSUser class]]?user:nil;
+}
+
+- (FHSUser *)recipient {
+    id user = [self modelForKey:@"recipient"];
+    return [user isKindOfClass:[FHSUser class]]?user:nil;
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  FHSMultipartBody.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ multipart/form-data request body.
+ Parts are kept as a list of segments (rendered part headers, borrowed
+ NSData and memory-mapped file ranges) and streamed to the connection, so
+ the payload is never copied into a second buffer.
+ */
+@interface FHSMultipartBody : NSObject
+
+/**
+ Body with a random boundary.
+ @return A body instance.
+ */
++ (FHSMultipartBody *)body;
+
+/**
+ Body with a given boundary.
+ @param boundary Boundary, must not occur in any part.
+ @return A body instance.
+ */
++ (FHSMultipartBody *)bodyWithBoundary:(NSString *)boundary;
+
+/**
+ Boundary.
+ */
+@property (nonatomic, readonly) NSString *boundary;
+
+/**
+ Content type header value, including the boundary.
+ */
+@property (nonatomic, readonly) NSString *contentType;
+
+/**
+ Length of the whole body, closing boundary included.
+ */
+@property (nonatomic, readonly) unsigned long long contentLength;
+
+/**
+ Add a text part.
+ @param value Value.
+ @param name Field name.
+ */
+- (void)addString:(NSString *)value forName:(NSString *)name;
+
+/**
+ Add a binary part. The data is retained, not copied.
+ @param data Data.
+ @param name Field name.
+ @param fileName File name, or nil.
+ @param contentType Content type, or nil for application/octet-stream.
+ */
+- (void)addData:(NSData *)data forName:(NSString *)name fileName:(NSString *)fileName contentType:(NSString *)contentType;
+
+/**
+ Add a part holding a range of a file. The range is memory-mapped.
+ @param path File path.
+ @param offset Offset of the range.
+ @param length Length of the range.
+ @param name Field name.
+ @param fileName File name, or nil.
+ @param contentType Content type, or nil for application/octet-stream.
+ @return If an error occurs, returns an NSError object that describes the problem.
+ */
+- (NSError *)addFileAtPath:(NSString *)path offset:(unsigned long long)offset length:(NSUInteger)length forName:(NSString *)name fileName:(NSString *)fileName contentType:(NSString *)contentType;
+
+/**
+ New stream over the body. Each call returns a stream starting from the first byte.
+ @return Body stream.
+ */
+- (NSInputStream *)inputStream;
+
+/**
+ Set the Content-Type, Content-Length and body stream of a request.
+ @param request Request.
+ */
+- (void)applyToRequest:(NSMutableURLRequest *)request;
+
+@end
@@ -0,0 +1,270 @@
+//
+//  FHSMultipartBody.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSMultipartBody.h"
+#import "FHSTwitterEngine.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//
+// Body stream: reads through the segments in order, copying each one
+// straight into the buffer the connection hands in.
+//
+
+@interface FHSMultipartBodyStream : NSInputStream <NSStreamDelegate>
+
+- (instancetype)initWithSegments:(NSArray *)segments;
+
+@end
+
+@implementation FHSMultipartBodyStream {
+    NSArray *_segments;
+    NSUInteger _segmentIndex;
+    NSUInteger _segmentOffset;
+    NSStreamStatus _status;
+    __weak id<NSStreamDelegate> _delegate;
+}
+
+- (instancetype)initWithSegments:(NSArray *)segments {
+    self = [super init];
+    if (self) {
+        _segments = segments;
+        _status = NSStreamStatusNotOpen;
+        _delegate = self;
+    }
+    return self;
+}
+
+- (void)open {
+    _status = NSStreamStatusOpen;
+}
+
+- (void)close {
+    _status = NSStreamStatusClosed;
+}
+
+- (NSInteger)read:(uint8_t *)buffer maxLength:(NSUInteger)maxLength {
+    if (_status == NSStreamStatusClosed) {
+        return 0;
+    }
+
+    NSUInteger total = 0;
+
+    while (total < maxLength && _segmentIndex < _segments.count) {
+        NSData *segment = _segments[_segmentIndex];
+        NSUInteger n = MIN(segment.length-_segmentOffset, maxLength-total);
+
+        memcpy(buffer+total, (const uint8_t *)segment.bytes+_segmentOffset, n);
+        total += n;
+        _segmentOffset += n;
+
+        if (_segmentOffset == segment.length) {
+            _segmentIndex++;
+            _segmentOffset = 0;
+        }
+    }
+
+    if (_segmentIndex == _segments.count) {
+        _status = NSStreamStatusAtEnd;
+    }
+
+    return total;
+}
+
+- (BOOL)getBuffer:(uint8_t **)buffer length:(NSUInteger *)length {
+    return NO;
+}
+
+- (BOOL)hasBytesAvailable {
+    return _status == NSStreamStatusOpen;
+}
+
+- (NSStreamStatus)streamStatus {
+    return _status;
+}
+
+- (NSError *)streamError {
+    return nil;
+}
+
+- (id<NSStreamDelegate>)delegate {
+    return _delegate;
+}
+
+- (void)setDelegate:(id<NSStreamDelegate>)delegate {
+    _delegate = delegate?delegate:self;
+}
+
+- (void)scheduleInRunLoop:(NSRunLoop *)runLoop forMode:(NSString *)mode {}
+
+- (void)removeFromRunLoop:(NSRunLoop *)runLoop forMode:(NSString *)mode {}
+
+- (id)propertyForKey:(NSString *)key {
+    return nil;
+}
+
+- (BOOL)setProperty:(id)property forKey:(NSString *)key {
+    return NO;
+}
+
+// CFNetwork schedules body streams through these toll-free bridging hooks.
+// The stream never blocks, so there is nothing to schedule.
+
+- (void)_scheduleInCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {}
+
+- (void)_unscheduleFromCFRunLoop:(CFRunLoopRef)runLoop forMode:(CFStringRef)mode {}
+
+- (BOOL)_setCFClientFlags:(CFOptionFlags)flags callback:(CFReadStreamClientCallBack)callback context:(CFStreamClientContext *)context {
+    return NO;
+}
+
+@end
+
+@interface FHSMultipartBody ()
+
+@property (nonatomic, strong, readwrite) NSString *boundary;
+@property (nonatomic, strong) NSMutableArray *segments;
+@property (nonatomic, strong) NSMutableData *pending; // rendered text not yet closed into a segment
+@property (nonatomic, assign) unsigned long long length;
+
+@end
+
+@implementation FHSMultipartBody
+
++ (FHSMultipartBody *)body {
+    return [[self class]bodyWithBoundary:[NSString fhs_nonce]];
+}
+
++ (FHSMultipartBody *)bodyWithBoundary:(NSString *)boundary {
+    return [[[self class]alloc]initWithBoundary:boundary];
+}
+
+- (instancetype)initWithBoundary:(NSString *)boundary {
+    self = [super init];
+    if (self) {
+        self.boundary = boundary;
+        self.segments = [NSMutableArray array];
+        self.pending = [NSMutableData data];
+    }
+    return self;
+}
+
+- (NSString *)contentType {
+    return [NSString stringWithFormat:@"multipart/form-data; boundary=%@", _boundary];
+}
+
+- (NSData *)closingBoundary {
+    return [[NSString stringWithFormat:@"--%@--\r\n", _boundary]dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+- (unsigned long long)contentLength {
+    return _length+_pending.length+[self closingBoundary].length;
+}
+
+- (void)appendHeaderForName:(NSString *)name fileName:(NSString *)fileName contentType:(NSString *)contentType {
+    NSMutableString *header = [NSMutableString stringWithFormat:@"--%@\r\nContent-Disposition: form-data; name=\"%@\"", _boundary, name];
+
+    if (fileName.length > 0) {
+        [header appendFormat:@"; filename=\"%@\"", fileName];
+    }
+
+    if (contentType.length > 0) {
+        [header appendFormat:@"\r\nContent-Type: %@", contentType];
+    }
+
+    [header appendString:@"\r\n\r\n"];
+    [_pending appendData:[header dataUsingEncoding:NSUTF8StringEncoding]];
+}
+
+- (void)appendSegment:(NSData *)data {
+    if (_pending.length > 0) {
+        [_segments addObject:_pending];
+        _length += _pending.length;
+        self.pending = [NSMutableData data];
+    }
+
+    if (data.length > 0) {
+        [_segments addObject:data];
+        _length += data.length;
+    }
+
+    [_pending appendBytes:"\r\n" length:2];
+}
+
+- (void)addString:(NSString *)value forName:(NSString *)name {
+    [self appendHeaderForName:name fileName:nil contentType:nil];
+    [_pending appendData:[(value?:@"") dataUsingEncoding:NSUTF8StringEncoding]];
+    [_pending appendBytes:"\r\n" length:2];
+}
+
+- (void)addData:(NSData *)data forName:(NSString *)name fileName:(NSString *)fileName contentType:(NSString *)contentType {
+    [self appendHeaderForName:name fileName:fileName contentType:contentType?:@"application/octet-stream"];
+    [self appendSegment:data];
+}
+
+- (NSError *)addFileAtPath:(NSString *)path offset:(unsigned long long)offset length:(NSUInteger)length forName:(NSString *)name fileName:(NSString *)fileName contentType:(NSString *)contentType {
+    NSData *data = [NSData data];
+
+    if (length > 0) {
+        int fd = open(path.fileSystemRepresentation, O_RDONLY);
+
+        if (fd < 0) {
+            return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:@{NSFilePathErrorKey: path}];
+        }
+
+        struct stat info;
+
+        if (fstat(fd, &info) != 0 || offset+length > (unsigned long long)info.st_size) {
+            close(fd);
+            return [NSError errorWithDomain:NSPOSIXErrorDomain code:ERANGE userInfo:@{NSFilePathErrorKey: path}];
+        }
+
+        // mmap offsets have to be page aligned
+        off_t pageSize = sysconf(_SC_PAGESIZE);
+        off_t aligned = (off_t)offset-((off_t)offset % pageSize);
+        size_t mapLength = length+(size_t)((off_t)offset-aligned);
+
+        void *base = mmap(NULL, mapLength, PROT_READ, MAP_PRIVATE, fd, aligned);
+        int mapError = errno;
+        close(fd);
+
+        if (base == MAP_FAILED) {
+            return [NSError errorWithDomain:NSPOSIXErrorDomain code:mapError userInfo:@{NSFilePathErrorKey: path}];
+        }
+
+        madvise(base, mapLength, MADV_SEQUENTIAL);
+
+        data = [[NSData alloc]initWithBytesNoCopy:(uint8_t *)base+((off_t)offset-aligned) length:length deallocator:^(void *bytes, NSUInteger dataLength) {
+            munmap(base, mapLength);
+        }];
+    }
+
+    [self appendHeaderForName:name fileName:fileName contentType:contentType?:@"application/octet-stream"];
+    [self appendSegment:data];
+    return nil;
+}
+
+- (NSInputStream *)inputStream {
+    NSMutableArray *segments = [NSMutableArray arrayWithArray:_segments];
+    NSMutableData *last = [NSMutableData dataWithData:_pending];
+    [last appendData:[self closingBoundary]];
+    [segments addObject:last];
+    return [[FHSMultipartBodyStream alloc]initWithSegments:segments];
+}
+
+- (void)applyToRequest:(NSMutableURLRequest *)request {
+    [request setValue:self.contentType forHTTPHeaderField:@"Content-Type"];
+    [request setValue:@(self.contentLength).stringValue forHTTPHeaderField:@"Content-Length"];
+    request.HTTPBody = nil;
+    request.HTTPBodyStream = [self inputStream];
+}
+
+@end
@@ -0,0 +1,177 @@
+//
+//  FHSNonce.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // syscall()
+#endif
+
+#include "FHSNonce.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__) || defined(__NetBSD__)
+#define FHS_HAVE_ARC4RANDOM 1
+#elif defined(__linux__)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static char const alphanumerics[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+#if !FHS_HAVE_ARC4RANDOM
+
+#define FHS_RANDOM_POOL_SIZE 512
+
+typedef struct {
+    uint8_t bytes[FHS_RANDOM_POOL_SIZE];
+    size_t offset; // bytes before offset have been handed out
+    unsigned long generation; // forkGeneration when the bytes were drawn
+} fhs_random_pool;
+
+static pthread_key_t poolKey;
+static pthread_once_t poolOnce = PTHREAD_ONCE_INIT;
+
+// Bumped in the child of every fork, which would otherwise hand out the same buffered bytes as its parent
+static volatile unsigned long forkGeneration;
+
+static void fhs_pool_after_fork(void) {
+    forkGeneration++;
+}
+
+static void fhs_pool_free(void *pool) {
+    memset(pool, 0, sizeof(fhs_random_pool));
+    free(pool);
+}
+
+static void fhs_pool_key_create(void) {
+    pthread_key_create(&poolKey, fhs_pool_free);
+    pthread_atfork(NULL, NULL, fhs_pool_after_fork);
+}
+
+static void fhs_system_random(void *buffer, size_t length) {
+#if defined(__linux__)
+    uint8_t *out = buffer;
+    while (length > 0) {
+#ifdef SYS_getrandom
+        long n = syscall(SYS_getrandom, out, length, 0);
+#else
+        long n = -1;
+        errno = ENOSYS;
+#endif
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+
+        if (n < 0) {
+            // Kernels older than 3.17
+            int fd = open("/dev/urandom", O_RDONLY | O_CLOEXEC);
+            if (fd < 0) {
+                abort();
+            }
+            while (length > 0) {
+                ssize_t r = read(fd, out, length);
+                if (r <= 0) {
+                    if (r < 0 && errno == EINTR) {
+                        continue;
+                    }
+                    abort();
+                }
+                out += r;
+                length -= r;
+            }
+            close(fd);
+            return;
+        }
+
+        out += n;
+        length -= n;
+    }
+#else
+#error "No system random source for this platform"
+#endif
+}
+
+static fhs_random_pool *fhs_pool_get(void) {
+    pthread_once(&poolOnce, fhs_pool_key_create);
+
+    fhs_random_pool *pool = pthread_getspecific(poolKey);
+    if (!pool) {
+        pool = malloc(sizeof(fhs_random_pool));
+        if (!pool) {
+            return NULL;
+        }
+        pool->offset = FHS_RANDOM_POOL_SIZE;
+        pthread_setspecific(poolKey, pool);
+    }
+    return pool;
+}
+
+#endif
+
+void fhs_random_bytes(void *buffer, size_t length) {
+#if FHS_HAVE_ARC4RANDOM
+    // Already buffered in user space, and reseeded across fork
+    arc4random_buf(buffer, length);
+#else
+    fhs_random_pool *pool = fhs_pool_get();
+
+    if (!pool || length > FHS_RANDOM_POOL_SIZE/2) {
+        fhs_system_random(buffer, length);
+        return;
+    }
+
+    uint8_t *out = buffer;
+    while (length > 0) {
+        if (pool->offset == FHS_RANDOM_POOL_SIZE || pool->generation != forkGeneration) {
+            fhs_system_random(pool->bytes, FHS_RANDOM_POOL_SIZE);
+            pool->offset = 0;
+            pool->generation = forkGeneration;
+        }
+
+        size_t n = FHS_RANDOM_POOL_SIZE-pool->offset;
+        if (n > length) {
+            n = length;
+        }
+
+        // Bytes are wiped once used so they can't be recovered from the pool later
+        memcpy(out, pool->bytes+pool->offset, n);
+        memset(pool->bytes+pool->offset, 0, n);
+        pool->offset += n;
+        out += n;
+        length -= n;
+    }
+#endif
+}
+
+void fhs_nonce(char nonce[FHS_NONCE_LENGTH+1]) {
+    uint8_t random[FHS_NONCE_LENGTH+8];
+    size_t available = 0;
+    size_t used = 0;
+    int i = 0;
+
+    while (i < FHS_NONCE_LENGTH) {
+        if (used == available) {
+            available = sizeof(random);
+            used = 0;
+            fhs_random_bytes(random, available);
+        }
+
+        // Reject 248..255 so every character is equally likely (248 = 4*62)
+        uint8_t b = random[used++];
+        if (b < 248) {
+            nonce[i++] = alphanumerics[b % 62];
+        }
+    }
+
+    nonce[FHS_NONCE_LENGTH] = 0;
+    memset(random, 0, sizeof(random));
+}
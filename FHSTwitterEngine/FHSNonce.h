@@ -0,0 +1,45 @@
+//
+//  FHSNonce.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Cryptographically random nonces for oauth_nonce and multipart boundaries.
+//
+
+#ifndef FHSNONCE_H
+#define FHSNONCE_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Nonce length in characters, not counting the terminating NUL.
+ 32 alphanumeric characters carry about 190 bits of entropy.
+ */
+#define FHS_NONCE_LENGTH 32
+
+/**
+ Fill a buffer with random bytes.
+ Bytes come from arc4random_buf() where there is one, otherwise from a per-thread
+ buffer refilled from getrandom() that a forked child discards, so parent and
+ child never hand out the same bytes.
+ @param buffer Output buffer.
+ @param length Number of bytes.
+ */
+void fhs_random_bytes(void *buffer, size_t length);
+
+/**
+ Write a random alphanumeric nonce.
+ @param nonce Output buffer, NUL-terminated on return.
+ */
+void fhs_nonce(char nonce[FHS_NONCE_LENGTH+1]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
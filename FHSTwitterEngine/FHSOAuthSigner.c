@@ -0,0 +1,365 @@
+//
+//  FHSOAuthSigner.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSOAuthSigner.h"
+#include "FHSPercentEncoding.h"
+#include "FHSSHA1.h"
+#include "FHSBase64.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct fhs_oauth_key {
+    fhs_hmac_sha1_ctx hmac; // keyed with "consumer_secret&token_secret"
+    char *consumerKey;  // percent-encoded
+    size_t consumerKeyLength;
+    char *token;        // percent-encoded, NULL if unauthorized
+    size_t tokenLength;
+};
+
+typedef struct {
+    const char *key;
+    size_t keyLength;
+    const char *value;
+    size_t valueLength;
+} fhs_oauth_param;
+
+typedef struct {
+    char *buffer;
+    size_t capacity;
+    fhs_oauth_param *params;
+    size_t paramCapacity;
+} fhs_oauth_scratch;
+
+static pthread_key_t scratchKey;
+static pthread_once_t scratchOnce = PTHREAD_ONCE_INIT;
+
+//
+// Helpers
+//
+
+static char *fhs_encode_copy(const char *src, size_t *length) {
+    size_t srcLength = src?strlen(src):0;
+    char *dst = malloc(srcLength*3+1);
+    if (dst) {
+        *length = fhs_percent_encode(src, srcLength, dst);
+        dst[*length] = 0;
+    }
+    return dst;
+}
+
+static int fhs_param_compare(const void *a, const void *b) {
+    const fhs_oauth_param *x = a;
+    const fhs_oauth_param *y = b;
+
+    // OAuth Spec, Section 9.1.1: sort by name, then by value, using byte order
+    int result = memcmp(x->key, y->key, x->keyLength < y->keyLength?x->keyLength:y->keyLength);
+    if (result == 0 && x->keyLength != y->keyLength) {
+        return x->keyLength < y->keyLength?-1:1;
+    }
+    if (result == 0) {
+        result = memcmp(x->value, y->value, x->valueLength < y->valueLength?x->valueLength:y->valueLength);
+        if (result == 0 && x->valueLength != y->valueLength) {
+            return x->valueLength < y->valueLength?-1:1;
+        }
+    }
+    return result;
+}
+
+static void fhs_scratch_free(void *ptr) {
+    fhs_oauth_scratch *scratch = ptr;
+    free(scratch->buffer);
+    free(scratch->params);
+    free(scratch);
+}
+
+static void fhs_scratch_key_create(void) {
+    pthread_key_create(&scratchKey, fhs_scratch_free);
+}
+
+static fhs_oauth_scratch *fhs_scratch_get(size_t capacity, size_t paramCapacity) {
+    pthread_once(&scratchOnce, fhs_scratch_key_create);
+
+    fhs_oauth_scratch *scratch = pthread_getspecific(scratchKey);
+    if (!scratch) {
+        scratch = calloc(1, sizeof(fhs_oauth_scratch));
+        if (!scratch) {
+            return NULL;
+        }
+        pthread_setspecific(scratchKey, scratch);
+    }
+
+    if (scratch->capacity < capacity) {
+        char *buffer = realloc(scratch->buffer, capacity);
+        if (!buffer) {
+            return NULL;
+        }
+        scratch->buffer = buffer;
+        scratch->capacity = capacity;
+    }
+
+    if (scratch->paramCapacity < paramCapacity) {
+        fhs_oauth_param *params = realloc(scratch->params, paramCapacity*sizeof(fhs_oauth_param));
+        if (!params) {
+            return NULL;
+        }
+        scratch->params = params;
+        scratch->paramCapacity = paramCapacity;
+    }
+
+    return scratch;
+}
+
+static size_t fhs_count_pairs(const char *s, size_t length) {
+    size_t count = 1;
+    for (size_t i = 0; i < length; i++) {
+        count += (s[i] == '&');
+    }
+    return count;
+}
+
+// Splits an already-encoded "a=b&c=d" string into params, skipping empty pairs.
+static size_t fhs_add_pairs(fhs_oauth_param *params, const char *s, size_t length) {
+    size_t count = 0;
+    const char *end = s+length;
+
+    while (s < end) {
+        const char *amp = memchr(s, '&', end-s);
+        const char *pairEnd = amp?amp:end;
+
+        if (pairEnd > s) {
+            const char *eq = memchr(s, '=', pairEnd-s);
+            fhs_oauth_param *p = &params[count++];
+            p->key = s;
+            p->keyLength = (eq?eq:pairEnd)-s;
+            p->value = eq?eq+1:pairEnd;
+            p->valueLength = eq?pairEnd-(eq+1):0;
+        }
+
+        s = pairEnd+1;
+    }
+
+    return count;
+}
+
+static inline void fhs_add_param(fhs_oauth_param *params, size_t *count, const char *key, const char *value, size_t valueLength) {
+    fhs_oauth_param *p = &params[(*count)++];
+    p->key = key;
+    p->keyLength = strlen(key);
+    p->value = value;
+    p->valueLength = valueLength;
+}
+
+static inline char *fhs_append(char *out, const char *s, size_t length) {
+    memcpy(out, s, length);
+    return out+length;
+}
+
+#define FHS_APPEND_LITERAL(out, lit) fhs_append((out), (lit), sizeof(lit)-1)
+
+//
+// Key
+//
+
+fhs_oauth_key *fhs_oauth_key_create(const char *consumerKey, const char *consumerSecret, const char *token, const char *tokenSecret) {
+    fhs_oauth_key *key = calloc(1, sizeof(fhs_oauth_key));
+    if (!key) {
+        return NULL;
+    }
+
+    key->consumerKey = fhs_encode_copy(consumerKey, &key->consumerKeyLength);
+
+    if (token && token[0]) {
+        key->token = fhs_encode_copy(token, &key->tokenLength);
+    }
+
+    // Secret is "consumer_secret&token_secret", a missing token secret leaves it empty
+    size_t consumerSecretLength = consumerSecret?strlen(consumerSecret):0;
+    size_t tokenSecretLength = tokenSecret?strlen(tokenSecret):0;
+    char *secret = malloc((consumerSecretLength+tokenSecretLength)*3+1);
+
+    if (!key->consumerKey || (token && token[0] && !key->token) || !secret) {
+        free(secret);
+        fhs_oauth_key_free(key);
+        return NULL;
+    }
+
+    size_t secretLength = fhs_percent_encode(consumerSecret, consumerSecretLength, secret);
+    secret[secretLength++] = '&';
+    secretLength += fhs_percent_encode(tokenSecret, tokenSecretLength, secret+secretLength);
+
+    fhs_hmac_sha1_init(&key->hmac, secret, secretLength);
+
+    memset(secret, 0, secretLength);
+    free(secret);
+
+    return key;
+}
+
+void fhs_oauth_key_free(fhs_oauth_key *key) {
+    if (!key) {
+        return;
+    }
+
+    free(key->consumerKey);
+    free(key->token);
+    memset(key, 0, sizeof(fhs_oauth_key));
+    free(key);
+}
+
+//
+// Signing
+//
+
+const char *fhs_oauth_sign(const fhs_oauth_key *key, const fhs_oauth_request *request, size_t *headerLength) {
+
+    const char *url = request->url;
+    const char *urlEnd = url+request->urlLength;
+    const char *query = memchr(url, '?', request->urlLength);
+    const char *fragment = memchr(url, '#', request->urlLength);
+    const char *baseURLEnd = query?query:(fragment?fragment:urlEnd);
+    const char *queryEnd = (fragment && (!query || fragment > query))?fragment:urlEnd;
+    size_t queryLength = query?queryEnd-(query+1):0;
+
+    size_t methodLength = strlen(request->method);
+    size_t verifierLength = (key->token && request->verifier)?strlen(request->verifier):0;
+    size_t realmLength = request->realm?strlen(request->realm):0;
+    size_t nonceLength = strlen(request->nonce);
+
+    char timestamp[24];
+    size_t timestampLength = snprintf(timestamp, sizeof(timestamp), "%ld", request->timestamp);
+
+    size_t paramCapacity = 7+fhs_count_pairs(query?query+1:"", queryLength)+fhs_count_pairs(request->body?request->body:"", request->bodyLength);
+
+    // Upper bounds: every byte of the normalized parameters may be encoded twice (x9),
+    // the base URL once (x3). The header holds the encoded oauth values plus fixed text.
+    size_t oauthLength = key->consumerKeyLength+key->tokenLength+verifierLength*3+nonceLength+timestampLength+128;
+    size_t prefixLength = request->signingPrefix?request->signingPrefixLength:methodLength+2+(baseURLEnd-url)*3;
+    size_t baseCapacity = prefixLength+(queryLength+request->bodyLength+oauthLength+paramCapacity*2)*3;
+    size_t headerCapacity = 256+realmLength*3+oauthLength;
+
+    fhs_oauth_scratch *scratch = fhs_scratch_get(verifierLength*3+baseCapacity+headerCapacity, paramCapacity);
+    if (!scratch) {
+        return NULL;
+    }
+
+    char *verifier = scratch->buffer;
+    verifierLength = fhs_percent_encode(request->verifier, verifierLength, verifier);
+
+    char *base = verifier+verifierLength;
+
+    //
+    // OAuth Spec, Section 9.1.1 "Normalize Request Parameters"
+    //
+
+    fhs_oauth_param *params = scratch->params;
+    size_t count = 0;
+
+    fhs_add_param(params, &count, "oauth_consumer_key", key->consumerKey, key->consumerKeyLength);
+    fhs_add_param(params, &count, "oauth_nonce", request->nonce, nonceLength);
+    fhs_add_param(params, &count, "oauth_signature_method", "HMAC-SHA1", 9);
+    fhs_add_param(params, &count, "oauth_timestamp", timestamp, timestampLength);
+    fhs_add_param(params, &count, "oauth_version", "1.0", 3);
+
+    if (key->token) {
+        fhs_add_param(params, &count, "oauth_token", key->token, key->tokenLength);
+        if (verifierLength > 0) {
+            fhs_add_param(params, &count, "oauth_verifier", verifier, verifierLength);
+        }
+    } else {
+        fhs_add_param(params, &count, "oauth_callback", "oob", 3);
+    }
+
+    if (query) {
+        count += fhs_add_pairs(params+count, query+1, queryLength);
+    }
+
+    if (request->body) {
+        count += fhs_add_pairs(params+count, request->body, request->bodyLength);
+    }
+
+    qsort(params, count, sizeof(fhs_oauth_param), fhs_param_compare);
+
+    //
+    // OAuth Spec, Section 9.1.2 "Concatenate Request Elements"
+    //
+
+    char *out = base;
+
+    if (request->signingPrefix) {
+        out = fhs_append(out, request->signingPrefix, request->signingPrefixLength);
+    } else {
+        out = fhs_append(out, request->method, methodLength);
+        *out++ = '&';
+        out += fhs_percent_encode(url, baseURLEnd-url, out);
+        *out++ = '&';
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0) {
+            out = FHS_APPEND_LITERAL(out, "%26");
+        }
+        out += fhs_percent_encode(params[i].key, params[i].keyLength, out);
+        out = FHS_APPEND_LITERAL(out, "%3D");
+        out += fhs_percent_encode(params[i].value, params[i].valueLength, out);
+    }
+
+    //
+    // HMAC-SHA1, starting from the pre-keyed state
+    //
+
+    uint8_t digest[FHS_SHA1_DIGEST_LENGTH];
+    fhs_hmac_sha1_ctx hmac = key->hmac;
+    fhs_hmac_sha1_update(&hmac, base, out-base);
+    fhs_hmac_sha1_final(&hmac, digest);
+
+    char signature[28];
+    fhs_base64_encode(digest, FHS_SHA1_DIGEST_LENGTH, signature);
+
+    //
+    // Authorization header
+    //
+
+    char *header = out;
+    out = FHS_APPEND_LITERAL(out, "OAuth ");
+
+    if (realmLength > 0) {
+        out = FHS_APPEND_LITERAL(out, "realm=\"");
+        out += fhs_percent_encode(request->realm, realmLength, out);
+        out = FHS_APPEND_LITERAL(out, "\", ");
+    }
+
+    out = FHS_APPEND_LITERAL(out, "oauth_consumer_key=\"");
+    out = fhs_append(out, key->consumerKey, key->consumerKeyLength);
+
+    if (key->token) {
+        out = FHS_APPEND_LITERAL(out, "\", oauth_token=\"");
+        out = fhs_append(out, key->token, key->tokenLength);
+
+        if (verifierLength > 0) {
+            out = FHS_APPEND_LITERAL(out, "\", oauth_verifier=\"");
+            out = fhs_append(out, verifier, verifierLength);
+        }
+    } else {
+        out = FHS_APPEND_LITERAL(out, "\", oauth_callback=\"oob");
+    }
+
+    out = FHS_APPEND_LITERAL(out, "\", oauth_signature_method=\"HMAC-SHA1\", oauth_signature=\"");
+    out += fhs_percent_encode(signature, sizeof(signature), out);
+    out = FHS_APPEND_LITERAL(out, "\", oauth_timestamp=\"");
+    out = fhs_append(out, timestamp, timestampLength);
+    out = FHS_APPEND_LITERAL(out, "\", oauth_nonce=\"");
+    out = fhs_append(out, request->nonce, nonceLength);
+    out = FHS_APPEND_LITERAL(out, "\", oauth_version=\"1.0\"");
+    *out = 0;
+
+    *headerLength = out-header;
+    return header;
+}
@@ -0,0 +1,76 @@
+//
+//  FHSOAuthSigner.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  OAuth 1.0a HMAC-SHA1 request signing without Foundation objects.
+//
+
+#ifndef FHSOAUTHSIGNER_H
+#define FHSOAUTHSIGNER_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Signing key for one consumer/token pair.
+ Holds the percent-encoded consumer key and token plus the HMAC state
+ already keyed with the signing secret, so signing a request never
+ rebuilds the secret or re-runs the HMAC key schedule.
+ A key is immutable once created and may be shared between threads.
+ */
+typedef struct fhs_oauth_key fhs_oauth_key;
+
+/**
+ Request to sign.
+ */
+typedef struct {
+    const char *method;     // HTTP method, e.g. "GET"
+    const char *url;        // Absolute URL, the query string (if any) is signed as parameters
+    size_t urlLength;
+    const char *body;       // application/x-www-form-urlencoded body, or NULL
+    size_t bodyLength;
+    const char *verifier;   // oauth_verifier, or NULL
+    const char *realm;      // Header realm (not signed), or NULL
+    const char *nonce;      // oauth_nonce, must only contain unreserved characters
+    long timestamp;         // oauth_timestamp
+    const char *signingPrefix; // "METHOD&" and the encoded base URL and "&", or NULL to build it from method and url
+    size_t signingPrefixLength;
+} fhs_oauth_request;
+
+/**
+ Create a signing key.
+ @param consumerKey Consumer key.
+ @param consumerSecret Consumer secret.
+ @param token Token key, or NULL to sign with oauth_callback="oob".
+ @param tokenSecret Token secret, or NULL.
+ @return Signing key, free with fhs_oauth_key_free().
+ */
+fhs_oauth_key *fhs_oauth_key_create(const char *consumerKey, const char *consumerSecret, const char *token, const char *tokenSecret);
+
+/**
+ Free a signing key.
+ @param key Signing key.
+ */
+void fhs_oauth_key_free(fhs_oauth_key *key);
+
+/**
+ Sign a request.
+ The signature base string and the header are built in a per-thread
+ buffer that is reused between calls.
+ @param key Signing key.
+ @param request Request to sign.
+ @param headerLength Set to the length of the returned header.
+ @return Authorization header value, valid until the next call on the same thread. NULL if out of memory.
+ */
+const char *fhs_oauth_sign(const fhs_oauth_key *key, const fhs_oauth_request *request, size_t *headerLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,140 @@
+//
+//  FHSPercentEncoding.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSPercentEncoding.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define FHS_PERCENT_SSE2 1
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define FHS_PERCENT_NEON 1
+#endif
+
+#define U1 1
+const uint8_t fhs_percent_unreserved[256] = {
+    ['A'] = U1, ['B'] = U1, ['C'] = U1, ['D'] = U1, ['E'] = U1, ['F'] = U1, ['G'] = U1, ['H'] = U1, ['I'] = U1,
+    ['J'] = U1, ['K'] = U1, ['L'] = U1, ['M'] = U1, ['N'] = U1, ['O'] = U1, ['P'] = U1, ['Q'] = U1, ['R'] = U1,
+    ['S'] = U1, ['T'] = U1, ['U'] = U1, ['V'] = U1, ['W'] = U1, ['X'] = U1, ['Y'] = U1, ['Z'] = U1,
+    ['a'] = U1, ['b'] = U1, ['c'] = U1, ['d'] = U1, ['e'] = U1, ['f'] = U1, ['g'] = U1, ['h'] = U1, ['i'] = U1,
+    ['j'] = U1, ['k'] = U1, ['l'] = U1, ['m'] = U1, ['n'] = U1, ['o'] = U1, ['p'] = U1, ['q'] = U1, ['r'] = U1,
+    ['s'] = U1, ['t'] = U1, ['u'] = U1, ['v'] = U1, ['w'] = U1, ['x'] = U1, ['y'] = U1, ['z'] = U1,
+    ['0'] = U1, ['1'] = U1, ['2'] = U1, ['3'] = U1, ['4'] = U1, ['5'] = U1, ['6'] = U1, ['7'] = U1, ['8'] = U1, ['9'] = U1,
+    ['-'] = U1, ['.'] = U1, ['_'] = U1, ['~'] = U1
+};
+#undef U1
+
+static char const hex[] = "0123456789ABCDEF";
+
+//
+// Vector fast path: returns the length of the leading run of unreserved bytes,
+// checked 16 bytes at a time. The scalar loop picks up from there.
+//
+
+#if FHS_PERCENT_SSE2
+
+static inline __m128i fhs_in_range(__m128i v, char lo, char hi) {
+    // Signed compares, so bias bytes by 0x80 to compare as unsigned
+    const __m128i bias = _mm_set1_epi8((char)0x80);
+    __m128i x = _mm_xor_si128(v, bias);
+    __m128i l = _mm_set1_epi8((char)(lo ^ 0x80));
+    __m128i h = _mm_set1_epi8((char)(hi ^ 0x80));
+    return _mm_andnot_si128(_mm_or_si128(_mm_cmplt_epi8(x, l), _mm_cmpgt_epi8(x, h)), _mm_set1_epi8((char)0xFF));
+}
+
+static size_t fhs_unreserved_run(const char *src, size_t length, char *dst) {
+    size_t i = 0;
+    while (i+16 <= length) {
+        __m128i v = _mm_loadu_si128((const __m128i *)(src+i));
+        __m128i lower = _mm_or_si128(v, _mm_set1_epi8(0x20)); // fold case for the alpha check
+        __m128i ok = _mm_or_si128(fhs_in_range(lower, 'a', 'z'), fhs_in_range(v, '0', '9'));
+        ok = _mm_or_si128(ok, fhs_in_range(v, '-', '.'));
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8('_')));
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, _mm_set1_epi8('~')));
+
+        if (_mm_movemask_epi8(ok) != 0xFFFF) {
+            break;
+        }
+
+        _mm_storeu_si128((__m128i *)(dst+i), v);
+        i += 16;
+    }
+    return i;
+}
+
+#elif FHS_PERCENT_NEON
+
+static size_t fhs_unreserved_run(const char *src, size_t length, char *dst) {
+    size_t i = 0;
+    while (i+16 <= length) {
+        uint8x16_t v = vld1q_u8((const uint8_t *)(src+i));
+        uint8x16_t lower = vorrq_u8(v, vdupq_n_u8(0x20));
+        uint8x16_t ok = vcleq_u8(vsubq_u8(lower, vdupq_n_u8('a')), vdupq_n_u8('z'-'a'));
+        ok = vorrq_u8(ok, vcleq_u8(vsubq_u8(v, vdupq_n_u8('0')), vdupq_n_u8(9)));
+        ok = vorrq_u8(ok, vcleq_u8(vsubq_u8(v, vdupq_n_u8('-')), vdupq_n_u8(1)));
+        ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('_')));
+        ok = vorrq_u8(ok, vceqq_u8(v, vdupq_n_u8('~')));
+
+        if (vminvq_u8(ok) != 0xFF) {
+            break;
+        }
+
+        vst1q_u8((uint8_t *)(dst+i), v);
+        i += 16;
+    }
+    return i;
+}
+
+#else
+
+static size_t fhs_unreserved_run(const char *src, size_t length, char *dst) {
+    (void)src; (void)length; (void)dst;
+    return 0;
+}
+
+#endif
+
+size_t fhs_percent_encoded_length(const char *src, size_t length) {
+    const uint8_t *s = (const uint8_t *)src;
+    size_t encoded = length;
+    for (size_t i = 0; i < length; i++) {
+        encoded += fhs_percent_unreserved[s[i]]?0:2;
+    }
+    return encoded;
+}
+
+size_t fhs_percent_encode(const char *src, size_t length, char *dst) {
+    const uint8_t *s = (const uint8_t *)src;
+    char *out = dst;
+    size_t i = 0;
+
+    while (i < length) {
+        if (length-i >= 16) {
+            size_t run = fhs_unreserved_run(src+i, length-i, out);
+            i += run;
+            out += run;
+        }
+
+        // Scalar until the next reserved byte has been handled, then try the vector path again
+        while (i < length) {
+            uint8_t c = s[i++];
+            if (fhs_percent_unreserved[c]) {
+                *out++ = (char)c;
+            } else {
+                out[0] = '%';
+                out[1] = hex[c >> 4];
+                out[2] = hex[c & 0x0F];
+                out += 3;
+                break;
+            }
+        }
+    }
+
+    return out-dst;
+}
@@ -0,0 +1,47 @@
+//
+//  FHSPercentEncoding.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  RFC 3986 percent-encoding for OAuth (Section 3.6 of RFC 5849).
+//
+
+#ifndef FHSPERCENTENCODING_H
+#define FHSPERCENTENCODING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Lookup table, non-zero for bytes in the unreserved set (ALPHA / DIGIT / "-" / "." / "_" / "~").
+ */
+extern const uint8_t fhs_percent_unreserved[256];
+
+/**
+ Length of the percent-encoded form of a UTF-8 string.
+ @param src UTF-8 bytes.
+ @param length Number of bytes.
+ @return Encoded length in bytes.
+ */
+size_t fhs_percent_encoded_length(const char *src, size_t length);
+
+/**
+ Percent-encode UTF-8 bytes into a caller-provided buffer.
+ Unreserved bytes are copied, every other byte becomes "%XX" with uppercase hex.
+ @param src UTF-8 bytes.
+ @param length Number of bytes.
+ @param dst Output buffer, at least 3*length bytes (or fhs_percent_encoded_length()). Not NUL-terminated.
+ @return Number of bytes written.
+ */
+size_t fhs_percent_encode(const char *src, size_t length, char *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
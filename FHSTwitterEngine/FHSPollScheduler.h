@@ -0,0 +1,111 @@
+//
+//  FHSPollScheduler.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+#import "FHSTimelineSync.h"
+
+extern NSString * const FHSPollLagKey; // NSNumber, seconds the account's last poll started after its allowed time
+extern NSString * const FHSPollAverageLagKey; // NSNumber, moving average of that lag
+extern NSString * const FHSPollOverdueKey; // NSNumber, seconds the account's most overdue waiting poll is past its allowed time, 0 if none
+extern NSString * const FHSPollLastPollDateKey; // NSDate of the account's last finished poll, absent before the first
+extern NSString * const FHSPollItemCountKey; // NSNumber, new items fetched for the account
+extern NSString * const FHSPollErrorCountKey; // NSNumber, failed polls of the account
+
+/**
+ Poll block, called on the callback queue after each poll.
+ @param sync Timeline polled. Its engine is the account.
+ @param result New items, newest first, or an NSError.
+ */
+typedef void(^FHSPollBlock)(FHSTimelineSync *sync, id result);
+
+/**
+ Polls timelines of many accounts, each with its own engine and rate limits.
+ Every (account, timeline) job waits in a queue ordered by the time it may
+ next run. A job's time is its interval after its last poll, pushed back to
+ spread what is left of the endpoint's rate limit window over the rest of
+ the window, or past the reset once the window is spent. When several jobs
+ are due, the ones expected to bring the most new items run first, from a
+ moving average of each job's items per second.
+ Due jobs go to the queue of their account's worker, so an account's polls
+ tend to stay on one worker. A worker with nothing queued takes the last job
+ of the longest queue instead of waiting.
+ Polls go through FHSTimelineSync, so new items are stored and checkpointed
+ before the block sees them.
+ */
+@interface FHSPollScheduler : NSObject
+
+/**
+ Scheduler.
+ @param block Block called after each poll.
+ @return A scheduler instance.
+ */
++ (FHSPollScheduler *)schedulerWithBlock:(FHSPollBlock)block;
+
+/**
+ Most polls in flight. Read when started. Defaults to twice the active processor count, at least 4.
+ */
+@property (nonatomic, assign) NSUInteger workerCount;
+
+/**
+ Queue the block is called on. Defaults to the main queue.
+ */
+@property (nonatomic, strong) dispatch_queue_t callbackQueue;
+
+/**
+ Whether the scheduler is running.
+ */
+@property (readonly, getter=isRunning) BOOL running;
+
+/**
+ Poll an account's home timeline every 60 seconds, mentions every 12 and direct messages every 60, the fastest their rate limits allow.
+ @param engine Engine of the account.
+ */
+- (void)addAccount:(FHSTwitterEngine *)engine;
+
+/**
+ Poll a timeline.
+ @param sync Timeline. Its engine is the account.
+ @param interval Shortest time between two polls.
+ */
+- (void)addSync:(FHSTimelineSync *)sync interval:(NSTimeInterval)interval;
+
+/**
+ Stop polling an account. A poll in flight still calls the block.
+ @param engine Engine of the account.
+ */
+- (void)removeAccount:(FHSTwitterEngine *)engine;
+
+/**
+ Start polling. Jobs added before start are polled right away.
+ */
+- (void)start;
+
+/**
+ Stop polling. Polls in flight finish and call the block. Start again to resume where it left off.
+ */
+- (void)stop;
+
+/**
+ Accounts being polled.
+ @return Engines.
+ */
+- (NSArray *)accounts;
+
+/**
+ Lag and counts of an account.
+ @param engine Engine of the account.
+ @return Dictionary with the FHSPoll keys, or nil if the account isn't polled.
+ */
+- (NSDictionary *)metricsForAccount:(FHSTwitterEngine *)engine;
+
+/**
+ Seconds the most overdue waiting poll of any account is past its allowed time, 0 if none. A growing value means more workers are needed.
+ */
+@property (readonly) NSTimeInterval lag;
+
+@end
@@ -0,0 +1,549 @@
+//
+//  FHSPollScheduler.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSPollScheduler.h"
+
+#include <math.h>
+
+NSString * const FHSPollLagKey = @"FHSPollLag";
+NSString * const FHSPollAverageLagKey = @"FHSPollAverageLag";
+NSString * const FHSPollOverdueKey = @"FHSPollOverdue";
+NSString * const FHSPollLastPollDateKey = @"FHSPollLastPollDate";
+NSString * const FHSPollItemCountKey = @"FHSPollItemCount";
+NSString * const FHSPollErrorCountKey = @"FHSPollErrorCount";
+
+// Longest wait after repeated failures
+static NSTimeInterval const maxBackoff = 900.0;
+
+// Weight of the newest sample in the yield and lag averages
+static double const averageWeight = 0.3;
+
+//
+// Queue of waiting jobs: a binary min-heap of entries, earliest time first,
+// then highest expected yield.
+//
+
+typedef struct {
+    CFAbsoluteTime time;
+    double yield;
+    uint32_t job;
+} fhs_poll_entry;
+
+static int fhs_poll_entry_before(const fhs_poll_entry *a, const fhs_poll_entry *b) {
+    return (a->time != b->time)?(a->time < b->time):(a->yield > b->yield);
+}
+
+static void fhs_poll_heap_push(fhs_poll_entry *heap, size_t count, fhs_poll_entry entry) {
+    size_t i = count;
+
+    while (i > 0) {
+        size_t parent = (i-1)/2;
+
+        if (!fhs_poll_entry_before(&entry, &heap[parent])) {
+            break;
+        }
+
+        heap[i] = heap[parent];
+        i = parent;
+    }
+
+    heap[i] = entry;
+}
+
+static fhs_poll_entry fhs_poll_heap_pop(fhs_poll_entry *heap, size_t count) {
+    fhs_poll_entry top = heap[0];
+    fhs_poll_entry last = heap[count-1];
+    size_t remaining = count-1;
+    size_t i = 0;
+
+    for (;;) {
+        size_t child = 2*i+1;
+
+        if (child >= remaining) {
+            break;
+        }
+
+        if (child+1 < remaining && fhs_poll_entry_before(&heap[child+1], &heap[child])) {
+            child++;
+        }
+
+        if (!fhs_poll_entry_before(&heap[child], &last)) {
+            break;
+        }
+
+        heap[i] = heap[child];
+        i = child;
+    }
+
+    if (remaining > 0) {
+        heap[i] = last;
+    }
+
+    return top;
+}
+
+@interface FHSPollAccount : NSObject
+
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+@property (nonatomic, strong) NSMutableArray *jobs;
+@property (nonatomic, assign) NSUInteger worker; // whose queue its due jobs go to
+@property (nonatomic, assign) NSTimeInterval lag;
+@property (nonatomic, assign) NSTimeInterval averageLag;
+@property (nonatomic, strong) NSDate *lastPollDate;
+@property (nonatomic, assign) NSUInteger itemCount;
+@property (nonatomic, assign) NSUInteger errorCount;
+
+@end
+
+@implementation FHSPollAccount
+@end
+
+@interface FHSPollJob : NSObject
+
+@property (nonatomic, strong) FHSTimelineSync *sync;
+@property (nonatomic, weak) FHSPollAccount *account;
+@property (nonatomic, assign) uint32_t index;
+@property (nonatomic, assign) NSTimeInterval interval;
+@property (nonatomic, assign) CFAbsoluteTime time; // next allowed run
+@property (nonatomic, assign) CFAbsoluteTime lastPollTime; // 0 before the first
+@property (nonatomic, assign) double yieldRate; // new items per second
+@property (nonatomic, assign) double expectedYield;
+@property (nonatomic, assign) NSUInteger failures; // in a row
+@property (nonatomic, assign) BOOL waiting; // in the heap or a worker queue
+@property (nonatomic, assign) BOOL removed;
+
+@end
+
+@implementation FHSPollJob
+@end
+
+@interface FHSPollWorker : NSObject
+
+@property (nonatomic, strong) NSMutableArray *jobs; // highest expected yield first
+@property (nonatomic, assign) BOOL busy;
+
+@end
+
+@implementation FHSPollWorker
+@end
+
+// All state below is only touched on the scheduler's serial queue.
+
+@interface FHSPollScheduler () {
+    NSMutableData *_heap;
+    size_t _heapCount;
+}
+
+@property (nonatomic, copy) FHSPollBlock block;
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) dispatch_source_t timer;
+@property (nonatomic, strong) NSMapTable *accountsByEngine;
+@property (nonatomic, strong) NSMutableArray *jobs; // by index, removed ones included
+@property (nonatomic, strong) NSMutableArray *workers;
+@property (nonatomic, assign) NSUInteger nextWorker; // for the next account added
+@property (readwrite, getter=isRunning) BOOL running;
+
+@end
+
+@implementation FHSPollScheduler
+
++ (FHSPollScheduler *)schedulerWithBlock:(FHSPollBlock)block {
+    return [[[self class]alloc]initWithBlock:block];
+}
+
+- (instancetype)initWithBlock:(FHSPollBlock)block {
+    self = [super init];
+    if (self) {
+        self.block = block;
+        self.workerCount = MAX([NSProcessInfo processInfo].activeProcessorCount*2, 4);
+        self.callbackQueue = dispatch_get_main_queue();
+        self.queue = dispatch_queue_create("FHSPollScheduler", DISPATCH_QUEUE_SERIAL);
+        self.accountsByEngine = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsStrongMemory|NSPointerFunctionsObjectPointerPersonality valueOptions:NSPointerFunctionsStrongMemory];
+        self.jobs = [NSMutableArray array];
+        self.workers = [NSMutableArray array];
+        _heap = [NSMutableData data];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    if (_timer) {
+        dispatch_source_cancel(_timer);
+    }
+}
+
+//
+// Accounts
+//
+
+- (void)addAccount:(FHSTwitterEngine *)engine {
+    FHSTimelineSync *home = [FHSTimelineSync syncForHomeTimeline];
+    FHSTimelineSync *mentions = [FHSTimelineSync syncForMentions];
+    FHSTimelineSync *directMessages = [FHSTimelineSync syncForDirectMessages];
+    home.engine = engine;
+    mentions.engine = engine;
+    directMessages.engine = engine;
+
+    [self addSync:home interval:60.0];
+    [self addSync:mentions interval:12.0];
+    [self addSync:directMessages interval:60.0];
+}
+
+- (void)addSync:(FHSTimelineSync *)sync interval:(NSTimeInterval)interval {
+    dispatch_async(_queue, ^{
+        FHSPollAccount *account = [self.accountsByEngine objectForKey:sync.engine];
+
+        if (!account) {
+            account = [[FHSPollAccount alloc]init];
+            account.engine = sync.engine;
+            account.jobs = [NSMutableArray array];
+            account.worker = self.nextWorker++;
+            [self.accountsByEngine setObject:account forKey:sync.engine];
+        }
+
+        FHSPollJob *job = [[FHSPollJob alloc]init];
+        job.sync = sync;
+        job.account = account;
+        job.index = (uint32_t)self.jobs.count;
+        job.interval = MAX(interval, 1.0);
+        job.time = CFAbsoluteTimeGetCurrent();
+        [account.jobs addObject:job];
+        [self.jobs addObject:job];
+        [self enqueueJob:job];
+
+        if (self.running) {
+            [self dispatchDueJobs];
+        }
+    });
+}
+
+- (void)removeAccount:(FHSTwitterEngine *)engine {
+    dispatch_async(_queue, ^{
+        FHSPollAccount *account = [self.accountsByEngine objectForKey:engine];
+
+        // Removed jobs are skipped when they come out of the heap or a worker queue
+        for (FHSPollJob *job in account.jobs) {
+            job.removed = YES;
+        }
+
+        [self.accountsByEngine removeObjectForKey:engine];
+    });
+}
+
+- (NSArray *)accounts {
+    __block NSArray *accounts = nil;
+    dispatch_sync(_queue, ^{
+        accounts = self.accountsByEngine.keyEnumerator.allObjects;
+    });
+    return accounts;
+}
+
+//
+// Metrics
+//
+
+// Seconds the most overdue waiting job of the account is past its time
+- (NSTimeInterval)overdueForAccount:(FHSPollAccount *)account now:(CFAbsoluteTime)now {
+    NSTimeInterval overdue = 0;
+
+    for (FHSPollJob *job in account.jobs) {
+        if (job.waiting) {
+            overdue = MAX(overdue, now-job.time);
+        }
+    }
+
+    return overdue;
+}
+
+- (NSDictionary *)metricsForAccount:(FHSTwitterEngine *)engine {
+    __block NSDictionary *metrics = nil;
+    dispatch_sync(_queue, ^{
+        FHSPollAccount *account = [self.accountsByEngine objectForKey:engine];
+
+        if (!account) {
+            return;
+        }
+
+        NSMutableDictionary *values = [NSMutableDictionary dictionary];
+        values[FHSPollLagKey] = @(account.lag);
+        values[FHSPollAverageLagKey] = @(account.averageLag);
+        values[FHSPollOverdueKey] = self.running?@([self overdueForAccount:account now:CFAbsoluteTimeGetCurrent()]):@0;
+        values[FHSPollItemCountKey] = @(account.itemCount);
+        values[FHSPollErrorCountKey] = @(account.errorCount);
+
+        if (account.lastPollDate) {
+            values[FHSPollLastPollDateKey] = account.lastPollDate;
+        }
+
+        metrics = values;
+    });
+    return metrics;
+}
+
+- (NSTimeInterval)lag {
+    __block NSTimeInterval lag = 0;
+    dispatch_sync(_queue, ^{
+        if (!self.running) {
+            return;
+        }
+
+        CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+
+        for (FHSPollAccount *account in self.accountsByEngine.objectEnumerator) {
+            lag = MAX(lag, [self overdueForAccount:account now:now]);
+        }
+    });
+    return lag;
+}
+
+//
+// Scheduling
+//
+
+- (void)start {
+    dispatch_async(_queue, ^{
+        if (self.running) {
+            return;
+        }
+
+        self.running = YES;
+
+        while (self.workers.count < MAX(self.workerCount, 1)) {
+            FHSPollWorker *worker = [[FHSPollWorker alloc]init];
+            worker.jobs = [NSMutableArray array];
+            [self.workers addObject:worker];
+        }
+
+        self.timer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, self.queue);
+        __weak FHSPollScheduler *weakSelf = self;
+        dispatch_source_set_event_handler(self.timer, ^{
+            [weakSelf dispatchDueJobs];
+        });
+        dispatch_source_set_timer(self.timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+        dispatch_resume(self.timer);
+
+        [self dispatchDueJobs];
+    });
+}
+
+- (void)stop {
+    dispatch_async(_queue, ^{
+        if (!self.running) {
+            return;
+        }
+
+        self.running = NO;
+        dispatch_source_cancel(self.timer);
+        self.timer = nil;
+
+        // Due jobs go back to the heap, keeping their time
+        for (FHSPollWorker *worker in self.workers) {
+            for (FHSPollJob *job in worker.jobs) {
+                job.waiting = NO;
+                [self enqueueJob:job];
+            }
+            [worker.jobs removeAllObjects];
+        }
+    });
+}
+
+- (void)enqueueJob:(FHSPollJob *)job {
+    if (job.removed) {
+        return;
+    }
+
+    size_t needed = (_heapCount+1)*sizeof(fhs_poll_entry);
+
+    if (_heap.length < needed) {
+        _heap.length = MAX(needed, _heap.length*2);
+    }
+
+    // Yield expected by the time the job is due
+    double elapsed = job.time-job.lastPollTime;
+    double yield = (job.lastPollTime > 0)?job.yieldRate*elapsed:HUGE_VAL;
+
+    fhs_poll_heap_push(_heap.mutableBytes, _heapCount, (fhs_poll_entry){ job.time, yield, job.index });
+    _heapCount++;
+    job.waiting = YES;
+}
+
+// Moves the due jobs to their worker queues, starts idle workers and sets the timer for the next job
+- (void)dispatchDueJobs {
+    if (!_running) {
+        return;
+    }
+
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    fhs_poll_entry *heap = _heap.mutableBytes;
+    NSMutableArray *due = [NSMutableArray array];
+
+    while (_heapCount > 0 && heap[0].time <= now) {
+        fhs_poll_entry entry = fhs_poll_heap_pop(heap, _heapCount);
+        _heapCount--;
+
+        FHSPollJob *job = _jobs[entry.job];
+
+        if (job.removed) {
+            job.waiting = NO;
+            continue;
+        }
+
+        job.expectedYield = (job.lastPollTime > 0)?job.yieldRate*(now-job.lastPollTime):HUGE_VAL;
+        [due addObject:job];
+    }
+
+    [due sortUsingComparator:^NSComparisonResult(FHSPollJob *a, FHSPollJob *b) {
+        return (a.expectedYield > b.expectedYield)?NSOrderedAscending:((a.expectedYield < b.expectedYield)?NSOrderedDescending:NSOrderedSame);
+    }];
+
+    for (FHSPollJob *job in due) {
+        FHSPollWorker *worker = _workers[job.account.worker%_workers.count];
+        [worker.jobs addObject:job];
+    }
+
+    // Owners first, so stealing only takes what they can't
+    for (FHSPollWorker *worker in _workers) {
+        if (!worker.busy && worker.jobs.count > 0) {
+            [self runWorker:worker];
+        }
+    }
+
+    for (FHSPollWorker *worker in _workers) {
+        if (!worker.busy) {
+            [self runWorker:worker];
+
+            if (!worker.busy) {
+                break; // nothing left to steal
+            }
+        }
+    }
+
+    if (_heapCount > 0) {
+        int64_t delay = (int64_t)(MAX(heap[0].time-now, 0)*NSEC_PER_SEC);
+        dispatch_source_set_timer(_timer, dispatch_time(DISPATCH_TIME_NOW, delay), DISPATCH_TIME_FOREVER, (uint64_t)(0.05*NSEC_PER_SEC));
+    } else {
+        dispatch_source_set_timer(_timer, DISPATCH_TIME_FOREVER, DISPATCH_TIME_FOREVER, 0);
+    }
+}
+
+// Next job for a worker: the head of its own queue, or the tail of the longest other queue
+- (FHSPollJob *)takeJobForWorker:(FHSPollWorker *)worker {
+    while (YES) {
+        FHSPollWorker *source = worker;
+        FHSPollJob *job = nil;
+
+        if (worker.jobs.count == 0) {
+            for (FHSPollWorker *other in _workers) {
+                if (other.jobs.count > source.jobs.count) {
+                    source = other;
+                }
+            }
+        }
+
+        if (source.jobs.count == 0) {
+            return nil;
+        }
+
+        if (source == worker) {
+            job = source.jobs.firstObject;
+            [source.jobs removeObjectAtIndex:0];
+        } else {
+            job = source.jobs.lastObject;
+            [source.jobs removeLastObject];
+        }
+
+        job.waiting = NO;
+
+        if (!job.removed) {
+            return job;
+        }
+    }
+}
+
+- (void)runWorker:(FHSPollWorker *)worker {
+    FHSPollJob *job = _running?[self takeJobForWorker:worker]:nil;
+
+    if (!job) {
+        worker.busy = NO;
+        return;
+    }
+
+    worker.busy = YES;
+
+    FHSPollAccount *account = job.account;
+    CFAbsoluteTime start = CFAbsoluteTimeGetCurrent();
+    account.lag = MAX(start-job.time, 0);
+    account.averageLag = (account.lastPollDate)?account.averageLag+averageWeight*(account.lag-account.averageLag):account.lag;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id result = [job.sync sync];
+
+            dispatch_async(self.queue, ^{
+                [self finishJob:job result:result start:start];
+                [self runWorker:worker];
+            });
+        }
+    });
+}
+
+- (void)finishJob:(FHSPollJob *)job result:(id)result start:(CFAbsoluteTime)start {
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    FHSPollAccount *account = job.account;
+    NSTimeInterval delay = job.interval;
+
+    if ([result isKindOfClass:[NSError class]]) {
+        NSDate *resetDate = [result userInfo][FHSRateLimitResetDateKey];
+        account.errorCount++;
+
+        if (resetDate) {
+            delay = MAX(delay, resetDate.timeIntervalSinceReferenceDate+1.0-now);
+        } else {
+            job.failures++;
+            delay = MIN(job.interval*pow(2.0, (double)MIN(job.failures, 16)), MAX(maxBackoff, job.interval));
+        }
+    } else {
+        NSUInteger count = [result isKindOfClass:[NSArray class]]?[result count]:0;
+        account.itemCount += count;
+        job.failures = 0;
+
+        if (job.lastPollTime > 0) {
+            double rate = count/MAX(start-job.lastPollTime, 1.0);
+            job.yieldRate += averageWeight*(rate-job.yieldRate);
+        }
+
+        job.lastPollTime = start;
+    }
+
+    // Spread what's left of the window over the rest of it, or wait for the reset once it's spent
+    NSDictionary *limit = [job.sync.engine rateLimitForURL:job.sync.url];
+    NSTimeInterval untilReset = [limit[FHSRateLimitResetDateKey] timeIntervalSinceReferenceDate]-now;
+
+    if (limit && untilReset > 0) {
+        NSUInteger remaining = [limit[FHSRateLimitRemainingKey] unsignedIntegerValue];
+        delay = MAX(delay, (remaining == 0)?untilReset+1.0:untilReset/remaining);
+    }
+
+    account.lastPollDate = [NSDate date];
+    job.time = now+delay;
+    [self enqueueJob:job];
+
+    if (_running) {
+        [self dispatchDueJobs];
+    }
+
+    FHSPollBlock block = _block;
+
+    if (block) {
+        FHSTimelineSync *sync = job.sync;
+        dispatch_async(_callbackQueue, ^{
+            block(sync, result);
+        });
+    }
+}
+
+@end
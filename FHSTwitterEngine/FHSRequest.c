@@ -0,0 +1,160 @@
+//
+//  FHSRequest.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSRequest.h"
+#include "FHSBase64.h"
+#include "FHSPercentEncoding.h"
+#include "FHSNonce.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Makes room for length more bytes plus the terminator
+static int fhs_request_buffer_reserve(fhs_request_buffer *buffer, size_t length) {
+    if (length > (size_t)-1-buffer->length-1) {
+        return -1;
+    }
+
+    size_t needed = buffer->length+length+1;
+
+    if (needed <= buffer->capacity) {
+        return 0;
+    }
+
+    size_t capacity = buffer->capacity?buffer->capacity:256;
+
+    while (capacity < needed) {
+        capacity = (capacity > (size_t)-1/2)?needed:capacity*2;
+    }
+
+    char *data = realloc(buffer->data, capacity);
+
+    if (!data) {
+        return -1;
+    }
+
+    buffer->data = data;
+    buffer->capacity = capacity;
+    return 0;
+}
+
+int fhs_request_buffer_append(fhs_request_buffer *buffer, const void *bytes, size_t length) {
+    if (fhs_request_buffer_reserve(buffer, length) != 0) {
+        return -1;
+    }
+
+    if (length > 0) {
+        memcpy(buffer->data+buffer->length, bytes, length);
+    }
+
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+    return 0;
+}
+
+void fhs_request_buffer_free(fhs_request_buffer *buffer) {
+    free(buffer->data);
+    memset(buffer, 0, sizeof(*buffer));
+}
+
+static int fhs_request_append_encoded(fhs_request_buffer *buffer, const char *bytes, size_t length) {
+    // 3 bytes per input byte at most, so reserving that skips the length pass
+    if (length > ((size_t)-1)/3 || fhs_request_buffer_reserve(buffer, length*3) != 0) {
+        return -1;
+    }
+
+    buffer->length += fhs_percent_encode(bytes, length, buffer->data+buffer->length);
+    buffer->data[buffer->length] = '\0';
+    return 0;
+}
+
+size_t fhs_request_base_length(const char *url, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (url[i] == '?' || url[i] == '#') {
+            return i;
+        }
+    }
+    return length;
+}
+
+int fhs_request_append_form(fhs_request_buffer *buffer, const fhs_request_param *params, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        if (i > 0 && fhs_request_buffer_append(buffer, "&", 1) != 0) {
+            return -1;
+        }
+
+        if (fhs_request_append_encoded(buffer, params[i].key, params[i].keyLength) != 0
+            || fhs_request_buffer_append(buffer, "=", 1) != 0
+            || fhs_request_append_encoded(buffer, params[i].value, params[i].valueLength) != 0) {
+            return -1;
+        }
+    }
+
+    // An empty form still leaves a terminated buffer
+    return fhs_request_buffer_append(buffer, NULL, 0);
+}
+
+int fhs_request_append_base64_form(fhs_request_buffer *buffer, const fhs_request_param *param) {
+    if (fhs_request_append_encoded(buffer, param->key, param->keyLength) != 0 || fhs_request_buffer_append(buffer, "=", 1) != 0) {
+        return -1;
+    }
+
+    fhs_base64_stream stream;
+    fhs_base64_stream_init(&stream);
+
+    char base64[4096]; // 3072 bytes plus two carried over make at most 1024 groups
+    const char *bytes = param->value;
+    size_t remaining = param->valueLength;
+
+    while (remaining > 0 || stream.carryLength > 0) {
+        size_t chunk = (remaining < 3072)?remaining:3072;
+        size_t length = (chunk > 0)?fhs_base64_stream_update(&stream, bytes, chunk, base64):fhs_base64_stream_final(&stream, base64);
+        bytes += chunk;
+        remaining -= chunk;
+
+        // '+', '/' and '=' need encoding
+        if (fhs_request_append_encoded(buffer, base64, length) != 0) {
+            return -1;
+        }
+    }
+
+    return fhs_request_buffer_append(buffer, NULL, 0);
+}
+
+int fhs_request_build_url(fhs_request_buffer *buffer, const char *url, size_t length, const fhs_request_param *params, size_t count) {
+    if (fhs_request_buffer_append(buffer, url, fhs_request_base_length(url, length)) != 0) {
+        return -1;
+    }
+
+    if (count == 0) {
+        return 0;
+    }
+
+    if (fhs_request_buffer_append(buffer, "?", 1) != 0) {
+        return -1;
+    }
+
+    return fhs_request_append_form(buffer, params, count);
+}
+
+const char *fhs_request_sign(const fhs_oauth_key *key, const char *method, const char *url, size_t urlLength, const char *body, size_t bodyLength, size_t *headerLength) {
+    char nonce[FHS_NONCE_LENGTH+1];
+    fhs_nonce(nonce);
+
+    fhs_oauth_request request;
+    memset(&request, 0, sizeof(request));
+    request.method = method;
+    request.url = url;
+    request.urlLength = urlLength;
+    request.body = body;
+    request.bodyLength = body?bodyLength:0;
+    request.nonce = nonce;
+    request.timestamp = (long)time(NULL);
+
+    return fhs_oauth_sign(key, &request, headerLength);
+}
@@ -0,0 +1,110 @@
+//
+//  FHSRequest.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Request building without Foundation objects: query strings, form bodies
+//  and signed Authorization headers, for the headless core. Send the result
+//  with any HTTP client.
+//
+
+#ifndef FHSREQUEST_H
+#define FHSREQUEST_H
+
+#include <stddef.h>
+
+#include "FHSOAuthSigner.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Growable byte buffer. Zero it before the first use and free data when done.
+ The contents are kept NUL-terminated.
+ */
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} fhs_request_buffer;
+
+/**
+ Request parameter. Keys and values are UTF-8 and are percent-encoded when appended.
+ */
+typedef struct {
+    const char *key;
+    size_t keyLength;
+    const char *value;
+    size_t valueLength;
+} fhs_request_param;
+
+/**
+ Append bytes to a buffer.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_request_buffer_append(fhs_request_buffer *buffer, const void *bytes, size_t length);
+
+/**
+ Free a buffer's data and zero it.
+ */
+void fhs_request_buffer_free(fhs_request_buffer *buffer);
+
+/**
+ Length of a URL without its query string and fragment.
+ @param url URL.
+ @param length Length of the URL.
+ @return Length up to the first '?' or '#'.
+ */
+size_t fhs_request_base_length(const char *url, size_t length);
+
+/**
+ Append parameters as key=value pairs joined by '&', the form of both query
+ strings and application/x-www-form-urlencoded bodies.
+ @param buffer Buffer.
+ @param params Parameters.
+ @param count Number of parameters.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_request_append_form(fhs_request_buffer *buffer, const fhs_request_param *params, size_t count);
+
+/**
+ Append a parameter as key=value with the value's bytes base 64 encoded, then
+ percent-encoded. The value is encoded a chunk at a time straight into the
+ buffer, without a copy of the whole base 64 string.
+ @param buffer Buffer.
+ @param param Parameter, its value is binary.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_request_append_base64_form(fhs_request_buffer *buffer, const fhs_request_param *param);
+
+/**
+ Build a URL from a base URL and query parameters. A query already on the base URL is replaced.
+ @param buffer Buffer the URL is appended to.
+ @param url Base URL.
+ @param length Length of the base URL.
+ @param params Parameters, may be NULL if count is 0.
+ @param count Number of parameters.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_request_build_url(fhs_request_buffer *buffer, const char *url, size_t length, const fhs_request_param *params, size_t count);
+
+/**
+ Sign a request with a fresh nonce and the current time.
+ @param key Signing key.
+ @param method HTTP method.
+ @param url Request URL, with its query string.
+ @param urlLength Length of the URL.
+ @param body Form body, or NULL for none or for multipart bodies, which aren't signed.
+ @param bodyLength Length of the body.
+ @param headerLength Set to the length of the returned header.
+ @return Authorization header value, valid until the next signing on the same thread. NULL if out of memory.
+ */
+const char *fhs_request_sign(const fhs_oauth_key *key, const char *method, const char *url, size_t urlLength, const char *body, size_t bodyLength, size_t *headerLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,641 @@
+//
+//  FHSSHA1.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSSHA1.h"
+
+#include <pthread.h>
+#include <string.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <immintrin.h>
+#define FHS_SHA1_X86 1
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#include <arm_neon.h>
+#define FHS_SHA1_ARMV8 1
+#if defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+#endif
+
+#define ROL(x, n) (((x) << (n)) | ((x) >> (32-(n))))
+
+// The backend can be switched while other threads hash, so it's read and written as one atomic pointer
+#if defined(__GNUC__) || defined(__clang__)
+#define FHS_ATOMIC_LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define FHS_ATOMIC_STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+#else
+#define FHS_ATOMIC_LOAD(p) (*(p))
+#define FHS_ATOMIC_STORE(p, v) (*(p) = (v))
+#endif
+
+static inline uint32_t fhs_load_be32(const uint8_t *p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+static inline void fhs_store_be32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+//
+// Portable
+//
+
+static void fhs_sha1_blocks_portable(uint32_t state[5], const uint8_t *blocks, size_t count) {
+    while (count--) {
+        uint32_t w[16];
+        for (int i = 0; i < 16; i++) {
+            w[i] = fhs_load_be32(blocks+i*4);
+        }
+
+        uint32_t a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        for (int t = 0; t < 80; t++) {
+            uint32_t f, k;
+            if (t >= 16) {
+                uint32_t x = w[(t+13) & 15] ^ w[(t+8) & 15] ^ w[(t+2) & 15] ^ w[t & 15];
+                w[t & 15] = ROL(x, 1);
+            }
+
+            if (t < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (t < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (t < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+
+            uint32_t temp = ROL(a, 5)+f+e+k+w[t & 15];
+            e = d;
+            d = c;
+            c = ROL(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        blocks += FHS_SHA1_BLOCK_LENGTH;
+    }
+}
+
+//
+// x86 SHA extensions
+//
+
+#if FHS_SHA1_X86
+
+// Message words for rounds 4g..4g+3, kept in a ring of four vectors
+#define FHS_SHANI_SCHEDULE(g) \
+    M[(g) & 3] = _mm_sha1msg2_epu32(_mm_xor_si128(_mm_sha1msg1_epu32(M[(g) & 3], M[((g)+1) & 3]), M[((g)+2) & 3]), M[((g)+3) & 3])
+
+#define FHS_SHANI_ROUNDS(g, f) \
+    E = _mm_sha1nexte_epu32(saved, M[(g) & 3]); \
+    saved = ABCD; \
+    ABCD = _mm_sha1rnds4_epu32(ABCD, E, f)
+
+__attribute__((target("sha,sse4.1,ssse3")))
+static void fhs_sha1_blocks_shani(uint32_t state[5], const uint8_t *blocks, size_t count) {
+    const __m128i mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+
+    __m128i ABCD = _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)state), 0x1B);
+    __m128i E0 = _mm_set_epi32((int)state[4], 0, 0, 0);
+
+    while (count--) {
+        __m128i ABCDSave = ABCD;
+        __m128i E0Save = E0;
+        __m128i M[4], E, saved;
+
+        for (int i = 0; i < 4; i++) {
+            M[i] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(blocks+i*16)), mask);
+        }
+
+        E = _mm_add_epi32(E0, M[0]);
+        saved = ABCD;
+        ABCD = _mm_sha1rnds4_epu32(ABCD, E, 0);
+
+        FHS_SHANI_ROUNDS(1, 0);
+        FHS_SHANI_ROUNDS(2, 0);
+        FHS_SHANI_ROUNDS(3, 0);
+        FHS_SHANI_SCHEDULE(4); FHS_SHANI_ROUNDS(4, 0);
+        FHS_SHANI_SCHEDULE(5); FHS_SHANI_ROUNDS(5, 1);
+        FHS_SHANI_SCHEDULE(6); FHS_SHANI_ROUNDS(6, 1);
+        FHS_SHANI_SCHEDULE(7); FHS_SHANI_ROUNDS(7, 1);
+        FHS_SHANI_SCHEDULE(8); FHS_SHANI_ROUNDS(8, 1);
+        FHS_SHANI_SCHEDULE(9); FHS_SHANI_ROUNDS(9, 1);
+        FHS_SHANI_SCHEDULE(10); FHS_SHANI_ROUNDS(10, 2);
+        FHS_SHANI_SCHEDULE(11); FHS_SHANI_ROUNDS(11, 2);
+        FHS_SHANI_SCHEDULE(12); FHS_SHANI_ROUNDS(12, 2);
+        FHS_SHANI_SCHEDULE(13); FHS_SHANI_ROUNDS(13, 2);
+        FHS_SHANI_SCHEDULE(14); FHS_SHANI_ROUNDS(14, 2);
+        FHS_SHANI_SCHEDULE(15); FHS_SHANI_ROUNDS(15, 3);
+        FHS_SHANI_SCHEDULE(16); FHS_SHANI_ROUNDS(16, 3);
+        FHS_SHANI_SCHEDULE(17); FHS_SHANI_ROUNDS(17, 3);
+        FHS_SHANI_SCHEDULE(18); FHS_SHANI_ROUNDS(18, 3);
+        FHS_SHANI_SCHEDULE(19); FHS_SHANI_ROUNDS(19, 3);
+
+        E0 = _mm_sha1nexte_epu32(saved, E0Save);
+        ABCD = _mm_add_epi32(ABCD, ABCDSave);
+        blocks += FHS_SHA1_BLOCK_LENGTH;
+    }
+
+    _mm_storeu_si128((__m128i *)state, _mm_shuffle_epi32(ABCD, 0x1B));
+    state[4] = (uint32_t)_mm_extract_epi32(E0, 3);
+}
+
+static int fhs_sha1_has_shani(void) {
+    unsigned int eax, ebx, ecx, edx;
+
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    int sse41 = (ecx & bit_SSE4_1) != 0;
+    int ssse3 = (ecx & bit_SSSE3) != 0;
+
+    if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx)) {
+        return 0;
+    }
+
+    return sse41 && ssse3 && (ebx & (1u << 29)) != 0;
+}
+
+#endif
+
+//
+// ARMv8 cryptography extensions
+//
+
+#if FHS_SHA1_ARMV8
+
+#define FHS_ARMV8_SCHEDULE(g) \
+    M[(g) & 3] = vsha1su1q_u32(vsha1su0q_u32(M[(g) & 3], M[((g)+1) & 3], M[((g)+2) & 3]), M[((g)+3) & 3])
+
+#define FHS_ARMV8_ROUNDS(g, op, k) \
+    wk = vaddq_u32(M[(g) & 3], k); \
+    e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0)); \
+    abcd = op(abcd, e0, wk); \
+    e0 = e1
+
+// Built for the crypto extensions whatever the build targets, and only called once the CPU reports them
+#if defined(__clang__)
+__attribute__((target("crypto")))
+#else
+__attribute__((target("+crypto")))
+#endif
+static void fhs_sha1_blocks_armv8(uint32_t state[5], const uint8_t *blocks, size_t count) {
+    const uint32x4_t k0 = vdupq_n_u32(0x5A827999);
+    const uint32x4_t k1 = vdupq_n_u32(0x6ED9EBA1);
+    const uint32x4_t k2 = vdupq_n_u32(0x8F1BBCDC);
+    const uint32x4_t k3 = vdupq_n_u32(0xCA62C1D6);
+
+    uint32x4_t abcd = vld1q_u32(state);
+    uint32_t e = state[4];
+
+    while (count--) {
+        uint32x4_t abcdSave = abcd;
+        uint32_t e0 = e, e1;
+        uint32x4_t M[4], wk;
+
+        for (int i = 0; i < 4; i++) {
+            M[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks+i*16)));
+        }
+
+        FHS_ARMV8_ROUNDS(0, vsha1cq_u32, k0);
+        FHS_ARMV8_ROUNDS(1, vsha1cq_u32, k0);
+        FHS_ARMV8_ROUNDS(2, vsha1cq_u32, k0);
+        FHS_ARMV8_ROUNDS(3, vsha1cq_u32, k0);
+        FHS_ARMV8_SCHEDULE(4); FHS_ARMV8_ROUNDS(4, vsha1cq_u32, k0);
+        FHS_ARMV8_SCHEDULE(5); FHS_ARMV8_ROUNDS(5, vsha1pq_u32, k1);
+        FHS_ARMV8_SCHEDULE(6); FHS_ARMV8_ROUNDS(6, vsha1pq_u32, k1);
+        FHS_ARMV8_SCHEDULE(7); FHS_ARMV8_ROUNDS(7, vsha1pq_u32, k1);
+        FHS_ARMV8_SCHEDULE(8); FHS_ARMV8_ROUNDS(8, vsha1pq_u32, k1);
+        FHS_ARMV8_SCHEDULE(9); FHS_ARMV8_ROUNDS(9, vsha1pq_u32, k1);
+        FHS_ARMV8_SCHEDULE(10); FHS_ARMV8_ROUNDS(10, vsha1mq_u32, k2);
+        FHS_ARMV8_SCHEDULE(11); FHS_ARMV8_ROUNDS(11, vsha1mq_u32, k2);
+        FHS_ARMV8_SCHEDULE(12); FHS_ARMV8_ROUNDS(12, vsha1mq_u32, k2);
+        FHS_ARMV8_SCHEDULE(13); FHS_ARMV8_ROUNDS(13, vsha1mq_u32, k2);
+        FHS_ARMV8_SCHEDULE(14); FHS_ARMV8_ROUNDS(14, vsha1mq_u32, k2);
+        FHS_ARMV8_SCHEDULE(15); FHS_ARMV8_ROUNDS(15, vsha1pq_u32, k3);
+        FHS_ARMV8_SCHEDULE(16); FHS_ARMV8_ROUNDS(16, vsha1pq_u32, k3);
+        FHS_ARMV8_SCHEDULE(17); FHS_ARMV8_ROUNDS(17, vsha1pq_u32, k3);
+        FHS_ARMV8_SCHEDULE(18); FHS_ARMV8_ROUNDS(18, vsha1pq_u32, k3);
+        FHS_ARMV8_SCHEDULE(19); FHS_ARMV8_ROUNDS(19, vsha1pq_u32, k3);
+
+        abcd = vaddq_u32(abcd, abcdSave);
+        e += e0;
+        blocks += FHS_SHA1_BLOCK_LENGTH;
+    }
+
+    vst1q_u32(state, abcd);
+    state[4] = e;
+}
+
+static int fhs_sha1_has_armv8(void) {
+#if defined(__linux__) && defined(HWCAP_SHA1)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA1) != 0;
+#elif defined(__APPLE__) || defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_SHA2)
+    return 1; // every 64-bit Apple core has the SHA-1 instructions, elsewhere the build's target says so
+#else
+    return 0;
+#endif
+}
+
+#endif
+
+//
+// Backend selection
+//
+
+static fhs_sha1_block_fn detectedBlocks = fhs_sha1_blocks_portable;
+static const char *detectedName = "portable";
+static fhs_sha1_block_fn sha1Blocks = NULL;
+static const char *sha1Name = NULL;
+static pthread_once_t detectOnce = PTHREAD_ONCE_INIT;
+
+static void fhs_sha1_detect(void) {
+#if FHS_SHA1_X86
+    if (fhs_sha1_has_shani()) {
+        detectedBlocks = fhs_sha1_blocks_shani;
+        detectedName = "sha-ni";
+    }
+#elif FHS_SHA1_ARMV8
+    if (fhs_sha1_has_armv8()) {
+        detectedBlocks = fhs_sha1_blocks_armv8;
+        detectedName = "armv8";
+    }
+#endif
+
+    if (!FHS_ATOMIC_LOAD(&sha1Blocks)) {
+        FHS_ATOMIC_STORE(&sha1Name, detectedName);
+        FHS_ATOMIC_STORE(&sha1Blocks, detectedBlocks);
+    }
+}
+
+static inline fhs_sha1_block_fn fhs_sha1_blocks(void) {
+    pthread_once(&detectOnce, fhs_sha1_detect);
+    return FHS_ATOMIC_LOAD(&sha1Blocks);
+}
+
+void fhs_sha1_set_backend(fhs_sha1_block_fn fn) {
+    pthread_once(&detectOnce, fhs_sha1_detect);
+    FHS_ATOMIC_STORE(&sha1Name, fn?"custom":detectedName);
+    FHS_ATOMIC_STORE(&sha1Blocks, fn?fn:detectedBlocks);
+}
+
+int fhs_sha1_use_backend(FHSSHA1Backend backend) {
+    fhs_sha1_block_fn fn = NULL;
+    const char *name = NULL;
+
+    pthread_once(&detectOnce, fhs_sha1_detect);
+
+    switch (backend) {
+        case FHSSHA1BackendDetected:
+            fn = detectedBlocks;
+            name = detectedName;
+            break;
+        case FHSSHA1BackendPortable:
+            fn = fhs_sha1_blocks_portable;
+            name = "portable";
+            break;
+#if FHS_SHA1_X86
+        case FHSSHA1BackendSHANI:
+            fn = fhs_sha1_has_shani()?fhs_sha1_blocks_shani:NULL;
+            name = "sha-ni";
+            break;
+#endif
+#if FHS_SHA1_ARMV8
+        case FHSSHA1BackendARMv8:
+            fn = fhs_sha1_has_armv8()?fhs_sha1_blocks_armv8:NULL;
+            name = "armv8";
+            break;
+#endif
+        default:
+            break;
+    }
+
+    if (!fn) {
+        return -1;
+    }
+
+    FHS_ATOMIC_STORE(&sha1Name, name);
+    FHS_ATOMIC_STORE(&sha1Blocks, fn);
+    return 0;
+}
+
+const char *fhs_sha1_backend_name(void) {
+    pthread_once(&detectOnce, fhs_sha1_detect);
+    return FHS_ATOMIC_LOAD(&sha1Name);
+}
+
+//
+// SHA-1
+//
+
+void fhs_sha1_init(fhs_sha1_ctx *ctx) {
+    ctx->state[0] = 0x67452301;
+    ctx->state[1] = 0xEFCDAB89;
+    ctx->state[2] = 0x98BADCFE;
+    ctx->state[3] = 0x10325476;
+    ctx->state[4] = 0xC3D2E1F0;
+    ctx->length = 0;
+    ctx->bufferLength = 0;
+}
+
+void fhs_sha1_update(fhs_sha1_ctx *ctx, const void *data, size_t length) {
+    fhs_sha1_block_fn blocks = fhs_sha1_blocks();
+    const uint8_t *p = data;
+    ctx->length += length;
+
+    if (ctx->bufferLength > 0) {
+        size_t n = FHS_SHA1_BLOCK_LENGTH-ctx->bufferLength;
+        if (n > length) {
+            n = length;
+        }
+        memcpy(ctx->buffer+ctx->bufferLength, p, n);
+        ctx->bufferLength += n;
+        p += n;
+        length -= n;
+
+        if (ctx->bufferLength < FHS_SHA1_BLOCK_LENGTH) {
+            return;
+        }
+
+        blocks(ctx->state, ctx->buffer, 1);
+        ctx->bufferLength = 0;
+    }
+
+    size_t whole = length/FHS_SHA1_BLOCK_LENGTH;
+    if (whole > 0) {
+        blocks(ctx->state, p, whole);
+        p += whole*FHS_SHA1_BLOCK_LENGTH;
+        length -= whole*FHS_SHA1_BLOCK_LENGTH;
+    }
+
+    if (length > 0) {
+        memcpy(ctx->buffer, p, length);
+        ctx->bufferLength = length;
+    }
+}
+
+void fhs_sha1_final(fhs_sha1_ctx *ctx, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]) {
+    fhs_sha1_block_fn blocks = fhs_sha1_blocks();
+    uint64_t bits = ctx->length*8;
+    size_t n = ctx->bufferLength;
+
+    ctx->buffer[n++] = 0x80;
+
+    if (n > 56) {
+        memset(ctx->buffer+n, 0, FHS_SHA1_BLOCK_LENGTH-n);
+        blocks(ctx->state, ctx->buffer, 1);
+        n = 0;
+    }
+
+    memset(ctx->buffer+n, 0, 56-n);
+    fhs_store_be32(ctx->buffer+56, (uint32_t)(bits >> 32));
+    fhs_store_be32(ctx->buffer+60, (uint32_t)bits);
+    blocks(ctx->state, ctx->buffer, 1);
+
+    for (int i = 0; i < 5; i++) {
+        fhs_store_be32(digest+i*4, ctx->state[i]);
+    }
+
+    memset(ctx, 0, sizeof(fhs_sha1_ctx));
+}
+
+void fhs_sha1(const void *data, size_t length, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]) {
+    fhs_sha1_ctx ctx;
+    fhs_sha1_init(&ctx);
+    fhs_sha1_update(&ctx, data, length);
+    fhs_sha1_final(&ctx, digest);
+}
+
+//
+// HMAC-SHA1
+//
+
+void fhs_hmac_sha1_init(fhs_hmac_sha1_ctx *ctx, const void *key, size_t keyLength) {
+    uint8_t block[FHS_SHA1_BLOCK_LENGTH] = {0};
+
+    if (keyLength > FHS_SHA1_BLOCK_LENGTH) {
+        fhs_sha1(key, keyLength, block);
+    } else if (keyLength > 0) {
+        memcpy(block, key, keyLength);
+    }
+
+    for (int i = 0; i < FHS_SHA1_BLOCK_LENGTH; i++) {
+        block[i] ^= 0x36;
+    }
+    fhs_sha1_init(&ctx->inner);
+    fhs_sha1_update(&ctx->inner, block, FHS_SHA1_BLOCK_LENGTH);
+
+    for (int i = 0; i < FHS_SHA1_BLOCK_LENGTH; i++) {
+        block[i] ^= 0x36^0x5C;
+    }
+    fhs_sha1_init(&ctx->outer);
+    fhs_sha1_update(&ctx->outer, block, FHS_SHA1_BLOCK_LENGTH);
+
+    memset(block, 0, sizeof(block));
+}
+
+void fhs_hmac_sha1_update(fhs_hmac_sha1_ctx *ctx, const void *data, size_t length) {
+    fhs_sha1_update(&ctx->inner, data, length);
+}
+
+void fhs_hmac_sha1_final(fhs_hmac_sha1_ctx *ctx, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]) {
+    uint8_t innerDigest[FHS_SHA1_DIGEST_LENGTH];
+    fhs_sha1_final(&ctx->inner, innerDigest);
+    fhs_sha1_update(&ctx->outer, innerDigest, FHS_SHA1_DIGEST_LENGTH);
+    fhs_sha1_final(&ctx->outer, digest);
+}
+
+void fhs_hmac_sha1(const void *key, size_t keyLength, const void *data, size_t length, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]) {
+    fhs_hmac_sha1_ctx ctx;
+    fhs_hmac_sha1_init(&ctx, key, keyLength);
+    fhs_hmac_sha1_update(&ctx, data, length);
+    fhs_hmac_sha1_final(&ctx, digest);
+}
+
+//
+// Multi-buffer HMAC-SHA1: four messages per pass, one per 32-bit vector lane.
+// Lanes that run out of blocks early keep their state through a blend mask.
+//
+
+#if defined(__GNUC__) || defined(__clang__)
+
+typedef uint32_t fhs_v4 __attribute__((vector_size(16)));
+
+#define VROL(x, n) (((x) << (n)) | ((x) >> (32-(n))))
+
+typedef struct {
+    const uint8_t *data;  // whole blocks taken straight from the message
+    size_t dataBlocks;
+    uint8_t tail[2*FHS_SHA1_BLOCK_LENGTH]; // remaining bytes plus padding
+    size_t blocks;        // total blocks, data plus tail
+} fhs_sha1_lane;
+
+static void fhs_sha1_lane_prepare(fhs_sha1_lane *lane, const uint8_t *message, size_t length, uint64_t prefixLength) {
+    size_t whole = length/FHS_SHA1_BLOCK_LENGTH;
+    size_t rest = length-whole*FHS_SHA1_BLOCK_LENGTH;
+    size_t tailLength = (rest+9 > FHS_SHA1_BLOCK_LENGTH)?2*FHS_SHA1_BLOCK_LENGTH:FHS_SHA1_BLOCK_LENGTH;
+    uint64_t bits = (prefixLength+length)*8;
+
+    memset(lane->tail, 0, tailLength);
+    memcpy(lane->tail, message+whole*FHS_SHA1_BLOCK_LENGTH, rest);
+    lane->tail[rest] = 0x80;
+    fhs_store_be32(lane->tail+tailLength-8, (uint32_t)(bits >> 32));
+    fhs_store_be32(lane->tail+tailLength-4, (uint32_t)bits);
+
+    lane->data = message;
+    lane->dataBlocks = whole;
+    lane->blocks = whole+tailLength/FHS_SHA1_BLOCK_LENGTH;
+}
+
+static inline const uint8_t *fhs_sha1_lane_block(const fhs_sha1_lane *lane, size_t i) {
+    if (i < lane->dataBlocks) {
+        return lane->data+i*FHS_SHA1_BLOCK_LENGTH;
+    }
+    if (i < lane->blocks) {
+        return lane->tail+(i-lane->dataBlocks)*FHS_SHA1_BLOCK_LENGTH;
+    }
+    return lane->tail; // finished lane, result is discarded by the mask
+}
+
+static void fhs_sha1_x4(fhs_v4 state[5], fhs_sha1_lane *lanes) {
+    size_t maxBlocks = 0;
+    for (int l = 0; l < 4; l++) {
+        if (lanes[l].blocks > maxBlocks) {
+            maxBlocks = lanes[l].blocks;
+        }
+    }
+
+    for (size_t i = 0; i < maxBlocks; i++) {
+        const uint8_t *p[4];
+        fhs_v4 active;
+        for (int l = 0; l < 4; l++) {
+            p[l] = fhs_sha1_lane_block(&lanes[l], i);
+            active[l] = (i < lanes[l].blocks)?0xFFFFFFFF:0;
+        }
+
+        fhs_v4 w[16];
+        for (int t = 0; t < 16; t++) {
+            fhs_v4 v = {fhs_load_be32(p[0]+t*4), fhs_load_be32(p[1]+t*4), fhs_load_be32(p[2]+t*4), fhs_load_be32(p[3]+t*4)};
+            w[t] = v;
+        }
+
+        fhs_v4 a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+
+        for (int t = 0; t < 80; t++) {
+            fhs_v4 f;
+            uint32_t k;
+            if (t >= 16) {
+                fhs_v4 x = w[(t+13) & 15] ^ w[(t+8) & 15] ^ w[(t+2) & 15] ^ w[t & 15];
+                w[t & 15] = VROL(x, 1);
+            }
+
+            if (t < 20) {
+                f = (b & c) | (~b & d);
+                k = 0x5A827999;
+            } else if (t < 40) {
+                f = b ^ c ^ d;
+                k = 0x6ED9EBA1;
+            } else if (t < 60) {
+                f = (b & c) | (b & d) | (c & d);
+                k = 0x8F1BBCDC;
+            } else {
+                f = b ^ c ^ d;
+                k = 0xCA62C1D6;
+            }
+
+            fhs_v4 temp = VROL(a, 5)+f+e+k+w[t & 15];
+            e = d;
+            d = c;
+            c = VROL(b, 30);
+            b = a;
+            a = temp;
+        }
+
+        state[0] += a & active;
+        state[1] += b & active;
+        state[2] += c & active;
+        state[3] += d & active;
+        state[4] += e & active;
+    }
+}
+
+static void fhs_hmac_sha1_x4(const fhs_hmac_sha1_ctx *key, const uint8_t *const *messages, const size_t *lengths, size_t count, uint8_t (*digests)[FHS_SHA1_DIGEST_LENGTH]) {
+    fhs_sha1_lane lanes[4];
+    fhs_v4 state[5];
+    uint8_t inner[4][FHS_SHA1_DIGEST_LENGTH];
+
+    // Inner hash continues from the keyed state, which has absorbed one block
+    for (int i = 0; i < 5; i++) {
+        state[i] = (fhs_v4){key->inner.state[i], key->inner.state[i], key->inner.state[i], key->inner.state[i]};
+    }
+    for (size_t l = 0; l < 4; l++) {
+        size_t m = (l < count)?l:0;
+        fhs_sha1_lane_prepare(&lanes[l], messages[m], lengths[m], FHS_SHA1_BLOCK_LENGTH);
+    }
+    fhs_sha1_x4(state, lanes);
+
+    for (int l = 0; l < 4; l++) {
+        for (int i = 0; i < 5; i++) {
+            fhs_store_be32(inner[l]+i*4, state[i][l]);
+        }
+    }
+
+    // Outer hash of each inner digest
+    for (int i = 0; i < 5; i++) {
+        state[i] = (fhs_v4){key->outer.state[i], key->outer.state[i], key->outer.state[i], key->outer.state[i]};
+    }
+    for (int l = 0; l < 4; l++) {
+        fhs_sha1_lane_prepare(&lanes[l], inner[l], FHS_SHA1_DIGEST_LENGTH, FHS_SHA1_BLOCK_LENGTH);
+    }
+    fhs_sha1_x4(state, lanes);
+
+    for (size_t l = 0; l < count; l++) {
+        for (int i = 0; i < 5; i++) {
+            fhs_store_be32(digests[l]+i*4, state[i][l]);
+        }
+    }
+}
+
+#endif
+
+void fhs_hmac_sha1_batch(const fhs_hmac_sha1_ctx *key, const void *const *messages, const size_t *lengths, size_t count, uint8_t (*digests)[FHS_SHA1_DIGEST_LENGTH]) {
+    size_t i = 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+    // Hardware SHA-1 beats four scalar lanes, so only interleave on the portable path
+    if (fhs_sha1_blocks() == fhs_sha1_blocks_portable) {
+        for (; i < count; i += 4) {
+            size_t n = (count-i < 4)?count-i:4;
+            fhs_hmac_sha1_x4(key, (const uint8_t *const *)messages+i, lengths+i, n, digests+i);
+        }
+        return;
+    }
+#endif
+
+    for (; i < count; i++) {
+        fhs_hmac_sha1_ctx ctx = *key;
+        fhs_hmac_sha1_update(&ctx, messages[i], lengths[i]);
+        fhs_hmac_sha1_final(&ctx, digests[i]);
+    }
+}
@@ -0,0 +1,109 @@
+//
+//  FHSSHA1.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Portable SHA-1 and HMAC-SHA1 (RFC 3174, RFC 2104) with hardware fast paths.
+//
+
+#ifndef FHSSHA1_H
+#define FHSSHA1_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FHS_SHA1_DIGEST_LENGTH 20
+#define FHS_SHA1_BLOCK_LENGTH 64
+
+/**
+ Block function, compresses a whole number of 64-byte blocks into the state.
+ */
+typedef void (*fhs_sha1_block_fn)(uint32_t state[5], const uint8_t *blocks, size_t count);
+
+/**
+ SHA-1 context.
+ */
+typedef struct {
+    uint32_t state[5];
+    uint64_t length; // total bytes hashed
+    uint8_t buffer[FHS_SHA1_BLOCK_LENGTH];
+    size_t bufferLength;
+} fhs_sha1_ctx;
+
+/**
+ HMAC-SHA1 context.
+ After fhs_hmac_sha1_init() the context holds the inner and outer states with
+ the padded key already absorbed; copy it to sign many messages with one key.
+ */
+typedef struct {
+    fhs_sha1_ctx inner;
+    fhs_sha1_ctx outer;
+} fhs_hmac_sha1_ctx;
+
+typedef enum {
+    FHSSHA1BackendDetected = 0, // picked at startup for this CPU
+    FHSSHA1BackendPortable,
+    FHSSHA1BackendSHANI,
+    FHSSHA1BackendARMv8
+} FHSSHA1Backend;
+
+/**
+ Switch to a built-in block function, e.g. to test the portable one and the
+ four-lane HMAC batch on a CPU that has SHA-1 instructions. Safe while other
+ threads hash: every block function gives the same result, and the switch is
+ a single atomic store.
+ @param backend Backend.
+ @return 0, or -1 if this build or CPU doesn't have it.
+ */
+int fhs_sha1_use_backend(FHSSHA1Backend backend);
+
+/**
+ Override the block function, e.g. to plug in a platform library. Safe while other threads hash, as above.
+ @param fn Block function, or NULL to restore the one detected at startup.
+ */
+void fhs_sha1_set_backend(fhs_sha1_block_fn fn);
+
+/**
+ Name of the block function in use: "portable", "sha-ni", "armv8" or "custom".
+ */
+const char *fhs_sha1_backend_name(void);
+
+void fhs_sha1_init(fhs_sha1_ctx *ctx);
+void fhs_sha1_update(fhs_sha1_ctx *ctx, const void *data, size_t length);
+void fhs_sha1_final(fhs_sha1_ctx *ctx, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]);
+
+/**
+ One-shot SHA-1.
+ */
+void fhs_sha1(const void *data, size_t length, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]);
+
+void fhs_hmac_sha1_init(fhs_hmac_sha1_ctx *ctx, const void *key, size_t keyLength);
+void fhs_hmac_sha1_update(fhs_hmac_sha1_ctx *ctx, const void *data, size_t length);
+void fhs_hmac_sha1_final(fhs_hmac_sha1_ctx *ctx, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]);
+
+/**
+ One-shot HMAC-SHA1.
+ */
+void fhs_hmac_sha1(const void *key, size_t keyLength, const void *data, size_t length, uint8_t digest[FHS_SHA1_DIGEST_LENGTH]);
+
+/**
+ HMAC-SHA1 of a batch of messages under one key.
+ Without hardware SHA-1 the messages are hashed four at a time, one per vector lane.
+ @param key Keyed context from fhs_hmac_sha1_init(), not modified.
+ @param messages Message pointers.
+ @param lengths Message lengths.
+ @param count Number of messages.
+ @param digests Output, one digest per message.
+ */
+void fhs_hmac_sha1_batch(const fhs_hmac_sha1_ctx *key, const void *const *messages, const size_t *lengths, size_t count, uint8_t (*digests)[FHS_SHA1_DIGEST_LENGTH]);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
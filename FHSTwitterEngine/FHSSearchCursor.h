@@ -0,0 +1,89 @@
+//
+//  FHSSearchCursor.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+/**
+ Iterator over every result of a search, newest first.
+ Pages go back with max_id below the oldest tweet seen, and the next page is
+ requested as soon as a page is handed out. Tweets are deduplicated by id
+ across pages. The walk stops at the sinceID watermark or when the API
+ reports no more results, so no request is spent on an empty page.
+ Before each request the cursor checks the search rate limit the engine saw
+ last, and waits for the reset instead of spending a request on a 429. All
+ cursors on one engine share that budget.
+ To poll, walk the cursor to the end, then call restartFromNewest to walk
+ only the tweets posted since.
+ A cursor must only be used from one thread at a time.
+ */
+@interface FHSSearchCursor : NSObject
+
+/**
+ Cursor over a search.
+ @param query Search query.
+ @return A cursor instance.
+ */
++ (FHSSearchCursor *)cursorWithQuery:(NSString *)query;
+
+/**
+ Engine used to send requests. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Tweets per request, up to 100. Defaults to 100.
+ */
+@property (nonatomic, assign) int count;
+
+/**
+ Result type. Defaults to FHSTwitterEngineResultTypeRecent, the only type that pages back reliably.
+ */
+@property (nonatomic, assign) FHSTwitterEngineResultType resultType;
+
+/**
+ Watermark: only tweets newer than this id are returned. Save newestID after a walk and set it here to resume. Setting it discards any prefetched page.
+ */
+@property (copy) NSString *sinceID;
+
+/**
+ Highest tweet id returned so far, or sinceID before any.
+ */
+@property (readonly) NSString *newestID;
+
+/**
+ Whether to wait for the rate limit to reset and retry, rather than fail. Defaults to YES.
+ */
+@property (assign) BOOL waitsForRateLimit;
+
+/**
+ Error that stopped the iteration, or nil.
+ */
+@property (strong, readonly) NSError *error;
+
+/**
+ Whether the last page has been returned.
+ */
+@property (readonly, getter=isFinished) BOOL finished;
+
+/**
+ Next page of tweets not returned before, waiting for it if it hasn't been prefetched yet.
+ @return Tweets, or nil once finished, cancelled or on error.
+ */
+- (NSArray *)nextPage;
+
+/**
+ Start a new walk over the tweets posted since the newest one returned. Clears the error.
+ */
+- (void)restartFromNewest;
+
+/**
+ Stop prefetching and stop waiting for a rate limit. nextPage returns nil afterwards.
+ */
+- (void)cancel;
+
+@end
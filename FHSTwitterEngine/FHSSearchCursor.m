@@ -0,0 +1,267 @@
+//
+//  FHSSearchCursor.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSSearchCursor.h"
+
+// Used when a 429 comes without a reset time
+static NSTimeInterval const defaultRateLimitWait = 60.0;
+
+@interface FHSSearchCursor () {
+    uint64_t _sinceID;
+    uint64_t _newestID;
+    uint64_t _maxID; // max_id of the next request, 0 for the first
+    NSError *_error;
+    BOOL _finished;
+}
+
+@property (nonatomic, strong) NSString *query;
+
+// Everything below is guarded by the condition
+@property (nonatomic, strong) NSCondition *condition;
+@property (nonatomic, strong) NSMutableSet *seenIDs;
+@property (nonatomic, strong) id result; // prefetched response or error
+@property (nonatomic, assign) BOOL fetching;
+@property (nonatomic, assign) BOOL cancelled;
+@property (nonatomic, assign) NSUInteger generation; // ignores pages fetched for a replaced watermark
+
+@end
+
+@implementation FHSSearchCursor
+
++ (FHSSearchCursor *)cursorWithQuery:(NSString *)query {
+    return [[[self class]alloc]initWithQuery:query];
+}
+
+- (instancetype)initWithQuery:(NSString *)query {
+    self = [super init];
+    if (self) {
+        self.query = query;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.count = 100;
+        self.resultType = FHSTwitterEngineResultTypeRecent;
+        self.waitsForRateLimit = YES;
+        self.condition = [[NSCondition alloc]init];
+        self.seenIDs = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (NSString *)sinceID {
+    [_condition lock];
+    uint64_t sinceID = _sinceID;
+    [_condition unlock];
+    return (sinceID > 0)?[NSString fhs_stringWithTweetID:sinceID]:nil;
+}
+
+- (void)setSinceID:(NSString *)sinceID {
+    [_condition lock];
+    _sinceID = [sinceID fhs_tweetID];
+    _newestID = _sinceID;
+    [self resetWalk];
+    [_condition unlock];
+}
+
+- (NSString *)newestID {
+    [_condition lock];
+    uint64_t newestID = _newestID;
+    [_condition unlock];
+    return (newestID > 0)?[NSString fhs_stringWithTweetID:newestID]:nil;
+}
+
+- (NSError *)error {
+    [_condition lock];
+    NSError *error = _error;
+    [_condition unlock];
+    return error;
+}
+
+- (BOOL)isFinished {
+    [_condition lock];
+    BOOL finished = _finished;
+    [_condition unlock];
+    return finished;
+}
+
+// Call with the condition locked
+- (void)resetWalk {
+    _maxID = 0;
+    _finished = NO;
+    _error = nil;
+    _result = nil;
+    _fetching = NO;
+    _generation++;
+    [_seenIDs removeAllObjects];
+}
+
+- (void)restartFromNewest {
+    [_condition lock];
+    _sinceID = _newestID;
+    [self resetWalk];
+    [_condition unlock];
+}
+
+- (BOOL)isRateLimitError:(id)response {
+    return [response isKindOfClass:[NSError class]] && [[response domain]isEqualToString:FHSErrorDomain] && [response code] == 429;
+}
+
+// Waits for a reset, or returns NO if the walk was cancelled or replaced meanwhile
+- (BOOL)waitUntil:(NSDate *)date generation:(NSUInteger)generation {
+    [_condition lock];
+
+    while (!_cancelled && _generation == generation && date.timeIntervalSinceNow > 0) {
+        [_condition waitUntilDate:date];
+    }
+
+    BOOL current = (!_cancelled && _generation == generation);
+    [_condition unlock];
+    return current;
+}
+
+// Call with the condition locked
+- (void)fetchNextPage {
+    NSString *sinceID = (_sinceID > 0)?[NSString fhs_stringWithTweetID:_sinceID]:nil;
+    NSString *maxID = (_maxID > 0)?[NSString fhs_stringWithTweetID:_maxID]:nil;
+    int count = MAX(1, MIN(_count, 100));
+    NSUInteger generation = _generation;
+    FHSTwitterEngine *engine = _engine;
+    NSURL *url = [NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointSearchTweets)->url)];
+    self.fetching = YES;
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = nil;
+
+            while (YES) {
+                // Skip the request that would come back 429
+                NSDictionary *limit = [engine rateLimitForURL:url];
+                NSDate *reset = limit[FHSRateLimitResetDateKey];
+
+                if ([limit[FHSRateLimitRemainingKey]integerValue] <= 0 && reset.timeIntervalSinceNow > 0) {
+                    response = [NSError errorWithDomain:FHSErrorDomain code:429 userInfo:@{NSLocalizedDescriptionKey: [NSHTTPURLResponse localizedStringForStatusCode:429], FHSRateLimitResetDateKey: reset}];
+                } else {
+                    response = [engine searchTweetsWithQuery:_query count:count resultType:_resultType unil:nil sinceID:sinceID maxID:maxID];
+                }
+
+                if (![self isRateLimitError:response] || !self.waitsForRateLimit) {
+                    break;
+                }
+
+                // A second of slack for clock skew with the API servers
+                reset = [response userInfo][FHSRateLimitResetDateKey]?:[NSDate dateWithTimeIntervalSinceNow:defaultRateLimitWait];
+
+                if (![self waitUntil:[reset dateByAddingTimeInterval:1.0] generation:generation]) {
+                    return;
+                }
+            }
+
+            [_condition lock];
+
+            if (!_cancelled && _generation == generation) {
+                self.result = response?:[NSError noDataError];
+                self.fetching = NO;
+                [_condition broadcast];
+            }
+
+            [_condition unlock];
+        }
+    });
+}
+
+// Call with the condition locked. Returns the new tweets of a response and moves the walk past it.
+- (NSArray *)consumeResponse:(NSDictionary *)response {
+    NSArray *statuses = response[@"statuses"];
+    id metadata = response[@"search_metadata"];
+    NSMutableArray *tweets = [NSMutableArray arrayWithCapacity:statuses.count];
+    uint64_t oldest = UINT64_MAX;
+
+    for (NSDictionary *tweet in statuses) {
+        uint64_t identifier = [tweet[@"id_str"] fhs_tweetID];
+
+        if (identifier == 0) {
+            continue;
+        }
+
+        oldest = MIN(oldest, identifier);
+
+        if (identifier <= _sinceID) {
+            continue;
+        }
+
+        NSNumber *key = @(identifier);
+
+        if ([_seenIDs containsObject:key]) {
+            continue;
+        }
+
+        [_seenIDs addObject:key];
+        [tweets addObject:tweet];
+        _newestID = MAX(_newestID, identifier);
+    }
+
+    // The API leaves out next_results on the last page
+    BOOL more = [metadata isKindOfClass:[NSDictionary class]] && [metadata[@"next_results"] length] > 0;
+
+    if (!more || oldest == UINT64_MAX || oldest <= _sinceID+1) {
+        _finished = YES;
+    } else {
+        _maxID = oldest-1;
+    }
+
+    return tweets;
+}
+
+- (NSArray *)nextPage {
+    [_condition lock];
+
+    NSArray *tweets = nil;
+
+    // Pages made only of duplicates are skipped
+    while (!tweets && !_cancelled && !_error && !_finished) {
+        if (!_result && !_fetching) {
+            [self fetchNextPage];
+        }
+
+        while (!_result && !_cancelled) {
+            [_condition wait];
+        }
+
+        id result = _result;
+        self.result = nil;
+
+        if (_cancelled) {
+            break;
+        } else if ([result isKindOfClass:[NSError class]]) {
+            _error = result;
+        } else if (![result isKindOfClass:[NSDictionary class]] || ![result[@"statuses"] isKindOfClass:[NSArray class]]) {
+            _error = [NSError noDataError];
+        } else {
+            NSArray *page = [self consumeResponse:result];
+
+            // Prefetch while the caller works through this page
+            if (!_finished) {
+                [self fetchNextPage];
+            }
+
+            if (page.count > 0) {
+                tweets = page;
+            }
+        }
+    }
+
+    [_condition unlock];
+    return tweets;
+}
+
+- (void)cancel {
+    [_condition lock];
+    self.cancelled = YES;
+    self.result = nil;
+    [_condition broadcast];
+    [_condition unlock];
+}
+
+@end
@@ -0,0 +1,86 @@
+//
+//  FHSSnowflake.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Twitter snowflake IDs: 41 bits of milliseconds since the Twitter epoch,
+//  then 10 bits of worker and 12 bits of sequence. Decoding the time lets
+//  callers turn a time window into since_id/max_id bounds.
+//
+
+#ifndef FHSSNOWFLAKE_H
+#define FHSSNOWFLAKE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Twitter epoch, in milliseconds since 1970 (2010-11-04 01:42:54.657 UTC).
+ */
+#define FHS_SNOWFLAKE_EPOCH 1288834974657ULL
+
+/**
+ Longest decimal ID, excluding the terminator.
+ */
+#define FHS_SNOWFLAKE_MAX_DIGITS 20
+
+/**
+ Whether an ID is a snowflake. IDs from before November 2010 were sequential and carry no time.
+ */
+static inline int fhs_snowflake_is_valid(uint64_t snowflake) {
+    return snowflake >= ((uint64_t)1 << 40) && snowflake < ((uint64_t)1 << 63);
+}
+
+/**
+ Creation time of a snowflake.
+ @return Milliseconds since 1970, or 0 if the ID isn't a snowflake.
+ */
+static inline uint64_t fhs_snowflake_time(uint64_t snowflake) {
+    return fhs_snowflake_is_valid(snowflake) ? (snowflake >> 22)+FHS_SNOWFLAKE_EPOCH : 0;
+}
+
+/**
+ Smallest ID that can be created at a time.
+ @param milliseconds Milliseconds since 1970.
+ @return The ID, or 0 for times before the Twitter epoch.
+ */
+static inline uint64_t fhs_snowflake_first_id(uint64_t milliseconds) {
+    return milliseconds > FHS_SNOWFLAKE_EPOCH ? (milliseconds-FHS_SNOWFLAKE_EPOCH) << 22 : 0;
+}
+
+/**
+ Largest ID that can be created at a time.
+ @param milliseconds Milliseconds since 1970.
+ @return The ID, or 0 for times before the Twitter epoch.
+ */
+static inline uint64_t fhs_snowflake_last_id(uint64_t milliseconds) {
+    return milliseconds >= FHS_SNOWFLAKE_EPOCH ? ((milliseconds-FHS_SNOWFLAKE_EPOCH) << 22) | 0x3FFFFF : 0;
+}
+
+/**
+ Parse a decimal ID.
+ @param text Digits. Need not be terminated.
+ @param length Length of the text.
+ @param snowflake Output.
+ @return 0 on success, -1 if the text is empty, has a non-digit or overflows 64 bits.
+ */
+int fhs_snowflake_parse(const char *text, size_t length, uint64_t *snowflake);
+
+/**
+ Format an ID in decimal.
+ @param snowflake ID.
+ @param buffer Output, at least FHS_SNOWFLAKE_MAX_DIGITS+1 bytes. Terminated.
+ @return Number of digits.
+ */
+size_t fhs_snowflake_format(uint64_t snowflake, char *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -17,6 +17,11 @@
  */
 @property (nonatomic, copy) StreamBlock block;
 
+/**
+ Engine that signs the stream and whose settings apply to it. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
 /**
  Stream with URL.
  @param url Stream URL.
@@ -7,8 +7,16 @@
 //
 
 #import "FHSStream.h"
+#import "FHSModel.h"
+#import "FHSIDList.h"
 
-@interface FHSStream () <NSURLConnectionDelegate>
+#include <string.h>
+
+#include "FHSStreamParser.h"
+
+@interface FHSStream () <NSURLConnectionDelegate> {
+    fhs_stream_parser _parser;
+}
 
 @property (nonatomic, strong) NSURLConnection *connection;
 @property (nonatomic, strong) NSMutableDictionary *params;
@@ -18,6 +26,8 @@
 
 @end
 
+static int fhs_stream_message(void *context, const char *message, size_t length);
+
 @implementation FHSStream
 
 + (FHSStream *)streamWithURL:(NSString *)url httpMethod:(NSString *)httpMethod parameters:(NSDictionary *)params timeout:(float)timeout block:(StreamBlock)block {
@@ -34,10 +44,16 @@
         _params[@"delimited"] = @"length"; // absolutely necessary
         _params[@"stall_warnings"] = @"true";
         self.block = block;
+        self.engine = [FHSTwitterEngine sharedEngine];
+        fhs_stream_parser_init(&_parser, 0, fhs_stream_message, (__bridge void *)self);
     }
     return self;
 }
 
+- (void)dealloc {
+    fhs_stream_parser_free(&_parser);
+}
+
 - (void)connection:(NSURLConnection *)connection didFailWithError:(NSError *)error {
     BOOL stop = NO;
     _block(error, &stop);
@@ -52,53 +68,54 @@
 }
 
 - (void)connection:(NSURLConnection *)connection didReceiveData:(NSData *)data {
-    NSInteger bytesExpected = 0;
-    NSMutableString *message = nil;
+    int result = fhs_stream_parser_feed(&_parser, data.bytes, data.length);
     
-    NSString *response = [[NSString alloc]initWithData:data encoding:NSUTF8StringEncoding];
-    for (NSString *part in [response componentsSeparatedByString:@"\r\n"]) {
-        NSInteger length = [part length];
-        
-        if (length > 0) {
-            message = [NSMutableString string];
-            bytesExpected = length;
-        }
-        if (bytesExpected > 0 && message) {
-            if (message.length < bytesExpected) {
-                [message appendString:part];
-                
-                if (message.length < bytesExpected) {
-                    [message appendString:@"\r\n"];
-                }
-                
-                if (message.length == bytesExpected) {
-                    NSError *jsonError = nil;
-                    id json = [NSJSONSerialization JSONObjectWithData:[message dataUsingEncoding:NSUTF8StringEncoding] options:NSJSONReadingMutableContainers error:&jsonError];
-
-                    BOOL stop = NO;
-                    
-                    if (!jsonError) {
-                        _block(json, &stop);
-                        [self keepAlive];
-                    } else {
-                        NSError *error = [NSError errorWithDomain:FHSErrorDomain code:406 userInfo:@{ NSUnderlyingErrorKey: jsonError, NSLocalizedDescriptionKey: @"Invalid JSON was returned from Twitter", @"response": response }];
-                        _block(error, &stop);
-                    }
-                    
-                    if (stop) {
-                        [self stop];
-                    }
-
-                    message = nil;
-                    bytesExpected = 0;
-                }
-            }
-        } else {
-            [self keepAlive];
-        }
+    if (result < 0) {
+        BOOL stop = NO;
+        NSError *error = [NSError errorWithDomain:FHSErrorDomain code:406 userInfo:@{ NSLocalizedDescriptionKey: @"Twitter sent a malformed stream" }];
+        _block(error, &stop);
+        [self stop];
+    } else if (result > 0) {
+        [self stop];
     }
 }
 
+// Returns NO to stop the stream
+- (BOOL)handleMessage:(const char *)message length:(size_t)length {
+    if (!message) {
+        [self keepAlive];
+        return YES;
+    }
+    
+    NSError *jsonError = nil;
+    NSData *messageData = [NSData dataWithBytes:message length:length];
+    id json = nil;
+    
+    if (_engine.usesLazyModels) {
+        // The friends message opens the stream with every followed id
+        json = (length > 9 && memcmp(message, "{\"friends", 9) == 0)?[FHSIDList listWithData:messageData]:nil;
+        json = json?:[FHSModel modelWithData:messageData];
+    }
+    
+    if (!json) {
+        json = [NSJSONSerialization JSONObjectWithData:messageData options:NSJSONReadingMutableContainers error:&jsonError];
+    }
+    
+    BOOL stop = NO;
+    
+    if (!jsonError) {
+        [_engine.tweetIndex addTweetsFromResponse:json];
+        _block(json, &stop);
+        [self keepAlive];
+    } else {
+        NSString *response = [[NSString alloc]initWithData:messageData encoding:NSUTF8StringEncoding]?:@"";
+        NSError *error = [NSError errorWithDomain:FHSErrorDomain code:406 userInfo:@{ NSUnderlyingErrorKey: jsonError, NSLocalizedDescriptionKey: @"Invalid JSON was returned from Twitter", @"response": response }];
+        _block(error, &stop);
+    }
+    
+    return !stop;
+}
+
 - (void)keepAlive {
     [NSObject cancelPreviousPerformRequestsWithTarget:self selector:@selector(stop) object:nil];
 }
@@ -110,16 +127,24 @@
 }
 
 - (void)start {
-    id req = [[FHSTwitterEngine sharedEngine]streamingRequestForURL:[NSURL URLWithString:_URL] HTTPMethod:_HTTPMethod parameters:_params];
+    id req = [_engine streamingRequestForURL:[NSURL URLWithString:_URL] HTTPMethod:_HTTPMethod parameters:_params];
     
     if (![req isKindOfClass:[NSURLRequest class]]) {
         if (_block) {
             _block(req, NULL);
         }
     } else {
+        // A new connection starts a new message
+        fhs_stream_parser_free(&_parser);
+        fhs_stream_parser_init(&_parser, 0, fhs_stream_message, (__bridge void *)self);
         self.connection = [NSURLConnection connectionWithRequest:req delegate:self];
     }
     [self performSelector:@selector(stop) withObject:nil afterDelay:_timeout];
 }
 
-@end
\ No newline at end of file
+static int fhs_stream_message(void *context, const char *message, size_t length) {
+    FHSStream *stream = (__bridge FHSStream *)context;
+    return [stream handleMessage:message length:length]?0:1;
+}
+
+@end
@@ -0,0 +1,130 @@
+//
+//  FHSStreamParser.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSStreamParser.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FHS_STREAM_DEFAULT_MAX_LENGTH (16*1024*1024)
+
+void fhs_stream_parser_init(fhs_stream_parser *parser, size_t maxLength, fhs_stream_message_callback callback, void *context) {
+    memset(parser, 0, sizeof(*parser));
+    parser->callback = callback;
+    parser->context = context;
+    parser->maxLength = maxLength?maxLength:FHS_STREAM_DEFAULT_MAX_LENGTH;
+}
+
+void fhs_stream_parser_free(fhs_stream_parser *parser) {
+    free(parser->buffer);
+    parser->buffer = NULL;
+    parser->bufferLength = 0;
+    parser->bufferCapacity = 0;
+}
+
+// The length counts the message's trailing line break, which isn't handed out
+static int fhs_stream_deliver(fhs_stream_parser *parser, const char *message, size_t length) {
+    while (length > 0 && (message[length-1] == '\n' || message[length-1] == '\r')) {
+        length--;
+    }
+
+    if (!parser->callback) {
+        return 0;
+    }
+
+    return parser->callback(parser->context, (length > 0)?message:NULL, length);
+}
+
+static int fhs_stream_fail(fhs_stream_parser *parser) {
+    parser->failed = 1;
+    return -1;
+}
+
+int fhs_stream_parser_feed(fhs_stream_parser *parser, const uint8_t *data, size_t length) {
+    size_t offset = 0;
+
+    if (parser->failed) {
+        return -1;
+    }
+
+    while (offset < length) {
+        if (parser->expected == 0) {
+            uint8_t c = data[offset++];
+
+            if (c >= '0' && c <= '9') {
+                size_t digit = c-'0';
+
+                if (digit > parser->maxLength || parser->lineValue > (parser->maxLength-digit)/10) {
+                    return fhs_stream_fail(parser);
+                }
+
+                parser->lineValue = parser->lineValue*10+digit;
+                parser->lineDigits++;
+            } else if (c == '\n') {
+                size_t value = parser->lineValue;
+                int hadDigits = (parser->lineDigits > 0);
+                parser->lineValue = 0;
+                parser->lineDigits = 0;
+
+                if (value > 0) {
+                    parser->expected = value;
+                } else if (!hadDigits && parser->callback && parser->callback(parser->context, NULL, 0) != 0) {
+                    return 1;
+                }
+            } else if (c != '\r') {
+                return fhs_stream_fail(parser);
+            }
+
+            continue;
+        }
+
+        size_t available = length-offset;
+
+        // The whole message is in this read, hand it out in place
+        if (parser->bufferLength == 0 && available >= parser->expected) {
+            const char *message = (const char *)data+offset;
+            size_t messageLength = parser->expected;
+            offset += messageLength;
+            parser->expected = 0;
+
+            if (fhs_stream_deliver(parser, message, messageLength) != 0) {
+                return 1;
+            }
+
+            continue;
+        }
+
+        if (parser->bufferCapacity < parser->expected) {
+            char *buffer = realloc(parser->buffer, parser->expected);
+
+            if (!buffer) {
+                return fhs_stream_fail(parser);
+            }
+
+            parser->buffer = buffer;
+            parser->bufferCapacity = parser->expected;
+        }
+
+        size_t take = parser->expected-parser->bufferLength;
+        take = (take < available)?take:available;
+        memcpy(parser->buffer+parser->bufferLength, data+offset, take);
+        parser->bufferLength += take;
+        offset += take;
+
+        if (parser->bufferLength == parser->expected) {
+            size_t messageLength = parser->expected;
+            parser->bufferLength = 0;
+            parser->expected = 0;
+
+            if (fhs_stream_deliver(parser, parser->buffer, messageLength) != 0) {
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,76 @@
+//
+//  FHSStreamParser.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Framing of streaming API responses requested with delimited=length: each
+//  message is preceded by its length in bytes on a line of its own, and
+//  blank lines are keep-alives. Messages may be split across reads in any
+//  way; only the part of a message that spans reads is copied.
+//
+
+#ifndef FHSSTREAMPARSER_H
+#define FHSSTREAMPARSER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Called for each message and keep-alive.
+ @param context Context passed to fhs_stream_parser_init().
+ @param message Message without its trailing line break, or NULL for a keep-alive. Only valid for the duration of the call.
+ @param length Length of the message, 0 for a keep-alive.
+ @return 0 to continue, anything else to stop.
+ */
+typedef int (*fhs_stream_message_callback)(void *context, const char *message, size_t length);
+
+/**
+ Parser state. Initialize it with fhs_stream_parser_init() and free it with fhs_stream_parser_free().
+ */
+typedef struct {
+    fhs_stream_message_callback callback;
+    void *context;
+    size_t maxLength;
+    size_t expected;    // bytes of the message being read, or 0 while reading a length line
+    size_t lineDigits;  // digits of the length line read so far
+    size_t lineValue;   // their value
+    char *buffer;       // start of a message that spans reads
+    size_t bufferLength;
+    size_t bufferCapacity;
+    int failed;
+} fhs_stream_parser;
+
+/**
+ Initialize a parser.
+ @param parser Parser.
+ @param maxLength Longest message accepted, 0 for 16 MB.
+ @param callback Message callback.
+ @param context Passed to the callback.
+ */
+void fhs_stream_parser_init(fhs_stream_parser *parser, size_t maxLength, fhs_stream_message_callback callback, void *context);
+
+/**
+ Free a parser's buffer.
+ @param parser Parser.
+ */
+void fhs_stream_parser_free(fhs_stream_parser *parser);
+
+/**
+ Feed bytes read from the stream.
+ @param parser Parser.
+ @param data Bytes.
+ @param length Number of bytes.
+ @return 0 on success, 1 if the callback stopped the parse, -1 on a malformed length line, a message over the limit, or if out of memory. Once it has failed, the parser keeps failing.
+ */
+int fhs_stream_parser_feed(fhs_stream_parser *parser, const uint8_t *data, size_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,1255 @@
+//
+//  FHSTextIndex.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSTextIndex.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define FHS_TI_MAGIC "FHSIDX01"
+#define FHS_TI_HEADER_LENGTH 56
+#define FHS_TI_ENTRY_LENGTH 24
+#define FHS_TI_MAX_CLAUSES 32
+#define FHS_TI_MAX_PHRASE 8
+
+//
+// Byte buffers and little endian fields
+//
+
+typedef struct {
+    uint8_t *bytes;
+    size_t length;
+    size_t capacity;
+} fhs_ti_buffer;
+
+static int fhs_ti_reserve(void **items, size_t *capacity, size_t needed, size_t size) {
+    if (needed <= *capacity) {
+        return 0;
+    }
+
+    size_t grown = (*capacity > 0)?*capacity*2:16;
+
+    while (grown < needed) {
+        grown *= 2;
+    }
+
+    void *resized = realloc(*items, grown*size);
+
+    if (!resized) {
+        return -1;
+    }
+
+    *items = resized;
+    *capacity = grown;
+    return 0;
+}
+
+static int fhs_ti_append(fhs_ti_buffer *buffer, const void *bytes, size_t length) {
+    if (length == 0) {
+        return 0;
+    }
+
+    if (fhs_ti_reserve((void **)&buffer->bytes, &buffer->capacity, buffer->length+length, 1) != 0) {
+        return -1;
+    }
+
+    memcpy(buffer->bytes+buffer->length, bytes, length);
+    buffer->length += length;
+    return 0;
+}
+
+static int fhs_ti_append_varint(fhs_ti_buffer *buffer, uint64_t value) {
+    uint8_t bytes[10];
+    size_t length = 0;
+
+    while (value >= 0x80) {
+        bytes[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+
+    bytes[length++] = (uint8_t)value;
+    return fhs_ti_append(buffer, bytes, length);
+}
+
+static void fhs_ti_put_u32(uint8_t *p, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        p[i] = (uint8_t)(value >> (8*i));
+    }
+}
+
+static void fhs_ti_put_u64(uint8_t *p, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(value >> (8*i));
+    }
+}
+
+static uint32_t fhs_ti_get_u32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint64_t fhs_ti_get_u64(const uint8_t *p) {
+    return (uint64_t)fhs_ti_get_u32(p) | ((uint64_t)fhs_ti_get_u32(p+4) << 32);
+}
+
+// Returns -1 past the end or on a varint longer than 64 bits
+static int fhs_ti_read_varint(const uint8_t **p, const uint8_t *end, uint64_t *value) {
+    uint64_t result = 0;
+
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        if (*p >= end) {
+            return -1;
+        }
+
+        uint8_t byte = *(*p)++;
+        result |= (uint64_t)(byte & 0x7F) << shift;
+
+        if (byte < 0x80) {
+            *value = result;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+static int fhs_ti_compare_ids(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return (x > y)-(x < y);
+}
+
+// Sorts and removes repeats, returning the new count
+static size_t fhs_ti_unique_ids(uint64_t *ids, size_t count) {
+    if (count == 0) {
+        return 0;
+    }
+
+    qsort(ids, count, sizeof(uint64_t), fhs_ti_compare_ids);
+
+    size_t unique = 1;
+
+    for (size_t i = 1; i < count; i++) {
+        if (ids[i] != ids[unique-1]) {
+            ids[unique++] = ids[i];
+        }
+    }
+
+    return unique;
+}
+
+//
+// Tokenizer
+//
+
+static inline int fhs_ti_is_word(unsigned char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_' || c >= 0x80;
+}
+
+uint32_t fhs_text_index_tokenize(const char *text, size_t length, int bareWords, fhs_text_index_token_callback callback, void *context) {
+    const unsigned char *bytes = (const unsigned char *)text;
+    char term[FHS_TEXT_INDEX_MAX_TERM];
+    uint32_t position = 0;
+    size_t i = 0;
+
+    while (i < length) {
+        int prefixed = (bytes[i] == '#' || bytes[i] == '@') && i+1 < length && fhs_ti_is_word(bytes[i+1]);
+
+        if (!prefixed && !fhs_ti_is_word(bytes[i])) {
+            i++;
+            continue;
+        }
+
+        size_t start = i;
+        i += prefixed;
+
+        while (i < length && fhs_ti_is_word(bytes[i])) {
+            i++;
+        }
+
+        // Longer runs are URLs' paths or unspaced scripts, and not worth a term
+        size_t termLength = i-start;
+
+        if (termLength <= FHS_TEXT_INDEX_MAX_TERM) {
+            for (size_t j = 0; j < termLength; j++) {
+                unsigned char c = bytes[start+j];
+                term[j] = (char)((c >= 'A' && c <= 'Z')?c+('a'-'A'):c);
+            }
+
+            if (callback(context, term, termLength, position) != 0) {
+                return position+1;
+            }
+
+            if (prefixed && bareWords && callback(context, term+1, termLength-1, position) != 0) {
+                return position+1;
+            }
+        }
+
+        position++;
+    }
+
+    return position;
+}
+
+//
+// Builder
+//
+
+typedef struct {
+    uint64_t id;
+    uint32_t positionStart;
+    uint32_t positionCount;
+} fhs_ti_posting;
+
+typedef struct {
+    uint32_t termOffset;
+    uint32_t termLength;
+    uint32_t hash;
+    fhs_ti_posting *postings;
+    size_t count;
+    size_t capacity;
+} fhs_ti_term;
+
+typedef struct {
+    uint32_t term;
+    uint32_t position;
+} fhs_ti_occurrence;
+
+struct fhs_text_index_builder {
+    fhs_ti_term *terms;
+    size_t termCount;
+    size_t termCapacity;
+    uint32_t *slots; // term index+1, 0 if empty
+    size_t slotCount;
+    fhs_ti_buffer pool;
+    uint32_t *positions;
+    size_t positionCount;
+    size_t positionCapacity;
+    fhs_ti_occurrence *occurrences; // tokens of the tweet being added
+    size_t occurrenceCount;
+    size_t occurrenceCapacity;
+    size_t tweetCount;
+    uint64_t minID;
+    uint64_t maxID;
+    int failed;
+};
+
+static uint32_t fhs_ti_hash(const char *term, size_t length) {
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < length; i++) {
+        hash = (hash ^ (uint8_t)term[i])*16777619u;
+    }
+
+    return hash;
+}
+
+fhs_text_index_builder *fhs_text_index_builder_create(void) {
+    return calloc(1, sizeof(fhs_text_index_builder));
+}
+
+void fhs_text_index_builder_free(fhs_text_index_builder *builder) {
+    if (!builder) {
+        return;
+    }
+
+    for (size_t i = 0; i < builder->termCount; i++) {
+        free(builder->terms[i].postings);
+    }
+
+    free(builder->terms);
+    free(builder->slots);
+    free(builder->pool.bytes);
+    free(builder->positions);
+    free(builder->occurrences);
+    free(builder);
+}
+
+size_t fhs_text_index_builder_count(const fhs_text_index_builder *builder) {
+    return builder->tweetCount;
+}
+
+static int fhs_ti_builder_rehash(fhs_text_index_builder *builder) {
+    size_t slotCount = (builder->slotCount > 0)?builder->slotCount*2:1024;
+    uint32_t *slots = calloc(slotCount, sizeof(uint32_t));
+
+    if (!slots) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < builder->termCount; i++) {
+        size_t slot = builder->terms[i].hash & (slotCount-1);
+
+        while (slots[slot] != 0) {
+            slot = (slot+1) & (slotCount-1);
+        }
+
+        slots[slot] = (uint32_t)(i+1);
+    }
+
+    free(builder->slots);
+    builder->slots = slots;
+    builder->slotCount = slotCount;
+    return 0;
+}
+
+// Index of a term, or -1 if it isn't in the builder
+static long fhs_ti_builder_find(const fhs_text_index_builder *builder, const char *term, size_t length, uint32_t hash) {
+    if (builder->slotCount == 0) {
+        return -1;
+    }
+
+    size_t slot = hash & (builder->slotCount-1);
+
+    while (builder->slots[slot] != 0) {
+        const fhs_ti_term *candidate = &builder->terms[builder->slots[slot]-1];
+
+        if (candidate->hash == hash && candidate->termLength == length && memcmp(builder->pool.bytes+candidate->termOffset, term, length) == 0) {
+            return (long)builder->slots[slot]-1;
+        }
+
+        slot = (slot+1) & (builder->slotCount-1);
+    }
+
+    return -1;
+}
+
+static int fhs_ti_builder_token(void *context, const char *term, size_t length, uint32_t position) {
+    fhs_text_index_builder *builder = context;
+    uint32_t hash = fhs_ti_hash(term, length);
+    long index = fhs_ti_builder_find(builder, term, length, hash);
+
+    if (index < 0) {
+        if ((builder->termCount+1)*2 > builder->slotCount && fhs_ti_builder_rehash(builder) != 0) {
+            builder->failed = 1;
+            return -1;
+        }
+
+        if (fhs_ti_reserve((void **)&builder->terms, &builder->termCapacity, builder->termCount+1, sizeof(fhs_ti_term)) != 0) {
+            builder->failed = 1;
+            return -1;
+        }
+
+        uint32_t offset = (uint32_t)builder->pool.length;
+
+        if (fhs_ti_append(&builder->pool, term, length) != 0) {
+            builder->failed = 1;
+            return -1;
+        }
+
+        index = (long)builder->termCount++;
+        builder->terms[index] = (fhs_ti_term){offset, (uint32_t)length, hash, NULL, 0, 0};
+
+        size_t slot = hash & (builder->slotCount-1);
+
+        while (builder->slots[slot] != 0) {
+            slot = (slot+1) & (builder->slotCount-1);
+        }
+
+        builder->slots[slot] = (uint32_t)index+1;
+    }
+
+    if (fhs_ti_reserve((void **)&builder->occurrences, &builder->occurrenceCapacity, builder->occurrenceCount+1, sizeof(fhs_ti_occurrence)) != 0) {
+        builder->failed = 1;
+        return -1;
+    }
+
+    builder->occurrences[builder->occurrenceCount++] = (fhs_ti_occurrence){(uint32_t)index, position};
+    return 0;
+}
+
+static int fhs_ti_compare_occurrences(const void *a, const void *b) {
+    const fhs_ti_occurrence *x = a;
+    const fhs_ti_occurrence *y = b;
+
+    if (x->term != y->term) {
+        return (x->term > y->term)-(x->term < y->term);
+    }
+
+    return (x->position > y->position)-(x->position < y->position);
+}
+
+int fhs_text_index_builder_add(fhs_text_index_builder *builder, uint64_t tweetID, const char *text, size_t length) {
+    builder->occurrenceCount = 0;
+    builder->failed = 0;
+    fhs_text_index_tokenize(text, length, 1, fhs_ti_builder_token, builder);
+
+    if (builder->failed) {
+        return -1;
+    }
+
+    // Group the tweet's positions by term, so each posting's positions are contiguous
+    qsort(builder->occurrences, builder->occurrenceCount, sizeof(fhs_ti_occurrence), fhs_ti_compare_occurrences);
+
+    if (fhs_ti_reserve((void **)&builder->positions, &builder->positionCapacity, builder->positionCount+builder->occurrenceCount, sizeof(uint32_t)) != 0) {
+        return -1;
+    }
+
+    size_t i = 0;
+
+    while (i < builder->occurrenceCount) {
+        fhs_ti_term *term = &builder->terms[builder->occurrences[i].term];
+
+        if (fhs_ti_reserve((void **)&term->postings, &term->capacity, term->count+1, sizeof(fhs_ti_posting)) != 0) {
+            return -1;
+        }
+
+        fhs_ti_posting *posting = &term->postings[term->count++];
+        posting->id = tweetID;
+        posting->positionStart = (uint32_t)builder->positionCount;
+        posting->positionCount = 0;
+
+        do {
+            builder->positions[builder->positionCount++] = builder->occurrences[i++].position;
+            posting->positionCount++;
+        } while (i < builder->occurrenceCount && &builder->terms[builder->occurrences[i].term] == term);
+    }
+
+    builder->minID = (builder->tweetCount == 0 || tweetID < builder->minID)?tweetID:builder->minID;
+    builder->maxID = (tweetID > builder->maxID)?tweetID:builder->maxID;
+    builder->tweetCount++;
+    return 0;
+}
+
+//
+// Posting lists, as decoded for merges and queries
+//
+
+typedef struct {
+    fhs_ti_posting *items;
+    size_t count;
+    size_t capacity;
+    uint32_t *positions;
+    size_t positionCount;
+    size_t positionCapacity;
+    int sorted;
+} fhs_ti_list;
+
+static void fhs_ti_list_free(fhs_ti_list *list) {
+    free(list->items);
+    free(list->positions);
+    memset(list, 0, sizeof(*list));
+}
+
+static void fhs_ti_list_clear(fhs_ti_list *list) {
+    list->count = 0;
+    list->positionCount = 0;
+    list->sorted = 1;
+}
+
+static int fhs_ti_list_add(fhs_ti_list *list, uint64_t id, const uint32_t *positions, size_t positionCount) {
+    if (fhs_ti_reserve((void **)&list->items, &list->capacity, list->count+1, sizeof(fhs_ti_posting)) != 0 || fhs_ti_reserve((void **)&list->positions, &list->positionCapacity, list->positionCount+positionCount, sizeof(uint32_t)) != 0) {
+        return -1;
+    }
+
+    if (list->count > 0 && list->items[list->count-1].id >= id) {
+        list->sorted = 0;
+    }
+
+    list->items[list->count++] = (fhs_ti_posting){id, (uint32_t)list->positionCount, (uint32_t)positionCount};
+
+    if (positionCount > 0) {
+        memcpy(list->positions+list->positionCount, positions, positionCount*sizeof(uint32_t));
+        list->positionCount += positionCount;
+    }
+
+    return 0;
+}
+
+static int fhs_ti_compare_postings(const void *a, const void *b) {
+    const fhs_ti_posting *x = a;
+    const fhs_ti_posting *y = b;
+    return (x->id > y->id)-(x->id < y->id);
+}
+
+// Sorts by id and drops repeats. Lists from one source are already sorted.
+static void fhs_ti_list_normalize(fhs_ti_list *list) {
+    if (list->sorted || list->count < 2) {
+        list->sorted = 1;
+        return;
+    }
+
+    qsort(list->items, list->count, sizeof(fhs_ti_posting), fhs_ti_compare_postings);
+
+    size_t unique = 1;
+
+    for (size_t i = 1; i < list->count; i++) {
+        if (list->items[i].id != list->items[unique-1].id) {
+            list->items[unique++] = list->items[i];
+        }
+    }
+
+    list->count = unique;
+    list->sorted = 1;
+}
+
+// Appends the postings of a builder term within [low, high]
+static int fhs_ti_list_add_builder(fhs_ti_list *list, const fhs_text_index_builder *builder, const char *term, size_t length, uint64_t low, uint64_t high) {
+    long index = fhs_ti_builder_find(builder, term, length, fhs_ti_hash(term, length));
+
+    if (index < 0) {
+        return 0;
+    }
+
+    const fhs_ti_term *entry = &builder->terms[index];
+
+    for (size_t i = 0; i < entry->count; i++) {
+        const fhs_ti_posting *posting = &entry->postings[i];
+
+        if (posting->id >= low && posting->id <= high && fhs_ti_list_add(list, posting->id, builder->positions+posting->positionStart, posting->positionCount) != 0) {
+            return -1;
+        }
+    }
+
+    // Builder postings are in the order tweets were added
+    list->sorted = 0;
+    return 0;
+}
+
+//
+// Segments
+//
+
+int fhs_text_index_segment_open(fhs_text_index_segment *segment, const uint8_t *data, size_t length) {
+    if (length < FHS_TI_HEADER_LENGTH || memcmp(data, FHS_TI_MAGIC, 8) != 0) {
+        return -1;
+    }
+
+    uint32_t termCount = fhs_ti_get_u32(data+32);
+    uint64_t poolOffset = fhs_ti_get_u64(data+40);
+    uint64_t postingsOffset = fhs_ti_get_u64(data+48);
+    uint64_t dictionaryEnd = FHS_TI_HEADER_LENGTH+(uint64_t)termCount*FHS_TI_ENTRY_LENGTH;
+
+    if (dictionaryEnd > poolOffset || poolOffset > postingsOffset || postingsOffset > length) {
+        return -1;
+    }
+
+    segment->data = data;
+    segment->length = length;
+    segment->count = fhs_ti_get_u64(data+8);
+    segment->minID = fhs_ti_get_u64(data+16);
+    segment->maxID = fhs_ti_get_u64(data+24);
+    segment->termCount = termCount;
+    segment->dictionary = data+FHS_TI_HEADER_LENGTH;
+    segment->pool = data+poolOffset;
+    segment->poolLength = (size_t)(postingsOffset-poolOffset);
+    segment->postings = data+postingsOffset;
+    segment->postingsLength = length-(size_t)postingsOffset;
+    return 0;
+}
+
+// Term of a dictionary entry, or -1 if the entry points outside the segment
+static int fhs_ti_segment_term(const fhs_text_index_segment *segment, uint32_t index, const uint8_t **term, size_t *length) {
+    const uint8_t *entry = segment->dictionary+(size_t)index*FHS_TI_ENTRY_LENGTH;
+    uint32_t offset = fhs_ti_get_u32(entry);
+    uint32_t termLength = fhs_ti_get_u32(entry+4);
+
+    if ((uint64_t)offset+termLength > segment->poolLength) {
+        return -1;
+    }
+
+    *term = segment->pool+offset;
+    *length = termLength;
+    return 0;
+}
+
+static int fhs_ti_compare_terms(const uint8_t *a, size_t aLength, const uint8_t *b, size_t bLength) {
+    int result = memcmp(a, b, (aLength < bLength)?aLength:bLength);
+    return (result != 0)?result:(aLength > bLength)-(aLength < bLength);
+}
+
+// Index of a term, -1 if it isn't in the segment, -2 if the segment is corrupt
+static long fhs_ti_segment_find(const fhs_text_index_segment *segment, const char *term, size_t length) {
+    size_t low = 0;
+    size_t high = segment->termCount;
+
+    while (low < high) {
+        size_t middle = low+(high-low)/2;
+        const uint8_t *candidate;
+        size_t candidateLength;
+
+        if (fhs_ti_segment_term(segment, (uint32_t)middle, &candidate, &candidateLength) != 0) {
+            return -2;
+        }
+
+        int order = fhs_ti_compare_terms(candidate, candidateLength, (const uint8_t *)term, length);
+
+        if (order == 0) {
+            return (long)middle;
+        } else if (order < 0) {
+            low = middle+1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return -1;
+}
+
+// Appends the postings of a dictionary entry within [low, high]
+static int fhs_ti_list_add_segment(fhs_ti_list *list, const fhs_text_index_segment *segment, uint32_t index, uint64_t low, uint64_t high) {
+    const uint8_t *entry = segment->dictionary+(size_t)index*FHS_TI_ENTRY_LENGTH;
+    uint64_t offset = fhs_ti_get_u64(entry+8);
+    uint32_t length = fhs_ti_get_u32(entry+16);
+
+    // Checked without adding, a huge offset would wrap offset+length back into range
+    if (offset > segment->postingsLength || length > segment->postingsLength-offset) {
+        return -1;
+    }
+
+    const uint8_t *p = segment->postings+offset;
+    const uint8_t *end = p+length;
+    uint32_t positions[256];
+    uint64_t id = 0;
+    int first = 1;
+
+    while (p < end) {
+        uint64_t delta, count;
+
+        if (fhs_ti_read_varint(&p, end, &delta) != 0 || fhs_ti_read_varint(&p, end, &count) != 0 || (!first && delta == 0) || count > 0xFFFFFFFFu) {
+            return -1;
+        }
+
+        id += delta;
+        first = 0;
+
+        // Positions past the buffer are dropped; phrases that long aren't looked for
+        uint32_t position = 0;
+        size_t kept = 0;
+
+        for (uint64_t i = 0; i < count; i++) {
+            uint64_t gap;
+
+            if (fhs_ti_read_varint(&p, end, &gap) != 0) {
+                return -1;
+            }
+
+            position += (uint32_t)gap;
+
+            if (kept < sizeof(positions)/sizeof(positions[0])) {
+                positions[kept++] = position;
+            }
+        }
+
+        if (id > high) {
+            break;
+        }
+
+        if (id >= low && fhs_ti_list_add(list, id, positions, kept) != 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+//
+// Segment writer
+//
+
+typedef struct {
+    fhs_ti_buffer dictionary;
+    fhs_ti_buffer pool;
+    fhs_ti_buffer postings;
+    uint64_t *ids;
+    size_t idCount;
+    size_t idCapacity;
+    size_t trimAt;
+    uint32_t termCount;
+} fhs_ti_writer;
+
+static void fhs_ti_writer_free(fhs_ti_writer *writer) {
+    free(writer->dictionary.bytes);
+    free(writer->pool.bytes);
+    free(writer->postings.bytes);
+    free(writer->ids);
+}
+
+// Writes a term with a normalized, non-empty list
+static int fhs_ti_writer_add(fhs_ti_writer *writer, const void *term, size_t length, const fhs_ti_list *list) {
+    uint8_t entry[FHS_TI_ENTRY_LENGTH];
+    size_t start = writer->postings.length;
+    uint64_t previous = 0;
+
+    fhs_ti_put_u32(entry, (uint32_t)writer->pool.length);
+    fhs_ti_put_u32(entry+4, (uint32_t)length);
+
+    if (fhs_ti_append(&writer->pool, term, length) != 0 || fhs_ti_reserve((void **)&writer->ids, &writer->idCapacity, writer->idCount+list->count, sizeof(uint64_t)) != 0) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < list->count; i++) {
+        const fhs_ti_posting *posting = &list->items[i];
+        const uint32_t *positions = list->positions+posting->positionStart;
+        uint32_t previousPosition = 0;
+
+        if (fhs_ti_append_varint(&writer->postings, posting->id-previous) != 0 || fhs_ti_append_varint(&writer->postings, posting->positionCount) != 0) {
+            return -1;
+        }
+
+        for (uint32_t j = 0; j < posting->positionCount; j++) {
+            if (fhs_ti_append_varint(&writer->postings, positions[j]-previousPosition) != 0) {
+                return -1;
+            }
+            previousPosition = positions[j];
+        }
+
+        previous = posting->id;
+        writer->ids[writer->idCount++] = posting->id;
+    }
+
+    fhs_ti_put_u64(entry+8, start);
+    fhs_ti_put_u32(entry+16, (uint32_t)(writer->postings.length-start));
+    fhs_ti_put_u32(entry+20, (uint32_t)list->count);
+    writer->termCount++;
+
+    // Every tweet of a term goes into ids; trim repeats now and then to bound memory
+    if (writer->idCount >= writer->trimAt && writer->idCount >= (1u << 20)) {
+        writer->idCount = fhs_ti_unique_ids(writer->ids, writer->idCount);
+        writer->trimAt = writer->idCount*2;
+    }
+
+    return fhs_ti_append(&writer->dictionary, entry, sizeof(entry));
+}
+
+static int fhs_ti_writer_finish(fhs_ti_writer *writer, uint8_t **segment, size_t *length) {
+    size_t count = fhs_ti_unique_ids(writer->ids, writer->idCount);
+    size_t poolOffset = FHS_TI_HEADER_LENGTH+writer->dictionary.length;
+    size_t postingsOffset = poolOffset+writer->pool.length;
+    size_t total = postingsOffset+writer->postings.length;
+    uint8_t *bytes = malloc(total);
+
+    if (!bytes) {
+        return -1;
+    }
+
+    memcpy(bytes, FHS_TI_MAGIC, 8);
+    fhs_ti_put_u64(bytes+8, count);
+    fhs_ti_put_u64(bytes+16, (count > 0)?writer->ids[0]:0);
+    fhs_ti_put_u64(bytes+24, (count > 0)?writer->ids[count-1]:0);
+    fhs_ti_put_u32(bytes+32, writer->termCount);
+    fhs_ti_put_u32(bytes+36, 0);
+    fhs_ti_put_u64(bytes+40, poolOffset);
+    fhs_ti_put_u64(bytes+48, postingsOffset);
+
+    if (writer->dictionary.length > 0) {
+        memcpy(bytes+FHS_TI_HEADER_LENGTH, writer->dictionary.bytes, writer->dictionary.length);
+    }
+
+    if (writer->pool.length > 0) {
+        memcpy(bytes+poolOffset, writer->pool.bytes, writer->pool.length);
+    }
+
+    if (writer->postings.length > 0) {
+        memcpy(bytes+postingsOffset, writer->postings.bytes, writer->postings.length);
+    }
+
+    *segment = bytes;
+    *length = total;
+    return 0;
+}
+
+typedef struct {
+    const uint8_t *term;
+    uint32_t length;
+    uint32_t index;
+} fhs_ti_sorted_term;
+
+static int fhs_ti_compare_sorted_terms(const void *a, const void *b) {
+    const fhs_ti_sorted_term *x = a;
+    const fhs_ti_sorted_term *y = b;
+    return fhs_ti_compare_terms(x->term, x->length, y->term, y->length);
+}
+
+int fhs_text_index_builder_write(const fhs_text_index_builder *builder, uint8_t **segment, size_t *length) {
+    fhs_ti_writer writer = {0};
+    fhs_ti_list list = {0};
+    fhs_ti_sorted_term *order = malloc((builder->termCount+1)*sizeof(fhs_ti_sorted_term));
+    int result = -1;
+
+    if (!order) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < builder->termCount; i++) {
+        const fhs_ti_term *term = &builder->terms[i];
+        order[i] = (fhs_ti_sorted_term){builder->pool.bytes+term->termOffset, term->termLength, (uint32_t)i};
+    }
+
+    qsort(order, builder->termCount, sizeof(fhs_ti_sorted_term), fhs_ti_compare_sorted_terms);
+
+    for (size_t i = 0; i < builder->termCount; i++) {
+        const fhs_ti_term *term = &builder->terms[order[i].index];
+
+        fhs_ti_list_clear(&list);
+
+        if (fhs_ti_list_add_builder(&list, builder, (const char *)builder->pool.bytes+term->termOffset, term->termLength, 0, UINT64_MAX) != 0) {
+            goto done;
+        }
+
+        fhs_ti_list_normalize(&list);
+
+        if (list.count > 0 && fhs_ti_writer_add(&writer, builder->pool.bytes+term->termOffset, term->termLength, &list) != 0) {
+            goto done;
+        }
+    }
+
+    result = fhs_ti_writer_finish(&writer, segment, length);
+
+done:
+    free(order);
+    fhs_ti_list_free(&list);
+    fhs_ti_writer_free(&writer);
+    return result;
+}
+
+int fhs_text_index_merge(const fhs_text_index_segment *segments, size_t count, uint64_t minID, uint8_t **merged, size_t *length) {
+    fhs_ti_writer writer = {0};
+    fhs_ti_list list = {0};
+    uint32_t *cursors = calloc(count+1, sizeof(uint32_t));
+    int result = -1;
+
+    if (!cursors) {
+        return -1;
+    }
+
+    // Walk the sorted dictionaries side by side, one term at a time
+    while (1) {
+        const uint8_t *smallest = NULL;
+        size_t smallestLength = 0;
+
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t *term;
+            size_t termLength;
+
+            if (cursors[i] >= segments[i].termCount) {
+                continue;
+            }
+
+            if (fhs_ti_segment_term(&segments[i], cursors[i], &term, &termLength) != 0) {
+                goto done;
+            }
+
+            if (!smallest || fhs_ti_compare_terms(term, termLength, smallest, smallestLength) < 0) {
+                smallest = term;
+                smallestLength = termLength;
+            }
+        }
+
+        if (!smallest) {
+            break;
+        }
+
+        fhs_ti_list_clear(&list);
+
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t *term;
+            size_t termLength;
+
+            if (cursors[i] >= segments[i].termCount || fhs_ti_segment_term(&segments[i], cursors[i], &term, &termLength) != 0 || fhs_ti_compare_terms(term, termLength, smallest, smallestLength) != 0) {
+                continue;
+            }
+
+            if (fhs_ti_list_add_segment(&list, &segments[i], cursors[i], minID, UINT64_MAX) != 0) {
+                goto done;
+            }
+
+            cursors[i]++;
+        }
+
+        fhs_ti_list_normalize(&list);
+
+        if (list.count > 0 && fhs_ti_writer_add(&writer, smallest, smallestLength, &list) != 0) {
+            goto done;
+        }
+    }
+
+    result = fhs_ti_writer_finish(&writer, merged, length);
+
+done:
+    free(cursors);
+    fhs_ti_list_free(&list);
+    fhs_ti_writer_free(&writer);
+    return result;
+}
+
+//
+// Queries
+//
+
+typedef struct {
+    char terms[FHS_TI_MAX_PHRASE][FHS_TEXT_INDEX_MAX_TERM];
+    size_t lengths[FHS_TI_MAX_PHRASE];
+    size_t count;
+    size_t group;
+} fhs_ti_clause;
+
+typedef struct {
+    fhs_ti_clause *clauses;
+    size_t count;
+    size_t group;
+} fhs_ti_query;
+
+static int fhs_ti_query_token(void *context, const char *term, size_t length, uint32_t position) {
+    fhs_ti_query *query = context;
+    fhs_ti_clause *clause = &query->clauses[query->count];
+    (void)position;
+
+    // Longer phrases are matched on their first words
+    if (clause->count == FHS_TI_MAX_PHRASE) {
+        return -1;
+    }
+
+    memcpy(clause->terms[clause->count], term, length);
+    clause->lengths[clause->count++] = length;
+    return 0;
+}
+
+// Adds a word or quoted phrase as a clause. Words that split into several tokens, like t.co, become phrases.
+static void fhs_ti_query_add(fhs_ti_query *query, const char *text, size_t length) {
+    if (query->count == FHS_TI_MAX_CLAUSES) {
+        return;
+    }
+
+    fhs_ti_clause *clause = &query->clauses[query->count];
+    clause->count = 0;
+    clause->group = query->group;
+    fhs_text_index_tokenize(text, length, 0, fhs_ti_query_token, query);
+
+    if (clause->count > 0) {
+        query->count++;
+    }
+}
+
+static void fhs_ti_query_parse(fhs_ti_query *query, const char *text, size_t length) {
+    size_t i = 0;
+
+    while (i < length) {
+        if (text[i] == ' ' || text[i] == '\t' || text[i] == '\n' || text[i] == '\r') {
+            i++;
+        } else if (text[i] == '"') {
+            size_t start = ++i;
+
+            while (i < length && text[i] != '"') {
+                i++;
+            }
+
+            fhs_ti_query_add(query, text+start, i-start);
+            i += (i < length);
+        } else {
+            size_t start = i;
+
+            while (i < length && text[i] != ' ' && text[i] != '\t' && text[i] != '\n' && text[i] != '\r' && text[i] != '"') {
+                i++;
+            }
+
+            if (i-start == 2 && text[start] == 'O' && text[start+1] == 'R') {
+                // A group only starts once the current one has a clause
+                if (query->count > 0 && query->clauses[query->count-1].group == query->group) {
+                    query->group++;
+                }
+            } else {
+                fhs_ti_query_add(query, text+start, i-start);
+            }
+        }
+    }
+}
+
+// Sources a query window reads, newest first. The builder, if any, is left out of segments.
+typedef struct {
+    const fhs_text_index_segment **segments;
+    size_t segmentCount;
+    const fhs_text_index_builder *builder;
+    uint64_t low;
+    uint64_t high;
+} fhs_ti_sources;
+
+static int fhs_ti_gather(const fhs_ti_sources *sources, const char *term, size_t length, fhs_ti_list *list) {
+    fhs_ti_list_clear(list);
+
+    for (size_t i = 0; i < sources->segmentCount; i++) {
+        const fhs_text_index_segment *segment = sources->segments[i];
+
+        // Segments outside the id range cost nothing
+        if (segment->count == 0 || segment->maxID < sources->low || segment->minID > sources->high) {
+            continue;
+        }
+
+        long index = fhs_ti_segment_find(segment, term, length);
+
+        if (index == -2 || (index >= 0 && fhs_ti_list_add_segment(list, segment, (uint32_t)index, sources->low, sources->high) != 0)) {
+            return -1;
+        }
+    }
+
+    if (sources->builder && fhs_ti_list_add_builder(list, sources->builder, term, length, sources->low, sources->high) != 0) {
+        return -1;
+    }
+
+    fhs_ti_list_normalize(list);
+    return 0;
+}
+
+static int fhs_ti_has_position(const fhs_ti_list *list, const fhs_ti_posting *posting, uint32_t position) {
+    const uint32_t *positions = list->positions+posting->positionStart;
+    size_t low = 0;
+    size_t high = posting->positionCount;
+
+    while (low < high) {
+        size_t middle = low+(high-low)/2;
+
+        if (positions[middle] == position) {
+            return 1;
+        } else if (positions[middle] < position) {
+            low = middle+1;
+        } else {
+            high = middle;
+        }
+    }
+
+    return 0;
+}
+
+// Ids matching a clause, ascending. Phrases need every term at consecutive positions.
+static int fhs_ti_clause_ids(const fhs_ti_sources *sources, const fhs_ti_clause *clause, fhs_ti_list *lists, uint64_t **ids, size_t *count) {
+    *ids = NULL;
+    *count = 0;
+
+    for (size_t i = 0; i < clause->count; i++) {
+        if (fhs_ti_gather(sources, clause->terms[i], clause->lengths[i], &lists[i]) != 0) {
+            return -1;
+        }
+
+        if (lists[i].count == 0) {
+            return 0;
+        }
+    }
+
+    uint64_t *result = malloc(lists[0].count*sizeof(uint64_t));
+    size_t cursors[FHS_TI_MAX_PHRASE] = {0};
+    size_t found = 0;
+
+    if (!result) {
+        return -1;
+    }
+
+    for (size_t i = 0; i < lists[0].count; i++) {
+        const fhs_ti_posting *first = &lists[0].items[i];
+        const fhs_ti_posting *postings[FHS_TI_MAX_PHRASE] = {first};
+        int everywhere = 1;
+
+        for (size_t j = 1; j < clause->count && everywhere; j++) {
+            while (cursors[j] < lists[j].count && lists[j].items[cursors[j]].id < first->id) {
+                cursors[j]++;
+            }
+
+            everywhere = cursors[j] < lists[j].count && lists[j].items[cursors[j]].id == first->id;
+            postings[j] = everywhere?&lists[j].items[cursors[j]]:NULL;
+        }
+
+        if (!everywhere) {
+            continue;
+        }
+
+        int matched = (clause->count == 1);
+        const uint32_t *starts = lists[0].positions+first->positionStart;
+
+        for (uint32_t k = 0; k < first->positionCount && !matched; k++) {
+            matched = 1;
+
+            for (size_t j = 1; j < clause->count && matched; j++) {
+                matched = fhs_ti_has_position(&lists[j], postings[j], starts[k]+(uint32_t)j);
+            }
+        }
+
+        if (matched) {
+            result[found++] = first->id;
+        }
+    }
+
+    *ids = result;
+    *count = found;
+    return 0;
+}
+
+// Keeps the ids of a that are also in b, both ascending
+static size_t fhs_ti_intersect(uint64_t *a, size_t aCount, const uint64_t *b, size_t bCount) {
+    size_t i = 0, j = 0, kept = 0;
+
+    while (i < aCount && j < bCount) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (a[i] > b[j]) {
+            j++;
+        } else {
+            a[kept++] = a[i];
+            i++;
+            j++;
+        }
+    }
+
+    return kept;
+}
+
+// Appends the ids matching a query within the sources' window, ascending
+static int fhs_ti_evaluate(const fhs_ti_sources *sources, const fhs_ti_query *query, fhs_ti_list *lists, uint64_t **matches, size_t *count, size_t *capacity) {
+    size_t start = *count;
+
+    // Each group is an AND of its clauses, and the groups are ORed
+    for (size_t c = 0; c < query->count;) {
+        size_t group = query->clauses[c].group;
+        uint64_t *groupIDs = NULL;
+        size_t groupCount = 0;
+        int empty = 0;
+
+        for (; c < query->count && query->clauses[c].group == group; c++) {
+            uint64_t *clauseIDs;
+            size_t clauseCount;
+
+            if (empty) {
+                continue;
+            }
+
+            if (fhs_ti_clause_ids(sources, &query->clauses[c], lists, &clauseIDs, &clauseCount) != 0) {
+                free(groupIDs);
+                return -1;
+            }
+
+            if (!groupIDs) {
+                groupIDs = clauseIDs;
+                groupCount = clauseCount;
+            } else {
+                groupCount = fhs_ti_intersect(groupIDs, groupCount, clauseIDs, clauseCount);
+                free(clauseIDs);
+            }
+
+            empty = (groupCount == 0);
+        }
+
+        if (groupCount > 0) {
+            if (fhs_ti_reserve((void **)matches, capacity, *count+groupCount, sizeof(uint64_t)) != 0) {
+                free(groupIDs);
+                return -1;
+            }
+
+            memcpy(*matches+*count, groupIDs, groupCount*sizeof(uint64_t));
+            *count += groupCount;
+        }
+
+        free(groupIDs);
+    }
+
+    *count = start+fhs_ti_unique_ids(*matches+start, *count-start);
+    return 0;
+}
+
+static int fhs_ti_compare_segments(const void *a, const void *b) {
+    uint64_t x = (*(const fhs_text_index_segment * const *)a)->maxID;
+    uint64_t y = (*(const fhs_text_index_segment * const *)b)->maxID;
+    return (x < y)-(x > y);
+}
+
+int fhs_text_index_search(const fhs_text_index_segment *segments, size_t count, const fhs_text_index_builder *builder, const char *query, size_t queryLength, uint64_t sinceID, uint64_t maxID, size_t limit, uint64_t **ids, size_t *idCount) {
+    fhs_ti_query parsed = {0};
+    fhs_ti_list lists[FHS_TI_MAX_PHRASE];
+    const fhs_text_index_segment **order = NULL;
+    uint64_t *matches = NULL;
+    size_t matchCount = 0;
+    size_t matchCapacity = 0;
+    uint64_t low = sinceID+1;
+    uint64_t high = (maxID > 0)?maxID:UINT64_MAX;
+    int result = -1;
+
+    *ids = NULL;
+    *idCount = 0;
+    memset(lists, 0, sizeof(lists));
+
+    if (sinceID == UINT64_MAX || low > high) {
+        return 0;
+    }
+
+    parsed.clauses = calloc(FHS_TI_MAX_CLAUSES, sizeof(fhs_ti_clause));
+    order = malloc((count+1)*sizeof(fhs_text_index_segment *));
+
+    if (!parsed.clauses || !order) {
+        goto done;
+    }
+
+    fhs_ti_query_parse(&parsed, query, queryLength);
+
+    if (parsed.count == 0) {
+        goto done;
+    }
+
+    size_t segmentCount = 0;
+
+    for (size_t i = 0; i < count; i++) {
+        if (segments[i].count > 0 && segments[i].maxID >= low && segments[i].minID <= high) {
+            order[segmentCount++] = &segments[i];
+        }
+    }
+
+    qsort(order, segmentCount, sizeof(fhs_text_index_segment *), fhs_ti_compare_segments);
+
+    if (builder && builder->tweetCount == 0) {
+        builder = NULL;
+    }
+
+    // Walk windows of ids from the newest down. A window ends at the newest id
+    // of the next segment, so everything above it is final, and a limited
+    // query stops once it has enough. Segments are flushed in time order, so
+    // recent matches usually come from the newest segment alone.
+    size_t opened = 0;
+
+    while (1) {
+        while (opened < segmentCount && order[opened]->maxID >= high) {
+            opened++;
+        }
+
+        int more = (opened < segmentCount && order[opened]->maxID >= low);
+        fhs_ti_sources sources = {order, opened, builder, more?order[opened]->maxID+1:low, high};
+        size_t start = matchCount;
+
+        if (fhs_ti_evaluate(&sources, &parsed, lists, &matches, &matchCount, &matchCapacity) != 0) {
+            goto done;
+        }
+
+        for (size_t i = start, j = matchCount; i+1 < j; i++, j--) {
+            uint64_t swap = matches[i];
+            matches[i] = matches[j-1];
+            matches[j-1] = swap;
+        }
+
+        if (!more || (limit > 0 && matchCount >= limit)) {
+            break;
+        }
+
+        high = order[opened]->maxID;
+    }
+
+    if (limit > 0 && matchCount > limit) {
+        matchCount = limit;
+    }
+
+    if (matchCount > 0) {
+        *ids = matches;
+        *idCount = matchCount;
+        matches = NULL;
+    }
+
+    result = 0;
+
+done:
+    free(matches);
+    free(order);
+    free(parsed.clauses);
+
+    for (size_t i = 0; i < FHS_TI_MAX_PHRASE; i++) {
+        fhs_ti_list_free(&lists[i]);
+    }
+
+    return result;
+}
@@ -0,0 +1,147 @@
+//
+//  FHSTextIndex.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Inverted index over tweet text. Tweets are added to an in-memory builder,
+//  which is written out as an immutable segment. Segments are read in place
+//  from memory mapped files, and merged into one when they pile up.
+//
+//  Segment layout, little endian:
+//    header     "FHSIDX01", u64 tweet count, u64 min id, u64 max id,
+//               u32 term count, u32 reserved, u64 pool offset, u64 postings offset
+//    dictionary term count entries of u32 term offset, u32 term length,
+//               u64 postings offset, u32 postings length, u32 tweet count,
+//               sorted by term bytes
+//    pool       term bytes
+//    postings   per term and tweet in ascending id order: varint id delta,
+//               varint position count, varint position deltas
+//
+
+#ifndef FHSTEXTINDEX_H
+#define FHSTEXTINDEX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FHS_TEXT_INDEX_MAX_TERM 64
+
+/**
+ Called for each token of a text.
+ @param context Context passed to the tokenizer.
+ @param term Lowercased token, not terminated.
+ @param length Length of the token.
+ @param position Word position. A hashtag or mention also yields its bare word at the same position.
+ @return 0 to continue, anything else to stop.
+ */
+typedef int (*fhs_text_index_token_callback)(void *context, const char *term, size_t length, uint32_t position);
+
+/**
+ Split text into tokens: runs of ASCII letters, digits, underscores and
+ non-ASCII UTF-8, with ASCII lowercased. A leading # or @ is kept, and the
+ bare word is emitted too so a search for it finds the hashtag.
+ @param text UTF-8 text.
+ @param length Length of the text.
+ @param bareWords Whether to emit the bare word of hashtags and mentions, off for queries.
+ @param callback Token callback.
+ @param context Passed to the callback.
+ @return Number of positions used.
+ */
+uint32_t fhs_text_index_tokenize(const char *text, size_t length, int bareWords, fhs_text_index_token_callback callback, void *context);
+
+/**
+ In-memory index of tweets not yet written out.
+ */
+typedef struct fhs_text_index_builder fhs_text_index_builder;
+
+fhs_text_index_builder *fhs_text_index_builder_create(void);
+void fhs_text_index_builder_free(fhs_text_index_builder *builder);
+
+/**
+ Index a tweet. Adding a tweet that is already in the builder has no effect on results.
+ @param builder Builder.
+ @param tweetID Tweet id.
+ @param text UTF-8 text.
+ @param length Length of the text.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_text_index_builder_add(fhs_text_index_builder *builder, uint64_t tweetID, const char *text, size_t length);
+
+/**
+ Number of tweets added, counting repeats.
+ */
+size_t fhs_text_index_builder_count(const fhs_text_index_builder *builder);
+
+/**
+ Write the builder out as a segment.
+ @param builder Builder.
+ @param segment Set to a malloc'd segment, to be freed by the caller.
+ @param length Set to the segment length.
+ @return 0 on success, -1 if out of memory.
+ */
+int fhs_text_index_builder_write(const fhs_text_index_builder *builder, uint8_t **segment, size_t *length);
+
+/**
+ Segment read in place. Holds pointers into the data, which must outlive it.
+ */
+typedef struct {
+    const uint8_t *data;
+    size_t length;
+    uint64_t count;
+    uint64_t minID;
+    uint64_t maxID;
+    uint32_t termCount;
+    const uint8_t *dictionary;
+    const uint8_t *pool;
+    size_t poolLength;
+    const uint8_t *postings;
+    size_t postingsLength;
+} fhs_text_index_segment;
+
+/**
+ Read a segment.
+ @param segment Segment to fill in.
+ @param data Segment data.
+ @param length Length of the data.
+ @return 0 on success, -1 if the data isn't a valid segment.
+ */
+int fhs_text_index_segment_open(fhs_text_index_segment *segment, const uint8_t *data, size_t length);
+
+/**
+ Merge segments into one, dropping tweets older than a cutoff.
+ @param segments Segments.
+ @param count Number of segments.
+ @param minID Tweets with lower ids are dropped, 0 to keep all.
+ @param merged Set to a malloc'd segment, to be freed by the caller.
+ @param length Set to the segment length.
+ @return 0 on success, -1 if out of memory or a segment is corrupt.
+ */
+int fhs_text_index_merge(const fhs_text_index_segment *segments, size_t count, uint64_t minID, uint8_t **merged, size_t *length);
+
+/**
+ Search segments and a builder. Words are ANDed, OR between words separates
+ alternatives, and "quoted words" must appear next to each other in order.
+ @param segments Segments, may be NULL.
+ @param count Number of segments.
+ @param builder Builder, may be NULL.
+ @param query UTF-8 query.
+ @param queryLength Length of the query.
+ @param sinceID Only tweets with higher ids, 0 for no bound.
+ @param maxID Only tweets with ids up to this one, 0 for no bound.
+ @param limit Most ids to return, 0 for no limit.
+ @param ids Set to a malloc'd array of matching ids, newest first, to be freed by the caller. NULL if there are none.
+ @param idCount Set to the number of ids.
+ @return 0 on success, -1 if out of memory, a segment is corrupt or the query has no words.
+ */
+int fhs_text_index_search(const fhs_text_index_segment *segments, size_t count, const fhs_text_index_builder *builder, const char *query, size_t queryLength, uint64_t sinceID, uint64_t maxID, size_t limit, uint64_t **ids, size_t *idCount);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+//
+//  FHSTimelineSync.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+#import "FHSTwitterEngine.h"
+
+/**
+ Incremental sync of one timeline for the authenticated account.
+ The newest id seen is kept on disk along with the newest items, so each
+ sync only asks for what is newer, even across launches. Older pages are
+ fetched until one comes back empty or reaches the checkpoint. Short pages
+ don't stop it: the API drops deleted and suspended items after applying
+ count, so they happen mid-timeline. If maxPages runs out first, the range
+ still missing is stored as a gap, and later syncs spend the pages they
+ have left on refilling gaps, newest first, so nothing is skipped.
+ The store is an append-only file per account and timeline. It is compacted
+ once it holds twice maxStoredItems.
+ */
+@interface FHSTimelineSync : NSObject
+
+/**
+ Home timeline.
+ @return A sync instance.
+ */
++ (FHSTimelineSync *)syncForHomeTimeline;
+
+/**
+ Mentions timeline.
+ @return A sync instance.
+ */
++ (FHSTimelineSync *)syncForMentions;
+
+/**
+ Received direct messages.
+ @return A sync instance.
+ */
++ (FHSTimelineSync *)syncForDirectMessages;
+
+/**
+ List timeline.
+ @param listID List id.
+ @return A sync instance.
+ */
++ (FHSTimelineSync *)syncForListWithID:(NSString *)listID;
+
+/**
+ Sync for any endpoint that takes since_id, max_id and count and returns an array of objects with id_str.
+ @param name Name of the store file, unique per timeline.
+ @param url Endpoint URL.
+ @param params Parameters, without since_id, max_id and count.
+ @return A sync instance.
+ */
++ (FHSTimelineSync *)syncWithName:(NSString *)name URL:(NSURL *)url parameters:(NSDictionary *)params;
+
+/**
+ Endpoint URL.
+ */
+@property (nonatomic, strong, readonly) NSURL *url;
+
+/**
+ Engine used to send requests. Its authenticated user picks the store file. Defaults to the shared engine.
+ */
+@property (nonatomic, strong) FHSTwitterEngine *engine;
+
+/**
+ Directory of the store files. Defaults to FHSTwitterEngine/Sync in Application Support.
+ */
+@property (nonatomic, copy) NSString *directory;
+
+/**
+ Most items kept on disk. Defaults to 800.
+ */
+@property (nonatomic, assign) NSUInteger maxStoredItems;
+
+/**
+ Most pages fetched by one sync. Defaults to 4, the API's depth for the home and mentions timelines.
+ */
+@property (nonatomic, assign) NSUInteger maxPages;
+
+/**
+ Newest id synced, or 0 before the first sync. Older items may still be missing while hasGaps is YES.
+ */
+@property (nonatomic, readonly) uint64_t checkpoint;
+
+/**
+ Whether a sync ran out of pages before reaching the previous checkpoint and the items in between are not all fetched yet.
+ */
+@property (nonatomic, readonly) BOOL hasGaps;
+
+/**
+ Fetch the items newer than the checkpoint, store them and advance the checkpoint, then refill gaps with the pages left.
+ On the first sync, only the newest page is fetched. Nothing is stored unless every page newer than the checkpoint succeeds;
+ a failed refill keeps its gap for the next sync.
+ @return New items, including those refilled into gaps, newest first, or an NSError.
+ */
+- (id)sync;
+
+/**
+ Stored items, as FHSModel instances.
+ @return Items, newest first.
+ */
+- (NSArray *)storedItems;
+
+/**
+ Delete the store, so the next sync starts over.
+ @return Error, nil on success.
+ */
+- (NSError *)reset;
+
+@end
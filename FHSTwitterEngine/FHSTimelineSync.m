@@ -0,0 +1,440 @@
+//
+//  FHSTimelineSync.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSTimelineSync.h"
+#import "FHSModel.h"
+
+#include <unistd.h>
+
+static NSUInteger const pageSize = 200;
+
+//
+// Store file: an 8 byte magic, then records of
+//   uint32 payload length, uint8 type, payload
+// in little endian. An item payload is its uint64 id followed by its JSON, a
+// gap payload the uint64 max_id and since_id of a range still to fetch, and a
+// checkpoint payload the uint64 id. Items and gaps are written before the
+// checkpoint that covers them, so a torn write at the end only loses the
+// batch whose checkpoint never made it. Every batch lists all open gaps.
+//
+
+static const char fhs_sync_magic[8] = {'F','H','S','S','Y','N','C','1'};
+
+enum {
+    FHSSyncRecordItem = 1,
+    FHSSyncRecordCheckpoint = 2,
+    FHSSyncRecordGap = 3
+};
+
+static void fhs_sync_append_record(NSMutableData *data, uint8_t type, uint64_t identifier, NSData *json) {
+    uint32_t length = CFSwapInt32HostToLittle((uint32_t)(sizeof(uint64_t)+json.length));
+    uint64_t littleIdentifier = CFSwapInt64HostToLittle(identifier);
+    [data appendBytes:&length length:sizeof(length)];
+    [data appendBytes:&type length:sizeof(type)];
+    [data appendBytes:&littleIdentifier length:sizeof(littleIdentifier)];
+
+    if (json) {
+        [data appendData:json];
+    }
+}
+
+static void fhs_sync_append_gaps(NSMutableData *data, NSDictionary *gaps) {
+    for (NSNumber *maxID in gaps) {
+        uint64_t since = CFSwapInt64HostToLittle([gaps[maxID] unsignedLongLongValue]);
+        fhs_sync_append_record(data, FHSSyncRecordGap, maxID.unsignedLongLongValue, [NSData dataWithBytes:&since length:sizeof(since)]);
+    }
+}
+
+static NSError *fhs_sync_posix_error(void) {
+    return [NSError errorWithDomain:NSPOSIXErrorDomain code:errno userInfo:nil];
+}
+
+@interface FHSTimelineSync ()
+
+@property (nonatomic, strong) NSString *name;
+@property (nonatomic, strong) NSURL *url;
+@property (nonatomic, strong) NSDictionary *params;
+
+// Loaded store, guarded by @synchronized(self)
+@property (nonatomic, strong) NSString *path;
+@property (nonatomic, assign, readwrite) uint64_t checkpoint;
+@property (nonatomic, strong) NSMutableDictionary *items; // JSON by id
+@property (nonatomic, strong) NSDictionary *gaps; // since_id by max_id of the ranges a sync ran out of pages for
+@property (nonatomic, assign) NSUInteger itemRecords; // item records in the file, including overwritten ones
+
+@end
+
+@implementation FHSTimelineSync
+
++ (FHSTimelineSync *)syncForHomeTimeline {
+    return [self syncWithName:@"home" URL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointStatusesHomeTimeline)->url)] parameters:nil];
+}
+
++ (FHSTimelineSync *)syncForMentions {
+    return [self syncWithName:@"mentions" URL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointStatusesMentionsTimeline)->url)] parameters:nil];
+}
+
++ (FHSTimelineSync *)syncForDirectMessages {
+    return [self syncWithName:@"direct_messages" URL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointDirectMessages)->url)] parameters:@{ @"skip_status":@"true" }];
+}
+
++ (FHSTimelineSync *)syncForListWithID:(NSString *)listID {
+    return [self syncWithName:[NSString stringWithFormat:@"list_%@", listID] URL:[NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointListsStatuses)->url)] parameters:@{ @"list_id":listID?:@"", @"include_rts":@"true" }];
+}
+
++ (FHSTimelineSync *)syncWithName:(NSString *)name URL:(NSURL *)url parameters:(NSDictionary *)params {
+    return [[[self class]alloc]initWithName:name URL:url parameters:params];
+}
+
+- (instancetype)initWithName:(NSString *)name URL:(NSURL *)url parameters:(NSDictionary *)params {
+    self = [super init];
+    if (self) {
+        self.name = name;
+        self.url = url;
+        self.params = params?:@{};
+        self.engine = [FHSTwitterEngine sharedEngine];
+        self.maxStoredItems = 800;
+        self.maxPages = 4;
+
+        NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+        self.directory = [[support stringByAppendingPathComponent:@"FHSTwitterEngine"]stringByAppendingPathComponent:@"Sync"];
+    }
+    return self;
+}
+
+//
+// Store
+//
+
+- (NSString *)storePath {
+    NSString *account = _engine.authenticatedID.length > 0?_engine.authenticatedID:@"default";
+    return [_directory stringByAppendingPathComponent:[NSString stringWithFormat:@"%@_%@.sync", account, _name]];
+}
+
+// Call within @synchronized(self)
+- (void)loadStore {
+    NSString *path = [self storePath];
+
+    if ([_path isEqualToString:path]) {
+        return;
+    }
+
+    self.path = path;
+    self.checkpoint = 0;
+    self.items = [NSMutableDictionary dictionary];
+    self.gaps = @{};
+    self.itemRecords = 0;
+
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    const uint8_t *bytes = data.bytes;
+    size_t length = data.length;
+
+    if (length < sizeof(fhs_sync_magic) || memcmp(bytes, fhs_sync_magic, sizeof(fhs_sync_magic)) != 0) {
+        // Not ours, or torn before the magic was written. Start over.
+        if (data) {
+            [[NSFileManager defaultManager]removeItemAtPath:path error:nil];
+        }
+        return;
+    }
+
+    NSMutableDictionary *batch = [NSMutableDictionary dictionary];
+    NSMutableDictionary *batchGaps = [NSMutableDictionary dictionary];
+    size_t offset = sizeof(fhs_sync_magic);
+    size_t committed = offset;
+    NSUInteger batchRecords = 0;
+
+    while (length-offset >= sizeof(uint32_t)+1+sizeof(uint64_t)) {
+        uint32_t payloadLength;
+        uint64_t identifier;
+        memcpy(&payloadLength, bytes+offset, sizeof(payloadLength));
+        memcpy(&identifier, bytes+offset+sizeof(uint32_t)+1, sizeof(identifier));
+        payloadLength = CFSwapInt32LittleToHost(payloadLength);
+        identifier = CFSwapInt64LittleToHost(identifier);
+
+        uint8_t type = bytes[offset+sizeof(uint32_t)];
+        size_t payload = offset+sizeof(uint32_t)+1;
+
+        if (payloadLength < sizeof(uint64_t) || length-payload < payloadLength) {
+            break;
+        }
+
+        if (type == FHSSyncRecordItem) {
+            batch[@(identifier)] = [data subdataWithRange:NSMakeRange(payload+sizeof(uint64_t), payloadLength-sizeof(uint64_t))];
+            batchRecords++;
+        } else if (type == FHSSyncRecordGap && payloadLength == 2*sizeof(uint64_t)) {
+            uint64_t since;
+            memcpy(&since, bytes+payload+sizeof(uint64_t), sizeof(since));
+            batchGaps[@(identifier)] = @(CFSwapInt64LittleToHost(since));
+        } else if (type == FHSSyncRecordCheckpoint) {
+            [_items addEntriesFromDictionary:batch];
+            [batch removeAllObjects];
+            _gaps = [batchGaps copy];
+            [batchGaps removeAllObjects];
+            _itemRecords += batchRecords;
+            batchRecords = 0;
+            _checkpoint = identifier;
+            committed = payload+payloadLength;
+        }
+
+        offset = payload+payloadLength;
+    }
+
+    // Drop a torn or uncommitted tail so later appends stay readable
+    if (committed < length) {
+        truncate(path.fileSystemRepresentation, (off_t)committed);
+    }
+}
+
+- (NSArray *)newestItemIDs {
+    NSArray *identifiers = [_items.allKeys sortedArrayUsingSelector:@selector(compare:)].reverseObjectEnumerator.allObjects;
+    return (identifiers.count > _maxStoredItems)?[identifiers subarrayWithRange:NSMakeRange(0, _maxStoredItems)]:identifiers;
+}
+
+- (NSError *)compactStore {
+    NSArray *identifiers = [self newestItemIDs];
+    NSMutableData *data = [NSMutableData dataWithBytes:fhs_sync_magic length:sizeof(fhs_sync_magic)];
+
+    for (NSNumber *identifier in identifiers.reverseObjectEnumerator) {
+        fhs_sync_append_record(data, FHSSyncRecordItem, identifier.unsignedLongLongValue, _items[identifier]);
+    }
+
+    fhs_sync_append_gaps(data, _gaps);
+    fhs_sync_append_record(data, FHSSyncRecordCheckpoint, _checkpoint, nil);
+
+    NSError *error = nil;
+
+    if (![data writeToFile:_path options:NSDataWritingAtomic error:&error]) {
+        return error;
+    }
+
+    self.items = [[NSMutableDictionary alloc]initWithObjects:[_items objectsForKeys:identifiers notFoundMarker:[NSNull null]] forKeys:identifiers];
+    self.itemRecords = identifiers.count;
+    return nil;
+}
+
+- (NSError *)appendItems:(NSDictionary *)items gaps:(NSDictionary *)gaps checkpoint:(uint64_t)checkpoint {
+    NSMutableData *data = [NSMutableData data];
+    BOOL exists = [[NSFileManager defaultManager]fileExistsAtPath:_path];
+
+    if (!exists) {
+        [[NSFileManager defaultManager]createDirectoryAtPath:_directory withIntermediateDirectories:YES attributes:nil error:nil];
+        [data appendBytes:fhs_sync_magic length:sizeof(fhs_sync_magic)];
+    }
+
+    for (NSNumber *identifier in [items.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        fhs_sync_append_record(data, FHSSyncRecordItem, identifier.unsignedLongLongValue, items[identifier]);
+    }
+
+    fhs_sync_append_gaps(data, gaps);
+    fhs_sync_append_record(data, FHSSyncRecordCheckpoint, checkpoint, nil);
+
+    FILE *file = fopen(_path.fileSystemRepresentation, "ab");
+
+    if (!file) {
+        return fhs_sync_posix_error();
+    }
+
+    BOOL written = (fwrite(data.bytes, 1, data.length, file) == data.length && fflush(file) == 0 && fsync(fileno(file)) == 0);
+    NSError *error = written?nil:fhs_sync_posix_error();
+    fclose(file);
+
+    if (error) {
+        return error;
+    }
+
+    [_items addEntriesFromDictionary:items];
+    self.itemRecords += items.count;
+    self.gaps = [gaps copy];
+    self.checkpoint = checkpoint;
+
+    if (_itemRecords > MAX(_maxStoredItems, 1)*2) {
+        return [self compactStore];
+    }
+
+    return nil;
+}
+
+//
+// Sync
+//
+
+- (uint64_t)checkpoint {
+    @synchronized(self) {
+        [self loadStore];
+        return _checkpoint;
+    }
+}
+
+- (NSData *)JSONDataForItem:(id)item {
+    if ([item isKindOfClass:[FHSModel class]]) {
+        return [item JSONData];
+    }
+    return [NSJSONSerialization dataWithJSONObject:item options:0 error:nil];
+}
+
+- (BOOL)hasGaps {
+    @synchronized(self) {
+        [self loadStore];
+        return _gaps.count > 0;
+    }
+}
+
+// Fetches the items in (since, maxID] newest first, maxID 0 meaning the newest, until since is reached or
+// the pages run out. Returns the max_id still missing, 0 once since was reached, or an NSError.
+- (id)fetchItemsSince:(uint64_t)since maxID:(uint64_t)maxID pages:(NSUInteger *)pages fetched:(NSMutableDictionary *)fetched items:(NSMutableArray *)newItems {
+    uint64_t high = maxID;
+
+    while (*pages > 0) {
+        (*pages)--;
+
+        NSMutableDictionary *params = [_params mutableCopy];
+        params[@"count"] = @(pageSize).stringValue;
+
+        if (since > 0) {
+            params[@"since_id"] = [NSString fhs_stringWithTweetID:since];
+        }
+
+        if (maxID > 0) {
+            params[@"max_id"] = [NSString fhs_stringWithTweetID:maxID];
+        }
+
+        id response = [_engine sendRequestForURL:_url HTTPMethod:@"GET" parameters:params];
+
+        if ([response isKindOfClass:[NSError class]]) {
+            return response;
+        }
+
+        if (![response isKindOfClass:[NSArray class]]) {
+            return [NSError noDataError];
+        }
+
+        uint64_t oldest = UINT64_MAX;
+
+        for (id item in response) {
+            uint64_t identifier = [item isKindOfClass:[NSDictionary class]]?[item[@"id_str"] fhs_tweetID]:0;
+
+            if (identifier <= since || (high > 0 && identifier > high) || fetched[@(identifier)]) {
+                continue;
+            }
+
+            NSData *json = [self JSONDataForItem:item];
+
+            if (json) {
+                fetched[@(identifier)] = json;
+                [newItems addObject:item];
+                oldest = MIN(oldest, identifier);
+            }
+        }
+
+        // Only an empty page means since was reached. Deleted and suspended items are removed after count
+        // is applied, so short pages are normal mid-timeline.
+        if (oldest == UINT64_MAX || oldest <= since+1) {
+            return @0;
+        }
+
+        maxID = oldest-1;
+    }
+
+    return @(maxID);
+}
+
+- (id)sync {
+    @synchronized(self) {
+        [self loadStore];
+
+        uint64_t since = _checkpoint;
+        NSUInteger pages = (since == 0)?1:MAX(_maxPages, 1); // a cold start only takes the newest page
+        NSMutableDictionary *fetched = [NSMutableDictionary dictionary];
+        NSMutableArray *newItems = [NSMutableArray array];
+        NSMutableDictionary *gaps = [_gaps mutableCopy];
+        id missing = [self fetchItemsSince:since maxID:0 pages:&pages fetched:fetched items:newItems];
+
+        if ([missing isKindOfClass:[NSError class]]) {
+            return missing;
+        }
+
+        // Out of pages before the checkpoint: what lies between is kept as a gap rather than skipped
+        if (since > 0 && [missing unsignedLongLongValue] > 0) {
+            gaps[missing] = @(since);
+        }
+
+        // Pages left over refill the gaps, newest first. A failed refill leaves its gap for the next sync.
+        for (NSNumber *maxID in [gaps.allKeys sortedArrayUsingSelector:@selector(compare:)].reverseObjectEnumerator) {
+            if (pages == 0) {
+                break;
+            }
+
+            NSNumber *gapSince = gaps[maxID];
+            missing = [self fetchItemsSince:gapSince.unsignedLongLongValue maxID:maxID.unsignedLongLongValue pages:&pages fetched:fetched items:newItems];
+
+            if ([missing isKindOfClass:[NSError class]]) {
+                break;
+            }
+
+            [gaps removeObjectForKey:maxID];
+
+            if ([missing unsignedLongLongValue] > 0) {
+                gaps[missing] = gapSince;
+            }
+        }
+
+        uint64_t newest = since;
+
+        for (NSNumber *identifier in fetched) {
+            newest = MAX(newest, identifier.unsignedLongLongValue);
+        }
+
+        if (fetched.count > 0 || ![gaps isEqualToDictionary:_gaps]) {
+            NSError *error = [self appendItems:fetched gaps:gaps checkpoint:newest];
+
+            if (error) {
+                return error;
+            }
+        }
+
+        return [newItems sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
+            uint64_t first = [a[@"id_str"] fhs_tweetID];
+            uint64_t second = [b[@"id_str"] fhs_tweetID];
+            return (first > second)?NSOrderedAscending:((first < second)?NSOrderedDescending:NSOrderedSame);
+        }];
+    }
+}
+
+- (NSArray *)storedItems {
+    @synchronized(self) {
+        [self loadStore];
+
+        NSArray *identifiers = [self newestItemIDs];
+        NSMutableArray *items = [NSMutableArray arrayWithCapacity:identifiers.count];
+
+        for (NSNumber *identifier in identifiers) {
+            id item = [FHSModel modelWithData:_items[identifier]];
+
+            if (item) {
+                [items addObject:item];
+            }
+        }
+
+        return items;
+    }
+}
+
+- (NSError *)reset {
+    @synchronized(self) {
+        NSString *path = [self storePath];
+        NSError *error = nil;
+
+        if ([[NSFileManager defaultManager]fileExistsAtPath:path] && ![[NSFileManager defaultManager]removeItemAtPath:path error:&error]) {
+            return error;
+        }
+
+        self.path = nil;
+        return nil;
+    }
+}
+
+@end
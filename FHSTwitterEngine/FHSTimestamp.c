@@ -0,0 +1,143 @@
+//
+//  FHSTimestamp.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#include "FHSTimestamp.h"
+
+static const char weekdays[7][3] = {{'T','h','u'}, {'F','r','i'}, {'S','a','t'}, {'S','u','n'}, {'M','o','n'}, {'T','u','e'}, {'W','e','d'}}; // 1970-01-01 was a Thursday
+static const char months[12][3] = {{'J','a','n'}, {'F','e','b'}, {'M','a','r'}, {'A','p','r'}, {'M','a','y'}, {'J','u','n'}, {'J','u','l'}, {'A','u','g'}, {'S','e','p'}, {'O','c','t'}, {'N','o','v'}, {'D','e','c'}};
+
+// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's days_from_civil)
+static int64_t fhs_days_from_civil(int64_t year, unsigned month, unsigned day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year-399)/400;
+    unsigned yearOfEra = (unsigned)(year-era*400);
+    unsigned dayOfYear = (153*(month > 2 ? month-3 : month+9)+2)/5+day-1;
+    unsigned dayOfEra = yearOfEra*365+yearOfEra/4-yearOfEra/100+dayOfYear;
+    return era*146097+(int64_t)dayOfEra-719468;
+}
+
+static void fhs_civil_from_days(int64_t days, int64_t *year, unsigned *month, unsigned *day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days-146096)/146097;
+    unsigned dayOfEra = (unsigned)(days-era*146097);
+    unsigned yearOfEra = (dayOfEra-dayOfEra/1460+dayOfEra/36524-dayOfEra/146096)/365;
+    unsigned dayOfYear = dayOfEra-(365*yearOfEra+yearOfEra/4-yearOfEra/100);
+    unsigned mp = (5*dayOfYear+2)/153;
+    *day = dayOfYear-(153*mp+2)/5+1;
+    *month = mp < 10 ? mp+3 : mp-9;
+    *year = (int64_t)yearOfEra+era*400+(*month <= 2);
+}
+
+static inline int fhs_digits(const char *p, unsigned count, unsigned *value) {
+    unsigned v = 0;
+
+    for (unsigned i = 0; i < count; i++) {
+        unsigned digit = (unsigned)(p[i]-'0');
+
+        if (digit > 9) {
+            return -1;
+        }
+
+        v = v*10+digit;
+    }
+
+    *value = v;
+    return 0;
+}
+
+static inline void fhs_put_digits(char *p, unsigned count, unsigned value) {
+    while (count-- > 0) {
+        p[count] = (char)('0'+value%10);
+        value /= 10;
+    }
+}
+
+int fhs_timestamp_parse(const char *text, size_t length, int64_t *seconds) {
+    // Www Mmm dd hh:mm:ss +zzzz yyyy
+    // 0   4   8  11 14 17 20    26
+    if (length != FHS_TIMESTAMP_LENGTH || text[3] != ' ' || text[7] != ' ' || text[10] != ' ' || text[13] != ':' || text[16] != ':' || text[19] != ' ' || text[25] != ' ') {
+        return -1;
+    }
+
+    unsigned month = 0;
+
+    while (month < 12 && !(text[4] == months[month][0] && text[5] == months[month][1] && text[6] == months[month][2])) {
+        month++;
+    }
+
+    unsigned day, hour, minute, second, offsetHours, offsetMinutes, year;
+
+    if (month == 12 || fhs_digits(text+8, 2, &day) || fhs_digits(text+11, 2, &hour) || fhs_digits(text+14, 2, &minute) || fhs_digits(text+17, 2, &second) || (text[20] != '+' && text[20] != '-') || fhs_digits(text+21, 2, &offsetHours) || fhs_digits(text+23, 2, &offsetMinutes) || fhs_digits(text+26, 4, &year)) {
+        return -1;
+    }
+
+    if (day < 1 || day > 31 || hour > 23 || minute > 59 || second > 60 || offsetMinutes > 59) {
+        return -1;
+    }
+
+    int64_t offset = (int64_t)(offsetHours*3600+offsetMinutes*60);
+    int64_t local = fhs_days_from_civil(year, month+1, day)*86400+hour*3600+minute*60+second;
+    *seconds = (text[20] == '+') ? local-offset : local+offset;
+    return 0;
+}
+
+static int fhs_timestamp_split(int64_t seconds, int64_t *days, unsigned *secondOfDay, int64_t *year, unsigned *month, unsigned *day) {
+    *days = seconds >= 0 ? seconds/86400 : -((-seconds+86399)/86400);
+    *secondOfDay = (unsigned)(seconds-*days*86400);
+    fhs_civil_from_days(*days, year, month, day);
+    return (*year < 0 || *year > 9999) ? -1 : 0;
+}
+
+size_t fhs_timestamp_format(int64_t seconds, char *buffer) {
+    int64_t days, year;
+    unsigned secondOfDay, month, day;
+
+    if (fhs_timestamp_split(seconds, &days, &secondOfDay, &year, &month, &day) != 0) {
+        return 0;
+    }
+
+    const char *weekday = weekdays[((days%7)+7)%7];
+    buffer[0] = weekday[0];
+    buffer[1] = weekday[1];
+    buffer[2] = weekday[2];
+    buffer[3] = ' ';
+    buffer[4] = months[month-1][0];
+    buffer[5] = months[month-1][1];
+    buffer[6] = months[month-1][2];
+    buffer[7] = ' ';
+    fhs_put_digits(buffer+8, 2, day);
+    buffer[10] = ' ';
+    fhs_put_digits(buffer+11, 2, secondOfDay/3600);
+    buffer[13] = ':';
+    fhs_put_digits(buffer+14, 2, secondOfDay/60%60);
+    buffer[16] = ':';
+    fhs_put_digits(buffer+17, 2, secondOfDay%60);
+    buffer[19] = ' ';
+    buffer[20] = '+';
+    fhs_put_digits(buffer+21, 4, 0);
+    buffer[25] = ' ';
+    fhs_put_digits(buffer+26, 4, (unsigned)year);
+    buffer[30] = '\0';
+    return FHS_TIMESTAMP_LENGTH;
+}
+
+size_t fhs_timestamp_format_date(int64_t seconds, char *buffer) {
+    int64_t days, year;
+    unsigned secondOfDay, month, day;
+
+    if (fhs_timestamp_split(seconds, &days, &secondOfDay, &year, &month, &day) != 0) {
+        return 0;
+    }
+
+    fhs_put_digits(buffer, 4, (unsigned)year);
+    buffer[4] = '-';
+    fhs_put_digits(buffer+5, 2, month);
+    buffer[7] = '-';
+    fhs_put_digits(buffer+8, 2, day);
+    buffer[10] = '\0';
+    return FHS_TIMESTAMP_DATE_LENGTH;
+}
@@ -0,0 +1,61 @@
+//
+//  FHSTimestamp.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Parses and formats Twitter's fixed timestamp layout,
+//  "Wed Aug 27 13:08:45 +0000 2008", without locales or allocation.
+//  All functions are reentrant.
+//
+
+#ifndef FHSTIMESTAMP_H
+#define FHSTIMESTAMP_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ Length of a formatted timestamp, excluding the terminator.
+ */
+#define FHS_TIMESTAMP_LENGTH 30
+
+/**
+ Length of a formatted date (yyyy-MM-dd), excluding the terminator.
+ */
+#define FHS_TIMESTAMP_DATE_LENGTH 10
+
+/**
+ Parse a timestamp.
+ @param text Timestamp, e.g. "Wed Aug 27 13:08:45 +0000 2008". Need not be terminated.
+ @param length Length of the text.
+ @param seconds Seconds since 1970, UTC.
+ @return 0 on success, -1 if the text isn't a valid timestamp.
+ */
+int fhs_timestamp_parse(const char *text, size_t length, int64_t *seconds);
+
+/**
+ Format a time as a UTC timestamp.
+ @param seconds Seconds since 1970, for years 0 through 9999.
+ @param buffer Output, at least FHS_TIMESTAMP_LENGTH+1 bytes. Terminated.
+ @return FHS_TIMESTAMP_LENGTH, or 0 if the year is out of range.
+ */
+size_t fhs_timestamp_format(int64_t seconds, char *buffer);
+
+/**
+ Format the UTC date of a time as yyyy-MM-dd, as search's until parameter takes it.
+ @param seconds Seconds since 1970, for years 0 through 9999.
+ @param buffer Output, at least FHS_TIMESTAMP_DATE_LENGTH+1 bytes. Terminated.
+ @return FHS_TIMESTAMP_DATE_LENGTH, or 0 if the year is out of range.
+ */
+size_t fhs_timestamp_format_date(int64_t seconds, char *buffer);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,97 @@
+//
+//  FHSTweetIndex.h
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ Local full-text index of tweets already fetched, so searches over them cost
+ no request. Set it as the engine's tweetIndex to feed it every timeline,
+ search and user stream response, or add tweets yourself.
+ Text, hashtags and mentions are indexed, case-insensitively for ASCII.
+ Queries AND their words, OR separates alternatives, and "quoted words" must
+ appear in that order: apple "new york" OR #wwdc. A hashtag or mention in a
+ query only matches the hashtag or mention, a bare word matches both.
+ New tweets are held in memory and written out as a segment file every
+ flushThreshold tweets or on synchronize:. Segments are memory mapped, and
+ merged in the background as they pile up, dropping tweets older than the
+ retention interval. Tweets not yet written out are lost if the process dies.
+ The index is safe to use from any thread.
+ */
+@interface FHSTweetIndex : NSObject
+
+/**
+ Open or create an index.
+ @param directory Directory holding the segment files, created if needed. Use one directory per index.
+ @param error Set on failure, may be NULL.
+ @return An index instance, or nil on failure.
+ */
++ (FHSTweetIndex *)indexWithDirectory:(NSString *)directory error:(NSError **)error;
+
+/**
+ Directory holding the segment files.
+ */
+@property (nonatomic, strong, readonly) NSString *directory;
+
+/**
+ Tweets held in memory before they are written out. Defaults to 20000.
+ */
+@property (assign) NSUInteger flushThreshold;
+
+/**
+ Most tweets a merged segment holds. Segments cover consecutive time ranges, so a limited query reads the newest ones only. Defaults to 200000.
+ */
+@property (assign) NSUInteger segmentSize;
+
+/**
+ Age past which tweets are dropped when segments are merged, or 0 to keep everything. Defaults to 7 days.
+ */
+@property (assign) NSTimeInterval retentionInterval;
+
+/**
+ Number of tweets in the index, counting a tweet added twice before a merge twice.
+ */
+@property (readonly) NSUInteger count;
+
+/**
+ Index a tweet, and the tweets it retweets or quotes.
+ @param tweet Tweet dictionary or model.
+ */
+- (void)addTweet:(NSDictionary *)tweet;
+
+/**
+ Index the tweets of an API response: an array of tweets, search results, or a single tweet. Anything else is ignored.
+ @param response Parsed response.
+ */
+- (void)addTweetsFromResponse:(id)response;
+
+/**
+ Search the index.
+ @param query Query.
+ @param sinceID Only tweets newer than this id, or nil.
+ @param maxID Only tweets up to this id, or nil.
+ @param limit Most ids to return, 0 for all.
+ @return Matching tweet ids as strings, newest first. Look them up with lookupTweets: if you don't keep the tweets.
+ */
+- (NSArray *)tweetIDsMatchingQuery:(NSString *)query sinceID:(NSString *)sinceID maxID:(NSString *)maxID limit:(NSUInteger)limit;
+
+/**
+ Search the tweets posted since a date.
+ @param query Query.
+ @param fromDate Earliest post date, from the tweet ids' timestamps.
+ @param limit Most ids to return, 0 for all.
+ @return Matching tweet ids as strings, newest first.
+ */
+- (NSArray *)tweetIDsMatchingQuery:(NSString *)query fromDate:(NSDate *)fromDate limit:(NSUInteger)limit;
+
+/**
+ Write out the tweets held in memory.
+ @param error Set on failure, may be NULL.
+ @return Whether the tweets were written.
+ */
+- (BOOL)synchronize:(NSError **)error;
+
+@end
@@ -0,0 +1,424 @@
+//
+//  FHSTweetIndex.m
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+
+#import "FHSTweetIndex.h"
+#import "FHSTwitterEngine.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#include "FHSTextIndex.h"
+
+static NSString * const segmentExtension = @"fhsidx";
+
+// Segments merged at once, so each tweet is rewritten a few times at most
+static NSUInteger const mergeFactor = 4;
+
+@interface FHSTweetIndexSegment : NSObject {
+@public
+    fhs_text_index_segment _segment;
+}
+
+@property (nonatomic, strong) NSData *data;
+@property (nonatomic, strong) NSString *path;
+
+@end
+
+@implementation FHSTweetIndexSegment
+
++ (FHSTweetIndexSegment *)segmentWithContentsOfFile:(NSString *)path {
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil];
+    FHSTweetIndexSegment *segment = [[[self class]alloc]init];
+
+    if (!data || fhs_text_index_segment_open(&segment->_segment, data.bytes, data.length) != 0) {
+        return nil;
+    }
+
+    segment.data = data;
+    segment.path = path;
+    return segment;
+}
+
+@end
+
+@interface FHSTweetIndex () {
+    fhs_text_index_builder *_builder;
+}
+
+@property (nonatomic, strong, readwrite) NSString *directory;
+
+// Everything below is only touched on the queue
+@property (nonatomic, strong) dispatch_queue_t queue;
+@property (nonatomic, strong) NSMutableArray *segments; // by newest id, oldest first
+@property (nonatomic, assign) unsigned long long sequence; // of the last segment file
+@property (nonatomic, assign) BOOL merging;
+
+@property (nonatomic, strong) dispatch_queue_t mergeQueue;
+
+@end
+
+@implementation FHSTweetIndex
+
++ (FHSTweetIndex *)indexWithDirectory:(NSString *)directory error:(NSError **)error {
+    if (![[NSFileManager defaultManager]createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:error]) {
+        return nil;
+    }
+
+    return [[[self class]alloc]initWithDirectory:directory];
+}
+
+- (instancetype)initWithDirectory:(NSString *)directory {
+    self = [super init];
+    if (self) {
+        self.directory = directory;
+        self.flushThreshold = 20000;
+        self.segmentSize = 200000;
+        self.retentionInterval = 7*24*60*60;
+        self.queue = dispatch_queue_create("FHSTweetIndex", DISPATCH_QUEUE_SERIAL);
+        self.mergeQueue = dispatch_queue_create("FHSTweetIndexMerge", DISPATCH_QUEUE_SERIAL);
+        self.segments = [NSMutableArray array];
+        _builder = fhs_text_index_builder_create();
+
+        // Files that fail to open are leftovers of a crash and are skipped
+        for (NSString *name in [[NSFileManager defaultManager]contentsOfDirectoryAtPath:directory error:nil]) {
+            if (![name.pathExtension isEqualToString:segmentExtension]) {
+                continue;
+            }
+
+            FHSTweetIndexSegment *segment = [FHSTweetIndexSegment segmentWithContentsOfFile:[directory stringByAppendingPathComponent:name]];
+            unsigned long long sequence = strtoull(name.stringByDeletingPathExtension.UTF8String, NULL, 16);
+
+            if (segment) {
+                [_segments addObject:segment];
+            }
+
+            _sequence = MAX(_sequence, sequence);
+        }
+
+        [self sortSegments];
+    }
+    return self;
+}
+
+- (void)dealloc {
+    fhs_text_index_builder_free(_builder);
+}
+
+- (NSUInteger)count {
+    __block NSUInteger count = 0;
+
+    dispatch_sync(_queue, ^{
+        count = fhs_text_index_builder_count(_builder);
+
+        for (FHSTweetIndexSegment *segment in _segments) {
+            count += (NSUInteger)segment->_segment.count;
+        }
+    });
+
+    return count;
+}
+
+// Call on the queue
+- (void)sortSegments {
+    [_segments sortUsingComparator:^NSComparisonResult(FHSTweetIndexSegment *a, FHSTweetIndexSegment *b) {
+        if (a->_segment.maxID == b->_segment.maxID) {
+            return NSOrderedSame;
+        }
+        return (a->_segment.maxID < b->_segment.maxID)?NSOrderedAscending:NSOrderedDescending;
+    }];
+}
+
+//
+// Adding
+//
+
+- (void)addTweet:(NSDictionary *)tweet {
+    [self addTweetsFromResponse:tweet];
+}
+
+// Collects id and text pairs, following retweets and quotes
+- (void)collectTweet:(NSDictionary *)tweet into:(NSMutableArray *)entries {
+    if (![tweet isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+
+    uint64_t identifier = [tweet[@"id_str"] fhs_tweetID];
+    id extended = tweet[@"extended_tweet"];
+    NSString *text = tweet[@"full_text"];
+
+    if (![text isKindOfClass:[NSString class]] && [extended isKindOfClass:[NSDictionary class]]) {
+        text = extended[@"full_text"];
+    }
+
+    if (![text isKindOfClass:[NSString class]]) {
+        text = tweet[@"text"];
+    }
+
+    // Direct messages have text too, but no user
+    if (identifier > 0 && [text isKindOfClass:[NSString class]] && tweet[@"user"]) {
+        [entries addObject:@[@(identifier), text]];
+    }
+
+    [self collectTweet:tweet[@"retweeted_status"] into:entries];
+    [self collectTweet:tweet[@"quoted_status"] into:entries];
+}
+
+- (void)addTweetsFromResponse:(id)response {
+    NSMutableArray *entries = [NSMutableArray array];
+
+    if ([response isKindOfClass:[NSArray class]]) {
+        for (id tweet in response) {
+            [self collectTweet:tweet into:entries];
+        }
+    } else if ([response isKindOfClass:[NSDictionary class]] && [response[@"statuses"] isKindOfClass:[NSArray class]]) {
+        for (id tweet in response[@"statuses"]) {
+            [self collectTweet:tweet into:entries];
+        }
+    } else {
+        [self collectTweet:response into:entries];
+    }
+
+    if (entries.count == 0) {
+        return;
+    }
+
+    dispatch_async(_queue, ^{
+        for (NSArray *entry in entries) {
+            NSData *text = [entry[1] dataUsingEncoding:NSUTF8StringEncoding];
+            fhs_text_index_builder_add(_builder, [entry[0] unsignedLongLongValue], text.bytes, text.length);
+        }
+
+        if (fhs_text_index_builder_count(_builder) >= self.flushThreshold) {
+            [self flush:nil];
+        }
+    });
+}
+
+// Call on the queue
+- (NSString *)nextSegmentPath {
+    self.sequence = _sequence+1;
+    return [_directory stringByAppendingPathComponent:[[NSString stringWithFormat:@"%016llx", _sequence] stringByAppendingPathExtension:segmentExtension]];
+}
+
+// Call on the queue. Writes the builder out as a segment and starts a merge if due.
+- (BOOL)flush:(NSError **)error {
+    if (fhs_text_index_builder_count(_builder) == 0) {
+        return YES;
+    }
+
+    uint8_t *bytes;
+    size_t length;
+
+    if (fhs_text_index_builder_write(_builder, &bytes, &length) != 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:ENOMEM userInfo:nil];
+        }
+        return NO;
+    }
+
+    NSData *data = [NSData dataWithBytesNoCopy:bytes length:length freeWhenDone:YES];
+    NSString *path = [self nextSegmentPath];
+
+    if (![data writeToFile:path options:NSDataWritingAtomic error:error]) {
+        return NO;
+    }
+
+    FHSTweetIndexSegment *segment = [FHSTweetIndexSegment segmentWithContentsOfFile:path];
+
+    if (!segment) {
+        if (error) {
+            *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileReadCorruptFileError userInfo:@{NSFilePathErrorKey: path}];
+        }
+        return NO;
+    }
+
+    fhs_text_index_builder_free(_builder);
+    _builder = fhs_text_index_builder_create();
+    [_segments addObject:segment];
+    [self sortSegments];
+    [self mergeIfNeeded];
+    return YES;
+}
+
+- (BOOL)synchronize:(NSError **)error {
+    __block BOOL written = NO;
+    __block NSError *flushError = nil;
+
+    dispatch_sync(_queue, ^{
+        NSError *blockError = nil;
+        written = [self flush:&blockError];
+        flushError = blockError;
+    });
+
+    if (error) {
+        *error = flushError;
+    }
+
+    return written;
+}
+
+//
+// Merging
+//
+
+// Call on the queue
+- (uint64_t)retentionCutoff {
+    NSTimeInterval retention = self.retentionInterval;
+    return (retention > 0)?[[NSDate dateWithTimeIntervalSinceNow:-retention]fhs_firstTweetID]:0;
+}
+
+// Call on the queue. Picks the oldest run of neighbouring small segments, so merged segments keep covering consecutive time ranges.
+- (NSArray *)segmentsToMerge {
+    NSUInteger segmentSize = self.segmentSize;
+    NSMutableArray *run = [NSMutableArray array];
+    uint64_t total = 0;
+
+    for (FHSTweetIndexSegment *segment in _segments) {
+        uint64_t count = segment->_segment.count;
+
+        if (count >= segmentSize || total+count > segmentSize) {
+            if (run.count >= mergeFactor) {
+                return run;
+            }
+
+            [run removeAllObjects];
+            total = 0;
+
+            if (count >= segmentSize) {
+                continue;
+            }
+        }
+
+        [run addObject:segment];
+        total += count;
+    }
+
+    return (run.count >= mergeFactor)?run:nil;
+}
+
+// Call on the queue
+- (void)mergeIfNeeded {
+    if (_merging) {
+        return;
+    }
+
+    uint64_t cutoff = [self retentionCutoff];
+
+    // Segments entirely past retention go without a merge
+    for (FHSTweetIndexSegment *segment in [_segments copy]) {
+        if (cutoff > 0 && segment->_segment.maxID < cutoff) {
+            [_segments removeObject:segment];
+            [[NSFileManager defaultManager]removeItemAtPath:segment.path error:nil];
+        }
+    }
+
+    NSArray *group = [self segmentsToMerge];
+
+    if (!group) {
+        return;
+    }
+
+    NSString *path = [self nextSegmentPath];
+    self.merging = YES;
+
+    // Segments are immutable and the group holds their mappings, so the merge reads them off the queue
+    dispatch_async(_mergeQueue, ^{
+        @autoreleasepool {
+            fhs_text_index_segment *parts = malloc(group.count*sizeof(fhs_text_index_segment));
+            FHSTweetIndexSegment *merged = nil;
+            uint8_t *bytes = NULL;
+            size_t length = 0;
+
+            for (NSUInteger i = 0; parts && i < group.count; i++) {
+                parts[i] = ((FHSTweetIndexSegment *)group[i])->_segment;
+            }
+
+            if (parts && fhs_text_index_merge(parts, group.count, cutoff, &bytes, &length) == 0) {
+                NSData *data = [NSData dataWithBytesNoCopy:bytes length:length freeWhenDone:YES];
+
+                if ([data writeToFile:path options:NSDataWritingAtomic error:nil]) {
+                    merged = [FHSTweetIndexSegment segmentWithContentsOfFile:path];
+                }
+            }
+
+            free(parts);
+
+            dispatch_async(_queue, ^{
+                self.merging = NO;
+
+                if (!merged) {
+                    [[NSFileManager defaultManager]removeItemAtPath:path error:nil];
+                    return;
+                }
+
+                // The new file is in place before the old ones go, so a crash leaves repeats, not gaps
+                for (FHSTweetIndexSegment *segment in group) {
+                    [_segments removeObjectIdenticalTo:segment];
+                    [[NSFileManager defaultManager]removeItemAtPath:segment.path error:nil];
+                }
+
+                if (merged->_segment.count > 0) {
+                    [_segments addObject:merged];
+                } else {
+                    [[NSFileManager defaultManager]removeItemAtPath:path error:nil];
+                }
+
+                [self sortSegments];
+                [self mergeIfNeeded];
+            });
+        }
+    });
+}
+
+//
+// Searching
+//
+
+- (NSArray *)tweetIDsMatchingQuery:(NSString *)query sinceID:(NSString *)sinceID maxID:(NSString *)maxID limit:(NSUInteger)limit {
+    return [self tweetIDsMatchingQuery:query since:[sinceID fhs_tweetID] max:[maxID fhs_tweetID] limit:limit];
+}
+
+- (NSArray *)tweetIDsMatchingQuery:(NSString *)query fromDate:(NSDate *)fromDate limit:(NSUInteger)limit {
+    uint64_t first = [fromDate fhs_firstTweetID];
+    return [self tweetIDsMatchingQuery:query since:(first > 0)?first-1:0 max:0 limit:limit];
+}
+
+- (NSArray *)tweetIDsMatchingQuery:(NSString *)query since:(uint64_t)sinceID max:(uint64_t)maxID limit:(NSUInteger)limit {
+    NSData *text = [query dataUsingEncoding:NSUTF8StringEncoding];
+    __block uint64_t *ids = NULL;
+    __block size_t count = 0;
+
+    if (text.length == 0) {
+        return @[];
+    }
+
+    dispatch_sync(_queue, ^{
+        fhs_text_index_segment *parts = malloc((_segments.count+1)*sizeof(fhs_text_index_segment));
+
+        if (!parts) {
+            return;
+        }
+
+        for (NSUInteger i = 0; i < _segments.count; i++) {
+            parts[i] = ((FHSTweetIndexSegment *)_segments[i])->_segment;
+        }
+
+        fhs_text_index_search(parts, _segments.count, _builder, text.bytes, text.length, sinceID, maxID, limit, &ids, &count);
+        free(parts);
+    });
+
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+
+    for (size_t i = 0; i < count; i++) {
+        [strings addObject:[NSString fhs_stringWithTweetID:ids[i]]];
+    }
+
+    free(ids);
+    return strings;
+}
+
+@end
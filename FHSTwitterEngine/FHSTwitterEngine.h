@@ -31,7 +31,24 @@
 // See https://dev.twitter.com/streaming/userstreams for Streaming APIs.
 //
 
+#import <Foundation/Foundation.h>
+
+// The login controller and UIImage profile images need UIKit. Builds without
+// it, such as GNUstep on Linux, leave them out. Define FHS_HEADLESS to leave
+// them out on iOS too.
+#if TARGET_OS_IPHONE && !defined(FHS_HEADLESS)
+#define FHS_UIKIT 1
 #import <UIKit/UIKit.h>
+#else
+#define FHS_UIKIT 0
+#endif
+
+#include "FHSEndpoint.h"
+
+@class FHSMultipartBody;
+@class FHSJSONReader;
+@class FHSIDList;
+@class FHSTweetIndex;
 
 /**
  Image sizes.
@@ -58,7 +75,7 @@ typedef enum {
 typedef void(^StreamBlock)(id result, BOOL *stop);
 
 /**
- Remove NSNulls from NSDictionary and NSArray.
+ Remove NSNulls from NSDictionary and NSArray. Responses are now cleaned while parsing, see FHSJSONReader.
  Credit: Conrad Kramer https://github.com/conradev
  */
 id removeNull(id rootObject);
@@ -77,6 +94,8 @@ extern NSString * const FHSProfileDescriptionKey;
 
 // Error
 extern NSString * const FHSErrorDomain;
+extern NSString * const FHSRateLimitResetDateKey; // NSDate in the userInfo of 429 errors, and in rateLimitForURL:
+extern NSString * const FHSRateLimitRemainingKey; // NSNumber in rateLimitForURL:
 
 /** FHSTwitterEngine token object. */
 @interface FHSToken : NSObject
@@ -161,7 +180,7 @@ extern NSString * const FHSErrorDomain;
 - (NSError *)postTweet:(NSString *)tweetString withMediaIDs:(NSArray *)mediaIDs ;
 
 /**
- Upload media with data.
+ Upload media with data. The upload is synchronous and the block is called on the calling thread, on success and on failure.
  @param imageData Image data.
  @param completionBlock Block to be called on completion.
  */
@@ -282,6 +301,13 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)getRateLimitStatus;
 
+/**
+ Rate limit of an endpoint as of its last response, from the x-rate-limit headers. Costs no request.
+ @param url Endpoint URL. Query parameters are ignored.
+ @return Dictionary with FHSRateLimitRemainingKey and FHSRateLimitResetDateKey, or nil if no response for the endpoint has been seen yet.
+ */
+- (NSDictionary *)rateLimitForURL:(NSURL *)url;
+
 /**
  Like a tweet.
  @param tweetId Tweet id.
@@ -431,6 +457,20 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)getConfiguration;
 
+/**
+ Check media against the upload limits without sending anything. Only the container header is read. Limits come from the last getConfiguration response, or the documented defaults if there is none.
+ @param data JPEG, PNG, GIF, WebP or MP4 data.
+ @return If the media would be refused, returns an NSError object that describes the problem.
+ */
+- (NSError *)validateMediaData:(NSData *)data;
+
+/**
+ Check a media file against the upload limits. The file is memory-mapped, so only its header pages are read.
+ @param path File path.
+ @return If the media would be refused, returns an NSError object that describes the problem.
+ */
+- (NSError *)validateMediaAtPath:(NSString *)path;
+
 /**
  Get languages.
  @return Languages.
@@ -461,7 +501,7 @@ extern NSString * const FHSErrorDomain;
  Get profile image for a user.
  @param username User.
  @param size FHSTwitterEngineImageSize size.
- @return Profile image.
+ @return Profile image, a UIImage, or its NSData in builds without UIKit.
  */
 - (id)getProfileImageForUsername:(NSString *)username andSize:(FHSTwitterEngineImageSize)size;
 
@@ -493,6 +533,17 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)getTimelineForUser:(NSString *)user isID:(BOOL)isID count:(int)count sinceID:(NSString *)sinceID maxID:(NSString *)maxID;
 
+/**
+ Get a user's tweets from a time window. The window is turned into since_id and max_id bounds from the tweet IDs' timestamps, so no paging is needed to reach it.
+ @param user User.
+ @param isID Boolean whether the user is a user id.
+ @param count Number of tweets, newest first.
+ @param fromDate Start of the window, or nil.
+ @param toDate End of the window, or nil.
+ @return If an error occurs, returns an NSError object that describes the problem.
+ */
+- (id)getTimelineForUser:(NSString *)user isID:(BOOL)isID count:(int)count fromDate:(NSDate *)fromDate toDate:(NSDate *)toDate;
+
 /**
  Retweet a tweet.
  @param identifier Tweet id.
@@ -699,6 +750,17 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)searchTweetsWithQuery:(NSString *)q count:(int)count resultType:(FHSTwitterEngineResultType)resultType unil:(NSDate *)untilDate sinceID:(NSString *)sinceID maxID:(NSString *)maxID;
 
+/**
+ Search tweets from a time window, with millisecond bounds taken from the tweet IDs' timestamps.
+ @param q Search query.
+ @param count Number of tweets, newest first.
+ @param resultType FHSTwitterEngineResultType type.
+ @param fromDate Start of the window, or nil.
+ @param toDate End of the window, or nil.
+ @result Search results.
+ */
+- (id)searchTweetsWithQuery:(NSString *)q count:(int)count resultType:(FHSTwitterEngineResultType)resultType fromDate:(NSDate *)fromDate toDate:(NSDate *)toDate;
+
 /**
  Get followers ids.
  @return List of follower ids.
@@ -720,6 +782,30 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)getFriendsIDs;
 
+/**
+ Get follower ids of the authenticated user as packed integers, with no object per id.
+ @return FHSIDList, or an NSError.
+ */
+- (id)getFollowerIDList;
+
+/**
+ Get ids of the users the authenticated user is following as packed integers, with no object per id.
+ @return FHSIDList, or an NSError.
+ */
+- (id)getFriendIDList;
+
+/**
+ Get blocked user ids as packed integers, with no object per id.
+ @return FHSIDList, or an NSError.
+ */
+- (id)getBlockedIDList;
+
+/**
+ Get ids of the users the authenticated user does not want retweets from as packed integers, with no object per id.
+ @return FHSIDList, or an NSError.
+ */
+- (id)getNoRetweetIDList;
+
 /**
  Get list of users a given user is following.
  @param user User.
@@ -782,6 +868,65 @@ extern NSString * const FHSErrorDomain;
  */
 - (id)streamingRequestForURL:(NSURL *)url HTTPMethod:(NSString *)method parameters:(NSDictionary *)params;
 
+/**
+ Send a signed request.
+ @param url URL.
+ @param method HTTP method, GET or POST.
+ @param params Parameters, form encoded for POST.
+ @return Parsed JSON response, NSNull if the response had no body, or an NSError. HTTP errors use the status code as the error code.
+ */
+- (id)sendRequestForURL:(NSURL *)url HTTPMethod:(NSString *)method parameters:(NSDictionary *)params;
+
+/**
+ Send a signed GET request to an id list endpoint and decode the ids straight into packed integers.
+ @param url URL.
+ @param params Parameters.
+ @return FHSIDList, or an NSError. HTTP errors use the status code as the error code.
+ */
+- (id)getIDListForURL:(NSURL *)url parameters:(NSDictionary *)params;
+
+/**
+ Send a signed request to an endpoint of the static table. The parameters are checked against the endpoint's schema before anything is sent: strings the schema truncates are shortened and counts clamped, anything else invalid fails.
+ @param endpoint Endpoint.
+ @param params Parameters. Arrays are joined with commas, NSData values are sent in a multipart body, or base 64 encoded in the form body where the schema says so (profile images), everything else as its description. NSData for a GET endpoint, and strings that aren't valid UTF-16, give a bad request error.
+ @return Parsed JSON response, or an NSError. HTTP errors use the status code as the error code, invalid parameters give a bad request error, and a response with no JSON body a no data error.
+ */
+- (id)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params;
+
+/**
+ Send a signed request to an endpoint of the static table in the background.
+ @param endpoint Endpoint.
+ @param params Parameters, as for sendRequestForEndpoint:parameters:.
+ @param callbackQueue Queue the completion is called on, e.g. the main queue. NULL to call it on the background queue the request ran on, for processes without a main run loop.
+ @param completion Called with the response of sendRequestForEndpoint:parameters:.
+ */
+- (void)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params callbackQueue:(dispatch_queue_t)callbackQueue completion:(void (^)(id response))completion;
+
+/**
+ Send a signed request to an id list endpoint of the static table and decode the ids straight into packed integers.
+ @param endpoint Endpoint.
+ @param params Parameters, as for sendRequestForEndpoint:parameters:.
+ @return FHSIDList, or an NSError. HTTP errors use the status code as the error code.
+ */
+- (id)getIDListForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params;
+
+/**
+ Send a signed POST request with a prebuilt body.
+ @param url URL.
+ @param body Request body.
+ @param contentType Content type of the body. Multipart bodies are not covered by the OAuth signature.
+ @return Parsed JSON response, NSNull if the response had no body, or an NSError. HTTP errors use the status code as the error code.
+ */
+- (id)sendPOSTRequestForURL:(NSURL *)url body:(NSData *)body contentType:(NSString *)contentType;
+
+/**
+ Send a signed multipart POST request, streaming the body.
+ @param url URL.
+ @param body Multipart body. It is not covered by the OAuth signature.
+ @return Parsed JSON response, NSNull if the response had no body, or an NSError. HTTP errors use the status code as the error code.
+ */
+- (id)sendPOSTRequestForURL:(NSURL *)url multipartBody:(FHSMultipartBody *)body;
+
 #pragma mark - XAuth
 
 /// @name XAuth
@@ -798,6 +943,8 @@ extern NSString * const FHSErrorDomain;
 
 /// @name OAuth
 
+#if FHS_UIKIT
+
 /**
  Login view controller.
  @return Instance of login view controller.
@@ -811,6 +958,8 @@ extern NSString * const FHSErrorDomain;
  */
 - (UIViewController *)loginControllerWithCompletionHandler:(void(^)(BOOL success))block;
 
+#endif
+
 #pragma mark - Access Token
 
 /// @name Access Token
@@ -870,6 +1019,15 @@ extern NSString * const FHSErrorDomain;
  */
 + (FHSTwitterEngine *)sharedEngine;
 
+/**
+ Engine of its own, for working with several accounts at once. Its consumer, access token, connections and rate limits are independent of the shared engine's and of other engines'. Pass it to helpers such as FHSCursor through their engine property. Engines are safe to call from several threads at once.
+ @param consumerKey Consumer key.
+ @param consumerSecret Consumer secret.
+ @param storeKey NSUserDefaults key the access token is saved under, loaded right away. nil to keep the token in memory only; set accessToken, authenticatedUsername and authenticatedID yourself.
+ @return An engine instance.
+ */
++ (FHSTwitterEngine *)engineWithConsumerKey:(NSString *)consumerKey secret:(NSString *)consumerSecret accessTokenStoreKey:(NSString *)storeKey;
+
 /**
  Check network connection.
  @return Whether there is a network connection.
@@ -881,32 +1039,95 @@ extern NSString * const FHSErrorDomain;
  */
 @property (nonatomic, assign) BOOL includeEntities;
 
+/**
+ Reader used to parse responses. Set its nullPlaceholder or mutableContainers to change how responses come back.
+ */
+@property (nonatomic, strong) FHSJSONReader *JSONReader;
+
+/**
+ Return responses as lazy FHSModel instances (FHSTweet, FHSUser, FHSDirectMessage...) instead of parsed dictionaries. Models are immutable NSDictionary subclasses, so they can stand in for responses that are only read. The friends message of user streams comes as an FHSIDList. Defaults to NO.
+ */
+@property (nonatomic, assign) BOOL usesLazyModels;
+
+/**
+ Local index fed with the tweets of every GET response and user stream message, or nil for none. Defaults to nil.
+ */
+@property (strong) FHSTweetIndex *tweetIndex;
+
 /**
  Username for authenticated user.
  */
-@property (nonatomic, strong) NSString *authenticatedUsername;
+@property (strong) NSString *authenticatedUsername;
 
 
 /**
  User id for authenticated user.
  */
-@property (nonatomic, strong) NSString *authenticatedID;
+@property (strong) NSString *authenticatedID;
 
 /**
- Access token.
+ Access token. Replace it rather than changing its key and secret, so requests signed meanwhile use one or the other.
  */
-@property (nonatomic, strong) FHSToken *accessToken;
+@property (strong) FHSToken *accessToken;
 
 /**
- Date formatter.
+ NSUserDefaults key the access token is saved under when there is no delegate, or nil to keep it in memory only. Defaults to SavedAccessHTTPBody.
  */
-@property (strong, nonatomic) NSDateFormatter *dateFormatter;
+@property (copy) NSString *accessTokenStoreKey;
+
+/**
+ Date formatter for Twitter timestamps. Not thread-safe; NSDate's fhs_dateWithTwitterTimestamp: and fhs_twitterTimestamp are, and are much faster.
+ */
+@property (strong) NSDateFormatter *dateFormatter;
 
 // Delegate, called to retrieve or save access tokens
 @property (nonatomic, weak) id<FHSTwitterEngineAccessTokenDelegate> delegate;
 
 @end
 
+/** FHSTwitterEngine date interface. Thread-safe, unlike NSDateFormatter. */
+@interface NSDate (FHSTwitterEngine)
+
+/**
+ Date from a Twitter timestamp, such as created_at.
+ @param timestamp Timestamp, e.g. "Wed Aug 27 13:08:45 +0000 2008".
+ @return Date, or nil if the timestamp is malformed.
+ */
++ (NSDate *)fhs_dateWithTwitterTimestamp:(NSString *)timestamp;
+
+/**
+ Twitter timestamp.
+ @return UTC timestamp, e.g. "Wed Aug 27 13:08:45 +0000 2008", or an empty string for dates outside years 0-9999.
+ */
+- (NSString *)fhs_twitterTimestamp;
+
+/**
+ Date string as search's until parameter takes it.
+ @return UTC date, e.g. "2008-08-27", or an empty string for dates outside years 0-9999.
+ */
+- (NSString *)fhs_twitterDateString;
+
+/**
+ Creation date of a tweet, decoded from its ID.
+ @param tweetID Tweet ID.
+ @return Date with millisecond precision, or nil for IDs from before November 2010.
+ */
++ (NSDate *)fhs_dateWithTweetID:(uint64_t)tweetID;
+
+/**
+ Smallest tweet ID that can be created at or after this date.
+ @return Tweet ID, or 0 for dates before November 2010.
+ */
+- (uint64_t)fhs_firstTweetID;
+
+/**
+ Largest tweet ID that can be created at or before this date.
+ @return Tweet ID, or 0 for dates before November 2010.
+ */
+- (uint64_t)fhs_lastTweetID;
+
+@end
+
 /** FHSTwitterEngine data interface. */
 @interface NSData (FHSTwitterEngine)
 
@@ -957,12 +1178,37 @@ extern NSString * const FHSErrorDomain;
  */
 + (NSString *)fhs_UUID;
 
+/**
+ Random alphanumeric nonce, suitable for oauth_nonce and multipart boundaries.
+ @return Nonce.
+ */
++ (NSString *)fhs_nonce;
+
+/**
+ Data decoded from a base 64 string.
+ @return Decoded data, or nil if the string is not valid base 64.
+ */
+- (NSData *)fhs_base64Decode;
+
 /**
  String is numeric.
  @return Whether a string is numeric.
  */
 - (BOOL)fhs_isNumeric;
 
+/**
+ Tweet or user ID.
+ @return ID, or 0 if the string isn't a decimal 64-bit integer.
+ */
+- (uint64_t)fhs_tweetID;
+
+/**
+ Decimal string for a tweet or user ID, as the API's *_id parameters take it.
+ @param tweetID ID.
+ @return Decimal string.
+ */
++ (NSString *)fhs_stringWithTweetID:(uint64_t)tweetID;
+
 @end
 
 /** FHSTwitterEngine errors. */
@@ -983,4 +1229,9 @@ extern NSString * const FHSErrorDomain;
  */
 + (NSError *)imageTooLargeError;
 
+/**
+ Unsupported media error.
+ */
++ (NSError *)unsupportedMediaError;
+
 @end
@@ -25,23 +25,40 @@
 
 #import "FHSTwitterEngine.h"
 
+#if FHS_UIKIT
 #import <QuartzCore/QuartzCore.h>
+#endif
+
+#if defined(__APPLE__)
 #import <SystemConfiguration/SystemConfiguration.h>
-#import <CommonCrypto/CommonHMAC.h>
+#endif
+
 #import <objc/runtime.h>
+#import <net/if.h>
 #import <sys/socket.h>
 #import <netinet/in.h>
 #import <ifaddrs.h>
 
 // Helper classes
 #include "FHSStream.h"
+#include "FHSMultipartBody.h"
+#include "FHSJSONReader.h"
+#include "FHSModel.h"
+#include "FHSIDList.h"
+#include "FHSTweetIndex.h"
+#include "FHSOAuthSigner.h"
+#include "FHSRequest.h"
+#include "FHSPercentEncoding.h"
+#include "FHSNonce.h"
+#include "FHSBase64.h"
+#include "FHSMediaProbe.h"
+#include "FHSTimestamp.h"
+#include "FHSSnowflake.h"
 
 static NSURLRequestCachePolicy const cachePolicy = NSURLRequestReloadRevalidatingCacheData;
 
 static float const streamingTimeoutInterval = 30.0f;
 
-static char const Encode[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 static NSString * const newPinJS = @"var d = document.getElementById('oauth-pin'); if (d == null) d = document.getElementById('oauth_pin'); if (d) { var d2 = d.getElementsByTagName('code'); if (d2.length > 0) d2[0].innerHTML; }";
 static NSString * const oldPinJS = @"var d = document.getElementById('oauth-pin'); if (d == null) d = document.getElementById('oauth_pin'); if (d) d = d.innerHTML; d;";
 
@@ -57,92 +74,107 @@ NSString * const FHSProfileLocationKey = @"location";
 NSString * const FHSProfileDescriptionKey = @"description";
 
 NSString * const FHSErrorDomain = @"FHSErrorDomain";
+NSString * const FHSRateLimitResetDateKey = @"FHSRateLimitResetDate";
+NSString * const FHSRateLimitRemainingKey = @"FHSRateLimitRemaining";
 
 static NSString * const authBlockKey = @"FHSTwitterEngineOAuthCompletion";
 
-//
-// URL constants
-//
-static NSString * const url_media_upload = @"https://upload.twitter.com/1.1/media/upload.json";
-
-static NSString * const url_search_tweets = @"https://api.twitter.com/1.1/search/tweets.json";
-
-static NSString * const url_users_search = @"https://api.twitter.com/1.1/users/search.json";
-static NSString * const url_users_show = @"https://api.twitter.com/1.1/users/show.json";
-static NSString * const url_users_report_spam = @"https://api.twitter.com/1.1/users/report_spam.json";
-static NSString * const url_users_lookup = @"https://api.twitter.com/1.1/users/lookup.json";
-
-static NSString * const url_lists_create = @"https://api.twitter.com/1.1/lists/create.json";
-static NSString * const url_lists_show = @"https://api.twitter.com/1.1/lists/show.json";
-static NSString * const url_lists_update = @"https://api.twitter.com/1.1/lists/update.json";
-static NSString * const url_lists_members = @"https://api.twitter.com/1.1/lists/members.json";
-static NSString * const url_lists_members_destroy_all = @"https://api.twitter.com/1.1/lists/members/destroy_all.json";
-static NSString * const url_lists_members_create_all = @"https://api.twitter.com/1.1/lists/members/create_all.json";
-static NSString * const url_lists_statuses = @"https://api.twitter.com/1.1/lists/statuses.json";
-static NSString * const url_lists_list = @"https://api.twitter.com/1.1/lists/list.json";
-
-static NSString * const url_statuses_home_timeline = @"https://api.twitter.com/1.1/statuses/home_timeline.json";
-static NSString * const url_statuses_update = @"https://api.twitter.com/1.1/statuses/update.json";
-static NSString * const url_statuses_retweets_of_me = @"https://api.twitter.com/1.1/statuses/retweets_of_me.json";
-static NSString * const url_statuses_user_timeline = @"https://api.twitter.com/1.1/statuses/user_timeline.json";
-static NSString * const url_statuses_metions_timeline = @"https://api.twitter.com/1.1/statuses/mentions_timeline.json";
-static NSString * const url_statuses_update_with_media = @"https://api.twitter.com/1.1/statuses/update_with_media.json";
-static NSString * const url_statuses_destroy = @"https://api.twitter.com/1.1/statuses/destroy.json";
-static NSString * const url_statuses_show = @"https://api.twitter.com/1.1/statuses/show.json";
-
-static NSString * const url_blocks_exists = @"https://api.twitter.com/1.1/blocks/exists.json";
-static NSString * const url_blocks_blocking = @"https://api.twitter.com/1.1/blocks/blocking.json";
-static NSString * const url_blocks_blocking_ids = @"https://api.twitter.com/1.1/blocks/blocking/ids.json";
-static NSString * const url_blocks_destroy = @"https://api.twitter.com/1.1/blocks/destroy.json";
-static NSString * const url_blocks_create = @"https://api.twitter.com/1.1/blocks/create.json";
-
-static NSString * const url_help_languages = @"https://api.twitter.com/1.1/help/languages.json";
-static NSString * const url_help_configuration = @"https://api.twitter.com/1.1/help/configuration.json";
-static NSString * const url_help_privacy = @"https://api.twitter.com/1.1/help/privacy.json";
-static NSString * const url_help_tos = @"https://api.twitter.com/1.1/help/tos.json";
-static NSString * const url_help_test = @"https://api.twitter.com/1.1/help/test.json";
-
-static NSString * const url_direct_messages_show = @"https://api.twitter.com/1.1/direct_messages/show.json";
-static NSString * const url_direct_messages_new = @"https://api.twitter.com/1.1/direct_messages/new.json";
-static NSString * const url_direct_messages_sent = @"https://api.twitter.com/1.1/direct_messages/sent.json";
-static NSString * const url_direct_messages_destroy = @"https://api.twitter.com/1.1/direct_messages/destroy.json";
-static NSString * const url_direct_messages = @"https://api.twitter.com/1.1/direct_messages.json";
-
-static NSString * const url_friendships_no_retweets_ids = @"https://api.twitter.com/1.1/friendships/no_retweets/ids.json";
-static NSString * const url_friendships_update = @"https://api.twitter.com/1.1/friendships/update.json";
-static NSString * const url_friendships_outgoing = @"https://api.twitter.com/1.1/friendships/outgoing.json";
-static NSString * const url_friendships_incoming = @"https://api.twitter.com/1.1/friendships/incoming.json";
-static NSString * const url_friendships_lookup = @"https://api.twitter.com/1.1/friendships/lookup.json";
-static NSString * const url_friendships_destroy = @"https://api.twitter.com/1.1/friendships/destroy.json";
-static NSString * const url_friendships_create = @"https://api.twitter.com/1.1/friendships/create.json";
-
-static NSString * const url_account_verify_credentials = @"https://api.twitter.com/1.1/account/verify_credentials.json";
-static NSString * const url_account_update_profile_colors = @"https://api.twitter.com/1.1/account/update_profile_colors.json";
-static NSString * const url_account_update_profile_background_image = @"https://api.twitter.com/1.1/account/update_profile_background_image.json";
-static NSString * const url_account_update_profile_image = @"https://api.twitter.com/1.1/account/update_profile_image.json";
-static NSString * const url_account_settings = @"https://api.twitter.com/1.1/account/settings.json";
-static NSString * const url_account_update_profile = @"https://api.twitter.com/1.1/account/update_profile.json";
-
-static NSString * const url_favorites_list = @"https://api.twitter.com/1.1/favorites/list.json";
-static NSString * const url_favorites_create = @"https://api.twitter.com/1.1/favorites/create.json";
-static NSString * const url_favorites_destroy = @"https://api.twitter.com/1.1/favorites/destroy.json";
-
-static NSString * const url_application_rate_limit_status = @"https://api.twitter.com/1.1/application/rate_limit_status.json";
-
-static NSString * const url_followers_ids = @"https://api.twitter.com/1.1/followers/ids.json";
-static NSString * const url_followers_list = @"https://api.twitter.com/1.1/followers/list.json";
-
-static NSString * const url_friends_ids = @"https://api.twitter.com/1.1/friends/ids.json";
-static NSString * const url_friends_list = @"https://api.twitter.com/1.1/friends/list.json";
-
-
 NSString * fhs_url_remove_params(NSURL *url) {
-    if (url.absoluteString.length == 0) {
+    const char *string = url.absoluteString.UTF8String;
+    
+    if (!string || string[0] == '\0') {
         return nil;
     }
     
-    NSArray *parts = [url.absoluteString componentsSeparatedByString:@"?"];
-    return (parts.count == 0)?nil:parts[0];
+    return [[NSString alloc]initWithBytes:string length:fhs_request_base_length(string, strlen(string)) encoding:NSUTF8StringEncoding];
+}
+
+static void fhs_append_encoded(NSMutableData *data, NSString *string) {
+    const char *utf8 = string.UTF8String;
+    size_t length = utf8?strlen(utf8):0;
+    NSUInteger offset = data.length;
+    data.length = offset+fhs_percent_encoded_length(utf8, length);
+    fhs_percent_encode(utf8, length, (char *)data.mutableBytes+offset);
+}
+
+static void fhs_append_base64_encoded(NSMutableData *data, NSData *value) {
+    fhs_base64_stream stream;
+    fhs_base64_stream_init(&stream);
+    
+    // Base 64 a chunk at a time straight into the body, percent-encoding '+', '/' and '='
+    char base64[4096]; // 3072 bytes plus two carried over make at most 1024 groups
+    const uint8_t *bytes = value.bytes;
+    NSUInteger remaining = value.length;
+    
+    while (remaining > 0 || stream.carryLength > 0) {
+        size_t chunk = MIN(remaining, 3072);
+        size_t length = (chunk > 0)?fhs_base64_stream_update(&stream, bytes, chunk, base64):fhs_base64_stream_final(&stream, base64);
+        bytes += chunk;
+        remaining -= chunk;
+        
+        NSUInteger offset = data.length;
+        data.length = offset+fhs_percent_encoded_length(base64, length);
+        fhs_percent_encode(base64, length, (char *)data.mutableBytes+offset);
+    }
+}
+
+// application/x-www-form-urlencoded "key=value&key=value", array values are joined with commas and data values are base 64 encoded
+NSMutableData * fhs_form_encode(NSDictionary *params) {
+    NSMutableData *data = [NSMutableData dataWithCapacity:params.count*32];
+    
+    [params enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
+        if (data.length > 0) {
+            [data appendBytes:"&" length:1];
+        }
+        
+        fhs_append_encoded(data, key);
+        [data appendBytes:"=" length:1];
+        
+        if ([obj isKindOfClass:[NSData class]]) {
+            fhs_append_base64_encoded(data, obj);
+        } else {
+            fhs_append_encoded(data, [obj isKindOfClass:[NSArray class]]?[obj componentsJoinedByString:@","]:[obj description]);
+        }
+    }];
+    
+    return data;
+}
+
+// Responses of methods that only report errors
+static NSError * fhs_error_only(id response) {
+    return [response isKindOfClass:[NSError class]]?response:nil;
+}
+
+NSURL * fhs_url_with_params(NSURL *url, NSDictionary *params) {
+    if (params.count == 0) {
+        return url;
+    }
+    
+    NSMutableData *data = [[fhs_url_remove_params(url) dataUsingEncoding:NSUTF8StringEncoding]mutableCopy];
+    [data appendBytes:"?" length:1];
+    [data appendData:fhs_form_encode(params)];
+    return [NSURL URLWithString:[[NSString alloc]initWithData:data encoding:NSUTF8StringEncoding]];
+}
+
+static BOOL fhs_string_equal(NSString *a, NSString *b) {
+    if (a.length == 0 || b.length == 0) {
+        return a.length == b.length;
+    }
+    return [a isEqualToString:b];
+}
+
+// since_id is exclusive and max_id inclusive. Either date may be nil for an open end.
+static BOOL fhs_tweet_id_window(NSDate *fromDate, NSDate *toDate, NSString **sinceID, NSString **maxID) {
+    uint64_t first = fromDate.fhs_firstTweetID;
+    uint64_t last = toDate.fhs_lastTweetID;
+
+    if (toDate && (last == 0 || (fromDate && first > last))) {
+        return NO;
+    }
+
+    *sinceID = (first > 0)?[NSString fhs_stringWithTweetID:first-1]:nil;
+    *maxID = toDate?[NSString fhs_stringWithTweetID:last]:nil;
+    return YES;
 }
 
 id removeNull(id rootObject) {
@@ -156,7 +188,7 @@ id removeNull(id rootObject) {
                 [sanitizedDictionary setObject:sanitized forKey:key];
             }
         }];
-        return [NSMutableDictionary dictionaryWithDictionary:sanitizedDictionary];
+        return sanitizedDictionary;
     }
     
     if ([rootObject isKindOfClass:[NSArray class]]) {
@@ -164,12 +196,12 @@ id removeNull(id rootObject) {
         [rootObject enumerateObjectsUsingBlock:^(id obj, NSUInteger idx, BOOL *stop) {
             id sanitized = removeNull(obj);
             if (!sanitized) {
-                [sanitizedArray replaceObjectAtIndex:[sanitizedArray indexOfObject:obj] withObject:@""];
+                [sanitizedArray replaceObjectAtIndex:idx withObject:@""];
             } else {
-                [sanitizedArray replaceObjectAtIndex:[sanitizedArray indexOfObject:obj] withObject:sanitized];
+                [sanitizedArray replaceObjectAtIndex:idx withObject:sanitized];
             }
         }];
-        return [NSMutableArray arrayWithArray:sanitizedArray];
+        return sanitizedArray;
     }
     
     if ([rootObject isKindOfClass:[NSNull class]]) {
@@ -204,6 +236,83 @@ id removeNull(id rootObject) {
 
 @end
 
+@interface FHSSigningKey : NSObject
+
+@property (nonatomic, assign, readonly) fhs_oauth_key *key;
+@property (nonatomic, copy, readonly) NSString *consumerKey;
+@property (nonatomic, copy, readonly) NSString *consumerSecret;
+@property (nonatomic, copy, readonly) NSString *token;
+@property (nonatomic, copy, readonly) NSString *tokenSecret;
+
++ (FHSSigningKey *)keyWithConsumer:(FHSConsumer *)consumer token:(NSString *)token tokenSecret:(NSString *)tokenSecret;
+- (BOOL)matchesConsumer:(FHSConsumer *)consumer token:(NSString *)token tokenSecret:(NSString *)tokenSecret;
+- (NSString *)authorizationHeaderForURL:(NSString *)url HTTPMethod:(NSString *)method body:(NSData *)body verifier:(NSString *)verifier realm:(NSString *)realm;
+@end
+
+@implementation FHSSigningKey
+
++ (FHSSigningKey *)keyWithConsumer:(FHSConsumer *)consumer token:(NSString *)token tokenSecret:(NSString *)tokenSecret {
+    return [[[self class]alloc]initWithConsumer:consumer token:token tokenSecret:tokenSecret];
+}
+
+- (instancetype)initWithConsumer:(FHSConsumer *)consumer token:(NSString *)token tokenSecret:(NSString *)tokenSecret {
+    self = [super init];
+    if (self) {
+        // Copies, not the consumer itself: its key and secret are mutable
+        _consumerKey = [consumer.key copy];
+        _consumerSecret = [consumer.secret copy];
+        _token = [token copy];
+        _tokenSecret = [tokenSecret copy];
+        _key = fhs_oauth_key_create(_consumerKey.UTF8String, _consumerSecret.UTF8String, token.UTF8String, tokenSecret.UTF8String);
+        
+        if (!_key) {
+            return nil;
+        }
+    }
+    return self;
+}
+
+- (BOOL)matchesConsumer:(FHSConsumer *)consumer token:(NSString *)token tokenSecret:(NSString *)tokenSecret {
+    if (!fhs_string_equal(consumer.key, _consumerKey) || !fhs_string_equal(consumer.secret, _consumerSecret)) {
+        return NO;
+    }
+    
+    return fhs_string_equal(token, _token) && fhs_string_equal(tokenSecret, _tokenSecret);
+}
+
+- (NSString *)authorizationHeaderForURL:(NSString *)url HTTPMethod:(NSString *)method body:(NSData *)body verifier:(NSString *)verifier realm:(NSString *)realm {
+    const char *urlString = url.UTF8String;
+    
+    char nonce[FHS_NONCE_LENGTH+1];
+    fhs_nonce(nonce);
+    
+    fhs_oauth_request request = {0};
+    request.method = method.UTF8String;
+    request.url = urlString;
+    request.urlLength = strlen(urlString);
+    request.body = body.bytes;
+    request.bodyLength = body.length;
+    request.verifier = verifier.UTF8String;
+    request.realm = realm.UTF8String;
+    request.nonce = nonce;
+    request.timestamp = time(NULL);
+    
+    size_t headerLength = 0;
+    const char *header = fhs_oauth_sign(_key, &request, &headerLength);
+    
+    if (!header) {
+        return nil;
+    }
+    
+    return [[NSString alloc]initWithBytes:header length:headerLength encoding:NSUTF8StringEncoding];
+}
+
+- (void)dealloc {
+    fhs_oauth_key_free(_key);
+}
+
+@end
+
 @implementation FHSToken
 
 + (FHSToken *)tokenWithHTTPResponseBody:(NSString *)body {
@@ -240,6 +349,8 @@ id removeNull(id rootObject) {
 
 @end
 
+#if FHS_UIKIT
+
 @interface FHSTwitterEngineController : UIViewController <UIWebViewDelegate>
 
 @property (nonatomic, strong) UINavigationBar *navBar;
@@ -247,9 +358,12 @@ id removeNull(id rootObject) {
 @property (nonatomic, strong) UILabel *loadingText;
 @property (nonatomic, strong) UIActivityIndicatorView *spinner;
 @property (nonatomic, strong) FHSToken *requestToken;
+@property (nonatomic, strong) FHSTwitterEngine *engine;
 
 @end
 
+#endif
+
 @interface FHSTwitterEngine ()
 
 // Login stuff
@@ -258,9 +372,44 @@ id removeNull(id rootObject) {
 // General Get request sender
 - (id)sendRequest:(NSURLRequest *)request;
 
+// Signs, sends and parses, keeping the HTTP status on failure
+- (id)sendSignedRequest:(NSMutableURLRequest *)request;
+- (id)sendSignedRequest:(NSMutableURLRequest *)request decodesIDs:(BOOL)decodesIDs;
+
+// Sends and parses a request that already has its Authorization header
+- (id)sendAuthorizedRequest:(NSURLRequest *)request decodesIDs:(BOOL)decodesIDs;
+
+// Builds a request from the endpoint table, signs it and sends it
+- (id)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params decodesIDs:(BOOL)decodesIDs;
+
+// Parses a response body with the JSONReader, or into lazy models
+- (id)parseResponseData:(NSData *)data;
+
 // These are here to obfuscate them from prying eyes
-@property (strong, nonatomic) FHSConsumer *consumer;
-@property (assign, nonatomic) BOOL shouldClearConsumer;
+@property (strong, atomic) FHSConsumer *consumer;
+@property (assign, atomic) BOOL shouldClearConsumer;
+
+// Signing state for the last consumer/token pair, reused while they don't change
+@property (strong, atomic) FHSSigningKey *signingKey;
+- (FHSSigningKey *)signingKeyForToken:(NSString *)tokenString tokenSecret:(NSString *)tokenSecretString;
+
+// Last help/configuration response, for media limits
+@property (strong, atomic) NSDictionary *configuration;
+
+// Last x-rate-limit headers by endpoint path, guarded by itself
+@property (strong, nonatomic) NSMutableDictionary *rateLimits;
+
+// Connections of this engine, kept apart from other engines' and from cookies and caches
+@property (strong, nonatomic) NSURLSession *session;
+
+// Sends a request on the session and waits for it
+- (NSData *)sendSynchronousRequest:(NSURLRequest *)request returningResponse:(NSHTTPURLResponse **)response error:(NSError **)error;
+
+// Drops a consumer set with temporarilySetConsumerKey:andSecret: once a request is signed with it
+- (void)clearTemporaryConsumer;
+
+// Points a stream at this engine and starts it
+- (void)startStream:(FHSStream *)stream;
 
 @end
 
@@ -278,13 +427,33 @@ id removeNull(id rootObject) {
     return [NSError errorWithDomain:FHSErrorDomain code:422 userInfo:@{NSLocalizedDescriptionKey:@"The image you are trying to upload is too large."}];
 }
 
++ (NSError *)unsupportedMediaError {
+    return [NSError errorWithDomain:FHSErrorDomain code:415 userInfo:@{NSLocalizedDescriptionKey:@"The media format, dimensions, frame count or duration are not supported."}];
+}
+
 @end
 
 @implementation NSString (FHSTwitterEngine)
 
 - (NSString *)fhs_URLEncode {
-    CFStringRef url = CFURLCreateStringByAddingPercentEscapes(kCFAllocatorDefault, (CFStringRef)self, NULL, CFSTR("!*'();:@&=+$,/?%#[]"), kCFStringEncodingUTF8);
-    return (__bridge NSString *)url;
+    const char *utf8 = self.UTF8String;
+    size_t length = utf8?strlen(utf8):0;
+    
+    char stackBuffer[256];
+    char *buffer = (length*3 <= sizeof(stackBuffer))?stackBuffer:malloc(length*3);
+    
+    if (!buffer) {
+        return nil;
+    }
+    
+    size_t encodedLength = fhs_percent_encode(utf8, length, buffer);
+    NSString *encoded = [[NSString alloc]initWithBytes:buffer length:encodedLength encoding:NSUTF8StringEncoding];
+    
+    if (buffer != stackBuffer) {
+        free(buffer);
+    }
+    
+    return encoded;
 }
 
 - (NSString *)fhs_truncatedToLength:(int)length {
@@ -300,98 +469,139 @@ id removeNull(id rootObject) {
 }
 
 + (NSString *)fhs_UUID {
-    if ([[[UIDevice currentDevice]systemVersion]floatValue] >= 6.0f) {
-        return [[NSUUID UUID]UUIDString];
-    } else {
-        CFUUIDRef theUUID = CFUUIDCreate(kCFAllocatorDefault);
-        CFStringRef string = CFUUIDCreateString(kCFAllocatorDefault, theUUID);
-        CFRelease(theUUID);
-        NSString *uuid = [NSString stringWithString:(__bridge NSString *)string];
-        CFRelease(string);
-        return uuid;
+    return [[NSUUID UUID]UUIDString];
+}
+
++ (NSString *)fhs_nonce {
+    char nonce[FHS_NONCE_LENGTH+1];
+    fhs_nonce(nonce);
+    return [[NSString alloc]initWithBytes:nonce length:FHS_NONCE_LENGTH encoding:NSASCIIStringEncoding];
+}
+
+- (NSData *)fhs_base64Decode {
+    const char *ascii = self.UTF8String;
+    size_t length = ascii?strlen(ascii):0;
+    NSMutableData *data = [NSMutableData dataWithLength:fhs_base64_decoded_length(length)];
+    size_t decodedLength = 0;
+    
+    if (fhs_base64_decode(ascii, length, data.mutableBytes, &decodedLength) != 0) {
+        return nil;
     }
+    
+    data.length = decodedLength;
+    return data;
 }
 
 - (BOOL)fhs_isNumeric {
-    const char *raw = (const char *)[self UTF8String];
+    const char *raw = self.UTF8String;
     
-    for (int i = 0; i < strlen(raw); i++) {
-        if (raw[i] < '0' || raw[i] > '9') {
+    if (!raw) {
+        return NO;
+    }
+    
+    for (; *raw; raw++) {
+        if (*raw < '0' || *raw > '9') {
             return NO;
         }
     }
     return YES;
 }
 
+- (uint64_t)fhs_tweetID {
+    char buffer[FHS_SNOWFLAKE_MAX_DIGITS+1];
+    NSUInteger length;
+    uint64_t tweetID;
+    
+    if (![self getBytes:buffer maxLength:sizeof(buffer) usedLength:&length encoding:NSASCIIStringEncoding options:0 range:NSMakeRange(0, self.length) remainingRange:NULL] || fhs_snowflake_parse(buffer, length, &tweetID) != 0) {
+        return 0;
+    }
+    
+    return tweetID;
+}
+
++ (NSString *)fhs_stringWithTweetID:(uint64_t)tweetID {
+    char buffer[FHS_SNOWFLAKE_MAX_DIGITS+1];
+    size_t length = fhs_snowflake_format(tweetID, buffer);
+    return [[NSString alloc]initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+@end
+
+@implementation NSDate (FHSTwitterEngine)
+
++ (NSDate *)fhs_dateWithTwitterTimestamp:(NSString *)timestamp {
+    char buffer[FHS_TIMESTAMP_LENGTH+1];
+    NSUInteger length;
+    int64_t seconds;
+    
+    if (![timestamp getBytes:buffer maxLength:sizeof(buffer) usedLength:&length encoding:NSASCIIStringEncoding options:0 range:NSMakeRange(0, timestamp.length) remainingRange:NULL] || fhs_timestamp_parse(buffer, length, &seconds) != 0) {
+        return nil;
+    }
+    
+    return [NSDate dateWithTimeIntervalSince1970:seconds];
+}
+
+- (NSString *)fhs_twitterTimestamp {
+    char buffer[FHS_TIMESTAMP_LENGTH+1];
+    size_t length = fhs_timestamp_format((int64_t)floor(self.timeIntervalSince1970), buffer);
+    return [[NSString alloc]initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
+- (NSString *)fhs_twitterDateString {
+    char buffer[FHS_TIMESTAMP_DATE_LENGTH+1];
+    size_t length = fhs_timestamp_format_date((int64_t)floor(self.timeIntervalSince1970), buffer);
+    return [[NSString alloc]initWithBytes:buffer length:length encoding:NSASCIIStringEncoding];
+}
+
++ (NSDate *)fhs_dateWithTweetID:(uint64_t)tweetID {
+    uint64_t milliseconds = fhs_snowflake_time(tweetID);
+    return milliseconds?[NSDate dateWithTimeIntervalSince1970:milliseconds/1000.0]:nil;
+}
+
+- (uint64_t)fhs_firstTweetID {
+    double milliseconds = ceil(self.timeIntervalSince1970*1000.0);
+    return milliseconds > 0?fhs_snowflake_first_id((uint64_t)milliseconds):0;
+}
+
+- (uint64_t)fhs_lastTweetID {
+    double milliseconds = floor(self.timeIntervalSince1970*1000.0);
+    return milliseconds > 0?fhs_snowflake_last_id((uint64_t)milliseconds):0;
+}
+
 @end
 
 @implementation NSData (FHSTwitterEngine)
 
 - (NSString *)appropriateFileExtension {
-    uint8_t c;
-    [self getBytes:&c length:1];
-    
-    switch (c) {
-        case 0xFF:
-            return @"jpeg";
-        case 0x89:
-            return @"png";
-        case 0x47:
-            return @"gif";
-        case 0x49:
-        case 0x4D:
-            return @"tiff";
+    fhs_media_info info;
+    
+    if (fhs_media_probe(self.bytes, self.length, &info) == 0) {
+        return @(fhs_media_format_extension(info.format));
     }
+    
+    // TIFF isn't uploadable to Twitter but TwitPic takes it
+    if (self.length >= 4 && (memcmp(self.bytes, "II*\0", 4) == 0 || memcmp(self.bytes, "MM\0*", 4) == 0)) {
+        return @"tiff";
+    }
+    
     return nil;
 }
 
 - (NSString *)base64Encode {
-    int outLength = ((((self.length*4)/3)/4)*4)+(((self.length*4)/3)%4?4:0);
-    const char *inputBuffer = self.bytes;
-    char *outputBuffer = malloc(outLength+1);
-    outputBuffer[outLength] = 0;
-    
-    int cycle = 0;
-    int inpos = 0;
-    int outpos = 0;
-    char temp;
-    
-    outputBuffer[outLength-1] = '=';
-    outputBuffer[outLength-2] = '=';
-    
-    while (inpos < self.length) {
-        switch (cycle) {
-            case 0:
-                outputBuffer[outpos++] = Encode[(inputBuffer[inpos]&0xFC)>>2];
-                cycle = 1;
-                break;
-            case 1:
-                temp = (inputBuffer[inpos++]&0x03)<<4;
-                outputBuffer[outpos] = Encode[temp];
-                cycle = 2;
-                break;
-            case 2:
-                outputBuffer[outpos++] = Encode[temp|(inputBuffer[inpos]&0xF0)>>4];
-                temp = (inputBuffer[inpos++]&0x0F)<<2;
-                outputBuffer[outpos] = Encode[temp];
-                cycle = 3;
-                break;
-            case 3:
-                outputBuffer[outpos++] = Encode[temp|(inputBuffer[inpos]&0xC0)>>6];
-                cycle = 4;
-                break;
-            case 4:
-                outputBuffer[outpos++] = Encode[inputBuffer[inpos++]&0x3f];
-                cycle = 0;
-                break;
-            default:
-                cycle = 0;
-                break;
-        }
+    size_t length = fhs_base64_encoded_length(self.length);
+    
+    if (length == 0) {
+        return @"";
+    }
+    
+    char *buffer = malloc(length);
+    
+    if (!buffer) {
+        return nil;
     }
-    NSString *pictemp = [NSString stringWithUTF8String:outputBuffer];
-    free(outputBuffer);
-    return pictemp;
+    
+    fhs_base64_encode(self.bytes, self.length, buffer);
+    return [[NSString alloc]initWithBytesNoCopy:buffer length:length encoding:NSASCIIStringEncoding freeWhenDone:YES];
 }
 
 @end
@@ -404,9 +614,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_followers_list];
-    
-    return [self sendGETRequestForURL:baseURL andParams:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), (isID?@"user_id":@"screen_name"):user, @"cursor":cursor }];
+    return [self sendRequestForEndpoint:FHSEndpointFollowersList parameters:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), (isID?@"user_id":@"screen_name"):user, @"cursor":cursor }];
 }
 
 - (id)listFriendsForUser:(NSString *)user isID:(BOOL)isID withCursor:(NSString *)cursor {
@@ -415,8 +623,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_friends_list];
-    return [self sendGETRequestForURL:baseURL andParams:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), (isID?@"user_id":@"screen_name"):user, @"cursor":cursor }];
+    return [self sendRequestForEndpoint:FHSEndpointFriendsList parameters:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), (isID?@"user_id":@"screen_name"):user, @"cursor":cursor }];
 }
 
 - (id)searchUsersWithQuery:(NSString *)q andCount:(int)count {
@@ -424,16 +631,7 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    if (q.length == 0) {
-        return [NSError badRequestError];
-    }
-    
-    if (q.length > 1000) {
-        q = [q substringToIndex:1000];
-    }
-    
-    NSURL *baseURL = [NSURL URLWithString:url_users_search];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"include_entities":(_includeEntities?@"true":@"false"), @"count":@(count).stringValue, @"q":q }];
+    return [self sendRequestForEndpoint:FHSEndpointUsersSearch parameters:@{ @"include_entities":(_includeEntities?@"true":@"false"), @"count":@(count).stringValue, @"q":q?:@"" }];
 }
 
 - (id)searchTweetsWithQuery:(NSString *)q count:(int)count resultType:(FHSTwitterEngineResultType)resultType unil:(NSDate *)untilDate sinceID:(NSString *)sinceID maxID:(NSString *)maxID {
@@ -442,22 +640,12 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    if (q.length == 0) {
-        return [NSError badRequestError];
-    }
+    NSMutableDictionary *params = [@{ @"include_entities":(_includeEntities?@"true":@"false"), @"count":@(count).stringValue, @"q":q?:@"" } mutableCopy];
     
-    if (q.length > 1000) {
-        q = [q substringToIndex:1000];
+    if (untilDate) {
+        params[@"until"] = [untilDate fhs_twitterDateString];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_search_tweets];
-    
-    NSMutableDictionary *params = [@{ @"include_entities":(_includeEntities?@"true":@"false"), @"count":@(count).stringValue, @"q":q } mutableCopy];
-    
-    [_dateFormatter setDateFormat:@"YYYY-MM-DD"];
-    params[@"until"] = [_dateFormatter stringFromDate:untilDate];
-    [_dateFormatter setDateFormat:@"EEE MMM dd HH:mm:ss ZZZZ yyyy"];
-    
     if (resultType == FHSTwitterEngineResultTypeMixed) {
         params[@"result_type"] = @"mixed";
     } else if (resultType == FHSTwitterEngineResultTypeRecent) {
@@ -473,8 +661,19 @@ id removeNull(id rootObject) {
     if (sinceID.length > 0) {
         params[@"since_id"] = sinceID;
     }
-    
-    return [self sendGETRequestForURL:baseURL andParams:params];
+
+    return [self sendRequestForEndpoint:FHSEndpointSearchTweets parameters:params];
+}
+
+- (id)searchTweetsWithQuery:(NSString *)q count:(int)count resultType:(FHSTwitterEngineResultType)resultType fromDate:(NSDate *)fromDate toDate:(NSDate *)toDate {
+    NSString *sinceID = nil;
+    NSString *maxID = nil;
+
+    if (!fhs_tweet_id_window(fromDate, toDate, &sinceID, &maxID)) {
+        return [NSError badRequestError];
+    }
+
+    return [self searchTweetsWithQuery:q count:count resultType:resultType unil:nil sinceID:sinceID maxID:maxID];
 }
 
 - (NSError *)createListWithName:(NSString *)name isPrivate:(BOOL)isPrivate description:(NSString *)description {
@@ -483,15 +682,13 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_create];
-    
     NSMutableDictionary *params = [@{@"name": name, @"mode":isPrivate?@"private":@"public"} mutableCopy];
     
     if (description.length > 0) {
         params[@"description"] = description;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsCreate parameters:params]);
 }
 
 - (id)getListWithID:(NSString *)listID {
@@ -500,8 +697,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_show];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"list_id": listID }];
+    return [self sendRequestForEndpoint:FHSEndpointListsShow parameters:@{ @"list_id": listID }];
 }
 
 - (NSError *)updateListWithID:(NSString *)listID name:(NSString *)name {
@@ -511,8 +707,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_update];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"list_id": listID, @"name": name}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsUpdate parameters:@{@"list_id": listID, @"name": name}]);
 }
 
 - (NSError *)updateListWithID:(NSString *)listID description:(NSString *)description {
@@ -524,8 +719,7 @@ id removeNull(id rootObject) {
         description = @"";
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_update];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"list_id": listID, @"description": description}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsUpdate parameters:@{@"list_id": listID, @"description": description}]);
 }
 
 - (NSError *)updateListWithID:(NSString *)listID mode:(BOOL)isPrivate {
@@ -533,8 +727,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_update];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"list_id": listID, @"mode": isPrivate?@"private":@"public"}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsUpdate parameters:@{@"list_id": listID, @"mode": isPrivate?@"private":@"public"}]);
 }
 
 - (NSError *)updateListWithID:(NSString *)listID name:(NSString *)name description:(NSString *)description mode:(BOOL)isPrivate {
@@ -548,8 +741,7 @@ id removeNull(id rootObject) {
         description = @"";
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_update];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"list_id": listID, @"name": name, @"description": description, @"mode": isPrivate?@"private":@"public"}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsUpdate parameters:@{@"list_id": listID, @"name": name, @"description": description, @"mode": isPrivate?@"private":@"public"}]);
 }
 
 - (id)listUsersInListWithID:(NSString *)listID {
@@ -558,8 +750,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_members];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"list_id": listID }];
+    return [self sendRequestForEndpoint:FHSEndpointListsMembers parameters:@{ @"list_id": listID }];
 }
 
 - (NSError *)removeUsersFromListWithID:(NSString *)listID users:(NSArray *)users {
@@ -570,12 +761,11 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_members_destroy_all];
     NSDictionary *params = @{
                              @"list_id": listID,
                              @"screen_name": [users componentsJoinedByString:@","]
                              };
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsMembersDestroyAll parameters:params]);
 }
 
 - (NSError *)addUsersToListWithID:(NSString *)listID users:(NSArray *)users {
@@ -586,12 +776,11 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_members_create_all];
     NSDictionary *params = @{
                              @"list_id": listID,
                              @"screen_name": [users componentsJoinedByString:@","]
                              };
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointListsMembersCreateAll parameters:params]);
 }
 
 - (id)getTimelineForListWithID:(NSString *)listID count:(int)count {
@@ -616,7 +805,6 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_statuses];
     NSMutableDictionary *params = [@{ @"count":@(count).stringValue, @"exclude_replies":(excludeReplies?@"true":@"false"), @"include_rts":(excludeRetweets?@"false":@"true"),@"list_id":listID } mutableCopy];
     
     if (sinceID.length > 0) {
@@ -627,7 +815,7 @@ id removeNull(id rootObject) {
         params[@"max_id"] = maxID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointListsStatuses parameters:params];
 }
 
 - (id)getListsForUser:(NSString *)user isID:(BOOL)isID {
@@ -636,8 +824,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_lists_list];
-    return [self sendGETRequestForURL:baseURL andParams:@{ (isID?@"user_id":@"screen_name"): user }];
+    return [self sendRequestForEndpoint:FHSEndpointListsList parameters:@{ (isID?@"user_id":@"screen_name"): user }];
 }
 
 - (id)getRetweetsForTweet:(NSString *)identifier count:(int)count {
@@ -650,8 +837,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:[NSString stringWithFormat:@"https://api.twitter.com/1.1/statuses/retweets/%@.json",identifier]];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"count":@(count).stringValue }];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesRetweets parameters:@{ @"id":identifier, @"count":@(count).stringValue }];
 }
 
 - (id)getRetweetedTimelineWithCount:(int)count {
@@ -664,7 +850,6 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_retweets_of_me];
     NSMutableDictionary *params = [@{ @"count":@(count).stringValue, @"exclude_replies":@"false", @"include_rts":@"true"} mutableCopy];
     
     if (sinceID.length > 0) {
@@ -675,7 +860,7 @@ id removeNull(id rootObject) {
         params[@"max_id"] = maxID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesRetweetsOfMe parameters:params];
 }
 
 - (id)getMentionsTimelineWithCount:(int)count {
@@ -688,8 +873,6 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_metions_timeline];
-    
     NSMutableDictionary *params = [@{ @"count":@(count).stringValue, @"exclude_replies":@"false", @"include_rts":@"true" } mutableCopy];
     
     if (sinceID.length > 0) {
@@ -700,7 +883,7 @@ id removeNull(id rootObject) {
         params[@"max_id"] = maxID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesMentionsTimeline parameters:params];
 }
 
 - (NSError *)postTweet:(NSString *)tweetString withImageData:(NSData *)theData {
@@ -720,7 +903,11 @@ id removeNull(id rootObject) {
         }
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_update_with_media];
+    NSError *mediaError = [self validateMediaData:theData];
+    
+    if (mediaError) {
+        return mediaError;
+    }
     
     NSMutableDictionary *params = [NSMutableDictionary dictionary];
     params[@"status"] = tweetString;
@@ -730,20 +917,29 @@ id removeNull(id rootObject) {
         params[@"in_reply_to_status_id"] = tweetID;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointStatusesUpdateWithMedia parameters:params]);
 }
 
 - (void) uploadMediaWithData:(NSData *) imageData withCompletionBlock:(void (^)(NSError *, id))completionBlock
 {
+    NSError *error = nil;
+    
     if (imageData == nil){
-        NSError* error=  [NSError badRequestError];
+        error = [NSError badRequestError];
+        if (completionBlock){
+            completionBlock(error, nil);
+        }
+    } else if ((error = [self validateMediaData:imageData])) {
         if (completionBlock){
             completionBlock(error, nil);
         }
     } else {
-        NSURL *baseURL = [NSURL URLWithString:url_media_upload];
-        NSDictionary* params = @{@"media": imageData};
-        [self sendPOSTRequestForURL:baseURL andParams:params WithCompletionBlock:completionBlock];
+        id response = [self sendRequestForEndpoint:FHSEndpointMediaUpload parameters:@{@"media": imageData}];
+        
+        if (completionBlock){
+            BOOL failed = [response isKindOfClass:[NSError class]];
+            completionBlock(failed?response:nil, failed?nil:response);
+        }
     }
 }
 
@@ -752,16 +948,14 @@ id removeNull(id rootObject) {
     if (tweetString.length == 0) {
         return [NSError badRequestError];
     } else if (mediaIDs.count == 0) {
-        [self postTweet:tweetString];
+        return [self postTweet:tweetString];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_update];
-    
     NSMutableDictionary *params = [NSMutableDictionary dictionary];
     params[@"status"] = tweetString;
-    params[@"media_ids"] = mediaIDs;
+    params[@"media_ids"] = [mediaIDs componentsJoinedByString:@","];
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointStatusesUpdate parameters:params]);
 }
 
 
@@ -771,8 +965,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_destroy];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"id": identifier}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointStatusesDestroy parameters:@{@"id": identifier}]);
 }
 
 - (id)getDetailsForTweet:(NSString *)identifier {
@@ -781,8 +974,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_show];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"id":identifier, @"include_my_retweet":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesShow parameters:@{ @"id":identifier, @"include_my_retweet":@"true" }];
 }
 
 - (NSError *)retweet:(NSString *)identifier {
@@ -791,8 +983,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:[NSString stringWithFormat:@"https://api.twitter.com/1.1/statuses/retweet/%@.json",identifier]];
-    return [self sendPOSTRequestForURL:baseURL andParams:nil];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointStatusesRetweet parameters:@{ @"id":identifier }]);
 }
 
 - (id)getTimelineForUser:(NSString *)user isID:(BOOL)isID count:(int)count {
@@ -809,7 +1000,6 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_user_timeline];
     NSMutableDictionary *params = [@{ @"count":@(count).stringValue, (isID?@"user_id":@"screen_name"):user, @"exclude_replies":@"false", @"include_rts":@"true" } mutableCopy];
     
     if (sinceID.length > 0) {
@@ -820,7 +1010,18 @@ id removeNull(id rootObject) {
         params[@"max_id"] = maxID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesUserTimeline parameters:params];
+}
+
+- (id)getTimelineForUser:(NSString *)user isID:(BOOL)isID count:(int)count fromDate:(NSDate *)fromDate toDate:(NSDate *)toDate {
+    NSString *sinceID = nil;
+    NSString *maxID = nil;
+    
+    if (!fhs_tweet_id_window(fromDate, toDate, &sinceID, &maxID)) {
+        return [NSError badRequestError];
+    }
+    
+    return [self getTimelineForUser:user isID:isID count:count sinceID:sinceID maxID:maxID];
 }
 
 - (id)getProfileImageForUsername:(NSString *)username andSize:(FHSTwitterEngineImageSize)size {
@@ -829,8 +1030,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_users_show];
-    id userShowReturn = [self sendGETRequestForURL:baseURL andParams:@{ @"screen_name":username }];
+    id userShowReturn = [self sendRequestForEndpoint:FHSEndpointUsersShow parameters:@{ @"screen_name":username }];
     
     if ([userShowReturn isKindOfClass:[NSError class]]) {
         return userShowReturn;
@@ -847,9 +1047,11 @@ id removeNull(id rootObject) {
         
         id ret = [self sendRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:url]]];
         
+#if FHS_UIKIT
         if ([ret isKindOfClass:[NSData class]]) {
             return [UIImage imageWithData:(NSData *)ret];
         }
+#endif
         
         return ret;
     }
@@ -863,8 +1065,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_users_show];
-    id userShowReturn = [self sendGETRequestForURL:baseURL andParams:@{ @"screen_name":username }];
+    id userShowReturn = [self sendRequestForEndpoint:FHSEndpointUsersShow parameters:@{ @"screen_name":username }];
     
     if ([userShowReturn isKindOfClass:[NSError class]]) {
         return userShowReturn;
@@ -890,28 +1091,64 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_blocks_exists];
-    return [self sendGETRequestForURL:baseURL andParams:@{ (isID?@"user_id":@"screen_name"):@"true", @"skip_status":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointBlocksExists parameters:@{ (isID?@"user_id":@"screen_name"):user, @"skip_status":@"true" }];
 }
 
 - (id)listBlockedUsers {
-    NSURL *baseURL = [NSURL URLWithString:url_blocks_blocking];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"skip_status":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointBlocksList parameters:@{ @"skip_status":@"true" }];
 }
 
 - (id)listBlockedIDs {
-    NSURL *baseURL = [NSURL URLWithString:url_blocks_blocking_ids];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"stringify_ids": @"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointBlocksIDs parameters:@{ @"stringify_ids": @"true" }];
 }
 
 - (id)getLanguages {
-    NSURL *baseURL = [NSURL URLWithString:url_help_languages];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointHelpLanguages parameters:nil];
 }
 
 - (id)getConfiguration {
-    NSURL *baseURL = [NSURL URLWithString:url_help_configuration];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    id configuration = [self sendRequestForEndpoint:FHSEndpointHelpConfiguration parameters:nil];
+    
+    if ([configuration isKindOfClass:[NSDictionary class]]) {
+        self.configuration = configuration;
+    }
+    
+    return configuration;
+}
+
+- (NSError *)validateMediaData:(NSData *)data {
+    fhs_media_info info;
+    
+    if (fhs_media_probe(data.bytes, data.length, &info) != 0) {
+        return [NSError unsupportedMediaError];
+    }
+    
+    fhs_media_limits limits = fhs_media_default_limits;
+    NSNumber *photoSizeLimit = self.configuration[@"photo_size_limit"];
+    
+    if (photoSizeLimit.unsignedLongLongValue > 0) {
+        limits.imageBytes = photoSizeLimit.unsignedLongLongValue;
+    }
+    
+    switch (fhs_media_validate(&info, data.length, &limits)) {
+        case FHSMediaValid:
+            return nil;
+        case FHSMediaTooLarge:
+            return [NSError imageTooLargeError];
+        default:
+            return [NSError unsupportedMediaError];
+    }
+}
+
+- (NSError *)validateMediaAtPath:(NSString *)path {
+    NSError *error = nil;
+    NSData *data = [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:&error]; // only the pages the probe touches get read
+    
+    if (!data) {
+        return error;
+    }
+    
+    return [self validateMediaData:data];
 }
 
 - (NSError *)reportUserAsSpam:(NSString *)user isID:(BOOL)isID {
@@ -920,8 +1157,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_users_report_spam];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{(isID?@"user_id":@"screen_name"): user}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointUsersReportSpam parameters:@{(isID?@"user_id":@"screen_name"): user}]);
 }
 
 - (id)showDirectMessage:(NSString *)messageID {
@@ -929,8 +1165,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_direct_messages_show];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"id":messageID }];
+    return [self sendRequestForEndpoint:FHSEndpointDirectMessagesShow parameters:@{ @"id":messageID }];
 }
 
 - (NSError *)sendDirectMessage:(NSString *)body toUser:(NSString *)user isID:(BOOL)isID {
@@ -943,8 +1178,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_direct_messages_new];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"text": [body fhs_trimForTwitter], (isID?@"user_id":@"screen_name"):user}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointDirectMessagesNew parameters:@{@"text": [body fhs_trimForTwitter], (isID?@"user_id":@"screen_name"):user}]);
 }
 
 - (id)getSentDirectMessages:(int)count {
@@ -953,8 +1187,7 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_direct_messages_sent];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"count":@(count).stringValue }];
+    return [self sendRequestForEndpoint:FHSEndpointDirectMessagesSent parameters:@{ @"count":@(count).stringValue }];
 }
 
 - (NSError *)deleteDirectMessage:(NSString *)messageID {
@@ -963,8 +1196,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_direct_messages_destroy];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"id": messageID, @"include_entities": (_includeEntities?@"true":@"false")}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointDirectMessagesDestroy parameters:@{@"id": messageID, @"include_entities": (_includeEntities?@"true":@"false")}]);
 }
 
 - (id)getDirectMessages:(int)count {
@@ -972,23 +1204,19 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_direct_messages];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"count":@(count).stringValue,@"skip_status":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointDirectMessages parameters:@{ @"count":@(count).stringValue,@"skip_status":@"true" }];
 }
 
 - (id)getPrivacyPolicy {
-    NSURL *baseURL = [NSURL URLWithString:url_help_privacy];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointHelpPrivacy parameters:nil];
 }
 
 - (id)getTermsOfService {
-    NSURL *baseURL = [NSURL URLWithString:url_help_tos];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointHelpTOS parameters:nil];
 }
 
 - (id)getNoRetweetIDs {
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_no_retweets_ids];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"stringify_ids":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointFriendshipsNoRetweetsIDs parameters:@{ @"stringify_ids":@"true" }];
 }
 
 - (NSError *)enableRetweets:(BOOL)enableRTs andDeviceNotifs:(BOOL)devNotifs forUser:(NSString *)user isID:(BOOL)isID {
@@ -997,18 +1225,15 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_update];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{(isID?@"user_id":@"screen_name"): user, @"retweets": (enableRTs?@"true":@"false"), @"device": (devNotifs?@"true":@"false")}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointFriendshipsUpdate parameters:@{(isID?@"user_id":@"screen_name"): user, @"retweets": (enableRTs?@"true":@"false"), @"device": (devNotifs?@"true":@"false")}]);
 }
 
 - (id)getPendingOutgoingFollowers {
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_outgoing];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"stringify_ids":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointFriendshipsOutgoing parameters:@{ @"stringify_ids":@"true" }];
 }
 
 - (id)getPendingIncomingFollowers {
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_incoming];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"stringify_ids":@"true" }];
+    return [self sendRequestForEndpoint:FHSEndpointFriendshipsIncoming parameters:@{ @"stringify_ids":@"true" }];
 }
 
 - (id)lookupFriendshipStatusForUsers:(NSArray *)users areIDs:(BOOL)areIDs {
@@ -1019,11 +1244,9 @@ id removeNull(id rootObject) {
     NSMutableArray *returnedDictionaries = [NSMutableArray array];
     NSArray *reqStrings = [self generateRequestStringsFromArray:users];
     
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_lookup];
-    
     for (NSString *reqString in reqStrings) {
         
-        id retObj = [self sendGETRequestForURL:baseURL andParams:@{ (areIDs?@"user_id":@"screen_name"):reqString }];
+        id retObj = [self sendRequestForEndpoint:FHSEndpointFriendshipsLookup parameters:@{ (areIDs?@"user_id":@"screen_name"):reqString }];
         
         if ([retObj isKindOfClass:[NSArray class]]) {
             [returnedDictionaries addObjectsFromArray:(NSArray *)retObj];
@@ -1040,8 +1263,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_destroy];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{(isID?@"user_id":@"screen_name"): user}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointFriendshipsDestroy parameters:@{(isID?@"user_id":@"screen_name"): user}]);
 }
 
 - (NSError *)followUser:(NSString *)user isID:(BOOL)isID {
@@ -1049,13 +1271,11 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_friendships_create];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{(isID?@"user_id":@"screen_name"): user}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointFriendshipsCreate parameters:@{(isID?@"user_id":@"screen_name"): user}]);
 }
 
 - (id)verifyCredentials {
-    NSURL *baseURL = [NSURL URLWithString:url_account_verify_credentials];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointAccountVerifyCredentials parameters:nil];
 }
 
 - (id)getFavoritesForUser:(NSString *)user isID:(BOOL)isID andCount:(int)count {
@@ -1071,8 +1291,6 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_favorites_list];
-    
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:5];
     params[@"count"] = [NSString stringWithFormat:@"%d",count];
     params[(isID?@"user_id":@"screen_name")] = user;
@@ -1086,7 +1304,7 @@ id removeNull(id rootObject) {
         params[@"max_id"] = maxID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointFavoritesList parameters:params];
 }
 
 - (NSError *)markTweet:(NSString *)tweetID asFavorite:(BOOL)flag {
@@ -1095,13 +1313,33 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:flag?url_favorites_create:url_favorites_destroy];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"id": tweetID}];
+    return fhs_error_only([self sendRequestForEndpoint:flag?FHSEndpointFavoritesCreate:FHSEndpointFavoritesDestroy parameters:@{@"id": tweetID}]);
 }
 
 - (id)getRateLimitStatus {
-    NSURL *baseURL = [NSURL URLWithString:url_application_rate_limit_status];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointApplicationRateLimitStatus parameters:nil];
+}
+
+- (NSDictionary *)rateLimitForURL:(NSURL *)url {
+    @synchronized(_rateLimits) {
+        return _rateLimits[url.path?:@""];
+    }
+}
+
+- (void)recordRateLimitForURL:(NSURL *)url response:(NSHTTPURLResponse *)response {
+    NSDictionary *headers = response.allHeaderFields;
+    NSString *remaining = headers[@"x-rate-limit-remaining"]?:headers[@"X-Rate-Limit-Remaining"];
+    NSString *reset = headers[@"x-rate-limit-reset"]?:headers[@"X-Rate-Limit-Reset"];
+    
+    if (remaining.length == 0 || reset.longLongValue <= 0 || url.path.length == 0) {
+        return;
+    }
+    
+    NSDictionary *limit = @{ FHSRateLimitRemainingKey: @(remaining.integerValue), FHSRateLimitResetDateKey: [NSDate dateWithTimeIntervalSince1970:reset.longLongValue] };
+    
+    @synchronized(_rateLimits) {
+        _rateLimits[url.path] = limit;
+    }
 }
 
 - (NSError *)updateProfileColorsWithDictionary:(NSDictionary *)dictionary {
@@ -1117,7 +1355,6 @@ id removeNull(id rootObject) {
     NSString *profile_sidebar_fill_color = dictionary[FHSProfileSidebarFillColorKey];
     NSString *profile_text_color = dictionary[FHSProfileTextColorKey];
     
-    NSURL *baseURL = [NSURL URLWithString:url_account_update_profile_colors];
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:6];
     params[@"skip_status"] = @"true";
     
@@ -1141,12 +1378,11 @@ id removeNull(id rootObject) {
         params[@"profile_text_color"] = profile_text_color;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateProfileColors parameters:params]);
 }
 
 - (NSError *)setUseProfileBackgroundImage:(BOOL)shouldUseBGImg {
-    NSURL *baseURL = [NSURL URLWithString:url_account_update_profile_background_image];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"skip_status": @"true", @"use": (shouldUseBGImg?@"true":@"false")}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateProfileBackgroundImage parameters:@{@"skip_status": @"true", @"use": (shouldUseBGImg?@"true":@"false")}]);
 }
 
 - (NSError *)setProfileBackgroundImageWithImageData:(NSData *)data tiled:(BOOL)isTiled {
@@ -1158,8 +1394,7 @@ id removeNull(id rootObject) {
         return [NSError imageTooLargeError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_account_update_profile_background_image];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"skip_status":@"true", @"use":@"true", @"include_entities":_includeEntities?@"true":@"false", @"tiled":(isTiled?@"true":@"false"), @"image":[data base64Encode]}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateProfileBackgroundImage parameters:@{@"skip_status":@"true", @"use":@"true", @"include_entities":_includeEntities?@"true":@"false", @"tiled":(isTiled?@"true":@"false"), @"image":data}]);
 }
 
 - (NSError *)setProfileBackgroundImageWithImageAtPath:(NSString *)file tiled:(BOOL)isTiled {
@@ -1175,8 +1410,7 @@ id removeNull(id rootObject) {
         return [NSError imageTooLargeError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_account_update_profile_image];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), @"image":[data base64Encode]}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateProfileImage parameters:@{@"skip_status":@"true", @"include_entities":(_includeEntities?@"true":@"false"), @"image":data}]);
 }
 
 - (NSError *)setProfileImageWithImageAtPath:(NSString *)file {
@@ -1184,8 +1418,7 @@ id removeNull(id rootObject) {
 }
 
 - (id)getUserSettings {
-    NSURL *baseURL = [NSURL URLWithString:url_account_settings];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointAccountSettings parameters:nil];
 }
 
 - (NSError *)updateUserProfileWithDictionary:(NSDictionary *)settings {
@@ -1206,8 +1439,6 @@ id removeNull(id rootObject) {
     NSString *location = settings[FHSProfileLocationKey];
     NSString *description = settings[FHSProfileDescriptionKey];
     
-    NSURL *baseURL = [NSURL URLWithString:url_account_update_profile];
-    
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:6];
     params[@"skip_status"] = @"true";
     params[@"include_entities"] = (_includeEntities?@"true":@"false");
@@ -1228,7 +1459,7 @@ id removeNull(id rootObject) {
         params[@"description"] = description;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateProfile parameters:params]);
 }
 
 - (NSError *)updateSettingsWithDictionary:(NSDictionary *)settings {
@@ -1251,7 +1482,6 @@ id removeNull(id rootObject) {
     NSString *time_zone = settings[@"time_zone"];
     NSString *lang = settings[@"lang"];
     
-    NSURL *baseURL = [NSURL URLWithString:url_account_settings];
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:5];
     
     if (sleep_time_enabled.length > 0) {
@@ -1274,7 +1504,7 @@ id removeNull(id rootObject) {
         params[@"lang"] = lang;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointAccountUpdateSettings parameters:params]);
 }
 
 - (id)lookupUsers:(NSArray *)users areIDs:(BOOL)areIDs {
@@ -1287,8 +1517,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_users_lookup];
-    return [self sendGETRequestForURL:baseURL andParams:@{ (areIDs?@"user_id":@"screen_name"):[users componentsJoinedByString:@","] }];
+    return [self sendRequestForEndpoint:FHSEndpointUsersLookup parameters:@{ (areIDs?@"user_id":@"screen_name"):[users componentsJoinedByString:@","] }];
 }
 
 - (NSError *)unblock:(NSString *)username {
@@ -1296,8 +1525,7 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_blocks_destroy];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"screen_name":username}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointBlocksDestroy parameters:@{@"screen_name":username}]);
 }
 
 - (NSError *)block:(NSString *)username {
@@ -1306,13 +1534,11 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_blocks_create];
-    return [self sendPOSTRequestForURL:baseURL andParams:@{@"screen_name":username}];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointBlocksCreate parameters:@{@"screen_name":username}]);
 }
 
 - (id)testService {
-    NSURL *baseURL = [NSURL URLWithString:url_help_test];
-    return [self sendGETRequestForURL:baseURL andParams:nil];
+    return [self sendRequestForEndpoint:FHSEndpointHelpTest parameters:nil];
 }
 
 - (id)getHomeTimelineSinceID:(NSString *)sinceID count:(int)count {
@@ -1321,8 +1547,6 @@ id removeNull(id rootObject) {
         return nil;
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_home_timeline];
-    
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:2];
     params[@"count"] = [NSString stringWithFormat:@"%d",count];
     
@@ -1330,7 +1554,7 @@ id removeNull(id rootObject) {
         params[@"since_id"] = sinceID;
     }
     
-    return [self sendGETRequestForURL:baseURL andParams:params];
+    return [self sendRequestForEndpoint:FHSEndpointStatusesHomeTimeline parameters:params];
 }
 
 - (NSError *)postTweet:(NSString *)tweetString inReplyTo:(NSString *)tweetID {
@@ -1338,8 +1562,6 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSURL *baseURL = [NSURL URLWithString:url_statuses_update];
-    
     NSMutableDictionary *params = [NSMutableDictionary dictionaryWithCapacity:2];
     params[@"status"] = tweetString;
     
@@ -1347,7 +1569,7 @@ id removeNull(id rootObject) {
         params[@"in_reply_to_status_id"] = tweetID;
     }
     
-    return [self sendPOSTRequestForURL:baseURL andParams:params];
+    return fhs_error_only([self sendRequestForEndpoint:FHSEndpointStatusesUpdate parameters:params]);
 }
 
 - (NSError *)postTweet:(NSString *)tweetString {
@@ -1355,13 +1577,28 @@ id removeNull(id rootObject) {
 }
 
 - (id)getFollowersIDs {
-    NSURL *baseURL = [NSURL URLWithString:url_followers_ids];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"screen_name": _authenticatedUsername, @"stringify_ids":@"true"}];
+    return [self sendRequestForEndpoint:FHSEndpointFollowersIDs parameters:@{ @"screen_name": self.authenticatedUsername, @"stringify_ids":@"true"}];
 }
 
 - (id)getFriendsIDs {
-    NSURL *baseURL = [NSURL URLWithString:url_friends_ids];
-    return [self sendGETRequestForURL:baseURL andParams:@{ @"screen_name": _authenticatedUsername, @"stringify_ids":@"true"}];
+    return [self sendRequestForEndpoint:FHSEndpointFriendsIDs parameters:@{ @"screen_name": self.authenticatedUsername, @"stringify_ids":@"true"}];
+}
+
+// String ids decode faster than numbers, so id lists keep stringify_ids
+- (id)getFollowerIDList {
+    return [self getIDListForEndpoint:FHSEndpointFollowersIDs parameters:@{ @"screen_name": self.authenticatedUsername?:@"", @"stringify_ids":@"true"}];
+}
+
+- (id)getFriendIDList {
+    return [self getIDListForEndpoint:FHSEndpointFriendsIDs parameters:@{ @"screen_name": self.authenticatedUsername?:@"", @"stringify_ids":@"true"}];
+}
+
+- (id)getBlockedIDList {
+    return [self getIDListForEndpoint:FHSEndpointBlocksIDs parameters:@{ @"stringify_ids": @"true" }];
+}
+
+- (id)getNoRetweetIDList {
+    return [self getIDListForEndpoint:FHSEndpointFriendshipsNoRetweetsIDs parameters:@{ @"stringify_ids":@"true" }];
 }
 
 - (id)uploadImageToTwitPic:(NSData *)imageData withMessage:(NSString *)message twitPicAPIKey:(NSString *)twitPicAPIKey {
@@ -1372,35 +1609,11 @@ id removeNull(id rootObject) {
         return [NSError badRequestError];
     }
     
-    NSString *nonce = [NSString fhs_UUID];
-    NSURL *baseURL = [NSURL URLWithString:@"https://api.twitter.com/1.1/account/verify_credentials.json"];
-    
-    NSString *timestamp = [NSString stringWithFormat:@"%ld", time(nil)];
-    
-    NSMutableArray *parameterPairs = [NSMutableArray arrayWithCapacity:6];
-    [parameterPairs addObject:[NSString stringWithFormat:@"oauth_consumer_key=%@",_consumer.key.fhs_URLEncode]];
-    [parameterPairs addObject:@"oauth_signature_method=HMAC-SHA1"];
-    [parameterPairs addObject:[NSString stringWithFormat:@"oauth_nonce=%@",nonce.fhs_URLEncode]];
-    [parameterPairs addObject:[NSString stringWithFormat:@"oauth_timestamp=%@",timestamp.fhs_URLEncode]];
-    [parameterPairs addObject:@"oauth_version=1.0"];
-    [parameterPairs addObject:[NSString stringWithFormat:@"oauth_token=%@",_accessToken.key]];
-    
-    NSArray *sortedPairs = [parameterPairs sortedArrayUsingSelector:@selector(compare:)];
-    NSString *normalizedRequestParameters = [sortedPairs componentsJoinedByString:@"&"];
-    
-    NSString *signatureBaseString = [NSString stringWithFormat:@"%@&%@&%@", @"GET", [@"https://api.twitter.com/1.1/account/verify_credentials.json" fhs_URLEncode],normalizedRequestParameters.fhs_URLEncode];
-    
-    NSString *secretForSigning = [NSString stringWithFormat:@"%@&%@", _consumer.secret.fhs_URLEncode, _accessToken.secret.fhs_URLEncode];
-    
-    NSData *secretData = [secretForSigning dataUsingEncoding:NSUTF8StringEncoding];
-    NSData *clearTextData = [signatureBaseString dataUsingEncoding:NSUTF8StringEncoding];
-    unsigned char result[20];
-    CCHmac(kCCHmacAlgSHA1, secretData.bytes, secretData.length, clearTextData.bytes, clearTextData.length, result);
-    NSString *signature = [[NSData dataWithBytes:result length:20]base64Encode];
+    NSString *nonce = [NSString fhs_nonce];
+    NSURL *baseURL = [NSURL URLWithString:@(fhs_endpoint_get(FHSEndpointAccountVerifyCredentials)->url)];
     
-    NSString *oauthToken = [NSString stringWithFormat:@"oauth_token=\"%@\", ", _accessToken.key.fhs_URLEncode];
-    
-    NSString *oauthHeaders = [NSString stringWithFormat:@"OAuth realm=\"%@\", oauth_consumer_key=\"%@\", %@oauth_signature_method=\"HMAC-SHA1\", oauth_signature=\"%@\", oauth_timestamp=\"%@\", oauth_nonce=\"%@\", oauth_version=\"1.0\"", @"http://api.twitter.com/".fhs_URLEncode, _consumer.key.fhs_URLEncode, oauthToken, signature.fhs_URLEncode, timestamp, nonce];
+    FHSToken *accessToken = self.accessToken;
+    NSString *oauthHeaders = [self OAuthHeaderForURL:baseURL HTTPMethod:@"GET" body:nil contentType:nil token:accessToken.key tokenSecret:accessToken.secret verifier:nil realm:@"http://api.twitter.com/"];
     
     NSURL *url = [NSURL URLWithString:@"http://api.twitpic.com/2/upload.json"];
     
@@ -1409,46 +1622,18 @@ id removeNull(id rootObject) {
     [req setValue:oauthHeaders forHTTPHeaderField:@"X-Verify-Credentials-Authorization"];
     [req setValue:baseURL.absoluteString forHTTPHeaderField:@"X-Auth-Service-Provider"];
     
-    NSString *boundary = @"---------------------------14737809831466499882746641449";
-    NSString *contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=%@",boundary];
-    
-    [req addValue:contentType forHTTPHeaderField:@"Content-Type"];
-    
-    NSMutableData *body = [NSMutableData data];
-    
-    // message
-    [body appendData:[[NSString stringWithFormat:@"--%@\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"message\"\r\n\r\n"] dataUsingEncoding:NSUTF8StringEncoding]];
-    
-    [body appendData:[message dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-    
-    // key
-    [body appendData:[[NSString stringWithFormat:@"--%@\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"key\"\r\n\r\n"] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[twitPicAPIKey dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-    
-    // picture
-    [body appendData:[[NSString stringWithFormat:@"--%@\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"media\"; filename=\"%@.%@\"\r\n",nonce,appropriateExtension] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[[NSString stringWithFormat:@"Content-Type: image/%@\r\n",appropriateExtension] dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:[@"Content-Transfer-Encoding: binary\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-    [body appendData:imageData];
-    [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-    
-    [body appendData:[[NSString stringWithFormat:@"--%@\r\n", boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-    
-    [req setHTTPBody:body];
-    
-    [req setValue:[NSString stringWithFormat:@"%d",body.length] forHTTPHeaderField:@"Content-Length"];
+    FHSMultipartBody *body = [FHSMultipartBody body];
+    [body addString:message forName:@"message"];
+    [body addString:twitPicAPIKey forName:@"key"];
+    [body addData:imageData forName:@"media" fileName:[NSString stringWithFormat:@"%@.%@",nonce,appropriateExtension] contentType:[NSString stringWithFormat:@"image/%@",appropriateExtension]];
+    [body applyToRequest:req];
     
     NSError *error = nil;
     NSHTTPURLResponse *response = nil;
     
-    NSData *responseData = [NSURLConnection sendSynchronousRequest:req returningResponse:&response error:&error];
+    NSData *responseData = [self sendSynchronousRequest:req returningResponse:&response error:&error];
     
-    id parsedJSONResponse = removeNull([NSJSONSerialization JSONObjectWithData:responseData options:NSJSONReadingMutableContainers error:nil]);
+    id parsedJSONResponse = [self parseResponseData:responseData];
     
     if (error) {
         return error;
@@ -1511,7 +1696,7 @@ id removeNull(id rootObject) {
         params[@"locations"] = [locBox componentsJoinedByString:@","];
     }
     
-    [[FHSStream streamWithURL:@"https://userstream.twitter.com/1.1/user.json" httpMethod:@"POST" parameters:params timeout:streamingTimeoutInterval block:block]start]; // Twitter says it should be GET, but on further investigation of the docs, POST works too.
+    [self startStream:[FHSStream streamWithURL:@"https://userstream.twitter.com/1.1/user.json" httpMethod:@"POST" parameters:params timeout:streamingTimeoutInterval block:block]]; // Twitter says it should be GET, but on further investigation of the docs, POST works too.
 }
 
 - (void)streamPublicStatusesForUsers:(NSArray *)users keywords:(NSArray *)keywords locationBox:(NSArray *)locBox block:(StreamBlock)block {
@@ -1539,15 +1724,15 @@ id removeNull(id rootObject) {
         params[@"locations"] = [locBox componentsJoinedByString:@","];
     }
     
-    [[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/filter.json" httpMethod:@"POST" parameters:params timeout:streamingTimeoutInterval block:block]start];
+    [self startStream:[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/filter.json" httpMethod:@"POST" parameters:params timeout:streamingTimeoutInterval block:block]];
 }
 
 - (void)streamSampleStatusesWithBlock:(StreamBlock)block {
-    [[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/sample.json" httpMethod:@"GET" parameters:nil timeout:streamingTimeoutInterval block:block]start];
+    [self startStream:[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/sample.json" httpMethod:@"GET" parameters:nil timeout:streamingTimeoutInterval block:block]];
 }
 
 - (void)streamFirehoseWithBlock:(StreamBlock)block {
-    [[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/firehose.json" httpMethod:@"GET" parameters:nil timeout:streamingTimeoutInterval block:block]start];
+    [self startStream:[FHSStream streamWithURL:@"https://stream.twitter.com/1.1/statuses/firehose.json" httpMethod:@"GET" parameters:nil timeout:streamingTimeoutInterval block:block]];
 }
 
 - (instancetype)init {
@@ -1561,11 +1746,33 @@ id removeNull(id rootObject) {
         _dateFormatter.formatterBehavior = NSDateFormatterBehavior10_4;
         _dateFormatter.dateFormat = @"EEE MMM dd HH:mm:ss ZZZZ yyyy";
         
-        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(cancelTouched:) name:@"FHSTwitterEngineControllerDidCancel" object:nil];
+        self.JSONReader = [FHSJSONReader reader];
+        self.rateLimits = [NSMutableDictionary dictionary];
+        self.accessTokenStoreKey = @"SavedAccessHTTPBody";
+        
+        NSURLSessionConfiguration *configuration = [NSURLSessionConfiguration ephemeralSessionConfiguration];
+        configuration.HTTPShouldSetCookies = NO;
+        configuration.HTTPCookieAcceptPolicy = NSHTTPCookieAcceptPolicyNever;
+        configuration.URLCache = nil;
+        self.session = [NSURLSession sessionWithConfiguration:configuration];
+        
+        [[NSNotificationCenter defaultCenter] addObserver:self selector:@selector(cancelTouched:) name:@"FHSTwitterEngineControllerDidCancel" object:self];
     }
     return self;
 }
 
++ (FHSTwitterEngine *)engineWithConsumerKey:(NSString *)consumerKey secret:(NSString *)consumerSecret accessTokenStoreKey:(NSString *)storeKey {
+    FHSTwitterEngine *engine = [[[self class]alloc]init];
+    [engine permanentlySetConsumerKey:consumerKey andSecret:consumerSecret];
+    engine.accessTokenStoreKey = storeKey;
+    
+    if (storeKey) {
+        [engine loadAccessToken];
+    }
+    
+    return engine;
+}
+
 + (FHSTwitterEngine *)sharedEngine {
     static FHSTwitterEngine *sharedInstance = nil;
     static dispatch_once_t onceToken;
@@ -1621,15 +1828,12 @@ id removeNull(id rootObject) {
 
 - (id)sendRequest:(NSURLRequest *)request {
     
-    if (_shouldClearConsumer) {
-        self.shouldClearConsumer = NO;
-        self.consumer = nil;
-    }
+    [self clearTemporaryConsumer];
     
     NSHTTPURLResponse *response = nil;
     NSError *error = nil;
     
-    NSData *data = [NSURLConnection sendSynchronousRequest:request returningResponse:&response error:&error];
+    NSData *data = [self sendSynchronousRequest:request returningResponse:&response error:&error];
     
     if (error) {
         return error;
@@ -1650,94 +1854,95 @@ id removeNull(id rootObject) {
     return data;
 }
 
-- (void)signRequest:(NSMutableURLRequest *)request {
-    [self signRequest:request withToken:_accessToken.key tokenSecret:_accessToken.secret verifier:nil];
-}
-
-- (void)signRequest:(NSMutableURLRequest *)request withToken:(NSString *)tokenString tokenSecret:(NSString *)tokenSecretString verifier:(NSString *)verifierString {
+- (NSData *)sendSynchronousRequest:(NSURLRequest *)request returningResponse:(NSHTTPURLResponse **)response error:(NSError **)error {
+    __block NSData *taskData = nil;
+    __block NSURLResponse *taskResponse = nil;
+    __block NSError *taskError = nil;
+    dispatch_semaphore_t done = dispatch_semaphore_create(0);
     
-    NSString *consumerKey = [_consumer.key fhs_URLEncode];
-    NSString *nonce = [NSString fhs_UUID];
-    NSString *timestamp = [NSString stringWithFormat:@"%ld",time(nil)];
-    NSString *urlWithoutParams = [fhs_url_remove_params(request.URL) fhs_URLEncode];
-    
-    // OAuth Spec, Section 9.1.1 "Normalize Request Parameters"
-    // build a sorted array of both request parameters and OAuth header parameters
-    NSMutableDictionary *mutableParams = [NSMutableDictionary dictionary];
-    
-    mutableParams[@"oauth_consumer_key"] = consumerKey;
-    mutableParams[@"oauth_signature_method"] = @"HMAC-SHA1";
-    mutableParams[@"oauth_timestamp"] = timestamp;
-    mutableParams[@"oauth_nonce"] = nonce;
-    mutableParams[@"oauth_version"] = @"1.0";
-    
-    if (tokenString.length > 0) {
-        mutableParams[@"oauth_token"] = [tokenString fhs_URLEncode];
-        if (verifierString.length > 0) {
-            mutableParams[@"oauth_verifier"] = [verifierString fhs_URLEncode];
-        }
-    } else {
-        mutableParams[@"oauth_callback"] = @"oob";
-    }
+    [[_session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *urlResponse, NSError *urlError) {
+        taskData = data;
+        taskResponse = urlResponse;
+        taskError = urlError;
+        dispatch_semaphore_signal(done);
+    }]resume];
     
-    NSMutableArray *paramPairs = [NSMutableArray arrayWithCapacity:mutableParams.count];
+    dispatch_semaphore_wait(done, DISPATCH_TIME_FOREVER);
     
-    for (NSString *key in mutableParams.allKeys) {
-        [paramPairs addObject:[NSString stringWithFormat:@"%@=%@",[key fhs_URLEncode],[mutableParams[key] fhs_URLEncode]]];
+    if (response) {
+        *response = [taskResponse isKindOfClass:[NSHTTPURLResponse class]]?(NSHTTPURLResponse *)taskResponse:nil;
     }
-    // this is for parameters embedded in the request body, doesn't apply for multipart forms with binary data
-    if (request.HTTPBody){
-        NSString* bodyStr = [[NSString alloc] initWithUTF8String:request.HTTPBody.bytes];
-        NSArray* bodyParams = [bodyStr componentsSeparatedByString:@"&"];
-        [paramPairs addObjectsFromArray:bodyParams];
+    
+    if (error) {
+        *error = taskError;
     }
-    if ([request.HTTPMethod isEqualToString:@"GET"]) {
-        
-        NSArray *halves = [request.URL.absoluteString componentsSeparatedByString:@"?"];
-        
-        if (halves.count > 1) {
-            NSArray *parameters = [halves[1] componentsSeparatedByString:@"&"];
-            
-            if (parameters.count > 0) {
-                [paramPairs addObjectsFromArray:parameters];
-            }
+    
+    return taskData;
+}
+
+- (void)clearTemporaryConsumer {
+    @synchronized(self) {
+        if (self.shouldClearConsumer) {
+            self.shouldClearConsumer = NO;
+            self.consumer = nil;
         }
     }
+}
+
+- (void)startStream:(FHSStream *)stream {
+    stream.engine = self;
+    [stream start];
+}
+
+- (void)signRequest:(NSMutableURLRequest *)request {
+    // One read, so a token stored on another thread can't pair its key with the old secret
+    FHSToken *accessToken = self.accessToken;
+    [self signRequest:request withToken:accessToken.key tokenSecret:accessToken.secret verifier:nil];
+}
+
+- (void)signRequest:(NSMutableURLRequest *)request withToken:(NSString *)tokenString tokenSecret:(NSString *)tokenSecretString verifier:(NSString *)verifierString {
+    NSString *header = [self OAuthHeaderForURL:request.URL HTTPMethod:request.HTTPMethod body:request.HTTPBody contentType:[request valueForHTTPHeaderField:@"Content-Type"] token:tokenString tokenSecret:tokenSecretString verifier:verifierString realm:nil];
+    [request setValue:header forHTTPHeaderField:@"Authorization"];
+}
+
+- (FHSSigningKey *)signingKeyForToken:(NSString *)tokenString tokenSecret:(NSString *)tokenSecretString {
+    FHSConsumer *consumer = self.consumer;
+    FHSSigningKey *signingKey = self.signingKey;
     
-    [paramPairs sortUsingSelector:@selector(compare:)];
-    
-    NSString *normalizedRequestParameters = [[paramPairs componentsJoinedByString:@"&"]fhs_URLEncode];
-    
-    // OAuth Spec, Section 9.1.2 "Concatenate Request Elements"
-    // Sign request elements using HMAC-SHA1
-    NSString *signatureBaseString = [NSString stringWithFormat:@"%@&%@&%@",request.HTTPMethod,urlWithoutParams,normalizedRequestParameters];
-    
-    NSString *tokenSecretSantized = (tokenSecretString.length > 0)?[tokenSecretString fhs_URLEncode]:@""; // this way a nil token won't make a bad signature
-    
-    NSString *secret = [NSString stringWithFormat:@"%@&%@",[_consumer.secret fhs_URLEncode],tokenSecretSantized];
-    
-    NSData *secretData = [secret dataUsingEncoding:NSUTF8StringEncoding];
-    NSData *clearTextData = [signatureBaseString dataUsingEncoding:NSUTF8StringEncoding];
-    unsigned char result[20];
-    CCHmac(kCCHmacAlgSHA1, secretData.bytes, secretData.length, clearTextData.bytes, clearTextData.length, result);
-    NSData *theData = [[[NSData dataWithBytes:result length:20]base64Encode]dataUsingEncoding:NSUTF8StringEncoding];
+    if (![signingKey matchesConsumer:consumer token:tokenString tokenSecret:tokenSecretString]) {
+        signingKey = [FHSSigningKey keyWithConsumer:consumer token:tokenString tokenSecret:tokenSecretString];
+        self.signingKey = signingKey;
+    }
     
-    NSString *signature = [[[NSString alloc]initWithData:theData encoding:NSUTF8StringEncoding]fhs_URLEncode];
+    return signingKey;
+}
+
+- (NSString *)OAuthHeaderForURL:(NSURL *)url HTTPMethod:(NSString *)method body:(NSData *)body contentType:(NSString *)contentType token:(NSString *)tokenString tokenSecret:(NSString *)tokenSecretString verifier:(NSString *)verifierString realm:(NSString *)realm {
     
-    NSString *oauthToken = (tokenString.length > 0)?[NSString stringWithFormat:@"oauth_token=\"%@\", ",[tokenString fhs_URLEncode]]:@"oauth_callback=\"oob\", ";
-    NSString *oauthVerifier = (verifierString.length > 0)?[NSString stringWithFormat:@"oauth_verifier=\"%@\", ",verifierString]:@"";
+    FHSSigningKey *signingKey = [self signingKeyForToken:tokenString tokenSecret:tokenSecretString];
     
-    NSString *oauthHeader = [NSString stringWithFormat:@"OAuth oauth_consumer_key=\"%@\", %@%@oauth_signature_method=\"HMAC-SHA1\", oauth_signature=\"%@\", oauth_timestamp=\"%@\", oauth_nonce=\"%@\", oauth_version=\"1.0\"",consumerKey,oauthToken,oauthVerifier,signature,timestamp,nonce];
+    // this is for parameters embedded in the request body, doesn't apply for multipart forms with binary data
+    if ([contentType hasPrefix:@"multipart/form-data"]) {
+        body = nil;
+    }
     
-    [request setValue:oauthHeader forHTTPHeaderField:@"Authorization"];
+    return [signingKey authorizationHeaderForURL:url.absoluteString HTTPMethod:method body:body verifier:verifierString realm:realm];
 }
 
 - (int)parameterLengthForURL:(NSString *)url params:(NSMutableDictionary *)params {
     int length = url.length;
     
     for (NSString *key in params) {
-        length += [key fhs_URLEncode].length;
-        length += [params[key] fhs_URLEncode].length;
+        id value = params[key];
+        
+        if (![value isKindOfClass:[NSString class]]) {
+            value = [value description];
+        }
+        
+        const char *k = key.UTF8String;
+        const char *v = [value UTF8String];
+        length += k?fhs_percent_encoded_length(k, strlen(k)):0;
+        length += v?fhs_percent_encoded_length(v, strlen(v)):0;
         length += 1; // for the equal sign
     }
     
@@ -1754,6 +1959,18 @@ id removeNull(id rootObject) {
     return nil;
 }
 
+- (id)parseResponseData:(NSData *)data {
+    if (_usesLazyModels) {
+        id model = [FHSModel modelWithData:data nullPlaceholder:_JSONReader.nullPlaceholder];
+        
+        if (model) {
+            return model;
+        }
+    }
+    
+    return [_JSONReader objectWithData:data error:nil];
+}
+
 - (NSError *)checkError:(id)json {
     if ([json isKindOfClass:[NSDictionary class]]) {
         NSArray *errors = json[@"errors"];
@@ -1765,63 +1982,65 @@ id removeNull(id rootObject) {
     return nil;
 }
 
-- (NSData *) POSTBodyWithParams:(NSDictionary *) params
-{
-    __block NSString* urlParamsStr = nil;
-    [params enumerateKeysAndObjectsUsingBlock:^(id key, id obj, BOOL *stop) {
-        NSString* paramStr = nil;
-        NSString* valueStr = nil;
-        if ([obj isKindOfClass:[NSString class]]){
-            valueStr = obj;
-        } else if ([obj isKindOfClass:[NSArray class]]){
+- (NSData *)POSTBodyWithParams:(NSDictionary *)params {
+    return fhs_form_encode(params);
+}
+
+- (id)sendRequestForURL:(NSURL *)url HTTPMethod:(NSString *)method parameters:(NSDictionary *)params {
+    if ([method isEqualToString:@"POST"]) {
+        return [self sendPOSTRequestForURL:url body:[self POSTBodyWithParams:params] contentType:@"application/x-www-form-urlencoded"];
+    } else if ([method isEqualToString:@"GET"]) {
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:fhs_url_with_params(url, params) cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:30.0f];
+        [request setHTTPMethod:@"GET"];
+        return [self sendSignedRequest:request];
+    }
+    return [NSError badRequestError];
+}
+
+- (id)getIDListForURL:(NSURL *)url parameters:(NSDictionary *)params {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:fhs_url_with_params(url, params) cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:30.0f];
+    [request setHTTPMethod:@"GET"];
+    id response = [self sendSignedRequest:request decodesIDs:YES];
+    return ([response isKindOfClass:[FHSIDList class]] || [response isKindOfClass:[NSError class]])?response:[NSError noDataError];
+}
+
+- (id)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params {
+    return [self sendRequestForEndpoint:endpoint parameters:params decodesIDs:NO];
+}
+
+- (void)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params callbackQueue:(dispatch_queue_t)callbackQueue completion:(void (^)(id response))completion {
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        @autoreleasepool {
+            id response = [self sendRequestForEndpoint:endpoint parameters:params decodesIDs:NO];
             
-            for (NSString* value in obj) {
-                if (valueStr == nil){
-                    valueStr = value;
-                } else {
-                    valueStr = [valueStr stringByAppendingString:[NSString stringWithFormat:@",%@", value]];
-                }
+            if (!completion) {
+                return;
+            }
+            
+            // Without a queue, stay on the worker so processes with no main run loop still get called back
+            if (callbackQueue) {
+                dispatch_async(callbackQueue, ^{
+                    completion(response);
+                });
+            } else {
+                completion(response);
             }
         }
-        paramStr = [NSString stringWithFormat:@"%@=%@", [key fhs_URLEncode], [valueStr fhs_URLEncode]];
-        if (urlParamsStr == nil){
-            urlParamsStr = paramStr;
-        } else {
-            urlParamsStr = [urlParamsStr stringByAppendingString:[NSString stringWithFormat:@"&%@", paramStr]];
-        }
-    }];
-    return [urlParamsStr dataUsingEncoding:NSUTF8StringEncoding];
+    });
 }
 
-- (NSData *)POSTBodyWithParams:(NSDictionary *)params boundary:(NSString *)boundary {
-    NSMutableData *body = [NSMutableData dataWithLength:0];
-    
-    for (NSString *key in params.allKeys) {
-        id obj = params[key];
-        
-        [body appendData:[[NSString stringWithFormat:@"--%@\r\n",boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-        
-        NSData *data = nil;
-        
-        [body appendData:[[NSString stringWithFormat:@"Content-Disposition: form-data; name=\"%@\"\r\n",key] dataUsingEncoding:NSUTF8StringEncoding]];
-        
-        if ([obj isKindOfClass:[NSData class]]) {
-            [body appendData:[@"Content-Type: application/octet-stream\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-            data = (NSData *)obj;
-        } else if ([obj isKindOfClass:[NSString class]]) {
-            data = [[NSString stringWithFormat:@"%@",(NSString *)obj]dataUsingEncoding:NSUTF8StringEncoding];
-        }
-        
-        [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-        [body appendData:data];
-        [body appendData:[@"\r\n" dataUsingEncoding:NSUTF8StringEncoding]];
-    }
-    
-    [body appendData:[[NSString stringWithFormat:@"--%@--\r\n",boundary] dataUsingEncoding:NSUTF8StringEncoding]];
-    return body;
+- (id)getIDListForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params {
+    id response = [self sendRequestForEndpoint:endpoint parameters:params decodesIDs:YES];
+    return ([response isKindOfClass:[FHSIDList class]] || [response isKindOfClass:[NSError class]])?response:[NSError noDataError];
 }
 
-- (NSError *)sendPOSTRequestForURL:(NSURL *)url andParams:(NSDictionary *)params {
+- (id)sendRequestForEndpoint:(FHSEndpoint)endpoint parameters:(NSDictionary *)params decodesIDs:(BOOL)decodesIDs {
+    
+    const fhs_endpoint *descriptor = fhs_endpoint_get(endpoint);
+    
+    if (!descriptor) {
+        return [NSError badRequestError];
+    }
     
     NSError *authError = [self checkAuth];
     
@@ -1829,100 +2048,137 @@ id removeNull(id rootObject) {
         return authError;
     }
     
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:30.0f];
-    [request setHTTPMethod:@"POST"];
-    [request setHTTPShouldHandleCookies:NO];
-    // chose between multipart form and url encoded data formatting for request params
-    BOOL needsMultipart = NO;
-    if (params){
-        for (id obj in params.allValues){
-            if ([obj isKindOfClass:[NSData class]]){
-                needsMultipart = YES;
-                break;
-            }
+    // C views of the parameters, the strings they point into are kept alive by values.
+    // On the heap, the caller decides how many there are.
+    NSUInteger count = params.count;
+    NSMutableArray *keys = [NSMutableArray arrayWithCapacity:count];
+    NSMutableArray *values = [NSMutableArray arrayWithCapacity:count];
+    NSMutableData *cParamsData = [NSMutableData dataWithLength:(count+1)*sizeof(fhs_request_param)];
+    fhs_request_param *cParams = cParamsData.mutableBytes;
+    BOOL get = (strcmp(descriptor->method, "GET") == 0);
+    BOOL multipart = NO;
+    
+    for (NSString *key in params) {
+        id value = params[key];
+        
+        // Binary can't go in a query string
+        if (get && [value isKindOfClass:[NSData class]]) {
+            return [NSError badRequestError];
         }
-    }
-    if (needsMultipart){
-        NSString *boundary = [NSString fhs_UUID];
         
-        NSString *contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=%@",boundary];
-        [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
+        // UTF8String is NULL for strings with lone surrogates, e.g. a cut emoji
+        const char *k = [key isKindOfClass:[NSString class]]?key.UTF8String:NULL;
         
-        [self signRequest:request];
+        if (!k) {
+            return [NSError badRequestError];
+        }
         
-        NSData *body = [self POSTBodyWithParams:params boundary:boundary];
-        [request setValue:@(body.length).stringValue forHTTPHeaderField:@"Content-Length"];
-        request.HTTPBody = body;
-    } else {
-        NSData *body = [self POSTBodyWithParams:params];
-        request.HTTPBody = body;
-        [self signRequest:request];
-    }
-    id retobj = [self sendRequest:request];
-    
-    if (!retobj) {
-        return [NSError noDataError];
-    } else if ([retobj isKindOfClass:[NSError class]]) {
-        return retobj;
+        fhs_request_param *param = &cParams[keys.count];
+        param->key = k;
+        param->keyLength = strlen(k);
+        
+        const fhs_endpoint_param *schema = fhs_endpoint_param_named(descriptor, k, param->keyLength);
+        
+        if ([value isKindOfClass:[NSData class]] && schema && schema->type == FHSParameterBase64) {
+            // Base 64 encoded into the form body by the request builder
+            param->value = [value bytes];
+            param->valueLength = [value length];
+        } else if ([value isKindOfClass:[NSData class]]) {
+            param->value = NULL;
+            param->valueLength = [value length];
+            multipart = YES;
+        } else {
+            value = [value isKindOfClass:[NSArray class]]?[value componentsJoinedByString:@","]:[value description];
+            param->value = [value UTF8String];
+            
+            if (!param->value) {
+                return [NSError badRequestError];
+            }
+            
+            param->valueLength = strlen(param->value);
+        }
+        
+        [keys addObject:key];
+        [values addObject:value];
     }
     
-    id parsed = removeNull([NSJSONSerialization JSONObjectWithData:(NSData *)retobj options:NSJSONReadingMutableContainers error:nil]);
+    fhs_endpoint_request built;
+    memset(&built, 0, sizeof(built));
     
-    NSError *error = [self checkError:parsed];
-    
-    if (error) {
-        return error;
+    if (fhs_endpoint_request_build(&built, descriptor, cParams, count, multipart) != 0) {
+        fhs_endpoint_request_free(&built);
+        return [NSError badRequestError];
     }
     
-    return nil; // eventually return the parsed response
-}
-
-- (void) sendPOSTRequestForURL:(NSURL *)url andParams:(NSDictionary *)params WithCompletionBlock:(void (^)(NSError *error, id response)) completionBlock
-{
-    
-    NSError* error;
-    id response;
-    NSError *authError = [self checkAuth];
+    NSString *urlString = [[NSString alloc]initWithBytes:built.url.data length:built.url.length encoding:NSUTF8StringEncoding];
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:urlString] cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:multipart?60.0f:30.0f];
+    [request setHTTPMethod:@(descriptor->method)];
+    [request setHTTPShouldHandleCookies:NO];
     
-    if (authError) {
-        error = authError;
-        
-    } else {
-        
-        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:30.0f];
-        [request setHTTPMethod:@"POST"];
-        [request setHTTPShouldHandleCookies:NO];
-        
-        NSString *boundary = [NSString fhs_UUID];
-        
-        NSString *contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=%@",boundary];
-        [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
-        
-        [self signRequest:request];
+    if (multipart) {
+        // Strings as checked, so truncated ones go out truncated
+        FHSMultipartBody *body = [FHSMultipartBody body];
+        const char *pathKey = (descriptor->pathParam >= 0)?descriptor->params[descriptor->pathParam].key:NULL;
         
-        NSData *body = [self POSTBodyWithParams:params boundary:boundary];
-        [request setValue:@(body.length).stringValue forHTTPHeaderField:@"Content-Length"];
-        request.HTTPBody = body;
-        id retobj = [self sendRequest:request];
-        if (!retobj){
-            error = [NSError noDataError];
-        }  else if ([retobj isKindOfClass:[NSError class]]) {
-            error =  retobj;
-        } else {
-            id parsed = removeNull([NSJSONSerialization JSONObjectWithData:(NSData *)retobj options:NSJSONReadingMutableContainers error:nil]);
-            
-            error = [self checkError:parsed];
-            if (!error){
-                response = parsed;
+        for (NSUInteger i = 0; i < count; i++) {
+            if (pathKey && strcmp(cParams[i].key, pathKey) == 0) {
+                continue;
             }
-            if (completionBlock){
-                completionBlock(error, response);
+            
+            if (cParams[i].value) {
+                [body addString:[[NSString alloc]initWithBytes:cParams[i].value length:cParams[i].valueLength encoding:NSUTF8StringEncoding] forName:keys[i]];
+            } else {
+                [body addData:values[i] forName:keys[i] fileName:nil contentType:nil];
             }
         }
+        
+        [body applyToRequest:request];
+    } else if (built.body.length > 0) {
+        [request setValue:@"application/x-www-form-urlencoded" forHTTPHeaderField:@"Content-Type"];
+        [request setValue:@(built.body.length).stringValue forHTTPHeaderField:@"Content-Length"];
+        request.HTTPBody = [NSData dataWithBytes:built.body.data length:built.body.length];
+    }
+    
+    FHSToken *accessToken = self.accessToken;
+    FHSSigningKey *signingKey = [self signingKeyForToken:accessToken.key tokenSecret:accessToken.secret];
+    size_t headerLength = 0;
+    const char *header = fhs_endpoint_request_sign(&built, signingKey.key, &headerLength);
+    NSString *authorization = header?[[NSString alloc]initWithBytes:header length:headerLength encoding:NSUTF8StringEncoding]:nil;
+    fhs_endpoint_request_free(&built);
+    [self clearTemporaryConsumer];
+    
+    if (!authorization) {
+        return [NSError noDataError];
     }
+    
+    [request setValue:authorization forHTTPHeaderField:@"Authorization"];
+    
+    // Every table endpoint answers with JSON, so an empty or unparseable body is a failure
+    id response = [self sendAuthorizedRequest:request decodesIDs:decodesIDs];
+    return [response isKindOfClass:[NSNull class]]?[NSError noDataError]:response;
+}
+
+- (id)sendPOSTRequestForURL:(NSURL *)url body:(NSData *)body contentType:(NSString *)contentType {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:60.0f];
+    [request setHTTPMethod:@"POST"];
+    [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
+    [request setValue:@(body.length).stringValue forHTTPHeaderField:@"Content-Length"];
+    request.HTTPBody = body;
+    return [self sendSignedRequest:request];
+}
+
+- (id)sendPOSTRequestForURL:(NSURL *)url multipartBody:(FHSMultipartBody *)body {
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:60.0f];
+    [request setHTTPMethod:@"POST"];
+    [body applyToRequest:request];
+    return [self sendSignedRequest:request];
+}
+
+- (id)sendSignedRequest:(NSMutableURLRequest *)request {
+    return [self sendSignedRequest:request decodesIDs:NO];
 }
 
-- (id)sendGETRequestForURL:(NSURL *)url andParams:(NSDictionary *)params {
+- (id)sendSignedRequest:(NSMutableURLRequest *)request decodesIDs:(BOOL)decodesIDs {
     
     NSError *authError = [self checkAuth];
     
@@ -1930,39 +2186,70 @@ id removeNull(id rootObject) {
         return authError;
     }
     
-    if (params.count > 0) {
-        NSMutableArray *paramPairs = [NSMutableArray arrayWithCapacity:params.count];
-        
-        for (NSString *key in params) {
-            NSString *paramPair = [NSString stringWithFormat:@"%@=%@",[key fhs_URLEncode],[params[key] fhs_URLEncode]];
-            [paramPairs addObject:paramPair];
-        }
-        
-        url = [NSURL URLWithString:[NSString stringWithFormat:@"%@?%@",fhs_url_remove_params(url), [paramPairs componentsJoinedByString:@"&"]]];
-    }
-    
-    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:url cachePolicy:NSURLRequestReloadIgnoringCacheData timeoutInterval:30.0f];
-    [request setHTTPMethod:@"GET"];
     [request setHTTPShouldHandleCookies:NO];
     [self signRequest:request];
     
-    id retobj = [self sendRequest:request];
+    return [self sendAuthorizedRequest:request decodesIDs:decodesIDs];
+}
+
+- (id)sendAuthorizedRequest:(NSURLRequest *)request decodesIDs:(BOOL)decodesIDs {
+    NSHTTPURLResponse *response = nil;
+    NSError *error = nil;
+    
+    NSData *data = [self sendSynchronousRequest:request returningResponse:&response error:&error];
     
-    if (!retobj) {
+    if (error) {
+        return error;
+    }
+    
+    if (response == nil) {
         return [NSError noDataError];
-    } else if ([retobj isKindOfClass:[NSError class]]) {
-        return retobj;
     }
     
-    id parsed = removeNull([NSJSONSerialization JSONObjectWithData:(NSData *)retobj options:NSJSONReadingMutableContainers error:nil]);
+    [self recordRateLimitForURL:request.URL response:response];
     
-    NSError *error = [self checkError:parsed];
+    // Error responses fail to decode and take the parser below
+    if (decodesIDs && response.statusCode < 300) {
+        FHSIDList *list = [FHSIDList listWithData:data];
+        
+        if (list) {
+            return list;
+        }
+    }
+    
+    id parsed = (data.length > 0)?[self parseResponseData:data]:nil;
+    
+    error = [self checkError:parsed];
+    
+    // Unlike sendRequest:, keep the status code so callers can tell what is worth retrying
+    if (response.statusCode >= 300) {
+        NSMutableDictionary *userInfo = [NSMutableDictionary dictionaryWithObject:[NSHTTPURLResponse localizedStringForStatusCode:response.statusCode] forKey:NSLocalizedDescriptionKey];
+        
+        if (error) {
+            userInfo[@"errors"] = error.userInfo[@"errors"];
+        }
+        
+        if (response.statusCode == 429) {
+            NSDictionary *headers = response.allHeaderFields;
+            NSString *reset = headers[@"x-rate-limit-reset"]?:headers[@"X-Rate-Limit-Reset"];
+            
+            if (reset.longLongValue > 0) {
+                userInfo[FHSRateLimitResetDateKey] = [NSDate dateWithTimeIntervalSince1970:reset.longLongValue];
+            }
+        }
+        
+        return [NSError errorWithDomain:FHSErrorDomain code:response.statusCode userInfo:userInfo];
+    }
     
     if (error) {
         return error;
     }
     
-    return parsed;
+    if (parsed && [request.HTTPMethod isEqualToString:@"GET"]) {
+        [self.tweetIndex addTweetsFromResponse:parsed];
+    }
+    
+    return parsed?parsed:[NSNull null];
 }
 
 - (id)streamingRequestForURL:(NSURL *)url HTTPMethod:(NSString *)method parameters:(NSDictionary *)params {
@@ -1980,23 +2267,13 @@ id removeNull(id rootObject) {
     // Only POST and GET are relevant to the Twitter API
     
     if ([method isEqualToString:@"POST"]) {
-        NSString *boundary = [NSString fhs_UUID];
-        NSString *contentType = [NSString stringWithFormat:@"multipart/form-data; boundary=%@",boundary];
-        [request setValue:contentType forHTTPHeaderField:@"Content-Type"];
-        NSData *body = [self POSTBodyWithParams:params boundary:boundary];
+        // Form encoded so the predicates are covered by the OAuth signature
+        NSData *body = [self POSTBodyWithParams:params];
+        [request setValue:@"application/x-www-form-urlencoded" forHTTPHeaderField:@"Content-Type"];
         [request setValue:@(body.length).stringValue forHTTPHeaderField:@"Content-Length"];
         request.HTTPBody = body;
     } else if ([method isEqualToString:@"GET"]) {
-        if (params.count > 0) {
-            NSMutableArray *paramPairs = [NSMutableArray arrayWithCapacity:params.count];
-            
-            for (NSString *key in params) {
-                NSString *paramPair = [NSString stringWithFormat:@"%@=%@",[key fhs_URLEncode],[params[key] fhs_URLEncode]];
-                [paramPairs addObject:paramPair];
-            }
-            
-            url = [NSURL URLWithString:[NSString stringWithFormat:@"%@?%@",fhs_url_remove_params(url), [paramPairs componentsJoinedByString:@"&"]]];
-        }
+        request.URL = fhs_url_with_params(url, params);
     } else {
         return [NSError errorWithDomain:FHSErrorDomain code:-400 userInfo:@{}];
     }
@@ -2034,10 +2311,7 @@ id removeNull(id rootObject) {
     [request setHTTPShouldHandleCookies:NO];
     [self signRequest:request withToken:reqToken.key tokenSecret:reqToken.secret verifier:reqToken.verifier];
     
-    if (_shouldClearConsumer) {
-        self.shouldClearConsumer = NO;
-        self.consumer = nil;
-    }
+    [self clearTemporaryConsumer];
     
     id retobj = [self sendRequest:request];
     
@@ -2079,10 +2353,7 @@ id removeNull(id rootObject) {
     NSString *bodyString = [NSString stringWithFormat:@"x_auth_mode=client_auth&x_auth_username=%@&x_auth_password=%@",username,password];
     request.HTTPBody = [bodyString dataUsingEncoding:NSUTF8StringEncoding];
     
-    if (_shouldClearConsumer) {
-        self.shouldClearConsumer = NO;
-        self.consumer = nil;
-    }
+    [self clearTemporaryConsumer];
     
     id ret = [self sendRequest:request];
     
@@ -2112,8 +2383,10 @@ id removeNull(id rootObject) {
     
     if (_delegate && [_delegate respondsToSelector:@selector(loadAccessToken)]) {
         savedHttpBody = [_delegate loadAccessToken];
+    } else if (self.accessTokenStoreKey) {
+        savedHttpBody = [[NSUserDefaults standardUserDefaults]objectForKey:self.accessTokenStoreKey];
     } else {
-        savedHttpBody = [[NSUserDefaults standardUserDefaults]objectForKey:@"SavedAccessHTTPBody"];
+        return; // kept in memory only
     }
     
     self.accessToken = [FHSToken tokenWithHTTPResponseBody:savedHttpBody];
@@ -2128,8 +2401,8 @@ id removeNull(id rootObject) {
     
     if (_delegate && [_delegate respondsToSelector:@selector(storeAccessToken:)]) {
         [_delegate storeAccessToken:accessTokenZ];
-    } else {
-        [[NSUserDefaults standardUserDefaults]setObject:accessTokenZ forKey:@"SavedAccessHTTPBody"];
+    } else if (self.accessTokenStoreKey) {
+        [[NSUserDefaults standardUserDefaults]setObject:accessTokenZ forKey:self.accessTokenStoreKey];
     }
 }
 
@@ -2168,8 +2441,10 @@ id removeNull(id rootObject) {
         return NO;
     }
     
-    if (self.accessToken.key && self.accessToken.secret) {
-        if (self.accessToken.key.length > 0 && self.accessToken.secret.length > 0) {
+    FHSToken *accessToken = self.accessToken;
+    
+    if (accessToken.key && accessToken.secret) {
+        if (accessToken.key.length > 0 && accessToken.secret.length > 0) {
             return YES;
         }
     }
@@ -2188,26 +2463,38 @@ id removeNull(id rootObject) {
 }
 
 - (void)permanentlySetConsumerKey:(NSString *)consumerKey andSecret:(NSString *)consumerSecret {
-    self.shouldClearConsumer = NO;
-    self.consumer = [FHSConsumer consumerWithKey:consumerKey secret:consumerSecret];
+    @synchronized(self) {
+        self.shouldClearConsumer = NO;
+        self.consumer = [FHSConsumer consumerWithKey:consumerKey secret:consumerSecret];
+    }
 }
 
 - (void)temporarilySetConsumerKey:(NSString *)consumerKey andSecret:(NSString *)consumerSecret {
-    self.shouldClearConsumer = YES;
-    self.consumer = [FHSConsumer consumerWithKey:consumerKey secret:consumerSecret];
+    @synchronized(self) {
+        self.shouldClearConsumer = YES;
+        self.consumer = [FHSConsumer consumerWithKey:consumerKey secret:consumerSecret];
+    }
 }
 
+#if FHS_UIKIT
+
 - (UIViewController *)loginController {
-    return [[FHSTwitterEngineController alloc]init]; // It's legit because this project is ARC only.
+    FHSTwitterEngineController *vc = [[FHSTwitterEngineController alloc]init]; // It's legit because this project is ARC only.
+    vc.engine = self;
+    return vc;
 }
 
 - (UIViewController *)loginControllerWithCompletionHandler:(void(^)(BOOL success))block {
     FHSTwitterEngineController *vc = [[FHSTwitterEngineController alloc]init];
+    vc.engine = self;
     objc_setAssociatedObject(vc, "FHSTwitterEngineOAuthCompletion", block, OBJC_ASSOCIATION_COPY_NONATOMIC);
     return vc;
 }
 
+#endif
+
 + (BOOL)isConnectedToInternet {
+#if defined(__APPLE__)
     struct sockaddr_in zeroAddress;
     bzero(&zeroAddress, sizeof(zeroAddress));
     zeroAddress.sin_len = sizeof(zeroAddress);
@@ -2243,6 +2530,27 @@ id removeNull(id rootObject) {
         
     }
     return NO;
+#else
+    // Without reachability, settle for an interface other than loopback being up
+    struct ifaddrs *interfaces = NULL;
+    BOOL connected = NO;
+    
+    if (getifaddrs(&interfaces) != 0) {
+        return NO;
+    }
+    
+    for (struct ifaddrs *interface = interfaces; interface; interface = interface->ifa_next) {
+        if (interface->ifa_addr && (interface->ifa_flags & IFF_UP) && (interface->ifa_flags & IFF_RUNNING) && !(interface->ifa_flags & IFF_LOOPBACK)) {
+            if (interface->ifa_addr->sa_family == AF_INET || interface->ifa_addr->sa_family == AF_INET6) {
+                connected = YES;
+                break;
+            }
+        }
+    }
+    
+    freeifaddrs(interfaces);
+    return connected;
+#endif
 }
 
 - (void)cancelTouched:(NSNotification *)notification {
@@ -2254,10 +2562,13 @@ id removeNull(id rootObject) {
 - (void)dealloc {
     [self setDelegate:nil];
     [[NSNotificationCenter defaultCenter]removeObserver:self];
+    [_session finishTasksAndInvalidate];
 }
 
 @end
 
+#if FHS_UIKIT
+
 @implementation FHSTwitterEngineController
 
 - (void)loadView {
@@ -2301,7 +2612,7 @@ id removeNull(id rootObject) {
     
     dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
         @autoreleasepool {
-            NSString *reqString = [[FHSTwitterEngine sharedEngine]getRequestTokenString];
+            NSString *reqString = [_engine getRequestTokenString];
             
             if (reqString.length == 0) {
                 double delayInSeconds = 0.5;
@@ -2327,7 +2638,7 @@ id removeNull(id rootObject) {
 
 - (void)gotPin:(NSString *)pin {
     _requestToken.verifier = pin;
-    BOOL ret = [[FHSTwitterEngine sharedEngine]finishAuthWithRequestToken:_requestToken];
+    BOOL ret = [_engine finishAuthWithRequestToken:_requestToken];
     
     void(^block)(BOOL success) = objc_getAssociatedObject(self, "FHSTwitterEngineOAuthCompletion");
     
@@ -2423,7 +2734,7 @@ id removeNull(id rootObject) {
 
 - (void)close {
     [self dismissViewControllerAnimated:YES completion:^(void){
-        [[NSNotificationCenter defaultCenter] postNotificationName:@"FHSTwitterEngineControllerDidCancel" object:nil userInfo:nil];
+        [[NSNotificationCenter defaultCenter] postNotificationName:@"FHSTwitterEngineControllerDidCancel" object:_engine userInfo:nil];
     }];
 }
 
@@ -2438,3 +2749,5 @@ id removeNull(id rootObject) {
 }
 
 @end
+
+#endif
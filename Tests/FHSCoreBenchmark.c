@@ -0,0 +1,508 @@
+//
+//  FHSCoreBenchmark.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Benchmarks of the headless C core on synthetic data. Run with make bench.
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "FHSBase64.h"
+#include "FHSEndpoint.h"
+#include "FHSIDDecoder.h"
+#include "FHSJSON.h"
+#include "FHSPercentEncoding.h"
+#include "FHSRequest.h"
+#include "FHSSHA1.h"
+#include "FHSStreamParser.h"
+#include "FHSTextIndex.h"
+
+static double now(void) {
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return time.tv_sec+time.tv_nsec/1e9;
+}
+
+static uint64_t random_state = 88172645463325252ULL;
+
+static uint64_t next_random(void) {
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 7;
+    random_state ^= random_state << 17;
+    return random_state;
+}
+
+static void report(const char *name, double seconds, size_t operations, size_t bytes) {
+    printf("%-32s %10.0f ns/op", name, seconds/operations*1e9);
+
+    if (bytes > 0) {
+        printf(" %10.1f MB/s", bytes/seconds/1e6);
+    }
+
+    printf("\n");
+}
+
+static const char *words[] = {
+    "apple", "new", "york", "today", "the", "and", "phone", "launch", "#wwdc", "@apple",
+    "music", "watch", "price", "review", "live", "video", "update", "beta", "swift", "code"
+};
+
+// Timeline-like JSON of count tweets
+static char *make_timeline(size_t count, size_t *length) {
+    size_t capacity = count*512+16;
+    char *json = malloc(capacity);
+    size_t offset = 0;
+
+    json[offset++] = '[';
+
+    for (size_t i = 0; i < count; i++) {
+        uint64_t identifier = 1050118621198921728ULL+i*4096;
+        offset += snprintf(json+offset, capacity-offset, "%s{\"created_at\":\"Wed Oct 10 20:19:24 +0000 2018\",\"id\":%llu,\"id_str\":\"%llu\",\"text\":\"%s %s %s %s %s\",\"truncated\":false,\"user\":{\"id\":%llu,\"id_str\":\"%llu\",\"name\":\"User %zu\",\"screen_name\":\"user%zu\",\"followers_count\":%zu,\"verified\":false},\"retweet_count\":%zu,\"favorited\":false,\"geo\":null,\"lang\":\"en\"}",
+            (i > 0)?",":"", (unsigned long long)identifier, (unsigned long long)identifier,
+            words[i%20], words[(i*7)%20], words[(i*3)%20], words[(i*11)%20], words[(i*13)%20],
+            (unsigned long long)(i*31), (unsigned long long)(i*31), i, i, i*17, i%50);
+    }
+
+    json[offset++] = ']';
+    json[offset] = '\0';
+    *length = offset;
+    return json;
+}
+
+static void bench_signing(void) {
+    fhs_oauth_key *key = fhs_oauth_key_create("xvz1evFS4wEEPTGEFPHBog", "kAcSOqF21Fu85e7zjz7ZN2U4ZRhfV3WpwPAoE3Z7kBw", "370773112-GmHxMAgYyLbNEtIKZeRNFsMKPR9EyMZeS9weJAEb", "LswwdoUaIvS8ltyTt5jkRh4J50vUPVVHtR2YPi5kE");
+    fhs_request_param params[] = {
+        { "screen_name", 11, "twitterapi", 10 },
+        { "count", 5, "200", 3 },
+        { "since_id", 8, "1050118621198921728", 19 },
+        { "include_entities", 16, "true", 4 }
+    };
+    const char *base = "https://api.twitter.com/1.1/statuses/user_timeline.json";
+    size_t iterations = 200000;
+    size_t headerLength = 0;
+    fhs_request_buffer url = {0};
+
+    double start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        url.length = 0;
+        fhs_request_build_url(&url, base, strlen(base), params, 4);
+        fhs_request_sign(key, "GET", url.data, url.length, NULL, 0, &headerLength);
+    }
+
+    report("build url and sign", now()-start, iterations, 0);
+
+    // Same request from the endpoint table, schema check included
+    const fhs_endpoint *endpoint = fhs_endpoint_get(FHSEndpointStatusesUserTimeline);
+    fhs_endpoint_request request;
+    memset(&request, 0, sizeof(request));
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_endpoint_request_build(&request, endpoint, params, 4, 0);
+        fhs_endpoint_request_sign(&request, key, &headerLength);
+    }
+
+    report("endpoint build and sign", now()-start, iterations, 0);
+
+    // The halves apart: the table trades a schema check in the build for a
+    // precomputed signing prefix; sorting and encoding the parameters is shared
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        url.length = 0;
+        fhs_request_build_url(&url, base, strlen(base), params, 4);
+    }
+
+    report("  build url", now()-start, iterations, 0);
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_endpoint_request_build(&request, endpoint, params, 4, 0);
+    }
+
+    report("  endpoint build", now()-start, iterations, 0);
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_request_sign(key, "GET", url.data, url.length, NULL, 0, &headerLength);
+    }
+
+    report("  sign", now()-start, iterations, 0);
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_endpoint_request_sign(&request, key, &headerLength);
+    }
+
+    report("  endpoint sign", now()-start, iterations, 0);
+
+    // Signing alone: a prepared request with a fixed nonce and timestamp
+    fhs_oauth_request signRequest = {0};
+    signRequest.method = "GET";
+    signRequest.url = url.data;
+    signRequest.urlLength = url.length;
+    signRequest.nonce = "kYjzVBB8Y0ZFabxSWbWovY3uYSQ2pTgmZeNu2VS4cg";
+    signRequest.timestamp = 1318622958;
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_oauth_sign(key, &signRequest, &headerLength);
+    }
+
+    double seconds = now()-start;
+    report("oauth sign", seconds, iterations, 0);
+    printf("%-32s %10.0f signatures/s\n", "", iterations/seconds);
+    fhs_request_buffer_free(&url);
+    fhs_endpoint_request_free(&request);
+    fhs_oauth_key_free(key);
+}
+
+// One OAuth signature: HMAC of a signature base string under a pre-keyed context
+static void bench_hmac(void) {
+    static const FHSSHA1Backend backends[] = { FHSSHA1BackendPortable, FHSSHA1BackendDetected };
+    const char *base = "GET&https%3A%2F%2Fapi.twitter.com%2F1.1%2Fstatuses%2Fuser_timeline.json&count%3D200%26include_entities%3Dtrue%26oauth_consumer_key%3Dxvz1evFS4wEEPTGEFPHBog%26oauth_nonce%3DkYjzVBB8Y0ZFabxSWbWovY3uYSQ2pTgmZeNu2VS4cg%26oauth_signature_method%3DHMAC-SHA1%26oauth_timestamp%3D1318622958%26oauth_token%3D370773112-GmHxMAgYyLbNEtIKZeRNFsMKPR9EyMZeS9weJAEb%26oauth_version%3D1.0%26screen_name%3Dtwitterapi%26since_id%3D1050118621198921728";
+    size_t length = strlen(base);
+    size_t iterations = 500000;
+    const void *messages[16];
+    size_t lengths[16];
+    uint8_t digests[16][FHS_SHA1_DIGEST_LENGTH];
+
+    for (size_t i = 0; i < 16; i++) {
+        messages[i] = base;
+        lengths[i] = length;
+    }
+
+    fhs_hmac_sha1_ctx key;
+    const char *signingKey = "kAcSOqF21Fu85e7zjz7ZN2U4ZRhfV3WpwPAoE3Z7kBw&LswwdoUaIvS8ltyTt5jkRh4J50vUPVVHtR2YPi5kE";
+    fhs_hmac_sha1_init(&key, signingKey, strlen(signingKey));
+
+    for (size_t b = 0; b < 2; b++) {
+        char name[64];
+        fhs_sha1_use_backend(backends[b]);
+
+        double start = now();
+
+        for (size_t i = 0; i < iterations; i++) {
+            fhs_hmac_sha1_ctx ctx = key;
+            fhs_hmac_sha1_update(&ctx, base, length);
+            fhs_hmac_sha1_final(&ctx, digests[0]);
+        }
+
+        snprintf(name, sizeof(name), "hmac signature, %s", fhs_sha1_backend_name());
+        report(name, now()-start, iterations, 0);
+
+        start = now();
+
+        for (size_t i = 0; i < iterations; i += 16) {
+            fhs_hmac_sha1_batch(&key, messages, lengths, 16, digests);
+        }
+
+        snprintf(name, sizeof(name), "hmac batch of 16, %s", fhs_sha1_backend_name());
+        report(name, now()-start, iterations, 0);
+    }
+}
+
+// The encoder -[NSData base64Encode] had before the kernels: a byte-at-a-time
+// state machine into a malloc'd buffer, copied again into the string
+static char *legacy_base64_encode(const uint8_t *data, size_t length) {
+    static char const Encode[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t outLength = ((((length*4)/3)/4)*4)+(((length*4)/3)%4?4:0);
+    const char *inputBuffer = (const char *)data;
+    char *outputBuffer = malloc(outLength+1);
+    outputBuffer[outLength] = 0;
+
+    int cycle = 0;
+    size_t inpos = 0;
+    size_t outpos = 0;
+    char temp = 0;
+
+    outputBuffer[outLength-1] = '=';
+    outputBuffer[outLength-2] = '=';
+
+    while (inpos < length) {
+        switch (cycle) {
+            case 0:
+                outputBuffer[outpos++] = Encode[(inputBuffer[inpos]&0xFC)>>2];
+                cycle = 1;
+                break;
+            case 1:
+                temp = (inputBuffer[inpos++]&0x03)<<4;
+                outputBuffer[outpos] = Encode[(int)temp];
+                cycle = 2;
+                break;
+            case 2:
+                outputBuffer[outpos++] = Encode[temp|(inputBuffer[inpos]&0xF0)>>4];
+                temp = (inputBuffer[inpos++]&0x0F)<<2;
+                outputBuffer[outpos] = Encode[(int)temp];
+                cycle = 3;
+                break;
+            case 3:
+                outputBuffer[outpos++] = Encode[temp|(inputBuffer[inpos]&0xC0)>>6];
+                cycle = 4;
+                break;
+            case 4:
+                outputBuffer[outpos++] = Encode[inputBuffer[inpos++]&0x3f];
+                cycle = 0;
+                break;
+            default:
+                cycle = 0;
+                break;
+        }
+    }
+
+    char *string = strdup(outputBuffer);
+    free(outputBuffer);
+    return string;
+}
+
+static void bench_encoding(void) {
+    static const FHSBase64Backend backends[] = { FHSBase64BackendScalar, FHSBase64BackendSSSE3, FHSBase64BackendAVX2, FHSBase64BackendNEON };
+    size_t length = 1 << 20;
+    uint8_t *data = malloc(length);
+    char *out = malloc(fhs_base64_encoded_length(length)+length*3);
+    uint8_t *decoded = malloc(length);
+    size_t encodedLength = 0;
+    size_t decodedLength = 0;
+    size_t iterations = 50;
+    char name[64];
+
+    for (size_t i = 0; i < length; i++) {
+        data[i] = (uint8_t)next_random();
+    }
+
+    double start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        free(legacy_base64_encode(data, length));
+    }
+
+    report("base64 encode 1 MB, legacy", now()-start, iterations, length*iterations);
+
+    for (size_t b = 0; b < sizeof(backends)/sizeof(backends[0]); b++) {
+        if (fhs_base64_use_backend(backends[b]) != 0) {
+            continue;
+        }
+
+        start = now();
+
+        for (size_t i = 0; i < iterations; i++) {
+            encodedLength = fhs_base64_encode(data, length, out);
+        }
+
+        snprintf(name, sizeof(name), "base64 encode 1 MB, %s", fhs_base64_backend_name());
+        report(name, now()-start, iterations, length*iterations);
+
+        start = now();
+
+        for (size_t i = 0; i < iterations; i++) {
+            fhs_base64_decode(out, encodedLength, decoded, &decodedLength);
+        }
+
+        snprintf(name, sizeof(name), "base64 decode 1 MB, %s", fhs_base64_backend_name());
+        report(name, now()-start, iterations, length*iterations);
+    }
+
+    fhs_base64_use_backend(FHSBase64BackendDetected);
+    free(decoded);
+
+    for (size_t i = 0; i < length; i++) {
+        data[i] = (uint8_t)"abcdefgh ijk+/-_~"[i%17];
+    }
+
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_percent_encode((const char *)data, length, out);
+    }
+
+    report("percent encode 1 MB", now()-start, iterations, length*iterations);
+
+    uint8_t digest[FHS_SHA1_DIGEST_LENGTH];
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_sha1(data, length, digest);
+    }
+
+    report("sha1 1 MB", now()-start, iterations, length*iterations);
+
+    free(data);
+    free(out);
+}
+
+static int count_event(void *context) {
+    (*(size_t *)context)++;
+    return 0;
+}
+
+static void bench_json(void) {
+    size_t length = 0;
+    char *timeline = make_timeline(200, &length);
+    size_t iterations = 500;
+    size_t objects = 0;
+    fhs_json_callbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    callbacks.begin_object = count_event;
+
+    double start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_json_parse((const uint8_t *)timeline, length, &callbacks, &objects, NULL);
+    }
+
+    report("parse 200 tweet timeline", now()-start, iterations, length*iterations);
+
+    fhs_json_member *members = malloc(256*sizeof(fhs_json_member));
+    size_t count = 0;
+    start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_json_index((const uint8_t *)timeline, length, members, 256, &count, NULL);
+    }
+
+    report("index 200 tweet timeline", now()-start, iterations, length*iterations);
+
+    free(members);
+    free(timeline);
+}
+
+static void bench_ids(void) {
+    size_t count = 5000;
+    size_t capacity = count*24+64;
+    char *json = malloc(capacity);
+    size_t length = (size_t)snprintf(json, capacity, "{\"ids\":[");
+
+    for (size_t i = 0; i < count; i++) {
+        length += (size_t)snprintf(json+length, capacity-length, "%s\"%llu\"", (i > 0)?",":"", (unsigned long long)(next_random() >> 1));
+    }
+
+    length += (size_t)snprintf(json+length, capacity-length, "],\"next_cursor\":1374004777531007833,\"previous_cursor\":0}");
+
+    fhs_id_list list;
+    memset(&list, 0, sizeof(list));
+    size_t iterations = 500;
+    double start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        list.count = 0;
+        fhs_id_list_decode((const uint8_t *)json, length, &list, NULL);
+    }
+
+    report("decode 5000 string ids", now()-start, iterations, length*iterations);
+
+    free(list.ids);
+    free(json);
+}
+
+static int count_message(void *context, const char *message, size_t length) {
+    (void)message;
+    *(size_t *)context += length;
+    return 0;
+}
+
+static void bench_stream(void) {
+    size_t tweetLength = 0;
+    char *tweet = make_timeline(1, &tweetLength);
+    size_t messages = 20000;
+    char *stream = malloc(messages*(tweetLength+16));
+    size_t length = 0;
+
+    // Strip the array brackets, one tweet per message with keep-alives between
+    for (size_t i = 0; i < messages; i++) {
+        length += (size_t)sprintf(stream+length, "%zu\r\n", tweetLength);
+        memcpy(stream+length, tweet+1, tweetLength-2);
+        length += tweetLength-2;
+        memcpy(stream+length, "\r\n", 2);
+        length += 2;
+
+        if (i%50 == 0) {
+            memcpy(stream+length, "\r\n", 2);
+            length += 2;
+        }
+    }
+
+    size_t delivered = 0;
+    size_t iterations = 20;
+    double start = now();
+
+    for (size_t i = 0; i < iterations; i++) {
+        fhs_stream_parser parser;
+        fhs_stream_parser_init(&parser, 0, count_message, &delivered);
+
+        // Reads of 16 KB, so messages span them
+        for (size_t offset = 0; offset < length; offset += 16384) {
+            fhs_stream_parser_feed(&parser, (const uint8_t *)stream+offset, (length-offset < 16384)?length-offset:16384);
+        }
+
+        fhs_stream_parser_free(&parser);
+    }
+
+    report("frame stream, per message", now()-start, messages*iterations, 0);
+    report("frame stream", now()-start, iterations, length*iterations);
+
+    free(stream);
+    free(tweet);
+}
+
+static void bench_text_index(void) {
+    fhs_text_index_builder *builder = fhs_text_index_builder_create();
+    size_t tweets = 100000;
+    char text[256];
+
+    for (size_t i = 0; i < tweets; i++) {
+        size_t length = 0;
+
+        for (size_t word = 0; word < 12; word++) {
+            length += (size_t)sprintf(text+length, "%s%s", (word > 0)?" ":"", words[next_random()%20]);
+        }
+
+        fhs_text_index_builder_add(builder, 1050118621198921728ULL+i*4096, text, length);
+    }
+
+    uint8_t *segmentData = NULL;
+    size_t segmentLength = 0;
+    fhs_text_index_segment segment;
+    fhs_text_index_builder_write(builder, &segmentData, &segmentLength);
+    fhs_text_index_segment_open(&segment, segmentData, segmentLength);
+
+    const char *queries[] = { "apple", "\"new york\"", "swift OR beta", "#wwdc @apple launch" };
+    size_t iterations = 200;
+
+    for (size_t q = 0; q < 4; q++) {
+        uint64_t *ids = NULL;
+        size_t count = 0;
+        char name[64];
+        double start = now();
+
+        for (size_t i = 0; i < iterations; i++) {
+            fhs_text_index_search(&segment, 1, NULL, queries[q], strlen(queries[q]), 0, 0, 100, &ids, &count);
+            free(ids);
+        }
+
+        snprintf(name, sizeof(name), "search %s", queries[q]);
+        report(name, now()-start, iterations, 0);
+    }
+
+    free(segmentData);
+    fhs_text_index_builder_free(builder);
+}
+
+int main(void) {
+    printf("sha1 %s, base64 %s\n", fhs_sha1_backend_name(), fhs_base64_backend_name());
+    bench_signing();
+    bench_hmac();
+    bench_encoding();
+    bench_json();
+    bench_ids();
+    bench_stream();
+    bench_text_index();
+    return 0;
+}
@@ -0,0 +1,1000 @@
+//
+//  FHSCoreTests.c
+//  FHSTwitterEngine
+//
+//  Copyright (c) 2026 FHSTwitterEngine contributors.
+//
+//  Tests of the headless C core. Run with make test.
+//
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "FHSBase64.h"
+#include "FHSEndpoint.h"
+#include "FHSIDDecoder.h"
+#include "FHSIDSet.h"
+#include "FHSJSON.h"
+#include "FHSMediaProbe.h"
+#include "FHSNonce.h"
+#include "FHSOAuthSigner.h"
+#include "FHSPercentEncoding.h"
+#include "FHSRequest.h"
+#include "FHSSHA1.h"
+#include "FHSSnowflake.h"
+#include "FHSStreamParser.h"
+#include "FHSTextIndex.h"
+#include "FHSTimestamp.h"
+
+static int failures = 0;
+static int checks = 0;
+
+#define CHECK(condition) do { \
+    checks++; \
+    if (!(condition)) { \
+        failures++; \
+        fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+    } \
+} while (0)
+
+static void hex(const uint8_t *bytes, size_t length, char *out) {
+    for (size_t i = 0; i < length; i++) {
+        sprintf(out+i*2, "%02x", bytes[i]);
+    }
+}
+
+//
+// Hashing and encoding
+//
+
+// RFC 2202 HMAC-SHA1 test cases
+static void test_hmac_sha1_vectors(void) {
+    static const char *digests[] = {
+        "b617318655057264e28bc0b6fb378c8ef146be00",
+        "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79",
+        "125d7342b9ac11cd91a39af48aa17b4f63f175d3",
+        "4c9007f4026250c6bc8414f9bf50c86c2d7235da",
+        "4c1a03424b55e07fe7f27be1d58bb9324a9a5a04",
+        "aa4ae5e15272d00e95705637ce8a3b55ed402112",
+        "e8e99d0f45237d786d6bbaa7965c7808bbff1a91"
+    };
+    uint8_t keys[7][80];
+    size_t keyLengths[7] = { 20, 4, 20, 25, 20, 80, 80 };
+    uint8_t dd[50], cd[50];
+    const void *data[7] = { "Hi There", "what do ya want for nothing?", dd, cd, "Test With Truncation",
+        "Test Using Larger Than Block-Size Key - Hash Key First", "Test Using Larger Than Block-Size Key and Larger Than One Block-Size Data" };
+    size_t dataLengths[7] = { 8, 28, 50, 50, 20, 54, 73 };
+
+    memset(keys[0], 0x0b, 20);
+    memcpy(keys[1], "Jefe", 4);
+    memset(keys[2], 0xaa, 20);
+    for (int i = 0; i < 25; i++) {
+        keys[3][i] = (uint8_t)(i+1);
+    }
+    memset(keys[4], 0x0c, 20);
+    memset(keys[5], 0xaa, 80);
+    memset(keys[6], 0xaa, 80);
+    memset(dd, 0xdd, sizeof(dd));
+    memset(cd, 0xcd, sizeof(cd));
+
+    for (int i = 0; i < 7; i++) {
+        uint8_t digest[FHS_SHA1_DIGEST_LENGTH];
+        char text[FHS_SHA1_DIGEST_LENGTH*2+1];
+
+        fhs_hmac_sha1(keys[i], keyLengths[i], data[i], dataLengths[i], digest);
+        hex(digest, sizeof(digest), text);
+        CHECK(strcmp(text, digests[i]) == 0);
+
+        // Same through a batch of one
+        fhs_hmac_sha1_ctx key;
+        fhs_hmac_sha1_init(&key, keys[i], keyLengths[i]);
+        fhs_hmac_sha1_batch(&key, &data[i], &dataLengths[i], 1, &digest);
+        hex(digest, sizeof(digest), text);
+        CHECK(strcmp(text, digests[i]) == 0);
+    }
+}
+
+// Batches of every size up to two full passes plus one, lengths around the block boundaries
+static void test_hmac_sha1_batch(void) {
+    static uint8_t data[9][300];
+    const void *messages[9];
+    size_t lengths[9];
+    static const size_t lengthChoices[] = { 0, 1, 55, 56, 63, 64, 65, 119, 120, 200, 299 };
+
+    for (size_t m = 0; m < 9; m++) {
+        for (size_t i = 0; i < sizeof(data[m]); i++) {
+            data[m][i] = (uint8_t)(m*37+i*11);
+        }
+        messages[m] = data[m];
+    }
+
+    fhs_hmac_sha1_ctx key;
+    const char *signingKey = "kAcSOqF21Fu85e7zjz7ZN2U4ZRhfV3WpwPAoE3Z7kBw&LswwdoUaIvS8ltyTt5jkRh4J50vUPVVHtR2YPi5kE";
+    fhs_hmac_sha1_init(&key, signingKey, strlen(signingKey));
+
+    for (size_t count = 1; count <= 9; count++) {
+        uint8_t digests[9][FHS_SHA1_DIGEST_LENGTH];
+        int matched = 1;
+
+        for (size_t m = 0; m < count; m++) {
+            lengths[m] = lengthChoices[(m*3+count)%(sizeof(lengthChoices)/sizeof(lengthChoices[0]))];
+        }
+
+        fhs_hmac_sha1_batch(&key, messages, lengths, count, digests);
+
+        for (size_t m = 0; m < count; m++) {
+            uint8_t digest[FHS_SHA1_DIGEST_LENGTH];
+            fhs_hmac_sha1_ctx ctx = key;
+            fhs_hmac_sha1_update(&ctx, messages[m], lengths[m]);
+            fhs_hmac_sha1_final(&ctx, digest);
+            matched &= (memcmp(digest, digests[m], sizeof(digest)) == 0);
+        }
+
+        CHECK(matched);
+    }
+}
+
+static void test_sha1(void) {
+    static const FHSSHA1Backend backends[] = { FHSSHA1BackendPortable, FHSSHA1BackendSHANI, FHSSHA1BackendARMv8 };
+
+    // Every backend this build and CPU have, the portable one included
+    for (size_t b = 0; b < sizeof(backends)/sizeof(backends[0]); b++) {
+        if (fhs_sha1_use_backend(backends[b]) != 0) {
+            continue;
+        }
+
+        uint8_t digest[FHS_SHA1_DIGEST_LENGTH];
+        char text[FHS_SHA1_DIGEST_LENGTH*2+1];
+
+        fhs_sha1("abc", 3, digest);
+        hex(digest, sizeof(digest), text);
+        CHECK(strcmp(text, "a9993e364706816aba3e25717850c26c9cd0d89d") == 0);
+
+        // Incremental updates across block boundaries match the one-shot digest
+        uint8_t data[1000];
+        uint8_t oneShot[FHS_SHA1_DIGEST_LENGTH];
+
+        for (size_t i = 0; i < sizeof(data); i++) {
+            data[i] = (uint8_t)(i*7);
+        }
+
+        fhs_sha1(data, sizeof(data), oneShot);
+
+        fhs_sha1_ctx ctx;
+        fhs_sha1_init(&ctx);
+
+        for (size_t offset = 0, step = 1; offset < sizeof(data); offset += step, step = step%63+1) {
+            fhs_sha1_update(&ctx, data+offset, (offset+step < sizeof(data))?step:sizeof(data)-offset);
+        }
+
+        fhs_sha1_final(&ctx, digest);
+        CHECK(memcmp(digest, oneShot, sizeof(digest)) == 0);
+
+        test_hmac_sha1_vectors();
+        test_hmac_sha1_batch();
+    }
+
+    CHECK(fhs_sha1_use_backend(FHSSHA1BackendDetected) == 0);
+}
+
+// Runs with whichever kernels are in use, checked against the scalar encoding
+static void test_base64_kernels(const uint8_t *data, size_t dataLength, const char *reference, size_t referenceLength) {
+    static const char *plain[] = { "", "f", "fo", "foo", "foob", "fooba", "foobar" };
+    static const char *encoded[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==", "Zm9vYmE=", "Zm9vYmFy" };
+    static char out[65536];
+    static uint8_t decoded[49152];
+    size_t decodedLength;
+
+    for (size_t i = 0; i < sizeof(plain)/sizeof(plain[0]); i++) {
+        size_t length = fhs_base64_encode(plain[i], strlen(plain[i]), out);
+        CHECK(length == strlen(encoded[i]) && memcmp(out, encoded[i], length) == 0);
+        CHECK(fhs_base64_decode(encoded[i], strlen(encoded[i]), decoded, &decodedLength) == 0);
+        CHECK(decodedLength == strlen(plain[i]) && memcmp(decoded, plain[i], decodedLength) == 0);
+    }
+
+    CHECK(fhs_base64_decode("Zm9v!", 5, decoded, &decodedLength) != 0);
+
+    // Round trips of 1 KB and up with every tail length, padded and not
+    int matched = 1;
+
+    for (size_t base = 1024; base <= 32768; base *= 32) {
+        for (size_t tail = 0; tail < 64; tail++) {
+            size_t length = base+tail;
+            size_t encodedLength = fhs_base64_encode(data, length, out);
+            size_t unpadded = encodedLength;
+
+            matched &= (encodedLength == fhs_base64_encoded_length(length));
+            matched &= (length*4/3 <= referenceLength && memcmp(out, reference, length/3*4) == 0);
+            matched &= (fhs_base64_decode(out, encodedLength, decoded, &decodedLength) == 0 && decodedLength == length && memcmp(decoded, data, length) == 0);
+
+            while (unpadded > 0 && out[unpadded-1] == '=') {
+                unpadded--;
+            }
+
+            matched &= (fhs_base64_decode(out, unpadded, decoded, &decodedLength) == 0 && decodedLength == length && memcmp(decoded, data, length) == 0);
+        }
+    }
+
+    CHECK(matched);
+
+    size_t encodedLength = fhs_base64_encode(data, dataLength, out);
+    CHECK(encodedLength == referenceLength && memcmp(out, reference, referenceLength) == 0);
+
+    // A bad character or stray padding anywhere, vector blocks included, fails the whole decode
+    static const char bad[] = { '!', '-', '_', ' ', '\n', '=', '\0', (char)0x80, (char)0xFF };
+    static const size_t positions[] = { 0, 1, 15, 16, 17, 31, 32, 47, 48, 63, 64, 100, 1000, 4095, 4096 };
+    int rejected = 1;
+
+    for (size_t p = 0; p < sizeof(positions)/sizeof(positions[0]); p++) {
+        for (size_t b = 0; b < sizeof(bad); b++) {
+            char saved = out[positions[p]];
+            out[positions[p]] = bad[b];
+            rejected &= (fhs_base64_decode(out, encodedLength, decoded, &decodedLength) != 0);
+            out[positions[p]] = saved;
+        }
+    }
+
+    CHECK(rejected);
+    CHECK(fhs_base64_decode(out, encodedLength, decoded, &decodedLength) == 0 && decodedLength == dataLength);
+
+    // The stream encoder matches the one-shot encoder whatever the chunking
+    static char streamed[65536];
+    fhs_base64_stream stream;
+    fhs_base64_stream_init(&stream);
+    size_t streamedLength = 0;
+
+    for (size_t offset = 0, step = 1; offset < 4099; offset += step, step = step%97+1) {
+        size_t chunk = (offset+step < 4099)?step:4099-offset;
+        streamedLength += fhs_base64_stream_update(&stream, data+offset, chunk, streamed+streamedLength);
+    }
+
+    streamedLength += fhs_base64_stream_final(&stream, streamed+streamedLength);
+    CHECK(streamedLength == fhs_base64_encoded_length(4099) && memcmp(streamed, reference, streamedLength-4) == 0);
+}
+
+static void test_base64(void) {
+    static const FHSBase64Backend backends[] = { FHSBase64BackendSSSE3, FHSBase64BackendAVX2, FHSBase64BackendNEON };
+    static uint8_t data[32768+64];
+    static char reference[(sizeof(data)+2)/3*4];
+
+    for (size_t i = 0; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(i*31+7+(i >> 8));
+    }
+
+    CHECK(fhs_base64_use_backend(FHSBase64BackendScalar) == 0);
+    size_t referenceLength = fhs_base64_encode(data, sizeof(data), reference);
+    test_base64_kernels(data, sizeof(data), reference, referenceLength);
+
+    for (size_t b = 0; b < sizeof(backends)/sizeof(backends[0]); b++) {
+        if (fhs_base64_use_backend(backends[b]) == 0) {
+            test_base64_kernels(data, sizeof(data), reference, referenceLength);
+        }
+    }
+
+    CHECK(fhs_base64_use_backend(FHSBase64BackendDetected) == 0);
+}
+
+// Byte at a time straight from the table, the reference for the vector fast path
+static size_t percent_encode_reference(const char *src, size_t length, char *dst) {
+    static const char digits[] = "0123456789ABCDEF";
+    size_t out = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = (uint8_t)src[i];
+        if (fhs_percent_unreserved[c]) {
+            dst[out++] = (char)c;
+        } else {
+            dst[out++] = '%';
+            dst[out++] = digits[c >> 4];
+            dst[out++] = digits[c & 0x0F];
+        }
+    }
+
+    return out;
+}
+
+// Encodes src and compares against the reference and the length function
+static int percent_encoding_matches(const char *src, size_t length) {
+    static char out[3*4096], expected[3*4096];
+    memset(out, 0, 3*length);
+    size_t written = fhs_percent_encode(src, length, out);
+    size_t expectedLength = percent_encode_reference(src, length, expected);
+    return written == expectedLength && fhs_percent_encoded_length(src, length) == written && memcmp(out, expected, written) == 0;
+}
+
+static void test_percent_encoding(void) {
+    const char *text = "Ladies + Gentlemen, caf\xc3\xa9~";
+    char out[128];
+    size_t length = fhs_percent_encode(text, strlen(text), out);
+    out[length] = '\0';
+    CHECK(strcmp(out, "Ladies%20%2B%20Gentlemen%2C%20caf%C3%A9~") == 0);
+    CHECK(fhs_percent_encoded_length(text, strlen(text)) == length);
+
+    // The table is exactly RFC 3986 unreserved
+    const char *unreserved = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-._~";
+    int tableErrors = 0;
+    for (int c = 0; c < 256; c++) {
+        tableErrors += (fhs_percent_unreserved[c] != 0) != (c != 0 && strchr(unreserved, c) != NULL);
+    }
+    CHECK(tableErrors == 0);
+
+    // Long unreserved runs, every length up to a few blocks and one over 1 KB
+    char buffer[4096];
+    size_t unreservedLength = strlen(unreserved);
+    for (size_t i = 0; i < sizeof(buffer); i++) {
+        buffer[i] = unreserved[i%unreservedLength];
+    }
+
+    int runErrors = 0;
+    for (size_t n = 0; n <= 100; n++) {
+        runErrors += !percent_encoding_matches(buffer, n);
+    }
+    runErrors += !percent_encoding_matches(buffer, sizeof(buffer));
+    CHECK(runErrors == 0);
+    CHECK(fhs_percent_encoded_length(buffer, sizeof(buffer)) == sizeof(buffer));
+
+    // Reserved bytes just before, at and after the first block boundary, and one pair straddling it
+    const size_t offsets[] = { 0, 14, 15, 16, 17, 31, 32, 33, 47, 48 };
+    for (size_t o = 0; o < sizeof(offsets)/sizeof(offsets[0]); o++) {
+        char mixed[64];
+        memcpy(mixed, buffer, sizeof(mixed));
+        mixed[offsets[o]] = ' ';
+        CHECK(percent_encoding_matches(mixed, sizeof(mixed)));
+    }
+
+    char straddle[64];
+    memcpy(straddle, buffer, sizeof(straddle));
+    straddle[15] = '/';
+    straddle[16] = '&';
+    CHECK(percent_encoding_matches(straddle, sizeof(straddle)));
+
+    // Every byte value at every position of three blocks, to catch range edges like '@', '[', '`', '{' and 0x7F+
+    int byteErrors = 0;
+    for (int c = 0; c < 256; c++) {
+        for (size_t position = 0; position < 48; position++) {
+            char block[48];
+            memcpy(block, buffer, sizeof(block));
+            block[position] = (char)c;
+            byteErrors += !percent_encoding_matches(block, sizeof(block));
+        }
+    }
+    CHECK(byteErrors == 0);
+
+    // Multibyte UTF-8 mixed with unreserved runs
+    const char *words[] = { "caf\xc3\xa9", "\xc3\xb1" "and\xc3\xba", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e", "\xf0\x9f\x98\x80", "Gentlemen-and_ladies.~", " " };
+    size_t utf8Length = 0;
+    for (size_t i = 0; utf8Length+32 < sizeof(buffer); i++) {
+        const char *word = words[(i*7)%6];
+        memcpy(buffer+utf8Length, word, strlen(word));
+        utf8Length += strlen(word);
+    }
+    int utf8Errors = 0;
+    for (size_t n = 0; n <= 200; n++) {
+        utf8Errors += !percent_encoding_matches(buffer, n);
+    }
+    utf8Errors += !percent_encoding_matches(buffer, utf8Length);
+    CHECK(utf8Errors == 0);
+}
+
+//
+// Signing and requests
+//
+
+static void test_oauth(void) {
+    // The worked example of Twitter's "Creating a signature" guide
+    fhs_oauth_key *key = fhs_oauth_key_create("xvz1evFS4wEEPTGEFPHBog", "kAcSOqF21Fu85e7zjz7ZN2U4ZRhfV3WpwPAoE3Z7kBw", "370773112-GmHxMAgYyLbNEtIKZeRNFsMKPR9EyMZeS9weJAEb", "LswwdoUaIvS8ltyTt5jkRh4J50vUPVVHtR2YPi5kE");
+    const char *url = "https://api.twitter.com/1.1/statuses/update.json?include_entities=true";
+    const char *body = "status=Hello%20Ladies%20%2B%20Gentlemen%2C%20a%20signed%20OAuth%20request%21";
+
+    fhs_oauth_request request;
+    memset(&request, 0, sizeof(request));
+    request.method = "POST";
+    request.url = url;
+    request.urlLength = strlen(url);
+    request.body = body;
+    request.bodyLength = strlen(body);
+    request.nonce = "kYjzVBB8Y0ZFabxSWbWovY3uYSQ2pTgmZeNu2VS4cg";
+    request.timestamp = 1318622958;
+
+    size_t headerLength = 0;
+    const char *header = fhs_oauth_sign(key, &request, &headerLength);
+    CHECK(header != NULL);
+    CHECK(header && strlen(header) == headerLength);
+    CHECK(header && strstr(header, "oauth_signature=\"hCtSmYh%2BiHYCEqBWrE7C7hYmtUk%3D\"") != NULL);
+    CHECK(header && strncmp(header, "OAuth ", 6) == 0);
+
+    // Fresh nonces and times still sign
+    header = fhs_request_sign(key, "GET", url, strlen(url), NULL, 0, &headerLength);
+    CHECK(header && strstr(header, "oauth_nonce=\"") != NULL && strstr(header, "oauth_signature=\"") != NULL);
+
+    fhs_oauth_key_free(key);
+}
+
+static void test_request(void) {
+    fhs_request_buffer buffer = {0};
+    const char *url = "https://api.twitter.com/1.1/search/tweets.json?q=old#top";
+    fhs_request_param params[] = {
+        { "q", 1, "#wwdc OR caf\xc3\xa9", 14 },
+        { "count", 5, "100", 3 }
+    };
+
+    CHECK(fhs_request_base_length(url, strlen(url)) == strlen("https://api.twitter.com/1.1/search/tweets.json"));
+    CHECK(fhs_request_build_url(&buffer, url, strlen(url), params, 2) == 0);
+    CHECK(strcmp(buffer.data, "https://api.twitter.com/1.1/search/tweets.json?q=%23wwdc%20OR%20caf%C3%A9&count=100") == 0);
+    fhs_request_buffer_free(&buffer);
+
+    CHECK(fhs_request_build_url(&buffer, url, strlen(url), NULL, 0) == 0);
+    CHECK(strcmp(buffer.data, "https://api.twitter.com/1.1/search/tweets.json") == 0);
+    fhs_request_buffer_free(&buffer);
+
+    CHECK(fhs_request_append_form(&buffer, params+1, 1) == 0);
+    CHECK(buffer.length == 9 && strcmp(buffer.data, "count=100") == 0);
+    fhs_request_buffer_free(&buffer);
+    CHECK(buffer.data == NULL && buffer.length == 0);
+}
+
+static void test_endpoint(void) {
+    char encoded[512];
+
+    // The pre-encoded strings match what the signer would build
+    for (int i = 0; i < FHSEndpointCount; i++) {
+        const fhs_endpoint *endpoint = fhs_endpoint_get((FHSEndpoint)i);
+        CHECK(endpoint != NULL);
+
+        if (!endpoint) {
+            continue;
+        }
+
+        size_t length = sprintf(encoded, "%s&", endpoint->method);
+        length += fhs_percent_encode(endpoint->url, strlen(endpoint->url), encoded+length);
+
+        if (endpoint->pathParam < 0) {
+            encoded[length++] = '&';
+        }
+
+        encoded[length] = '\0';
+        CHECK(strlen(endpoint->url) == endpoint->urlLength);
+        CHECK(strlen(endpoint->signingPrefix) == endpoint->signingPrefixLength);
+        CHECK(strcmp(endpoint->signingPrefix, encoded) == 0);
+        CHECK(strncmp(endpoint->path, endpoint->family, strlen(endpoint->family)) == 0);
+        CHECK(endpoint->paramCount <= 32);
+        CHECK(endpoint->pathParam < 0 || (endpoint->params[endpoint->pathParam].flags & FHSParameterInPath));
+    }
+
+    CHECK(fhs_endpoint_get(FHSEndpointCount) == NULL);
+    CHECK(fhs_endpoint_param_named(fhs_endpoint_get(FHSEndpointUsersLookup), "screen_name", 11)->limit == 100);
+    CHECK(fhs_endpoint_param_named(fhs_endpoint_get(FHSEndpointUsersLookup), "screen", 6) == NULL);
+
+    // The worked example again, with its parameters in the body
+    fhs_oauth_key *key = fhs_oauth_key_create("xvz1evFS4wEEPTGEFPHBog", "kAcSOqF21Fu85e7zjz7ZN2U4ZRhfV3WpwPAoE3Z7kBw", "370773112-GmHxMAgYyLbNEtIKZeRNFsMKPR9EyMZeS9weJAEb", "LswwdoUaIvS8ltyTt5jkRh4J50vUPVVHtR2YPi5kE");
+    fhs_endpoint_request request;
+    memset(&request, 0, sizeof(request));
+    fhs_request_param update[] = {
+        { "include_entities", 16, "true", 4 },
+        { "status", 6, "Hello Ladies + Gentlemen, a signed OAuth request!", 49 }
+    };
+
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointStatusesUpdate), update, 2, 0) == 0);
+    CHECK(strcmp(request.url.data, "https://api.twitter.com/1.1/statuses/update.json") == 0);
+    CHECK(strcmp(request.body.data, "include_entities=true&status=Hello%20Ladies%20%2B%20Gentlemen%2C%20a%20signed%20OAuth%20request%21") == 0);
+
+    fhs_oauth_request oauth;
+    memset(&oauth, 0, sizeof(oauth));
+    oauth.method = request.method;
+    oauth.url = request.url.data;
+    oauth.urlLength = request.url.length;
+    oauth.body = request.body.data;
+    oauth.bodyLength = request.body.length;
+    oauth.nonce = "kYjzVBB8Y0ZFabxSWbWovY3uYSQ2pTgmZeNu2VS4cg";
+    oauth.timestamp = 1318622958;
+    oauth.signingPrefix = request.signingPrefix;
+    oauth.signingPrefixLength = request.signingPrefixLength;
+
+    size_t headerLength = 0;
+    const char *header = fhs_oauth_sign(key, &oauth, &headerLength);
+    CHECK(header && strstr(header, "oauth_signature=\"hCtSmYh%2BiHYCEqBWrE7C7hYmtUk%3D\"") != NULL);
+
+    header = fhs_endpoint_request_sign(&request, key, &headerLength);
+    CHECK(header && strlen(header) == headerLength && strncmp(header, "OAuth ", 6) == 0);
+
+    // Path parameters go in the URL and the signing prefix, not the body
+    fhs_request_param retweet[] = { { "id", 2, "1050118621198921728", 19 } };
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointStatusesRetweet), retweet, 1, 0) == 0);
+    CHECK(strcmp(request.url.data, "https://api.twitter.com/1.1/statuses/retweet/1050118621198921728.json") == 0);
+    CHECK(request.body.length == 0);
+    CHECK(request.signingPrefixLength == strlen("POST&https%3A%2F%2Fapi.twitter.com%2F1.1%2Fstatuses%2Fretweet%2F1050118621198921728.json&"));
+    CHECK(strncmp(request.signingPrefix, "POST&https%3A%2F%2Fapi.twitter.com%2F1.1%2Fstatuses%2Fretweet%2F1050118621198921728.json&", request.signingPrefixLength) == 0);
+
+    retweet[0].value = "105011862119892172a";
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointStatusesRetweet), retweet, 1, 0) == -1);
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointStatusesRetweet), NULL, 0, 0) == -1);
+
+    // GET parameters go in the query, counts are clamped
+    fhs_request_param search[] = {
+        { "q", 1, "#wwdc", 5 },
+        { "count", 5, "500", 3 },
+        { "lang", 4, "", 0 }
+    };
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointSearchTweets), search, 3, 0) == 0);
+    CHECK(strcmp(request.url.data, "https://api.twitter.com/1.1/search/tweets.json?q=%23wwdc&count=100&lang=") == 0);
+    CHECK(search[1].valueLength == 3 && memcmp(search[1].value, "100", 3) == 0);
+
+    // Multipart bodies are left to the caller, data parameters have no value
+    fhs_request_param media[] = {
+        { "status", 6, "Photo", 5 },
+        { "media[]", 7, NULL, 1024 }
+    };
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointStatusesUpdateWithMedia), media, 2, 1) == 0);
+    CHECK(strcmp(request.url.data, "https://api.twitter.com/1.1/statuses/update_with_media.json") == 0);
+    CHECK(request.multipart && request.body.length == 0);
+    media[1].valueLength = 0;
+    CHECK(fhs_endpoint_check(fhs_endpoint_get(FHSEndpointStatusesUpdateWithMedia), media, 2) == -1);
+
+    // Profile images are base 64 encoded into the form body, across several encoder chunks
+    static uint8_t image[10000];
+    static char imageBase64[(sizeof(image)+2)/3*4];
+    static char expectedBody[sizeof(imageBase64)*3+64];
+    for (size_t i = 0; i < sizeof(image); i++) {
+        image[i] = (uint8_t)(i*131+7);
+    }
+    image[0] = 0xFB;
+    image[1] = 0xFF;
+    image[2] = 0xBF;
+
+    size_t imageBase64Length = fhs_base64_encode(image, sizeof(image), imageBase64);
+    size_t expectedLength = (size_t)sprintf(expectedBody, "skip_status=true&image=");
+    expectedLength += fhs_percent_encode(imageBase64, imageBase64Length, expectedBody+expectedLength);
+    fhs_request_param profileImage[] = {
+        { "skip_status", 11, "true", 4 },
+        { "image", 5, (const char *)image, sizeof(image) }
+    };
+    CHECK(fhs_endpoint_request_build(&request, fhs_endpoint_get(FHSEndpointAccountUpdateProfileImage), profileImage, 2, 0) == 0);
+    CHECK(!request.multipart && request.body.length == expectedLength && memcmp(request.body.data, expectedBody, expectedLength) == 0);
+    CHECK(strncmp(request.body.data, "skip_status=true&image=%2B%2F%2B%2F", 35) == 0);
+
+    fhs_endpoint_request_free(&request);
+    fhs_oauth_key_free(key);
+
+    // Schema checks
+    const fhs_endpoint *usersSearch = fhs_endpoint_get(FHSEndpointUsersSearch);
+    fhs_request_param missing[] = { { "count", 5, "20", 2 } };
+    CHECK(fhs_endpoint_check(usersSearch, missing, 1) == -1);
+
+    char query[1300];
+    memset(query, 'a', 998);
+    memcpy(query+998, "\xc3\xa9\xc3\xa9\xc3\xa9", 6); // truncated after the second é
+    fhs_request_param longQuery[] = { { "q", 1, query, 1004 }, { "page", 4, "2", 1 } };
+    CHECK(fhs_endpoint_check(usersSearch, longQuery, 2) == 0);
+    CHECK(longQuery[0].valueLength == 1002);
+
+    fhs_request_param badBool[] = { { "q", 1, "a", 1 }, { "include_entities", 16, "yes", 3 } };
+    CHECK(fhs_endpoint_check(usersSearch, badBool, 2) == -1);
+    badBool[1].value = "false";
+    badBool[1].valueLength = 5;
+    CHECK(fhs_endpoint_check(usersSearch, badBool, 2) == 0);
+
+    fhs_request_param unknown[] = { { "q", 1, "a", 1 }, { "tweet_mode", 10, "extended", 8 } };
+    CHECK(fhs_endpoint_check(usersSearch, unknown, 2) == 0);
+
+    const fhs_endpoint *lookup = fhs_endpoint_get(FHSEndpointUsersLookup);
+    char users[512];
+    size_t usersLength = 0;
+
+    for (int i = 0; i < 101; i++) {
+        usersLength += sprintf(users+usersLength, "%s%d", (i > 0)?",":"", i);
+    }
+
+    fhs_request_param tooMany[] = { { "user_id", 7, users, usersLength } };
+    CHECK(fhs_endpoint_check(lookup, tooMany, 1) == -1);
+    tooMany[0].valueLength = strrchr(users, ',')-users;
+    CHECK(fhs_endpoint_check(lookup, tooMany, 1) == 0);
+    CHECK(fhs_endpoint_check(lookup, NULL, 0) == -1);
+
+    const fhs_endpoint *profile = fhs_endpoint_get(FHSEndpointAccountUpdateProfile);
+    fhs_request_param name[] = { { "name", 4, "twenty one characters", 21 } };
+    CHECK(fhs_endpoint_check(profile, name, 1) == -1);
+    name[0].valueLength = 20;
+    CHECK(fhs_endpoint_check(profile, name, 1) == 0);
+
+    fhs_request_param cursor[] = { { "cursor", 6, "-1", 2 } };
+    CHECK(fhs_endpoint_check(fhs_endpoint_get(FHSEndpointFollowersIDs), cursor, 1) == 0);
+    cursor[0].value = "-";
+    cursor[0].valueLength = 1;
+    CHECK(fhs_endpoint_check(fhs_endpoint_get(FHSEndpointFollowersIDs), cursor, 1) == -1);
+}
+
+static void test_nonce(void) {
+    char first[FHS_NONCE_LENGTH+1];
+    char second[FHS_NONCE_LENGTH+1];
+    fhs_nonce(first);
+    fhs_nonce(second);
+
+    CHECK(strlen(first) == FHS_NONCE_LENGTH);
+    CHECK(strcmp(first, second) != 0);
+
+    for (size_t i = 0; i < FHS_NONCE_LENGTH; i++) {
+        CHECK(fhs_percent_unreserved[(uint8_t)first[i]] && first[i] != '-' && first[i] != '.' && first[i] != '_' && first[i] != '~');
+    }
+
+    // A forked child doesn't replay the bytes its parent still has buffered
+    int pipeFDs[2];
+    CHECK(pipe(pipeFDs) == 0);
+    fflush(NULL);
+    pid_t child = fork();
+    CHECK(child >= 0);
+
+    if (child == 0) {
+        char nonce[FHS_NONCE_LENGTH+1];
+        fhs_nonce(nonce);
+        _exit(write(pipeFDs[1], nonce, FHS_NONCE_LENGTH) == FHS_NONCE_LENGTH?0:1);
+    }
+
+    char parentNonce[FHS_NONCE_LENGTH+1];
+    char childNonce[FHS_NONCE_LENGTH+1] = {0};
+    int status = 0;
+    fhs_nonce(parentNonce);
+    CHECK(read(pipeFDs[0], childNonce, FHS_NONCE_LENGTH) == FHS_NONCE_LENGTH);
+    CHECK(waitpid(child, &status, 0) == child && WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    CHECK(strcmp(parentNonce, childNonce) != 0);
+    close(pipeFDs[0]);
+    close(pipeFDs[1]);
+}
+
+//
+// Streaming
+//
+
+typedef struct {
+    char messages[8][64];
+    size_t count;
+    size_t keepAlives;
+    size_t stopAfter;
+} stream_capture;
+
+static int capture_message(void *context, const char *message, size_t length) {
+    stream_capture *capture = context;
+
+    if (!message) {
+        capture->keepAlives++;
+        return 0;
+    }
+
+    if (capture->count < 8 && length < 64) {
+        memcpy(capture->messages[capture->count], message, length);
+        capture->messages[capture->count][length] = '\0';
+    }
+
+    capture->count++;
+    return (capture->stopAfter > 0 && capture->count >= capture->stopAfter);
+}
+
+static void test_stream_parser(void) {
+    const char *stream = "\r\n16\r\n{\"text\":\"one\"}\r\n\r\n\r\n19\r\n{\"friends\":[1,2]}\r\n14\r\n{\"delete\":1}\r\n";
+    size_t length = strlen(stream);
+
+    // Every way of splitting the stream in two, and one byte at a time
+    for (size_t split = 0; split <= length+1; split++) {
+        stream_capture capture;
+        memset(&capture, 0, sizeof(capture));
+        fhs_stream_parser parser;
+        fhs_stream_parser_init(&parser, 0, capture_message, &capture);
+
+        if (split <= length) {
+            CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)stream, split) == 0);
+            CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)stream+split, length-split) == 0);
+        } else {
+            for (size_t i = 0; i < length; i++) {
+                CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)stream+i, 1) == 0);
+            }
+        }
+
+        CHECK(capture.count == 3);
+        CHECK(capture.keepAlives == 3);
+        CHECK(strcmp(capture.messages[0], "{\"text\":\"one\"}") == 0);
+        CHECK(strcmp(capture.messages[1], "{\"friends\":[1,2]}") == 0);
+        CHECK(strcmp(capture.messages[2], "{\"delete\":1}") == 0);
+        fhs_stream_parser_free(&parser);
+    }
+
+    // Stopping, limits and garbage
+    stream_capture capture;
+    memset(&capture, 0, sizeof(capture));
+    capture.stopAfter = 1;
+    fhs_stream_parser parser;
+    fhs_stream_parser_init(&parser, 0, capture_message, &capture);
+    CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)stream, length) == 1);
+    CHECK(capture.count == 1);
+    fhs_stream_parser_free(&parser);
+
+    fhs_stream_parser_init(&parser, 16, capture_message, &capture);
+    CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)"17\r\n", 4) == -1);
+    CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)"\r\n", 2) == -1);
+    fhs_stream_parser_free(&parser);
+
+    fhs_stream_parser_init(&parser, 0, capture_message, &capture);
+    CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)"<html>", 6) == -1);
+    fhs_stream_parser_free(&parser);
+
+    fhs_stream_parser_init(&parser, 0, capture_message, &capture);
+    CHECK(fhs_stream_parser_feed(&parser, (const uint8_t *)"99999999999999999999999\r\n", 25) == -1);
+    fhs_stream_parser_free(&parser);
+}
+
+//
+// JSON and ids
+//
+
+typedef struct {
+    int objects;
+    int arrays;
+    int strings;
+    int64_t integerSum;
+    int booleans;
+    int nulls;
+} json_counts;
+
+static int count_object(void *context) { ((json_counts *)context)->objects++; return 0; }
+static int count_array(void *context) { ((json_counts *)context)->arrays++; return 0; }
+static int count_string(void *context, const char *bytes, size_t length) { (void)bytes; (void)length; ((json_counts *)context)->strings++; return 0; }
+static int count_integer(void *context, int64_t value) { ((json_counts *)context)->integerSum += value; return 0; }
+static int count_boolean(void *context, int value) { (void)value; ((json_counts *)context)->booleans++; return 0; }
+static int count_null(void *context) { ((json_counts *)context)->nulls++; return 0; }
+
+// Containers open at once, as a builder keeping one frame per container would see them
+typedef struct {
+    int open;
+    int maxOpen;
+} json_depth;
+
+static int depth_begin(void *context) { json_depth *d = context; if (++d->open > d->maxOpen) { d->maxOpen = d->open; } return 0; }
+static int depth_end(void *context) { ((json_depth *)context)->open--; return 0; }
+
+// Parses depth nested containers, the innermost empty, and returns the parse result
+static int parse_nested(size_t depth, int objects, json_depth *result) {
+    char *text = malloc(depth*6+1);
+    size_t length = 0;
+    for (size_t i = 0; i < depth; i++) {
+        if (objects && i+1 < depth) {
+            memcpy(text+length, "{\"a\":", 5);
+            length += 5;
+        } else {
+            text[length++] = objects?'{':'[';
+        }
+    }
+    for (size_t i = 0; i < depth; i++) {
+        text[length++] = objects?'}':']';
+    }
+
+    fhs_json_callbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    callbacks.begin_object = depth_begin;
+    callbacks.begin_array = depth_begin;
+    callbacks.end_object = depth_end;
+    callbacks.end_array = depth_end;
+    memset(result, 0, sizeof(*result));
+    fhs_json_error error;
+    int status = fhs_json_parse((const uint8_t *)text, length, &callbacks, result, &error);
+    free(text);
+    return status;
+}
+
+static void test_json(void) {
+    const char *text = "{\"id\":10765432100123456789,\"id_str\":\"10765432100123456789\",\"user\":{\"name\":\"caf\\u00e9\",\"followers\":[1,2,-3]},\"truncated\":false,\"place\":null}";
+    fhs_json_callbacks callbacks;
+    memset(&callbacks, 0, sizeof(callbacks));
+    callbacks.begin_object = count_object;
+    callbacks.begin_array = count_array;
+    callbacks.string = count_string;
+    callbacks.integer = count_integer;
+    callbacks.boolean = count_boolean;
+    callbacks.null = count_null;
+
+    json_counts counts;
+    memset(&counts, 0, sizeof(counts));
+    fhs_json_error error;
+    CHECK(fhs_json_parse((const uint8_t *)text, strlen(text), &callbacks, &counts, &error) == 0);
+    CHECK(counts.objects == 2 && counts.arrays == 1 && counts.strings == 2);
+    CHECK(counts.integerSum == 0 && counts.booleans == 1 && counts.nulls == 1);
+
+    CHECK(fhs_json_parse((const uint8_t *)"{\"a\":[1,}", 9, &callbacks, &counts, &error) != 0);
+
+    // FHS_JSON_MAX_DEPTH containers parse, one more fails before its begin callback
+    json_depth depth;
+    CHECK(parse_nested(FHS_JSON_MAX_DEPTH, 0, &depth) == 0 && depth.maxOpen == FHS_JSON_MAX_DEPTH);
+    CHECK(parse_nested(FHS_JSON_MAX_DEPTH+1, 0, &depth) != 0 && depth.maxOpen == FHS_JSON_MAX_DEPTH);
+    CHECK(parse_nested(FHS_JSON_MAX_DEPTH, 1, &depth) == 0 && depth.maxOpen == FHS_JSON_MAX_DEPTH);
+    CHECK(parse_nested(FHS_JSON_MAX_DEPTH+1, 1, &depth) != 0 && depth.maxOpen == FHS_JSON_MAX_DEPTH);
+
+    fhs_json_member members[8];
+    size_t count = 0;
+    fhs_json_type type;
+    CHECK(fhs_json_index((const uint8_t *)text, strlen(text), members, 8, &count, &type) == 0);
+    CHECK(count == 5 && type == FHS_JSON_OBJECT);
+
+    const fhs_json_member *member = fhs_json_find((const uint8_t *)text, members, count, "id_str", 6);
+    uint64_t value = 0;
+    CHECK(member && member->type == FHS_JSON_STRING);
+    CHECK(member && fhs_json_read_uint64((const uint8_t *)text+member->valueOffset, member->valueLength, &value) == 0 && value == 10765432100123456789ULL);
+    CHECK(fhs_json_find((const uint8_t *)text, members, count, "missing", 7) == NULL);
+}
+
+static void test_ids(void) {
+    const char *page = "{\"ids\":[\"3\",\"1\",2],\"next_cursor\":1374004777531007833,\"previous_cursor\":0}";
+    fhs_id_list list;
+    memset(&list, 0, sizeof(list));
+    CHECK(fhs_id_list_decode((const uint8_t *)page, strlen(page), &list, NULL) == 0);
+    CHECK(list.count == 3 && list.ids[0] == 3 && list.ids[1] == 1 && list.ids[2] == 2);
+    CHECK(list.nextCursor == 1374004777531007833LL);
+
+    const char *failure = "{\"errors\":[{\"code\":88}]}";
+    CHECK(fhs_id_list_decode((const uint8_t *)failure, strlen(failure), &list, NULL) != 0);
+    CHECK(list.count == 3);
+    free(list.ids);
+
+    uint64_t a[] = { 9, 3, 3, 7, 1 };
+    uint64_t b[] = { 1, 2, 9 };
+    uint64_t onlyA[5], onlyB[3], both[3];
+    size_t onlyACount, onlyBCount, bothCount;
+    size_t unique = fhs_idset_normalize(a, 5, NULL);
+    CHECK(unique == 4 && a[0] == 1 && a[1] == 3 && a[2] == 7 && a[3] == 9);
+    CHECK(fhs_idset_contains(a, unique, 7) && !fhs_idset_contains(a, unique, 8));
+
+    fhs_idset_compare(a, unique, b, 3, onlyA, &onlyACount, onlyB, &onlyBCount, both, &bothCount);
+    CHECK(onlyACount == 2 && onlyA[0] == 3 && onlyA[1] == 7);
+    CHECK(onlyBCount == 1 && onlyB[0] == 2);
+    CHECK(bothCount == 2 && both[0] == 1 && both[1] == 9);
+
+    // Larger sets take the radix sort
+    size_t large = 10000;
+    uint64_t *ids = malloc(large*sizeof(uint64_t));
+    uint64_t *scratch = malloc(large*sizeof(uint64_t));
+    uint64_t state = 88172645463325252ULL;
+
+    for (size_t i = 0; i < large; i++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        ids[i] = (i%10 == 0 && i > 0)?ids[i-1]:state;
+    }
+
+    unique = fhs_idset_normalize(ids, large, scratch);
+    int sorted = 1;
+
+    for (size_t i = 1; i < unique; i++) {
+        sorted &= (ids[i-1] < ids[i]);
+    }
+
+    CHECK(sorted && unique == large-(large-1)/10);
+    free(ids);
+    free(scratch);
+
+    char digits[FHS_SNOWFLAKE_MAX_DIGITS+1];
+    uint64_t snowflake = 0;
+    CHECK(fhs_snowflake_parse("1050118621198921728", 19, &snowflake) == 0 && snowflake == 1050118621198921728ULL);
+    CHECK(fhs_snowflake_format(snowflake, digits) == 19 && strcmp(digits, "1050118621198921728") == 0);
+    CHECK(fhs_snowflake_time(snowflake) == 1539202764211ULL);
+    CHECK(fhs_snowflake_parse("18446744073709551616", 20, &snowflake) != 0);
+    CHECK(fhs_snowflake_parse("12a", 3, &snowflake) != 0);
+}
+
+static void test_timestamp(void) {
+    int64_t seconds = 0;
+    char text[FHS_TIMESTAMP_LENGTH+1];
+    char date[FHS_TIMESTAMP_DATE_LENGTH+1];
+
+    CHECK(fhs_timestamp_parse("Wed Aug 27 13:08:45 +0000 2008", 30, &seconds) == 0 && seconds == 1219842525);
+    CHECK(fhs_timestamp_format(seconds, text) == FHS_TIMESTAMP_LENGTH && strcmp(text, "Wed Aug 27 13:08:45 +0000 2008") == 0);
+    CHECK(fhs_timestamp_format_date(seconds, date) == FHS_TIMESTAMP_DATE_LENGTH && strcmp(date, "2008-08-27") == 0);
+    CHECK(fhs_timestamp_parse("Wed Aug 32 13:08:45 +0000 2008", 30, &seconds) != 0);
+}
+
+//
+// Media and the text index
+//
+
+static void test_media(void) {
+    static const uint8_t png[] = {
+        0x89, 'P', 'N', 'G', 0x0d, 0x0a, 0x1a, 0x0a,
+        0, 0, 0, 13, 'I', 'H', 'D', 'R',
+        0, 0, 0x01, 0x90, 0, 0, 0x00, 0xc8,
+        8, 6, 0, 0, 0,
+        0, 0, 0, 0 // CRC, not checked
+    };
+    fhs_media_info info;
+    CHECK(fhs_media_probe(png, sizeof(png), &info) == 0);
+    CHECK(info.format == FHSMediaFormatPNG && info.width == 400 && info.height == 200);
+    CHECK(fhs_media_validate(&info, 1000, &fhs_media_default_limits) == FHSMediaValid);
+    CHECK(strcmp(fhs_media_format_mime_type(FHSMediaFormatPNG), "image/png") == 0);
+    CHECK(fhs_media_probe(png, 12, &info) != 0);
+}
+
+static void test_text_index(void) {
+    fhs_text_index_builder *builder = fhs_text_index_builder_create();
+    const char *tweets[] = {
+        "Apple event in New York today #wwdc",
+        "new phone from @apple",
+        "York is not new",
+        "apples and oranges"
+    };
+
+    for (size_t i = 0; i < 4; i++) {
+        CHECK(fhs_text_index_builder_add(builder, 100+i, tweets[i], strlen(tweets[i])) == 0);
+    }
+
+    uint8_t *segmentData = NULL;
+    size_t segmentLength = 0;
+    fhs_text_index_segment segment;
+    CHECK(fhs_text_index_builder_write(builder, &segmentData, &segmentLength) == 0);
+    CHECK(fhs_text_index_segment_open(&segment, segmentData, segmentLength) == 0);
+    CHECK(segment.count == 4 && segment.minID == 100 && segment.maxID == 103);
+
+    uint64_t *ids = NULL;
+    size_t count = 0;
+    const char *phrase = "\"new york\"";
+    CHECK(fhs_text_index_search(&segment, 1, NULL, phrase, strlen(phrase), 0, 0, 0, &ids, &count) == 0);
+    CHECK(count == 1 && ids[0] == 100);
+    free(ids);
+
+    const char *either = "apple OR york";
+    CHECK(fhs_text_index_search(&segment, 1, NULL, either, strlen(either), 0, 0, 0, &ids, &count) == 0);
+    CHECK(count == 3 && ids[0] == 102 && ids[1] == 101 && ids[2] == 100);
+    free(ids);
+
+    // A hashtag query only matches the hashtag, and the builder is searched alongside segments
+    fhs_text_index_builder *fresh = fhs_text_index_builder_create();
+    const char *later = "more #wwdc news";
+    CHECK(fhs_text_index_builder_add(fresh, 200, later, strlen(later)) == 0);
+    const char *hashtag = "#wwdc";
+    CHECK(fhs_text_index_search(&segment, 1, fresh, hashtag, strlen(hashtag), 0, 0, 1, &ids, &count) == 0);
+    CHECK(count == 1 && ids[0] == 200);
+    free(ids);
+
+    // Dictionary entries whose postings offset plus length wraps to 0 are rejected, not read 4 GB before the segment
+    uint8_t *corrupt = malloc(segmentLength);
+    memcpy(corrupt, segmentData, segmentLength);
+    for (uint32_t i = 0; i < segment.termCount; i++) {
+        uint8_t *entry = corrupt+56+(size_t)i*24; // 56 byte header, 24 byte entries
+        uint64_t offset = 0-(uint64_t)0xFFFFFFFFu;
+        for (int b = 0; b < 8; b++) {
+            entry[8+b] = (uint8_t)(offset >> (8*b));
+        }
+        memset(entry+16, 0xFF, 4);
+    }
+    fhs_text_index_segment corruptSegment;
+    CHECK(fhs_text_index_segment_open(&corruptSegment, corrupt, segmentLength) == 0);
+    ids = NULL;
+    CHECK(fhs_text_index_search(&corruptSegment, 1, NULL, either, strlen(either), 0, 0, 0, &ids, &count) != 0);
+    free(ids);
+    free(corrupt);
+
+    segmentData[0] ^= 0xff;
+    CHECK(fhs_text_index_segment_open(&segment, segmentData, segmentLength) != 0);
+
+    free(segmentData);
+    fhs_text_index_builder_free(builder);
+    fhs_text_index_builder_free(fresh);
+}
+
+int main(void) {
+    test_sha1();
+    test_base64();
+    test_percent_encoding();
+    test_oauth();
+    test_request();
+    test_endpoint();
+    test_nonce();
+    test_stream_parser();
+    test_json();
+    test_ids();
+    test_timestamp();
+    test_media();
+    test_text_index();
+
+    printf("%d checks, %d failed (sha1 %s, base64 %s)\n", checks, failures, fhs_sha1_backend_name(), fhs_base64_backend_name());
+    return failures == 0?0:1;
+}